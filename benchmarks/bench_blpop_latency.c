@@ -0,0 +1,293 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : benchmarks/bench_blpop_latency.c
+ * Module                    : Blocking Pop Latency Benchmark
+ * Last Updating Author      : agent
+ * Last Update               : 10/17/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Parks a large population of consumers in BLPOP, spread over a set of
+ *  lists, then pushes one element at a time and measures how long it
+ *  takes to reach the consumer that was woken up. Each woken consumer
+ *  blocks again right away, joining the back of its list's queue.
+ *
+ *  Usage: ./benchmarks/bench_blpop_latency [-c consumers] [-k lists]
+ *                                          [-n pushes] [-P port] [-s server]
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+static pid_t server_pid = -1;
+
+static long long now_micros(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static int connect_to(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+static int start_server(const char *path, int port) {
+    server_pid = fork();
+    if (server_pid < 0) return -1;
+    if (server_pid == 0) {
+        char port_str[16];
+        snprintf(port_str, sizeof(port_str), "%d", port);
+        setenv("MEMORADB_PORT", port_str, 1);
+        int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) {
+            dup2(devnull, STDOUT_FILENO);
+            dup2(devnull, STDERR_FILENO);
+        }
+        execl(path, path, (char *)NULL);
+        _exit(127);
+    }
+
+    for (int attempt = 0; attempt < 50; attempt++) {
+        usleep(100 * 1000);
+        int fd = connect_to(port);
+        if (fd >= 0) {
+            close(fd);
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static void stop_server(void) {
+    if (server_pid > 0) {
+        kill(server_pid, SIGTERM);
+        waitpid(server_pid, NULL, 0);
+        server_pid = -1;
+    }
+}
+
+static void raise_fd_limit(void) {
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+static int send_all(int fd, const char *buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+static int send_blpop(int fd, int list) {
+    char key[32], request[128];
+    int key_len = snprintf(key, sizeof(key), "bench:q:%d", list);
+    int len = snprintf(request, sizeof(request), "*3\r\n$5\r\nBLPOP\r\n$%d\r\n%s\r\n$1\r\n0\r\n", key_len, key);
+    return send_all(fd, request, (size_t)len);
+}
+
+static int send_rpush(int fd, int list, long long value) {
+    char key[32], element[32], request[160];
+    int key_len = snprintf(key, sizeof(key), "bench:q:%d", list);
+    int element_len = snprintf(element, sizeof(element), "%lld", value);
+    int len = snprintf(request, sizeof(request), "*3\r\n$5\r\nRPUSH\r\n$%d\r\n%s\r\n$%d\r\n%s\r\n",
+                       key_len, key, element_len, element);
+    return send_all(fd, request, (size_t)len);
+}
+
+/**
+ * Ask INFO how many clients are parked in the server.
+ */
+static long blocked_clients(int fd) {
+    static const char info[] = "*1\r\n$4\r\nINFO\r\n";
+    char buf[8192];
+    if (send_all(fd, info, sizeof(info) - 1) != 0) return -1;
+
+    size_t got = 0;
+    long total = -1;   //- Bytes of the whole bulk reply once its header is in -//
+    while (got < sizeof(buf) - 1 && (total < 0 || (long)got < total)) {
+        ssize_t n = read(fd, buf + got, sizeof(buf) - 1 - got);
+        if (n <= 0) return -1;
+        got += (size_t)n;
+        buf[got] = '\0';
+        char *crlf = strstr(buf, "\r\n");
+        if (total < 0 && buf[0] == '$' && crlf) {
+            total = (crlf + 2 - buf) + strtol(buf + 1, NULL, 10) + 2;
+        }
+    }
+    char *field = strstr(buf, "blocked_clients:");
+    return field ? strtol(field + strlen("blocked_clients:"), NULL, 10) : -1;
+}
+
+static int compare_ll(const void *a, const void *b) {
+    long long x = *(const long long *)a, y = *(const long long *)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char *argv[]) {
+    int consumers = 10000, lists = 100, pushes = 50000, port = 6391;
+    const char *server_path = "./server";
+
+    int opt;
+    while ((opt = getopt(argc, argv, "c:k:n:P:s:")) != -1) {
+        switch (opt) {
+        case 'c': consumers = atoi(optarg); break;
+        case 'k': lists = atoi(optarg); break;
+        case 'n': pushes = atoi(optarg); break;
+        case 'P': port = atoi(optarg); break;
+        case 's': server_path = optarg; break;
+        default:
+            fprintf(stderr, "Usage: %s [-c consumers] [-k lists] [-n pushes] [-P port] [-s server]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (consumers < 1 || lists < 1 || lists > consumers || pushes < 1) {
+        fprintf(stderr, "Need 1 <= lists <= consumers and at least one push\n");
+        return 1;
+    }
+
+    raise_fd_limit();
+    signal(SIGPIPE, SIG_IGN);
+
+    if (start_server(server_path, port) != 0) {
+        fprintf(stderr, "Could not start %s on port %d\n", server_path, port);
+        stop_server();
+        return 1;
+    }
+
+    int producer = connect_to(port);
+    int epfd = epoll_create1(0);
+    int *fds = calloc(consumers, sizeof(int));
+    long long *latency = calloc(pushes, sizeof(long long));
+    if (producer < 0 || epfd < 0 || !fds || !latency) {
+        fprintf(stderr, "Setup failed: %s\n", strerror(errno));
+        stop_server();
+        return 1;
+    }
+
+    //-- Consumer i waits on list i % lists --//
+    int opened = 0;
+    for (; opened < consumers; opened++) {
+        int fd = connect_to(port);
+        if (fd < 0 || send_blpop(fd, opened % lists) != 0) {
+            fprintf(stderr, "Consumer %d failed: %s\n", opened, strerror(errno));
+            if (fd >= 0) close(fd);
+            break;
+        }
+        fds[opened] = fd;
+        struct epoll_event ev = { .events = EPOLLIN, .data.u32 = (uint32_t)opened };
+        epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+    }
+    if (opened < lists) {
+        fprintf(stderr, "Not enough consumers to cover every list\n");
+        stop_server();
+        return 1;
+    }
+
+    long parked = -1;
+    for (int attempt = 0; attempt < 100 && parked < opened; attempt++) {
+        parked = blocked_clients(producer);
+        if (parked < opened) usleep(50 * 1000);
+    }
+
+    printf("=== BLPOP Push-to-Pop Latency Benchmark ===\n");
+    printf("Blocked consumers            : %8ld\n", parked);
+    printf("Lists                        : %8d\n", lists);
+
+    //-- Producer replies are never read in the timed loop: stop it from blocking on them --//
+    fcntl(producer, F_SETFL, fcntl(producer, F_GETFL, 0) | O_NONBLOCK);
+
+    struct epoll_event events[16];
+    char buf[4096];
+    int completed = 0;
+    long long start = now_micros();
+
+    for (; completed < pushes; completed++) {
+        long long sent = now_micros();
+        if (send_rpush(producer, completed % lists, completed) != 0) {
+            fprintf(stderr, "Push failed: %s\n", strerror(errno));
+            break;
+        }
+
+        int woken = -1;
+        while (woken < 0) {
+            int n = epoll_wait(epfd, events, 16, 1000);
+            if (n <= 0) {
+                fprintf(stderr, "No consumer woke up for push %d\n", completed);
+                goto done;
+            }
+            woken = (int)events[0].data.u32;
+        }
+        latency[completed] = now_micros() - sent;
+
+        //-- One reply per wake-up; read it whole, then queue up again --//
+        if (read(fds[woken], buf, sizeof(buf)) <= 0 || send_blpop(fds[woken], woken % lists) != 0) {
+            fprintf(stderr, "Consumer %d went away\n", woken);
+            break;
+        }
+        while (read(producer, buf, sizeof(buf)) > 0) {
+        }
+    }
+
+done:;
+    double elapsed = (now_micros() - start) / 1e6;
+    if (completed > 0) {
+        long long sum = 0;
+        for (int i = 0; i < completed; i++) sum += latency[i];
+        qsort(latency, completed, sizeof(long long), compare_ll);
+        printf("Pushes delivered             : %8d\n", completed);
+        printf("Throughput                   : %8.0f pushes/s\n", completed / elapsed);
+        printf("Latency avg                  : %8.1f us\n", (double)sum / completed);
+        printf("Latency p50                  : %8lld us\n", latency[completed / 2]);
+        printf("Latency p99                  : %8lld us\n", latency[(long long)completed * 99 / 100]);
+        printf("Latency max                  : %8lld us\n", latency[completed - 1]);
+    }
+
+    for (int i = 0; i < opened; i++) close(fds[i]);
+    close(producer);
+    close(epfd);
+    free(fds);
+    free(latency);
+    stop_server();
+    return completed == pushes ? 0 : 1;
+}
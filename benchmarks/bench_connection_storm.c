@@ -0,0 +1,340 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : benchmarks/bench_connection_storm.c
+ * Module                    : Connection Storm Benchmark
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Reproduces the reconnect storm after a deploy: client threads open
+ *  all their connections at once, and each connection counts as served
+ *  when its first PING is answered. Runs the server with one shared
+ *  listening socket and with one SO_REUSEPORT socket per event loop,
+ *  and reports the accept rate, connect-to-reply latency, connections
+ *  that took a SYN retransmit (over one second) and the kernel's
+ *  ListenOverflows / ListenDrops counters over the run. With -m the
+ *  server admits at most that many clients; connections refused with an
+ *  error reply count as accepted, and are also counted apart.
+ *
+ *  Usage: ./benchmarks/bench_connection_storm [-c connections] [-t threads]
+ *                                             [-b backlog] [-w workers]
+ *                                             [-m maxclients]
+ *                                             [-P port] [-s server]
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#define PING_CMD "*1\r\n$4\r\nPING\r\n"
+#define PONG_REPLY_LEN 7
+#define STORM_TIMEOUT_S 60.0
+#define SYN_RETRANSMIT_S 1.0      //- First SYN retransmission: a connect this slow had a SYN dropped -//
+
+static pid_t server_pid = -1;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Read a TcpExt counter from /proc/net/netstat, where a line of names is
+ * followed by a line of values.
+ */
+static long long read_tcpext(const char *name) {
+    FILE *f = fopen("/proc/net/netstat", "r");
+    if (!f) return -1;
+    char names[4096], values[4096];
+    long long result = -1;
+    while (result < 0 && fgets(names, sizeof(names), f) && fgets(values, sizeof(values), f)) {
+        if (strncmp(names, "TcpExt:", 7) != 0) continue;
+        char *name_save = NULL, *value_save = NULL;
+        char *n = strtok_r(names, " \n", &name_save), *v = strtok_r(values, " \n", &value_save);
+        while (n && v) {
+            if (strcmp(n, name) == 0) {
+                result = atoll(v);
+                break;
+            }
+            n = strtok_r(NULL, " \n", &name_save);
+            v = strtok_r(NULL, " \n", &value_save);
+        }
+    }
+    fclose(f);
+    return result;
+}
+
+static int connect_to(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int start_server(const char *path, int port, int reuseport, int backlog, int workers, int maxclients) {
+    server_pid = fork();
+    if (server_pid < 0) return -1;
+    if (server_pid == 0) {
+        char value[16];
+        snprintf(value, sizeof(value), "%d", port);
+        setenv("MEMORADB_PORT", value, 1);
+        snprintf(value, sizeof(value), "%d", reuseport);
+        setenv("MEMORADB_REUSEPORT", value, 1);
+        snprintf(value, sizeof(value), "%d", backlog);
+        setenv("MEMORADB_TCP_BACKLOG", value, 1);
+        if (workers > 0) {
+            snprintf(value, sizeof(value), "%d", workers);
+            setenv("MEMORADB_WORKERS", value, 1);
+        }
+        if (maxclients > 0) {
+            snprintf(value, sizeof(value), "%d", maxclients);
+            setenv("MEMORADB_MAXCLIENTS", value, 1);
+        }
+        int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) {
+            dup2(devnull, STDOUT_FILENO);
+            dup2(devnull, STDERR_FILENO);
+        }
+        execl(path, path, (char *)NULL);
+        _exit(127);
+    }
+
+    for (int attempt = 0; attempt < 50; attempt++) {
+        usleep(100 * 1000);
+        int fd = connect_to(port);
+        if (fd >= 0) {
+            close(fd);
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static void stop_server(void) {
+    if (server_pid > 0) {
+        kill(server_pid, SIGTERM);
+        waitpid(server_pid, NULL, 0);
+        server_pid = -1;
+    }
+}
+
+static void raise_fd_limit(void) {
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+/* ==================== Storm ==================== */
+
+typedef struct {
+    int port;
+    int first;                //- Index of the thread's first connection -//
+    int count;
+    double *latency;          //- Connect to reply per connection, -1 if it failed -//
+    int failed;
+    int rejected;             //- Turned away at maxclients with an error reply -//
+} Storm;
+
+static pthread_barrier_t start_line;
+
+static void *run_storm(void *arg) {
+    Storm *s = arg;
+    int *fds = malloc((size_t)s->count * sizeof(int));
+    double *started = malloc((size_t)s->count * sizeof(double));
+    int epfd = epoll_create1(0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(s->port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+    pthread_barrier_wait(&start_line);
+
+    //-- Every SYN of the thread goes out back to back --//
+    int done = 0;
+    for (int i = 0; i < s->count; i++) {
+        double *latency = &s->latency[s->first + i];
+        *latency = -1;
+        started[i] = now_seconds();
+        fds[i] = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        if (fds[i] < 0 || (connect(fds[i], (struct sockaddr *)&addr, sizeof(addr)) != 0 && errno != EINPROGRESS)) {
+            s->failed++;
+            done++;
+            continue;
+        }
+        struct epoll_event ev = { .events = EPOLLOUT, .data.u32 = (uint32_t)i };
+        epoll_ctl(epfd, EPOLL_CTL_ADD, fds[i], &ev);
+    }
+
+    struct epoll_event events[256];
+    char buf[64];
+    double deadline = now_seconds() + STORM_TIMEOUT_S;
+    while (done < s->count && now_seconds() < deadline) {
+        int n = epoll_wait(epfd, events, 256, 100);
+        for (int e = 0; e < n; e++) {
+            int i = (int)events[e].data.u32;
+            if (events[e].events & EPOLLOUT) {
+                //-- Handshake over: ask for a PONG, which only an accepted connection gets --//
+                int err = 0;
+                socklen_t len = sizeof(err);
+                getsockopt(fds[i], SOL_SOCKET, SO_ERROR, &err, &len);
+                if (err != 0 || write(fds[i], PING_CMD, sizeof(PING_CMD) - 1) < 0) {
+                    epoll_ctl(epfd, EPOLL_CTL_DEL, fds[i], NULL);
+                    s->failed++;
+                    done++;
+                    continue;
+                }
+                struct epoll_event ev = { .events = EPOLLIN, .data.u32 = (uint32_t)i };
+                epoll_ctl(epfd, EPOLL_CTL_MOD, fds[i], &ev);
+            } else {
+                //-- A refusal is answered too: it counts as accepted, and apart as rejected --//
+                ssize_t n = read(fds[i], buf, sizeof(buf));
+                if (n > 0 && (buf[0] == '-' || n >= PONG_REPLY_LEN)) {
+                    s->latency[s->first + i] = now_seconds() - started[i];
+                    if (buf[0] == '-') s->rejected++;
+                } else if (n != 0) {
+                    continue;
+                } else {
+                    s->failed++;
+                }
+                epoll_ctl(epfd, EPOLL_CTL_DEL, fds[i], NULL);
+                done++;
+            }
+        }
+    }
+    s->failed += s->count - done;
+
+    //-- The connections stay open until every thread is done, as reconnected clients would --//
+    pthread_barrier_wait(&start_line);
+    for (int i = 0; i < s->count; i++) {
+        if (fds[i] >= 0) close(fds[i]);
+    }
+    close(epfd);
+    free(started);
+    free(fds);
+    return NULL;
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void run(const char *label, const char *server_path, int port, int reuseport,
+                int backlog, int workers, int maxclients, int connections, int threads) {
+    if (start_server(server_path, port, reuseport, backlog, workers, maxclients) != 0) {
+        fprintf(stderr, "Could not start %s on port %d\n", server_path, port);
+        stop_server();
+        exit(1);
+    }
+
+    double *latency = calloc((size_t)connections, sizeof(double));
+    Storm *storms = calloc((size_t)threads, sizeof(Storm));
+    pthread_t *tids = calloc((size_t)threads, sizeof(pthread_t));
+    pthread_barrier_init(&start_line, NULL, (unsigned)threads + 1);
+    for (int t = 0; t < threads; t++) {
+        int first = (int)((long long)connections * t / threads);
+        int next = (int)((long long)connections * (t + 1) / threads);
+        storms[t] = (Storm){ port, first, next - first, latency, 0, 0 };
+        pthread_create(&tids[t], NULL, run_storm, &storms[t]);
+    }
+
+    long long overflows = read_tcpext("ListenOverflows"), drops = read_tcpext("ListenDrops");
+    pthread_barrier_wait(&start_line);
+    double start = now_seconds();
+    pthread_barrier_wait(&start_line);
+    double elapsed = now_seconds() - start;
+    overflows = read_tcpext("ListenOverflows") - overflows;
+    drops = read_tcpext("ListenDrops") - drops;
+    for (int t = 0; t < threads; t++) pthread_join(tids[t], NULL);
+
+    int failed = 0, rejected = 0, retransmitted = 0, answered = 0;
+    for (int t = 0; t < threads; t++) {
+        failed += storms[t].failed;
+        rejected += storms[t].rejected;
+    }
+    for (int i = 0; i < connections; i++) {
+        if (latency[i] < 0) continue;
+        if (latency[i] >= SYN_RETRANSMIT_S) retransmitted++;
+        latency[answered++] = latency[i];
+    }
+    qsort(latency, (size_t)answered, sizeof(double), compare_double);
+
+    printf("%-18s %8.0f conn/s  p50 %7.2f ms  p99 %8.2f ms  max %8.2f ms  "
+           "SYN retransmits %5d  rejected %5d  failed %5d  ListenOverflows %6lld  ListenDrops %6lld\n",
+           label, answered / elapsed,
+           answered ? latency[answered / 2] * 1e3 : 0.0,
+           answered ? latency[(size_t)(answered * 0.99)] * 1e3 : 0.0,
+           answered ? latency[answered - 1] * 1e3 : 0.0,
+           retransmitted, rejected, failed, overflows, drops);
+
+    pthread_barrier_destroy(&start_line);
+    free(tids);
+    free(storms);
+    free(latency);
+    stop_server();
+}
+
+int main(int argc, char *argv[]) {
+    int connections = 20000, threads = 4, backlog = 511, workers = 0, maxclients = 0, port = 6391;
+    const char *server_path = "./server";
+
+    int opt;
+    while ((opt = getopt(argc, argv, "c:t:b:w:m:P:s:")) != -1) {
+        switch (opt) {
+        case 'c': connections = atoi(optarg); break;
+        case 't': threads = atoi(optarg); break;
+        case 'b': backlog = atoi(optarg); break;
+        case 'w': workers = atoi(optarg); break;
+        case 'm': maxclients = atoi(optarg); break;
+        case 'P': port = atoi(optarg); break;
+        case 's': server_path = optarg; break;
+        default:
+            fprintf(stderr, "Usage: %s [-c connections] [-t threads] [-b backlog] [-w workers] [-m maxclients] "
+                    "[-P port] [-s server]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+    if (threads < 1) threads = 1;
+    if (connections < threads) connections = threads;
+
+    raise_fd_limit();
+    signal(SIGPIPE, SIG_IGN);
+
+    printf("=== Connection Storm Benchmark (%d connections from %d threads, backlog %d) ===\n",
+           connections, threads, backlog);
+    run("shared socket", server_path, port, 0, backlog, workers, maxclients, connections, threads);
+    run("SO_REUSEPORT", server_path, port, 1, backlog, workers, maxclients, connections, threads);
+    return 0;
+}
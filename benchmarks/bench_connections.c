@@ -0,0 +1,225 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : benchmarks/bench_connections.c
+ * Module                    : Connection Scalability Benchmark
+ * Last Updating Author      : agent
+ * Last Update               : 10/17/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Opens a large population of idle connections plus a set of active
+ *  connections running a closed PING loop, then reports throughput and
+ *  the server's resident memory at each stage.
+ *
+ *  Usage: ./benchmarks/bench_connections [-i idle] [-a active]
+ *                                        [-d seconds] [-P port] [-s server]
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#define PING_CMD "*1\r\n$4\r\nPING\r\n"
+#define PONG_REPLY_LEN 7
+
+static pid_t server_pid = -1;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static long read_rss_kb(pid_t pid) {
+    char path[64], line[256];
+    snprintf(path, sizeof(path), "/proc/%d/status", (int)pid);
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+    long rss = -1;
+    while (fgets(line, sizeof(line), f)) {
+        if (strncmp(line, "VmRSS:", 6) == 0) {
+            rss = strtol(line + 6, NULL, 10);
+            break;
+        }
+    }
+    fclose(f);
+    return rss;
+}
+
+static int connect_to(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+static int start_server(const char *path, int port) {
+    server_pid = fork();
+    if (server_pid < 0) return -1;
+    if (server_pid == 0) {
+        char port_str[16];
+        snprintf(port_str, sizeof(port_str), "%d", port);
+        setenv("MEMORADB_PORT", port_str, 1);
+        int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) {
+            dup2(devnull, STDOUT_FILENO);
+            dup2(devnull, STDERR_FILENO);
+        }
+        execl(path, path, (char *)NULL);
+        _exit(127);
+    }
+
+    for (int attempt = 0; attempt < 50; attempt++) {
+        usleep(100 * 1000);
+        int fd = connect_to(port);
+        if (fd >= 0) {
+            close(fd);
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static void stop_server(void) {
+    if (server_pid > 0) {
+        kill(server_pid, SIGTERM);
+        waitpid(server_pid, NULL, 0);
+        server_pid = -1;
+    }
+}
+
+static void raise_fd_limit(void) {
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int idle = 10000, active = 1000, duration = 10, port = 6390;
+    const char *server_path = "./server";
+
+    int opt;
+    while ((opt = getopt(argc, argv, "i:a:d:P:s:")) != -1) {
+        switch (opt) {
+        case 'i': idle = atoi(optarg); break;
+        case 'a': active = atoi(optarg); break;
+        case 'd': duration = atoi(optarg); break;
+        case 'P': port = atoi(optarg); break;
+        case 's': server_path = optarg; break;
+        default:
+            fprintf(stderr, "Usage: %s [-i idle] [-a active] [-d seconds] [-P port] [-s server]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    raise_fd_limit();
+    signal(SIGPIPE, SIG_IGN);
+
+    if (start_server(server_path, port) != 0) {
+        fprintf(stderr, "Could not start %s on port %d\n", server_path, port);
+        stop_server();
+        return 1;
+    }
+
+    printf("=== Connection Scalability Benchmark ===\n");
+    printf("Server RSS at start          : %8ld kB\n", read_rss_kb(server_pid));
+
+    int *idle_fds = calloc(idle > 0 ? idle : 1, sizeof(int));
+    int opened = 0;
+    for (; opened < idle; opened++) {
+        idle_fds[opened] = connect_to(port);
+        if (idle_fds[opened] < 0) {
+            fprintf(stderr, "Idle connect %d failed: %s\n", opened, strerror(errno));
+            break;
+        }
+    }
+    usleep(500 * 1000);
+    printf("Server RSS with %5d idle    : %8ld kB\n", opened, read_rss_kb(server_pid));
+
+    int epfd = epoll_create1(0);
+    int *active_fds = calloc(active > 0 ? active : 1, sizeof(int));
+    size_t *pending = calloc(active > 0 ? active : 1, sizeof(size_t));
+    int active_opened = 0;
+    for (; active_opened < active; active_opened++) {
+        int fd = connect_to(port);
+        if (fd < 0) {
+            fprintf(stderr, "Active connect %d failed: %s\n", active_opened, strerror(errno));
+            break;
+        }
+        active_fds[active_opened] = fd;
+        struct epoll_event ev = { .events = EPOLLIN, .data.u32 = (uint32_t)active_opened };
+        epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+    }
+
+    //-- Closed loop: each active connection keeps exactly one PING in flight --//
+    for (int i = 0; i < active_opened; i++) {
+        if (write(active_fds[i], PING_CMD, sizeof(PING_CMD) - 1) < 0) {
+            fprintf(stderr, "Initial write failed: %s\n", strerror(errno));
+        }
+    }
+
+    struct epoll_event events[1024];
+    char buf[4096];
+    unsigned long long completed = 0;
+    double start = now_seconds();
+    double end = start + duration;
+
+    while (now_seconds() < end) {
+        int n = epoll_wait(epfd, events, 1024, 100);
+        for (int e = 0; e < n; e++) {
+            uint32_t idx = events[e].data.u32;
+            ssize_t r = read(active_fds[idx], buf, sizeof(buf));
+            if (r <= 0) continue;
+            pending[idx] += (size_t)r;
+            while (pending[idx] >= PONG_REPLY_LEN) {
+                pending[idx] -= PONG_REPLY_LEN;
+                completed++;
+                if (write(active_fds[idx], PING_CMD, sizeof(PING_CMD) - 1) < 0) break;
+            }
+        }
+    }
+
+    double elapsed = now_seconds() - start;
+    printf("Server RSS with %5d active  : %8ld kB\n", active_opened, read_rss_kb(server_pid));
+    printf("Requests completed           : %llu\n", completed);
+    printf("Throughput                   : %.0f req/s\n", completed / elapsed);
+
+    for (int i = 0; i < opened; i++) close(idle_fds[i]);
+    for (int i = 0; i < active_opened; i++) close(active_fds[i]);
+    close(epfd);
+    free(idle_fds);
+    free(active_fds);
+    free(pending);
+    stop_server();
+    return 0;
+}
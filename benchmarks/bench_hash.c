@@ -0,0 +1,144 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : benchmarks/bench_hash.c
+ * Module                    : Hash Function Benchmark
+ * Last Updating Author      : agent
+ * Last Update               : 10/17/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Compares the old shift-add string hash with seeded SipHash-1-3 on
+ *  realistic key shapes: bucket chain-length distribution in a
+ *  power-of-two table at load factor 1, and raw hashing throughput.
+ *
+ *  Usage: ./benchmarks/bench_hash [keys]   (default 1000000)
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "../src/utils/siphash.h"
+
+typedef uint64_t (*hash_fn)(const char *key, size_t len);
+
+static uint64_t shift_add_hash(const char *key, size_t len) {
+    unsigned int h = 0;
+    for (size_t i = 0; i < len; i++) {
+        h = (h << 5) + key[i];
+    }
+    return h;
+}
+
+static uint64_t sip_hash(const char *key, size_t len) {
+    return hash_bytes(key, len);
+}
+
+static inline uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* ==================== Key Sets ==================== */
+
+static void key_user(char *buf, size_t cap, size_t i) {
+    snprintf(buf, cap, "user:%zu", i);
+}
+
+static void key_session(char *buf, size_t cap, size_t i) {
+    snprintf(buf, cap, "session:%08zx%08zx", i * 2654435761u, i);
+}
+
+static void key_views(char *buf, size_t cap, size_t i) {
+    snprintf(buf, cap, "product:%zu:views", i);
+}
+
+typedef struct {
+    const char *name;
+    void (*make)(char *buf, size_t cap, size_t i);
+} KeySet;
+
+/* ==================== Measurements ==================== */
+
+static void chain_stats(const char *label, hash_fn fn, char *keys, size_t stride, size_t n) {
+    size_t buckets = 1;
+    while (buckets < n) buckets <<= 1;
+    uint32_t *chains = calloc(buckets, sizeof(uint32_t));
+
+    for (size_t i = 0; i < n; i++) {
+        const char *k = keys + i * stride;
+        chains[fn(k, strlen(k)) & (buckets - 1)]++;
+    }
+
+    size_t empty = 0, max = 0, nonempty = 0;
+    for (size_t b = 0; b < buckets; b++) {
+        if (chains[b] == 0) empty++;
+        else nonempty++;
+        if (chains[b] > max) max = chains[b];
+    }
+
+    //-- Ideal uniform hashing at load factor ~1 leaves ~37% of buckets empty --//
+    printf("  %-10s buckets %8zu  empty %5.1f%%  max chain %7zu  avg non-empty %6.2f\n",
+           label, buckets, 100.0 * empty / buckets, max, (double)n / (nonempty ? nonempty : 1));
+    free(chains);
+}
+
+static void throughput(const char *label, hash_fn fn, char *keys, size_t stride, size_t n) {
+    uint64_t sink = 0, bytes = 0;
+    uint64_t start = now_ns();
+    for (int round = 0; round < 5; round++) {
+        for (size_t i = 0; i < n; i++) {
+            const char *k = keys + i * stride;
+            size_t len = strlen(k);
+            sink += fn(k, len);
+            bytes += len;
+        }
+    }
+    double secs = (now_ns() - start) / 1e9;
+    printf("  %-10s %8.1f Mhash/s  %7.1f MB/s  (sink %016llx)\n",
+           label, 5.0 * n / secs / 1e6, bytes / secs / 1e6, (unsigned long long)sink);
+}
+
+int main(int argc, char *argv[]) {
+    size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000ULL;
+    if (n == 0) n = 1;
+
+    hash_seed_random();
+
+    const size_t stride = 48;
+    char *keys = malloc(n * stride);
+    if (!keys) {
+        fprintf(stderr, "Cannot allocate %zu keys\n", n);
+        return 1;
+    }
+
+    KeySet sets[] = {
+        { "user:N",            key_user },
+        { "session:<hex>",     key_session },
+        { "product:N:views",   key_views },
+    };
+
+    printf("=== Hash Function Benchmark (%zu keys per set) ===\n", n);
+    for (size_t s = 0; s < sizeof(sets) / sizeof(sets[0]); s++) {
+        for (size_t i = 0; i < n; i++) {
+            sets[s].make(keys + i * stride, stride, i);
+        }
+
+        printf("\n%s\n", sets[s].name);
+        chain_stats("shift-add", shift_add_hash, keys, stride, n);
+        chain_stats("siphash13", sip_hash, keys, stride, n);
+        throughput("shift-add", shift_add_hash, keys, stride, n);
+        throughput("siphash13", sip_hash, keys, stride, n);
+    }
+
+    free(keys);
+    return 0;
+}
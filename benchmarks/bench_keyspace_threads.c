@@ -0,0 +1,133 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : benchmarks/bench_keyspace_threads.c
+ * Module                    : Keyspace Scaling Benchmark
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Measures aggregate GET and SET throughput on the sharded keyspace with
+ *  1 to 16 threads hammering random keys, to show how well the shard
+ *  locks (for SET) and the lock-free read path (for GET) scale. Speedups are relative to the single-thread run; they
+ *  cannot exceed the number of online CPUs.
+ *
+ *  Usage: ./benchmarks/bench_keyspace_threads [keys] [seconds]
+ *         (defaults 1000000 keys, 2 seconds per run)
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "../src/utils/hashTable.h"
+#include "../src/utils/epoch.h"
+
+#define MAX_THREADS 16
+
+typedef struct {
+    int write;
+    size_t keys;
+    uint64_t seed;
+    uint64_t ops;
+    uint64_t found;   //- Keeps GETs from being optimized away -//
+} Worker;
+
+static atomic_int running;
+
+static inline uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static inline uint64_t next_random(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void *worker_run(void *arg) {
+    Worker *w = arg;
+    char key[32];
+
+    while (atomic_load_explicit(&running, memory_order_relaxed)) {
+        //-- Check the flag every 256 operations to keep it off the hot path --//
+        for (int i = 0; i < 256; i++) {
+            size_t len = (size_t)snprintf(key, sizeof(key), "user:%llu",
+                                          (unsigned long long)(next_random(&w->seed) % w->keys));
+            if (w->write) {
+                set_value(key, len, "value", 5, 0);
+            } else {
+                char int_buf[INT_TEXT_MAX];
+                size_t value_len;
+                epoch_enter();
+                w->found += get_value(key, len, &value_len, int_buf) != NULL;
+                epoch_exit();
+            }
+        }
+        w->ops += 256;
+    }
+    return NULL;
+}
+
+static double run(int threads, int write, size_t keys, int seconds) {
+    pthread_t tids[MAX_THREADS];
+    Worker workers[MAX_THREADS];
+
+    atomic_store(&running, 1);
+    for (int t = 0; t < threads; t++) {
+        workers[t] = (Worker){ .write = write, .keys = keys, .seed = 0x9e3779b97f4a7c15ULL * (t + 1) };
+        pthread_create(&tids[t], NULL, worker_run, &workers[t]);
+    }
+
+    uint64_t start = now_ns();
+    sleep(seconds);
+    atomic_store(&running, 0);
+
+    uint64_t ops = 0;
+    for (int t = 0; t < threads; t++) {
+        pthread_join(tids[t], NULL);
+        ops += workers[t].ops;
+    }
+    return ops / ((now_ns() - start) / 1e9);
+}
+
+int main(int argc, char *argv[]) {
+    size_t keys = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000ULL;
+    int seconds = argc > 2 ? atoi(argv[2]) : 2;
+    if (keys == 0) keys = 1;
+    if (seconds <= 0) seconds = 1;
+
+    printf("=== Keyspace Scaling Benchmark (%zu keys, %d shards, %ld CPUs) ===\n",
+           keys, KEYSPACE_SHARDS, sysconf(_SC_NPROCESSORS_ONLN));
+
+    char key[32];
+    for (size_t i = 0; i < keys; i++) {
+        int len = snprintf(key, sizeof(key), "user:%zu", i);
+        set_value(key, (size_t)len, "value", 5, 0);
+    }
+
+    const char *labels[] = { "GET", "SET" };
+    for (int write = 0; write <= 1; write++) {
+        double base = 0;
+        for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+            double rate = run(threads, write, keys, seconds);
+            if (threads == 1) base = rate;
+            printf("%s  %2d threads  %10.0f ops/s  speedup %5.2fx\n",
+                   labels[write], threads, rate, rate / base);
+        }
+    }
+    return 0;
+}
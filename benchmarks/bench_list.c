@@ -0,0 +1,335 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : benchmarks/bench_list.c
+ * Module                    : List Encoding Benchmark
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Builds one large list with each encoding and compares heap footprint,
+ *  push throughput, LRANGE latency at random offsets, pop throughput and a
+ *  capped log (LPUSH followed by LTRIM 0 cap-1):
+ *  the previous node-per-element linked list (reproduced here as the
+ *  baseline), packed nodes, and packed nodes with compressed interiors.
+ *  Then compares serialising LRANGE and LPOP replies through heap copies
+ *  of each element against writing them straight from list storage.
+ *
+ *  Usage: ./benchmarks/bench_list [-n elements] [-r ranges] [-s node-bytes]
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <malloc.h>
+#include <time.h>
+#include "../src/utils/list.h"
+#include "../src/server/reply.h"
+
+#define RANGE_ELEMENTS 10
+#define LOG_CAP        1000   //- Elements kept by the capped log -//
+#define REPLY_ELEMENTS 1000   //- Elements per LRANGE / LPOP reply -//
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static size_t heap_in_use(void) {
+    return mallinfo2().uordblks;
+}
+
+/* ==================== Baseline Layout ==================== */
+//-- The list as it was: one node and one string allocation per element, walked from the head --//
+typedef struct LinkedNode {
+    char *value;
+    struct LinkedNode *next;
+} LinkedNode;
+
+typedef struct {
+    LinkedNode *head;
+    LinkedNode *tail;
+    size_t length;
+} LinkedList;
+
+static void linked_rpush(LinkedList *list, const char *value) {
+    LinkedNode *node = malloc(sizeof(LinkedNode));
+    node->value = strdup(value);
+    node->next = NULL;
+    if (list->tail) list->tail->next = node; else list->head = node;
+    list->tail = node;
+    list->length++;
+}
+
+static char **linked_range(LinkedList *list, size_t start, int count) {
+    char **result = malloc(sizeof(char *) * count);
+    LinkedNode *node = list->head;
+    for (size_t i = 0; i < start; i++) node = node->next;
+    for (int i = 0; i < count; i++, node = node->next) result[i] = strdup(node->value);
+    return result;
+}
+
+static void linked_lpush(LinkedList *list, const char *value) {
+    LinkedNode *node = malloc(sizeof(LinkedNode));
+    node->value = strdup(value);
+    node->next = list->head;
+    list->head = node;
+    if (!list->tail) list->tail = node;
+    list->length++;
+}
+
+//-- Only `next` links: reaching the cut means walking from the head --//
+static void linked_trim(LinkedList *list, size_t keep) {
+    if (list->length <= keep) return;
+    LinkedNode *last = list->head;
+    for (size_t i = 1; i < keep; i++) last = last->next;
+    LinkedNode *node = last->next;
+    last->next = NULL;
+    list->tail = last;
+    list->length = keep;
+    while (node) {
+        LinkedNode *next = node->next;
+        free(node->value);
+        free(node);
+        node = next;
+    }
+}
+
+static char *linked_lpop(LinkedList *list) {
+    LinkedNode *node = list->head;
+    if (!node) return NULL;
+    list->head = node->next;
+    if (!list->head) list->tail = NULL;
+    list->length--;
+    char *value = node->value;
+    free(node);
+    return value;
+}
+
+/* ==================== Runs ==================== */
+
+typedef struct {
+    const char *name;
+    size_t bytes;
+    double push_s;
+    double range_s;
+    double pop_s;
+    double log_s;
+} RunResult;
+
+static void element_value(char *buf, size_t size, size_t i) {
+    snprintf(buf, size, "element:%07zu", i);
+}
+
+static void free_range(char **range) {
+    for (int i = 0; i < RANGE_ELEMENTS; i++) free(range[i]);
+    free(range);
+}
+
+static RunResult run_linked(size_t elements, int ranges) {
+    RunResult r = { "linked (old)", 0, 0, 0, 0, 0 };
+    LinkedList list = { NULL, NULL, 0 };
+    char value[32];
+
+    size_t before = heap_in_use();
+    double t = now_seconds();
+    for (size_t i = 0; i < elements; i++) {
+        element_value(value, sizeof(value), i);
+        linked_rpush(&list, value);
+    }
+    r.push_s = now_seconds() - t;
+    r.bytes = heap_in_use() - before;
+
+    srand(1);
+    t = now_seconds();
+    for (int i = 0; i < ranges; i++) {
+        free_range(linked_range(&list, (size_t)rand() % (elements - RANGE_ELEMENTS), RANGE_ELEMENTS));
+    }
+    r.range_s = now_seconds() - t;
+
+    t = now_seconds();
+    char *popped;
+    while ((popped = linked_lpop(&list))) free(popped);
+    r.pop_s = now_seconds() - t;
+
+    t = now_seconds();
+    for (size_t i = 0; i < elements; i++) {
+        element_value(value, sizeof(value), i);
+        linked_lpush(&list, value);
+        linked_trim(&list, LOG_CAP);
+    }
+    r.log_s = now_seconds() - t;
+    while ((popped = linked_lpop(&list))) free(popped);
+    return r;
+}
+
+static RunResult run_packed(const char *name, size_t elements, int ranges, size_t node_bytes, int depth) {
+    RunResult r = { name, 0, 0, 0, 0, 0 };
+    char value[32];
+    list_configure(node_bytes, depth);
+
+    size_t before = heap_in_use();
+    double t = now_seconds();
+    List *list = list_create();
+    for (size_t i = 0; i < elements; i++) {
+        element_value(value, sizeof(value), i);
+        list_rpush(list, value);
+    }
+    r.push_s = now_seconds() - t;
+    r.bytes = heap_in_use() - before;
+
+    srand(1);
+    t = now_seconds();
+    for (int i = 0; i < ranges; i++) {
+        int start = rand() % (int)(elements - RANGE_ELEMENTS), count;
+        free_range(list_range(list, start, start + RANGE_ELEMENTS - 1, &count));
+    }
+    r.range_s = now_seconds() - t;
+
+    t = now_seconds();
+    char *popped;
+    while ((popped = list_pop(list, LIST_HEAD, NULL))) free(popped);
+    r.pop_s = now_seconds() - t;
+
+    t = now_seconds();
+    for (size_t i = 0; i < elements; i++) {
+        element_value(value, sizeof(value), i);
+        list_lpush(list, value);
+        list_trim(list, 0, LOG_CAP - 1);
+    }
+    r.log_s = now_seconds() - t;
+    list_free(list);
+    return r;
+}
+
+/* ==================== Reply Serialisation ==================== */
+
+static void sink_begin(void *ctx, size_t count) {
+    reply_add_array_len(ctx, (long long)count);
+}
+
+static void sink_element(void *ctx, const char *value, size_t len) {
+    reply_add_bulk(ctx, value, len);
+}
+
+static void reply_copies(ReplyBuffer *reply, char **elements, int count) {
+    reply_add_array_len(reply, count);
+    for (int i = 0; i < count; i++) {
+        reply_add_bulk(reply, elements[i], strlen(elements[i]));
+        free(elements[i]);
+    }
+    free(elements);
+}
+
+static void fill_list(List *list) {
+    char value[32];
+    for (size_t i = 0; i < REPLY_ELEMENTS; i++) {
+        element_value(value, sizeof(value), i);
+        list_rpush(list, value);
+    }
+}
+
+/**
+ * Serialise LRANGE 0 -1 and LPOP <count> replies of REPLY_ELEMENTS elements,
+ * through heap copies (copy = 1) or straight from the nodes.
+ */
+static void run_replies(int copy, int rounds, double *range_us, double *pop_us) {
+    ReplyBuffer *reply = malloc(sizeof(ReplyBuffer));
+    ListSink sink = { sink_begin, sink_element, reply };
+    List *list = list_create();
+    fill_list(list);
+    reply_init(reply);
+
+    double t = now_seconds();
+    for (int i = 0; i < rounds; i++) {
+        if (copy) {
+            int count;
+            char **elements = list_range(list, 0, -1, &count);
+            reply_copies(reply, elements, count);
+        } else {
+            list_range_into(list, 0, -1, &sink);
+        }
+        reply_free(reply);
+        reply_init(reply);
+    }
+    *range_us = (now_seconds() - t) / rounds * 1e6;
+
+    double popping = 0;
+    for (int i = 0; i < rounds; i++) {
+        t = now_seconds();
+        if (copy) {
+            int count;
+            char **elements = list_pop_multiple(list, LIST_HEAD, REPLY_ELEMENTS, &count);
+            reply_copies(reply, elements, count);
+        } else {
+            list_pop_into(list, LIST_HEAD, REPLY_ELEMENTS, &sink);
+        }
+        popping += now_seconds() - t;
+        reply_free(reply);
+        reply_init(reply);
+        fill_list(list);
+    }
+    *pop_us = popping / rounds * 1e6;
+
+    list_free(list);
+    free(reply);
+}
+
+static void report(const RunResult *r, size_t elements, int ranges) {
+    printf("%-22s %10.1f %12.2f %14.1f %12.2f %14.2f\n", r->name,
+           (double)r->bytes / elements,
+           elements / r->push_s / 1e6,
+           r->range_s / ranges * 1e6,
+           elements / r->pop_s / 1e6,
+           elements / r->log_s / 1e6);
+}
+
+int main(int argc, char *argv[]) {
+    size_t elements = 1000000, node_bytes = LIST_NODE_BYTES_DEFAULT;
+    int ranges = 200;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:r:s:")) != -1) {
+        switch (opt) {
+        case 'n': elements = strtoull(optarg, NULL, 10); break;
+        case 'r': ranges = atoi(optarg); break;
+        case 's': node_bytes = strtoull(optarg, NULL, 10); break;
+        default:
+            fprintf(stderr, "Usage: %s [-n elements] [-r ranges] [-s node-bytes]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (elements <= RANGE_ELEMENTS || ranges < 1) {
+        fprintf(stderr, "Need more than %d elements and at least one range\n", RANGE_ELEMENTS);
+        return 1;
+    }
+
+    printf("=== List Encoding Benchmark (%zu elements of 15 bytes, %zu-byte nodes) ===\n",
+           elements, node_bytes);
+    printf("%-22s %10s %12s %14s %12s %14s\n", "encoding", "bytes/elem", "push Mops/s", "LRANGE 10 us",
+           "pop Mops/s", "capped Mops/s");
+
+    RunResult results[3];
+    results[0] = run_linked(elements, ranges);
+    results[1] = run_packed("packed", elements, ranges, node_bytes, 0);
+    results[2] = run_packed("packed + compression", elements, ranges, node_bytes, 1);
+    for (int i = 0; i < 3; i++) report(&results[i], elements, ranges);
+
+    double range_copy, pop_copy, range_direct, pop_direct;
+    list_configure(node_bytes, 0);
+    run_replies(1, ranges * 10, &range_copy, &pop_copy);
+    run_replies(0, ranges * 10, &range_direct, &pop_direct);
+    printf("\n=== Reply Serialisation (%d elements per reply) ===\n", REPLY_ELEMENTS);
+    printf("%-22s %14s %14s\n", "path", "LRANGE us", "LPOP n us");
+    printf("%-22s %14.1f %14.1f\n", "heap copy per element", range_copy, pop_copy);
+    printf("%-22s %14.1f %14.1f\n", "straight from nodes", range_direct, pop_direct);
+    return 0;
+}
@@ -0,0 +1,252 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : benchmarks/bench_shard_per_core.c
+ * Module                    : Execution Model Scaling Benchmark
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Starts ./server with 1, 2, 4, ... event loops, with the shared
+ *  (rwlock-sharded) keyspace, in shard-per-core mode and with threaded
+ *  I/O (that many I/O loops feeding one execution loop), and drives
+ *  it with pipelined SET/GET pairs on random keys from several client
+ *  threads. Reports throughput per configuration so scaling with cores
+ *  can be compared between the execution models.
+ *
+ *  Usage: ./benchmarks/bench_shard_per_core [-w max_workers] [-c conns]
+ *                                           [-p pipeline] [-d seconds]
+ *                                           [-P port] [-s server]
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#define PAIR_REPLY_LEN 16   //- "+OK\r\n" + "$5\r\nvalue\r\n" -//
+#define MAX_CLIENT_THREADS 16
+
+static pid_t server_pid = -1;
+static volatile int running;
+
+typedef struct {
+    int port;
+    int conns;
+    int pipeline;
+    unsigned int seed;
+    unsigned long long pairs;
+} ClientThread;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int connect_to(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+//-- Execution models, in the order they are measured --//
+enum { MODE_SHARED, MODE_SHARD_PER_CORE, MODE_IO_THREADS, MODES };
+
+static int start_server(const char *path, int port, int workers, int mode) {
+    server_pid = fork();
+    if (server_pid < 0) return -1;
+    if (server_pid == 0) {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%d", port);
+        setenv("MEMORADB_PORT", buf, 1);
+        snprintf(buf, sizeof(buf), "%d", workers);
+        setenv("MEMORADB_WORKERS", buf, 1);
+        setenv("MEMORADB_SHARD_PER_CORE", mode == MODE_SHARD_PER_CORE ? "1" : "0", 1);
+        setenv("MEMORADB_IO_THREADS", mode == MODE_IO_THREADS ? buf : "0", 1);
+        int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) {
+            dup2(devnull, STDOUT_FILENO);
+            dup2(devnull, STDERR_FILENO);
+        }
+        execl(path, path, (char *)NULL);
+        _exit(127);
+    }
+
+    for (int attempt = 0; attempt < 50; attempt++) {
+        usleep(100 * 1000);
+        int fd = connect_to(port);
+        if (fd >= 0) {
+            close(fd);
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static void stop_server(void) {
+    if (server_pid > 0) {
+        kill(server_pid, SIGTERM);
+        waitpid(server_pid, NULL, 0);
+        server_pid = -1;
+    }
+}
+
+/**
+ * Queue `count` SET/GET pairs on one connection.
+ */
+static void send_pairs(int fd, int count, unsigned int *seed) {
+    char buf[128 * 64];
+    size_t len = 0;
+    for (int i = 0; i < count; i++) {
+        char key[24];
+        int klen = snprintf(key, sizeof(key), "key:%u", rand_r(seed) % 100000);
+        len += snprintf(buf + len, sizeof(buf) - len,
+                        "*3\r\n$3\r\nSET\r\n$%d\r\n%s\r\n$5\r\nvalue\r\n"
+                        "*2\r\n$3\r\nGET\r\n$%d\r\n%s\r\n", klen, key, klen, key);
+    }
+    if (write(fd, buf, len) < 0) {
+        fprintf(stderr, "write failed: %s\n", strerror(errno));
+    }
+}
+
+static void *client_run(void *arg) {
+    ClientThread *ct = arg;
+    int epfd = epoll_create1(0);
+    int *fds = calloc(ct->conns, sizeof(int));
+    size_t *pending = calloc(ct->conns, sizeof(size_t));
+
+    for (int i = 0; i < ct->conns; i++) {
+        fds[i] = connect_to(ct->port);
+        if (fds[i] < 0) continue;
+        struct epoll_event ev = { .events = EPOLLIN, .data.u32 = (uint32_t)i };
+        epoll_ctl(epfd, EPOLL_CTL_ADD, fds[i], &ev);
+        send_pairs(fds[i], ct->pipeline, &ct->seed);
+    }
+
+    //-- Closed loop: each connection refills its pipeline as pairs complete --//
+    struct epoll_event events[256];
+    char buf[16384];
+    while (running) {
+        int n = epoll_wait(epfd, events, 256, 100);
+        for (int e = 0; e < n; e++) {
+            uint32_t idx = events[e].data.u32;
+            ssize_t r = read(fds[idx], buf, sizeof(buf));
+            if (r <= 0) continue;
+            pending[idx] += (size_t)r;
+            int done = (int)(pending[idx] / PAIR_REPLY_LEN);
+            pending[idx] %= PAIR_REPLY_LEN;
+            if (done > 0) {
+                ct->pairs += done;
+                send_pairs(fds[idx], done, &ct->seed);
+            }
+        }
+    }
+
+    for (int i = 0; i < ct->conns; i++) {
+        if (fds[i] >= 0) close(fds[i]);
+    }
+    close(epfd);
+    free(fds);
+    free(pending);
+    return NULL;
+}
+
+static double measure(int port, int threads, int conns, int pipeline, int duration) {
+    pthread_t tids[MAX_CLIENT_THREADS];
+    ClientThread cts[MAX_CLIENT_THREADS];
+
+    running = 1;
+    for (int t = 0; t < threads; t++) {
+        cts[t] = (ClientThread){ .port = port, .conns = conns / threads, .pipeline = pipeline,
+                                 .seed = 12345u + (unsigned int)t };
+        pthread_create(&tids[t], NULL, client_run, &cts[t]);
+    }
+
+    double start = now_seconds();
+    sleep(duration);
+    running = 0;
+
+    unsigned long long pairs = 0;
+    for (int t = 0; t < threads; t++) {
+        pthread_join(tids[t], NULL);
+        pairs += cts[t].pairs;
+    }
+    return 2.0 * pairs / (now_seconds() - start);
+}
+
+int main(int argc, char *argv[]) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int max_workers = cpus > 0 ? (int)cpus : 1;
+    int conns = 64, pipeline = 16, duration = 3, port = 6391;
+    const char *server_path = "./server";
+
+    int opt;
+    while ((opt = getopt(argc, argv, "w:c:p:d:P:s:")) != -1) {
+        switch (opt) {
+        case 'w': max_workers = atoi(optarg); break;
+        case 'c': conns = atoi(optarg); break;
+        case 'p': pipeline = atoi(optarg); break;
+        case 'd': duration = atoi(optarg); break;
+        case 'P': port = atoi(optarg); break;
+        case 's': server_path = optarg; break;
+        default:
+            fprintf(stderr, "Usage: %s [-w max_workers] [-c conns] [-p pipeline] [-d seconds] [-P port] [-s server]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+    if (pipeline > 64) pipeline = 64;
+    if (pipeline < 1) pipeline = 1;
+
+    signal(SIGPIPE, SIG_IGN);
+    printf("=== Execution Model Scaling Benchmark (%ld CPUs, %d conns, pipeline %d) ===\n",
+           cpus, conns, pipeline);
+
+    const char *modes[MODES] = { "shared keyspace", "shard-per-core", "threaded I/O" };
+    for (int mode = 0; mode < MODES; mode++) {
+        double base = 0;
+        for (int workers = 1; workers <= max_workers; workers *= 2) {
+            if (start_server(server_path, port, workers, mode) != 0) {
+                fprintf(stderr, "Could not start %s on port %d\n", server_path, port);
+                stop_server();
+                return 1;
+            }
+
+            int threads = workers < MAX_CLIENT_THREADS ? workers : MAX_CLIENT_THREADS;
+            double rate = measure(port, threads, conns, pipeline, duration);
+            if (workers == 1) base = rate;
+            printf("%-16s %2d loops  %10.0f ops/s  speedup %5.2fx\n", modes[mode], workers, rate, rate / base);
+            stop_server();
+        }
+    }
+    return 0;
+}
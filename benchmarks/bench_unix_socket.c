@@ -0,0 +1,228 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : benchmarks/bench_unix_socket.c
+ * Module                    : Unix Socket Latency Benchmark
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Starts the server with a Unix domain listener next to its TCP one and
+ *  measures request round trips over both from a single connection:
+ *  PING, and GET of a value of the given size. Reports the average and
+ *  the p50, p99 and p99.9 latency per transport.
+ *
+ *  Usage: ./benchmarks/bench_unix_socket [-n requests] [-v value_bytes]
+ *                                        [-P port] [-s server]
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#define PING_CMD "*1\r\n$4\r\nPING\r\n"
+#define GET_CMD  "*2\r\n$3\r\nGET\r\n$5\r\nbench\r\n"
+
+static pid_t server_pid = -1;
+static char socket_path[64];
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int connect_tcp(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+static int connect_unix(const char *path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int start_server(const char *path, int port) {
+    snprintf(socket_path, sizeof(socket_path), "/tmp/memoradb-bench-%d.sock", (int)getpid());
+    server_pid = fork();
+    if (server_pid < 0) return -1;
+    if (server_pid == 0) {
+        char port_str[16];
+        snprintf(port_str, sizeof(port_str), "%d", port);
+        setenv("MEMORADB_PORT", port_str, 1);
+        setenv("MEMORADB_UNIX_SOCKET", socket_path, 1);
+        int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) {
+            dup2(devnull, STDOUT_FILENO);
+            dup2(devnull, STDERR_FILENO);
+        }
+        execl(path, path, (char *)NULL);
+        _exit(127);
+    }
+
+    for (int attempt = 0; attempt < 50; attempt++) {
+        usleep(100 * 1000);
+        int fd = connect_unix(socket_path);
+        if (fd >= 0) {
+            close(fd);
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static void stop_server(void) {
+    if (server_pid > 0) {
+        kill(server_pid, SIGTERM);
+        waitpid(server_pid, NULL, 0);
+        server_pid = -1;
+    }
+    unlink(socket_path);
+}
+
+/**
+ * Send a request and read until the reply of known length is complete.
+ * @return 0 on success, -1 if the connection failed
+ */
+static int round_trip(int fd, const char *request, size_t request_len, char *buf, size_t reply_len) {
+    if (write(fd, request, request_len) != (ssize_t)request_len) return -1;
+    size_t got = 0;
+    while (got < reply_len) {
+        ssize_t n = read(fd, buf + got, reply_len - got);
+        if (n <= 0) return -1;
+        got += (size_t)n;
+    }
+    return 0;
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void measure(const char *label, int fd, const char *request, size_t reply_len, int n, double *samples) {
+    char *buf = malloc(reply_len);
+    size_t request_len = strlen(request);
+
+    //-- Warm up caches, the connection's buffers and the CPU frequency --//
+    for (int i = 0; i < n / 10; i++) {
+        if (round_trip(fd, request, request_len, buf, reply_len) != 0) break;
+    }
+
+    double total = 0;
+    int done = 0;
+    for (; done < n; done++) {
+        double start = now_seconds();
+        if (round_trip(fd, request, request_len, buf, reply_len) != 0) {
+            fprintf(stderr, "%s: connection failed after %d requests\n", label, done);
+            break;
+        }
+        samples[done] = now_seconds() - start;
+        total += samples[done];
+    }
+    free(buf);
+    if (done == 0) return;
+
+    qsort(samples, (size_t)done, sizeof(double), compare_double);
+    printf("  %-16s avg %6.2f us  p50 %6.2f us  p99 %7.2f us  p99.9 %7.2f us\n", label,
+           total / done * 1e6, samples[done / 2] * 1e6,
+           samples[(size_t)(done * 0.99)] * 1e6, samples[(size_t)(done * 0.999)] * 1e6);
+}
+
+int main(int argc, char *argv[]) {
+    int requests = 200000, value_bytes = 100, port = 6392;
+    const char *server_path = "./server";
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:v:P:s:")) != -1) {
+        switch (opt) {
+        case 'n': requests = atoi(optarg); break;
+        case 'v': value_bytes = atoi(optarg); break;
+        case 'P': port = atoi(optarg); break;
+        case 's': server_path = optarg; break;
+        default:
+            fprintf(stderr, "Usage: %s [-n requests] [-v value_bytes] [-P port] [-s server]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (requests < 10) requests = 10;
+    if (value_bytes < 1) value_bytes = 1;
+    signal(SIGPIPE, SIG_IGN);
+
+    if (start_server(server_path, port) != 0) {
+        fprintf(stderr, "Could not start %s on port %d with a Unix socket\n", server_path, port);
+        stop_server();
+        return 1;
+    }
+
+    int tcp = connect_tcp(port), unix_fd = connect_unix(socket_path);
+    if (tcp < 0 || unix_fd < 0) {
+        fprintf(stderr, "Could not connect: %s\n", strerror(errno));
+        stop_server();
+        return 1;
+    }
+
+    //-- SET bench <value>, then GET replies with "$<len>\r\n<value>\r\n" --//
+    char *set = malloc((size_t)value_bytes + 64), *ok = malloc(8);
+    int set_len = snprintf(set, 64, "*3\r\n$3\r\nSET\r\n$5\r\nbench\r\n$%d\r\n", value_bytes);
+    memset(set + set_len, 'v', (size_t)value_bytes);
+    memcpy(set + set_len + value_bytes, "\r\n", 3);
+    round_trip(tcp, set, strlen(set), ok, 5);
+    char header[32];
+    size_t get_reply_len = (size_t)snprintf(header, sizeof(header), "$%d\r\n", value_bytes) + value_bytes + 2;
+
+    double *samples = malloc((size_t)requests * sizeof(double));
+    printf("=== Unix Socket vs Loopback TCP (%d round trips each, one connection) ===\n", requests);
+    printf("PING\n");
+    measure("loopback TCP", tcp, PING_CMD, 7, requests, samples);
+    measure("Unix socket", unix_fd, PING_CMD, 7, requests, samples);
+    printf("GET (%d-byte value)\n", value_bytes);
+    measure("loopback TCP", tcp, GET_CMD, get_reply_len, requests, samples);
+    measure("Unix socket", unix_fd, GET_CMD, get_reply_len, requests, samples);
+
+    free(samples);
+    free(set);
+    free(ok);
+    close(tcp);
+    close(unix_fd);
+    stop_server();
+    return 0;
+}
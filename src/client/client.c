@@ -5,8 +5,8 @@
  * 
  * File                      : src/client/client.c
  * Module                    : Client Utilities
- * Last Updating Author      : shady0503
- * Last Update               : 01/23/2026
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
  * Version                   : 1.0.0
  * 
  * Description:
@@ -26,50 +26,102 @@
 #include <sys/time.h>
 #include <time.h>
 
-int main(int argc, char *argv[]) {
-    int client_fd;
-    struct sockaddr_in server_addr;
-    char buffer[BUFFER_SIZE];
-    char command[BUFFER_SIZE];
-    const char *server_ip = "127.0.0.1";
-    
-    //-- Override server IP if provided as argument --//
-    if (argc > 1) {
-        server_ip = argv[1];
-    }
-    
-    display_memoradb_logo();
-    printf("\n\n");
-    
-    printf("===============================================\n");
-    printf("     MemoraDB Client - Testing Interface      \n");
-    printf("        Connecting to: %s:%d               \n", server_ip, SERVER_PORT);
-    printf("===============================================\n");
-    
-    //-- Create socket --//
-    client_fd = socket(AF_INET, SOCK_STREAM, 0);
+/**
+ * Connect to the server over TCP.
+ * @return The connected socket, -1 on error (reported)
+ */
+static int connect_tcp(const char *server_ip) {
+    int client_fd = socket(AF_INET, SOCK_STREAM, 0);
     if (client_fd == -1) {
         printf("[Client: ERROR] Socket creation failed: %s\n", strerror(errno));
-        return 1;
+        return -1;
     }
-    
+
     printf("[Client: INFO] Socket created successfully.\n");
-    
+
     //-- Configure server address --//
+    struct sockaddr_in server_addr;
     memset(&server_addr, 0, sizeof(server_addr));
     server_addr.sin_family = AF_INET;
     server_addr.sin_port = htons(SERVER_PORT);
-    
+
     if (inet_pton(AF_INET, server_ip, &server_addr.sin_addr) <= 0) {
         printf("[Client: ERROR] Invalid address: %s\n", server_ip);
         close(client_fd);
-        return 1;
+        return -1;
     }
 
-    //-- Connect to server --//
     if (connect(client_fd, (struct sockaddr*)&server_addr, sizeof(server_addr)) < 0) {
         printf("[Client: ERROR] Connection failed: %s\n", strerror(errno));
         close(client_fd);
+        return -1;
+    }
+    return client_fd;
+}
+
+/**
+ * Connect to the server's Unix domain socket (MEMORADB_UNIX_SOCKET).
+ * @return The connected socket, -1 on error (reported)
+ */
+static int connect_unix(const char *path) {
+    struct sockaddr_un server_addr;
+    memset(&server_addr, 0, sizeof(server_addr));
+    server_addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(server_addr.sun_path)) {
+        printf("[Client: ERROR] Socket path too long: %s\n", path);
+        return -1;
+    }
+    memcpy(server_addr.sun_path, path, strlen(path) + 1);
+
+    int client_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (client_fd == -1) {
+        printf("[Client: ERROR] Socket creation failed: %s\n", strerror(errno));
+        return -1;
+    }
+
+    printf("[Client: INFO] Socket created successfully.\n");
+
+    if (connect(client_fd, (struct sockaddr*)&server_addr, sizeof(server_addr)) < 0) {
+        printf("[Client: ERROR] Connection to %s failed: %s\n", path, strerror(errno));
+        close(client_fd);
+        return -1;
+    }
+    return client_fd;
+}
+
+int main(int argc, char *argv[]) {
+    int client_fd;
+    char buffer[BUFFER_SIZE];
+    char command[BUFFER_SIZE];
+    const char *server_ip = DEFAULT_SERVER_IP;
+    const char *socket_path = NULL;
+
+    //-- Usage: client [-s socket_path] [server_ip] --//
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (argv[i][0] == '-') {
+            printf("Usage: %s [-s socket_path] [server_ip]\n", argv[0]);
+            return 1;
+        } else {
+            server_ip = argv[i];
+        }
+    }
+    
+    display_memoradb_logo();
+    printf("\n\n");
+    
+    printf("===============================================\n");
+    printf("     MemoraDB Client - Testing Interface      \n");
+    if (socket_path) {
+        printf("        Connecting to: %s               \n", socket_path);
+    } else {
+        printf("        Connecting to: %s:%d               \n", server_ip, SERVER_PORT);
+    }
+    printf("===============================================\n");
+    
+    client_fd = socket_path ? connect_unix(socket_path) : connect_tcp(server_ip);
+    if (client_fd < 0) {
         return 1;
     }
 
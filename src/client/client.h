@@ -5,8 +5,8 @@
  * 
  * File                      : src/client/client.h
  * Module                    : Client Utilities Header
- * Last Updating Author      : shady0503
- * Last Update               : 01/23/2026
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
  * Version                   : 1.0.0
  * 
  * Description:
@@ -24,6 +24,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/socket.h>
+#include <sys/un.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
@@ -5,8 +5,8 @@
  * 
  * File                      : src/parser/parser.c
  * Module                    : RESP Protocol Parser
- * Last Updating Author      : youssefbouraoui1
- * Last Update               : 02/08/2026
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
  * Version                   : 1.0.0
  * 
  * Description:
@@ -21,33 +21,189 @@
 #define _GNU_SOURCE
 #include "parser.h"
 #include "../utils/hashTable.h"
+#include "../utils/epoch.h"
+#include "../server/stats.h"
+#include "../server/blocking.h"
 #include <stdio.h>
 #include <stdbool.h>
+#include <errno.h>
+#include <ctype.h>
+#include <limits.h>
+#include <math.h>
 
-int parse_command(char * input, char * tokens[], int max_tokens){
-    int counter = 0;
-    char * cur = input;
+void request_parser_init(RequestParser *parser, int max_args) {
+    memset(parser, 0, sizeof(*parser));
+    parser->max_args = max_args;
+    parser->bulk_len = -1;
+}
+
+void request_parser_free(RequestParser *parser) {
+    free(parser->argv_off);
+    free(parser->argv_len);
+    free(parser->argv);
+    parser->argv_off = NULL;
+    parser->argv_len = NULL;
+    parser->argv = NULL;
+    parser->argv_cap = 0;
+}
+
+void request_parser_reset(RequestParser *parser) {
+    //-- Do not keep the argument arrays of one huge MSET for the life of the connection --//
+    if (parser->argv_cap > REQUEST_ARGV_PREALLOC) request_parser_free(parser);
+    parser->multibulk_len = 0;
+    parser->bulk_len = -1;
+    parser->pos = 0;
+    parser->argc = 0;
+}
+
+static int request_parser_reserve(RequestParser *parser, int count) {
+    if (count <= parser->argv_cap) return 0;
+
+    size_t *off = realloc(parser->argv_off, sizeof(size_t) * count);
+    if (!off) return -1;
+    parser->argv_off = off;
+    size_t *len = realloc(parser->argv_len, sizeof(size_t) * count);
+    if (!len) return -1;
+    parser->argv_len = len;
+    char **argv = realloc(parser->argv, sizeof(char *) * count);
+    if (!argv) return -1;
+    parser->argv = argv;
+
+    parser->argv_cap = count;
+    return 0;
+}
+
+/**
+ * Read the "<prefix><number>\r\n" header line at parser->pos.
+ * Returns 1 and advances pos when complete, 0 when more bytes are
+ * needed and -1 on malformed input.
+ */
+static int read_header_line(RequestParser *parser, const char *buf, size_t len, char prefix, long *value) {
+    size_t pos = parser->pos;
+    if (pos >= len) return 0;
+    if (buf[pos] != prefix) {
+        parser->error = prefix == '*' ? "expected '*'" : "expected '$'";
+        return -1;
+    }
+
+    const char *cr = memchr(buf + pos, '\r', len - pos);
+    if (!cr || (size_t)(cr - buf) + 1 >= len) {
+        if (len - pos > REQUEST_MAX_INLINE) {
+            parser->error = "too big header";
+            return -1;
+        }
+        return 0;
+    }
+    if (cr[1] != '\n') {
+        parser->error = "malformed header";
+        return -1;
+    }
+
+    const char *digits = buf + pos + 1;
+    if (digits == cr) {
+        parser->error = "empty length";
+        return -1;
+    }
+    long v = 0;
+    int negative = 0;
+    if (*digits == '-') {
+        negative = 1;
+        digits++;
+    }
+    for (const char *c = digits; c < cr; c++) {
+        if (*c < '0' || *c > '9' || v > REQUEST_MAX_BULK) {
+            parser->error = "invalid length";
+            return -1;
+        }
+        v = v * 10 + (*c - '0');
+    }
+
+    *value = negative ? -v : v;
+    parser->pos = (size_t)(cr - buf) + 2;
+    return 1;
+}
 
-    if(*cur != '*') return -1;
+request_parse_t request_parser_parse(RequestParser *parser, char *buf, size_t len, size_t *consumed) {
+    int r;
 
-    int num_args = atoi(cur+1);
-    cur = strstr(cur, "\r\n");
-    if(!cur) return -1;
+    if (parser->multibulk_len == 0) {
+        long count = 0;
+        r = read_header_line(parser, buf, len, '*', &count);
+        if (r <= 0) return r < 0 ? REQUEST_PARSE_ERROR : REQUEST_PARSE_INCOMPLETE;
 
-    cur += 2;
+        //-- "*0" and "*-1" carry no command: report an empty request --//
+        if (count <= 0) {
+            *consumed = parser->pos;
+            return REQUEST_PARSE_OK;
+        }
+        if (count > parser->max_args) {
+            parser->error = "too many arguments";
+            return REQUEST_PARSE_ERROR;
+        }
+        //-- Grown as arguments arrive: a bare "*1000000" header costs no more than "*2" --//
+        if (request_parser_reserve(parser, count < REQUEST_ARGV_PREALLOC ? (int)count : REQUEST_ARGV_PREALLOC) != 0) {
+            parser->error = "out of memory";
+            return REQUEST_PARSE_ERROR;
+        }
+        parser->multibulk_len = (int)count;
+    }
 
-    for(int i = 0; i < num_args && counter < max_tokens; i++){
-        if(*cur != '$') return -1;
+    while (parser->argc < parser->multibulk_len) {
+        if (parser->bulk_len < 0) {
+            long bulk_len = 0;
+            r = read_header_line(parser, buf, len, '$', &bulk_len);
+            if (r <= 0) return r < 0 ? REQUEST_PARSE_ERROR : REQUEST_PARSE_INCOMPLETE;
+            if (bulk_len < 0 || bulk_len > REQUEST_MAX_BULK) {
+                parser->error = "invalid bulk length";
+                return REQUEST_PARSE_ERROR;
+            }
+            parser->bulk_len = bulk_len;
+        }
+
+        size_t end = parser->pos + (size_t)parser->bulk_len;
+        if (end + RESP_CRLF_LEN > len) return REQUEST_PARSE_INCOMPLETE;
+        if (buf[end] != '\r' || buf[end + 1] != '\n') {
+            parser->error = "bulk not terminated by CRLF";
+            return REQUEST_PARSE_ERROR;
+        }
+
+        if (parser->argc == parser->argv_cap) {
+            long grown = (long)parser->argv_cap * 2;
+            if (grown > parser->multibulk_len) grown = parser->multibulk_len;
+            if (request_parser_reserve(parser, (int)grown) != 0) {
+                parser->error = "out of memory";
+                return REQUEST_PARSE_ERROR;
+            }
+        }
+
+        buf[end] = '\0';
+        parser->argv_off[parser->argc] = parser->pos;
+        parser->argv_len[parser->argc] = (size_t)parser->bulk_len;
+        parser->argc++;
+        parser->pos = end + RESP_CRLF_LEN;
+        parser->bulk_len = -1;
+    }
 
-        int len = atoi (cur+1);
-        cur = strstr(cur, "\r\n");
-        if (!cur) return -1;
-        cur += 2;
-        tokens[counter] = cur;
-        tokens[counter][len] = '\0';
-        cur += len + 2;
-        counter++;
+    for (int i = 0; i < parser->argc; i++) {
+        parser->argv[i] = buf + parser->argv_off[i];
     }
+    *consumed = parser->pos;
+    return REQUEST_PARSE_OK;
+}
+
+int parse_command(char * input, char * tokens[], int max_tokens){
+    RequestParser parser;
+    request_parser_init(&parser, max_tokens);
+
+    size_t consumed = 0;
+    int counter = -1;
+    if (request_parser_parse(&parser, input, strlen(input), &consumed) == REQUEST_PARSE_OK) {
+        for (counter = 0; counter < parser.argc; counter++) {
+            tokens[counter] = parser.argv[counter];
+        }
+    }
+
+    request_parser_free(&parser);
     return counter;
 }
 
@@ -56,20 +212,282 @@ enum command_t identify_command(const char * cmd){
     if(strcasecmp(cmd, "ECHO") == 0) return CMD_ECHO;
     if(strcasecmp(cmd, "SET") == 0) return CMD_SET;
     if(strcasecmp(cmd, "GET") == 0) return CMD_GET;
+    if(strcasecmp(cmd, "MGET") == 0) return CMD_MGET;
+    if(strcasecmp(cmd, "MSET") == 0) return CMD_MSET;
+    if(strcasecmp(cmd, "MSETNX") == 0) return CMD_MSETNX;
+    if(strcasecmp(cmd, "INCR") == 0) return CMD_INCR;
+    if(strcasecmp(cmd, "DECR") == 0) return CMD_DECR;
+    if(strcasecmp(cmd, "INCRBY") == 0) return CMD_INCRBY;
+    if(strcasecmp(cmd, "DECRBY") == 0) return CMD_DECRBY;
+    if(strcasecmp(cmd, "INCRBYFLOAT") == 0) return CMD_INCRBYFLOAT;
     if(strcasecmp(cmd, "DEL") == 0) return CMD_DEL;
     if(strcasecmp(cmd, "RPUSH") == 0) return CMD_RPUSH;
     if(strcasecmp(cmd, "LRANGE") == 0) return CMD_LRANGE;
     if(strcasecmp(cmd, "LPUSH") == 0) return CMD_LPUSH;
     if(strcasecmp(cmd,"LLEN") == 0) return CMD_LLEN;
     if(strcasecmp(cmd, "LPOP") == 0) return CMD_LPOP;
+    if(strcasecmp(cmd, "RPOP") == 0) return CMD_RPOP;
+    if(strcasecmp(cmd, "LINDEX") == 0) return CMD_LINDEX;
+    if(strcasecmp(cmd, "LSET") == 0) return CMD_LSET;
+    if(strcasecmp(cmd, "LINSERT") == 0) return CMD_LINSERT;
+    if(strcasecmp(cmd, "LTRIM") == 0) return CMD_LTRIM;
+    if(strcasecmp(cmd, "LREM") == 0) return CMD_LREM;
+    if(strcasecmp(cmd, "LPOS") == 0) return CMD_LPOS;
     if(strcasecmp(cmd, "BLPOP") == 0) return CMD_BLPOP;
+    if(strcasecmp(cmd, "BRPOP") == 0) return CMD_BRPOP;
+    if(strcasecmp(cmd, "LMOVE") == 0) return CMD_LMOVE;
+    if(strcasecmp(cmd, "BLMOVE") == 0) return CMD_BLMOVE;
+    if(strcasecmp(cmd, "LMPOP") == 0) return CMD_LMPOP;
+    if(strcasecmp(cmd, "BLMPOP") == 0) return CMD_BLMPOP;
     if(strcasecmp(cmd,"TYPE")==0) return CMD_TYPE;
+    if(strcasecmp(cmd, "INFO") == 0) return CMD_INFO;
+    if(strcasecmp(cmd, "EXPIRE") == 0) return CMD_EXPIRE;
+    if(strcasecmp(cmd, "PEXPIRE") == 0) return CMD_PEXPIRE;
+    if(strcasecmp(cmd, "EXPIREAT") == 0) return CMD_EXPIREAT;
+    if(strcasecmp(cmd, "PEXPIREAT") == 0) return CMD_PEXPIREAT;
+    if(strcasecmp(cmd, "TTL") == 0) return CMD_TTL;
+    if(strcasecmp(cmd, "PTTL") == 0) return CMD_PTTL;
+    if(strcasecmp(cmd, "PERSIST") == 0) return CMD_PERSIST;
     return CMD_UNKNOWN;
 }
 
-void dispatch_command(int client_fd, char * tokens[], int token_count){
+/**
+ * Number of keys of an LMPOP/BLMPOP whose numkeys is tokens[base], if it
+ * leaves room for the keys and the direction after them.
+ * @return The key count, 0 if numkeys is invalid
+ */
+static int mpop_key_count(char *tokens[], int token_count, int base){
+    char *end;
+    long numkeys = strtol(tokens[base], &end, 10);
+    if(end == tokens[base] || *end != '\0' || numkeys <= 0) return 0;
+    return numkeys <= token_count - base - 2 ? (int)numkeys : 0;
+}
+
+int command_key_range(char *tokens[], int token_count, int *first, int *last, int *step){
+    if(token_count < 2) return 0;
+    *step = 1;
+
+    enum command_t cmd = identify_command(tokens[0]);
+    switch (cmd)
+    {
+    case CMD_SET:
+    case CMD_GET:
+    case CMD_INCR:
+    case CMD_DECR:
+    case CMD_INCRBY:
+    case CMD_DECRBY:
+    case CMD_INCRBYFLOAT:
+    case CMD_RPUSH:
+    case CMD_LPUSH:
+    case CMD_LRANGE:
+    case CMD_LLEN:
+    case CMD_LPOP:
+    case CMD_RPOP:
+    case CMD_LINDEX:
+    case CMD_LSET:
+    case CMD_LINSERT:
+    case CMD_LTRIM:
+    case CMD_LREM:
+    case CMD_LPOS:
+    case CMD_TYPE:
+    case CMD_EXPIRE:
+    case CMD_PEXPIRE:
+    case CMD_EXPIREAT:
+    case CMD_PEXPIREAT:
+    case CMD_TTL:
+    case CMD_PTTL:
+    case CMD_PERSIST:
+        *first = *last = 1;
+        return 1;
+    case CMD_DEL:
+    case CMD_MGET:
+        *first = 1;
+        *last = token_count - 1;
+        return 1;
+    case CMD_MSET:
+    case CMD_MSETNX:
+        //-- Keys alternate with their values --//
+        *first = 1;
+        *last = token_count - 2;
+        *step = 2;
+        return *last >= 1;
+    case CMD_BLPOP:
+    case CMD_BRPOP:
+        //-- Every argument but the trailing timeout --//
+        *first = 1;
+        *last = token_count - 2;
+        return *last >= 1;
+    case CMD_LMOVE:
+    case CMD_BLMOVE:
+        *first = 1;
+        *last = token_count > 2 ? 2 : 1;
+        return 1;
+    case CMD_LMPOP:
+    case CMD_BLMPOP: {
+        int base = cmd == CMD_BLMPOP ? 2 : 1;
+        int numkeys = token_count > base ? mpop_key_count(tokens, token_count, base) : 0;
+        *first = base + 1;
+        *last = base + numkeys;
+        return numkeys > 0;
+    }
+    default:
+        return 0;
+    }
+}
+
+/* ==================== Argument Helpers ==================== */
+
+/**
+ * Parse a whole token as a signed 64-bit integer.
+ * @return 1 on success, 0 if it is not an integer or out of range
+ */
+static int parse_integer(const char *token, size_t len, long long *out){
+    char *end;
+    errno = 0;
+    long long value = strtoll(token, &end, 10);
+    if(end == token || end != token + len || errno == ERANGE) return 0;
+    *out = value;
+    return 1;
+}
+
+/**
+ * Parse a whole token as a finite long double.
+ * @return 1 on success, 0 if it is not a number, NaN or infinite
+ */
+static int parse_long_double(const char *token, size_t len, long double *out){
+    char *end;
+    errno = 0;
+    long double value = strtold(token, &end);
+    if(end == token || end != token + len || isspace((unsigned char)token[0]) || errno == ERANGE ||
+       isnan(value) || isinf(value)) return 0;
+    *out = value;
+    return 1;
+}
+
+/**
+ * Turn a relative time (EX/PX, EXPIRE/PEXPIRE) or a Unix time (EXAT/PXAT,
+ * EXPIREAT/PEXPIREAT) into a deadline on the expiry_now() clock.
+ * @param unit_ms 1000 for seconds, 1 for milliseconds
+ * @return 1 on success, 0 if the time overflows
+ */
+static int deadline_from_arg(long long amount, long long unit_ms, int absolute, long long *deadline){
+    long long ms;
+    if(__builtin_mul_overflow(amount, unit_ms, &ms)) return 0;
+    if(absolute){
+        *deadline = expiry_from_unix_ms(ms);
+        return 1;
+    }
+    return !__builtin_add_overflow(expiry_now(), ms, deadline);
+}
+
+/**
+ * Parse SET's options: NX | XX, GET, and one of EX, PX, EXAT, PXAT or KEEPTTL.
+ * @return NULL on success, or the error to report
+ */
+static const char *parse_set_options(char *tokens[], const size_t lens[], int token_count, int *flags, int *want_old, long long *expiry){
+    int has_expiry = 0;
+    *flags = 0;
+    *want_old = 0;
+    *expiry = 0;
+
+    for(int i = 3; i < token_count; i++){
+        const char *opt = tokens[i];
+        if(strcasecmp(opt, "NX") == 0 && !(*flags & SET_XX)){
+            *flags |= SET_NX;
+        } else if(strcasecmp(opt, "XX") == 0 && !(*flags & SET_NX)){
+            *flags |= SET_XX;
+        } else if(strcasecmp(opt, "GET") == 0){
+            *want_old = 1;
+        } else if(strcasecmp(opt, "KEEPTTL") == 0 && !has_expiry){
+            *flags |= SET_KEEPTTL;
+            has_expiry = 1;
+        } else if((strcasecmp(opt, "EX") == 0 || strcasecmp(opt, "PX") == 0 ||
+                   strcasecmp(opt, "EXAT") == 0 || strcasecmp(opt, "PXAT") == 0) &&
+                  !has_expiry && i + 1 < token_count){
+            long long amount;
+            i++;
+            if(!parse_integer(tokens[i], lens[i], &amount)) return "value is not an integer or out of range";
+            int seconds = toupper((unsigned char)opt[0]) == 'E';
+            int absolute = strlen(opt) == 4;
+            if(amount <= 0 || !deadline_from_arg(amount, seconds ? 1000 : 1, absolute, expiry)){
+                return "invalid expire time in 'set' command";
+            }
+            has_expiry = 1;
+        } else {
+            return "syntax error";
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Parse a blocking command's timeout, in seconds with an optional fraction,
+ * into a deadline on the expiry_now() clock (0 = wait forever).
+ * @return NULL on success, or the error to report
+ */
+static const char *parse_block_timeout(const char *token, size_t len, long long *deadline){
+    char *end;
+    errno = 0;
+    double seconds = strtod(token, &end);
+    if(end == token || end != token + len || errno == ERANGE || seconds != seconds){
+        return "timeout is not a float or out of range";
+    }
+    if(seconds < 0) return "timeout is negative";
+    if(seconds * 1000 >= (double)(LLONG_MAX / 2)) return "timeout is out of range";
+
+    long long ms = (long long)(seconds * 1000);
+    *deadline = seconds > 0 ? expiry_now() + (ms > 0 ? ms : 1) : 0;
+    return NULL;
+}
+
+/**
+ * Parse a list end argument: LEFT is the head, RIGHT the tail.
+ * @return 1 on success, 0 if it is neither
+ */
+static int parse_list_end(const char *token, int *where){
+    if(strcasecmp(token, "LEFT") == 0){
+        *where = LIST_HEAD;
+    } else if(strcasecmp(token, "RIGHT") == 0){
+        *where = LIST_TAIL;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+/* ==================== List Reply Sinks ==================== */
+//-- Elements are serialised straight from list storage while the shard is locked --//
+
+static void sink_array_begin(void *ctx, size_t count){
+    reply_add_array_len(ctx, (long long)count);
+}
+
+static void sink_single_begin(void *ctx, size_t count){
+    (void)ctx;
+    (void)count;
+}
+
+static void sink_bulk(void *ctx, const char *value, size_t len){
+    if(value){
+        reply_add_bulk(ctx, value, len);
+    } else {
+        reply_add_null(ctx);
+    }
+}
+
+int command_may_block(char *tokens[], int token_count){
+    if(token_count == 0) return 0;
+    enum command_t cmd = identify_command(tokens[0]);
+    return cmd == CMD_BLPOP || cmd == CMD_BRPOP || cmd == CMD_BLMOVE || cmd == CMD_BLMPOP;
+}
+
+void dispatch_command(ReplyBuffer *reply, char * tokens[], size_t lens[], int token_count){
+    dispatch_client_command(NULL, reply, tokens, lens, token_count);
+}
+
+void dispatch_client_command(struct Connection *conn, ReplyBuffer *reply, char * tokens[], size_t lens[], int token_count){
     if(token_count == 0){
-        dprintf(client_fd, "[MemoraDB: ERROR] Empty Command\n");
+        reply_add_format(reply, "[MemoraDB: ERROR] Empty Command\n");
         return;
     }
 
@@ -78,208 +496,601 @@ void dispatch_command(int client_fd, char * tokens[], int token_count){
     switch (cmd)
     {
     case CMD_PING:
-        dprintf(client_fd, "+PONG\r\n");
+        reply_add_simple(reply, "PONG");
         break;
     case CMD_ECHO:
         if(token_count < 2){
-            dprintf(client_fd, "[MemoraDB: WARN] ECHO needs one argument\n");
+            reply_add_format(reply, "[MemoraDB: WARN] ECHO needs one argument\n");
         } else {
-            dprintf(client_fd, "$%lu\r\n%s\r\n", strlen(tokens[1]), tokens[1]);
+            reply_add_bulk(reply, tokens[1], lens[1]);
         }
         break;
     case CMD_SET:
         if (token_count < 3) {
-            dprintf(client_fd, "[MemoraDB: WARN] SET needs key and value\r\n");
+            reply_add_format(reply, "[MemoraDB: WARN] SET needs key and value\r\n");
         } else {
-            long long px = 0;
-            if (token_count >= 5 && strcasecmp(tokens[3], "PX") == 0) {
-                px = atoll(tokens[4]);
+            int flags, want_old;
+            long long expiry;
+            const char *error = parse_set_options(tokens, lens, token_count, &flags, &want_old, &expiry);
+            if (error) {
+                reply_add_format(reply, "[MemoraDB: ERROR] %s\r\n", error);
+                break;
+            }
+
+            char *old_value = NULL;
+            size_t old_len = 0;
+            int stored = set_value_ex(tokens[1], lens[1], tokens[2], lens[2], expiry, flags,
+                                      want_old ? &old_value : NULL, &old_len);
+            if (stored == STRING_ERR_WRONGTYPE) {
+                reply_add_format(reply, "[MemoraDB: ERROR] WRONGTYPE Operation against a key holding the wrong kind of value\r\n");
+            } else if (stored == STRING_ERR_NO_MEMORY) {
+                reply_add_format(reply, "[MemoraDB: ERROR] out of memory\r\n");
+            } else if (want_old) {
+                //-- SET ... GET answers with the previous value, stored or not --//
+                if (old_value) {
+                    reply_add_bulk(reply, old_value, old_len);
+                    free(old_value);
+                } else {
+                    reply_add_null(reply);
+                }
+            } else if (stored) {
+                reply_add_simple(reply, "OK");
+            } else {
+                reply_add_null(reply);
             }
-            set_value(tokens[1], tokens[2], px);
-            dprintf(client_fd, "+OK\r\n");
         }
         break;
     case CMD_GET:
         if(token_count < 2){
-            dprintf(client_fd, "[MemoraDB: WARN] GET needs key\r\n");
+            reply_add_format(reply, "[MemoraDB: WARN] GET needs key\r\n");
         } else {
-            const char *value = get_value(tokens[1]);
-            if(value)
-                dprintf(client_fd, "$%lu\r\n%s\r\n", strlen(value), value);
-            else
-                dprintf(client_fd, "$-1\r\n");
+            //-- No lock and no copy: the epoch keeps the value alive until it is queued --//
+            epoch_enter();
+            char int_buf[INT_TEXT_MAX];
+            size_t value_len;
+            const char *value = get_value(tokens[1], lens[1], &value_len, int_buf);
+            if(value) {
+                reply_add_bulk(reply, value, value_len);
+            } else {
+                reply_add_null(reply);
+            }
+            epoch_exit();
         }
         break;
+    case CMD_MGET: {
+        if (token_count < 2) {
+            reply_add_format(reply, "[MemoraDB: ERROR] wrong number of arguments for 'MGET'\r\n");
+            break;
+        }
+        int count = token_count - 1;
+        StringValue *values = malloc((size_t)count * sizeof(StringValue));
+        epoch_enter();
+        if (!values || get_values(&tokens[1], &lens[1], count, values) != 0) {
+            reply_add_format(reply, "[MemoraDB: ERROR] out of memory\r\n");
+        } else {
+            reply_add_array_len(reply, count);
+            for (int i = 0; i < count; i++) {
+                if (values[i].value) {
+                    reply_add_bulk(reply, values[i].value, values[i].len);
+                } else {
+                    reply_add_null(reply);
+                }
+            }
+        }
+        epoch_exit();
+        free(values);
+        break;
+    }
+    case CMD_MSET:
+    case CMD_MSETNX: {
+        if (token_count < 3 || token_count % 2 == 0) {
+            reply_add_format(reply, "[MemoraDB: ERROR] wrong number of arguments for '%s'\r\n", tokens[0]);
+            break;
+        }
+        int stored = set_values(&tokens[1], &lens[1], (token_count - 1) / 2, cmd == CMD_MSETNX ? SET_NX : 0);
+        if (stored < 0) {
+            reply_add_format(reply, "[MemoraDB: ERROR] out of memory\r\n");
+        } else if (cmd == CMD_MSETNX) {
+            reply_add_integer(reply, stored);
+        } else {
+            reply_add_simple(reply, "OK");
+        }
+        break;
+    }
+    case CMD_INCR:
+    case CMD_DECR:
+    case CMD_INCRBY:
+    case CMD_DECRBY: {
+        int by = cmd == CMD_INCRBY || cmd == CMD_DECRBY;
+        if (token_count != (by ? 3 : 2)) {
+            reply_add_format(reply, "[MemoraDB: ERROR] wrong number of arguments for '%s'\r\n", tokens[0]);
+            break;
+        }
+        long long delta = 1;
+        if (by && !parse_integer(tokens[2], lens[2], &delta)) {
+            reply_add_format(reply, "[MemoraDB: ERROR] value is not an integer or out of range\r\n");
+            break;
+        }
+        if (cmd == CMD_DECR || cmd == CMD_DECRBY) {
+            if (delta == LLONG_MIN) {
+                reply_add_format(reply, "[MemoraDB: ERROR] decrement would overflow\r\n");
+                break;
+            }
+            delta = -delta;
+        }
+
+        long long value;
+        switch (increment_value(tokens[1], lens[1], delta, &value)) {
+        case STRING_ERR_WRONGTYPE:
+            reply_add_format(reply, "[MemoraDB: ERROR] WRONGTYPE Operation against a key holding the wrong kind of value\r\n");
+            break;
+        case STRING_ERR_NOT_INTEGER:
+            reply_add_format(reply, "[MemoraDB: ERROR] value is not an integer or out of range\r\n");
+            break;
+        case STRING_ERR_OVERFLOW:
+            reply_add_format(reply, "[MemoraDB: ERROR] increment or decrement would overflow\r\n");
+            break;
+        case STRING_ERR_NO_MEMORY:
+            reply_add_format(reply, "[MemoraDB: ERROR] out of memory\r\n");
+            break;
+        default:
+            reply_add_integer(reply, value);
+            break;
+        }
+        break;
+    }
+    case CMD_INCRBYFLOAT: {
+        if (token_count != 3) {
+            reply_add_format(reply, "[MemoraDB: ERROR] wrong number of arguments for 'INCRBYFLOAT'\r\n");
+            break;
+        }
+        long double delta;
+        if (!parse_long_double(tokens[2], lens[2], &delta)) {
+            reply_add_format(reply, "[MemoraDB: ERROR] value is not a valid float\r\n");
+            break;
+        }
+
+        char text[FLOAT_TEXT_MAX];
+        size_t text_len;
+        switch (increment_value_float(tokens[1], lens[1], delta, text, &text_len)) {
+        case STRING_ERR_WRONGTYPE:
+            reply_add_format(reply, "[MemoraDB: ERROR] WRONGTYPE Operation against a key holding the wrong kind of value\r\n");
+            break;
+        case STRING_ERR_NOT_FLOAT:
+            reply_add_format(reply, "[MemoraDB: ERROR] value is not a valid float\r\n");
+            break;
+        case STRING_ERR_OVERFLOW:
+            reply_add_format(reply, "[MemoraDB: ERROR] increment would produce NaN or Infinity\r\n");
+            break;
+        case STRING_ERR_NO_MEMORY:
+            reply_add_format(reply, "[MemoraDB: ERROR] out of memory\r\n");
+            break;
+        default:
+            reply_add_bulk(reply, text, text_len);
+            break;
+        }
+        break;
+    }
     case CMD_RPUSH:
         if (token_count < 3) {
-            dprintf(client_fd, "[MemoraDB: WARN] RPUSH needs key and at least one value\r\n");
+            reply_add_format(reply, "[MemoraDB: WARN] RPUSH needs key and at least one value\r\n");
         } else {
-            List *list = get_or_create_list(tokens[1]);
-            if (!list) {
-                dprintf(client_fd, "[MemoraDB: ERROR] could not create list\r\n");
+            long long total_elements = push_list_values(tokens[1], lens[1], &tokens[2], &lens[2], token_count - 2, 0);
+            if (total_elements == LIST_ERR_WRONGTYPE) {
+                reply_add_format(reply, "[MemoraDB: ERROR] WRONGTYPE Operation against a key holding the wrong kind of value\r\n");
                 break;
             }
-
-            size_t total_elements = 0;
-            for (int i = 2; i < token_count; i++) {
-                size_t new_len = list_rpush(list, tokens[i]);
-                if (new_len > total_elements) {
-                    total_elements = new_len;
-                }
+            if (total_elements == LIST_ERR_NO_MEMORY) {
+                //-- Values pushed before the failure may still wake a blocked client --//
+                reply_add_format(reply, "[MemoraDB: ERROR] out of memory\r\n");
+                blocking_signal_key(tokens[1], lens[1]);
+                break;
             }
 
-            dprintf(client_fd, ":%zu\r\n", total_elements);
+            reply_add_integer(reply, total_elements);
+            blocking_signal_key(tokens[1], lens[1]);
         }
         break;
     case CMD_LPUSH:
         if (token_count < 3) {
-            dprintf(client_fd, "[MemoraDB: ERROR] wrong number of arguments for 'LPUSH'\r\n");
+            reply_add_format(reply, "[MemoraDB: ERROR] wrong number of arguments for 'LPUSH'\r\n");
         } else {
-            List *list = get_or_create_list(tokens[1]);
-            if (!list) {
-                dprintf(client_fd, "[MemoraDB: ERROR] could not create list\r\n");
+            long long total_elements = push_list_values(tokens[1], lens[1], &tokens[2], &lens[2], token_count - 2, 1);
+            if (total_elements == LIST_ERR_WRONGTYPE) {
+                reply_add_format(reply, "[MemoraDB: ERROR] WRONGTYPE Operation against a key holding the wrong kind of value\r\n");
                 break;
             }
-
-            size_t total_elements = 0;
-            for (int i = 2 ; i < token_count ; i++) {
-                size_t new_len = list_lpush(list, tokens[i]);
-                if (new_len > total_elements) {
-                    total_elements = new_len;
-                }
+            if (total_elements == LIST_ERR_NO_MEMORY) {
+                //-- Values pushed before the failure may still wake a blocked client --//
+                reply_add_format(reply, "[MemoraDB: ERROR] out of memory\r\n");
+                blocking_signal_key(tokens[1], lens[1]);
+                break;
             }
 
-            dprintf(client_fd, ":%zu\r\n", total_elements);
+            reply_add_integer(reply, total_elements);
+            blocking_signal_key(tokens[1], lens[1]);
         }
         break;
-    case CMD_LRANGE:
+    case CMD_LRANGE: {
         if (token_count < 4) {
-            dprintf(client_fd, "[MemoraDB: ERROR] wrong number of arguments for 'LRANGE'\r\n");
-        } else {
-            int start = atoi(tokens[2]);
-            int end = atoi(tokens[3]);
-            
-            List *list = get_list_if_exists(tokens[1]);
-            int result_count = 0;
-            char **elements = NULL;
-            if (list) {
-                elements = list_range(list, start, end, &result_count);
-            }
-            
-            if (elements) {
-                dprintf(client_fd, "*%d\r\n", result_count);
-                for (int i = 0; i < result_count; i++) {
-                    dprintf(client_fd, "$%lu\r\n%s\r\n", strlen(elements[i]), elements[i]);
-                    free(elements[i]);
-                }
-                free(elements);
-            } else {
-                dprintf(client_fd, "*0\r\n");
-            }
+            reply_add_format(reply, "[MemoraDB: ERROR] wrong number of arguments for 'LRANGE'\r\n");
+            break;
+        }
+        long long start, end;
+        if (!parse_integer(tokens[2], lens[2], &start) || !parse_integer(tokens[3], lens[3], &end)) {
+            reply_add_format(reply, "[MemoraDB: ERROR] value is not an integer or out of range\r\n");
+            break;
+        }
+
+        ListSink sink = { sink_array_begin, sink_bulk, reply };
+        if (read_list_range(tokens[1], lens[1], (long)start, (long)end, &sink) == LIST_ERR_WRONGTYPE) {
+            reply_add_format(reply, "[MemoraDB: ERROR] WRONGTYPE Operation against a key holding the wrong kind of value\r\n");
         }
         break;
+    }
     case CMD_LLEN:
         if (token_count < 2) {
-            dprintf(client_fd, "[MemoraDB: ERROR] wrong number of arguments for 'LLEN'\r\n");
+            reply_add_format(reply, "[MemoraDB: ERROR] wrong number of arguments for 'LLEN'\r\n");
         } else {
-            List *list = get_list_if_exists(tokens[1]);
-            int length = 0;
-            if (list) {
-                length = list_length(list);
-            }
-            dprintf(client_fd, ":%d\r\n", length);
+            reply_add_integer(reply, (long long)get_list_length(tokens[1], lens[1]));
         }
         break;
     case CMD_LPOP:
-        if (token_count == 2) {
-            List *list = get_list_if_exists(tokens[1]);
-            char *popped = lpop_element(list);
-            if (popped) {
-                dprintf(client_fd, "$%lu\r\n%s\r\n", strlen(popped), popped);
-                free(popped);
-            } else {
-                dprintf(client_fd, "$-1\r\n");
-            }
-        } else if (token_count == 3) {
-            List *list = get_list_if_exists(tokens[1]);
-            int count = atoi(tokens[2]);
-            if (count <= 0) {
-                dprintf(client_fd, "*0\r\n");
-            } else {
-                int actual_count = 0;
-                char **popped_elements = lpop_multiple(list, count, &actual_count);
+    case CMD_RPOP: {
+        const char *name = cmd == CMD_LPOP ? "LPOP" : "RPOP";
+        int where = cmd == CMD_LPOP ? LIST_HEAD : LIST_TAIL;
+        if (token_count != 2 && token_count != 3) {
+            reply_add_format(reply, "[MemoraDB: ERROR] wrong number of arguments for '%s'\r\n", name);
+            break;
+        }
+
+        long long count = 1;
+        if (token_count == 3 && (!parse_integer(tokens[2], lens[2], &count) || count < 0)) {
+            reply_add_format(reply, "[MemoraDB: ERROR] value is out of range, must be positive\r\n");
+            break;
+        }
 
-                dprintf(client_fd, "*%d\r\n", actual_count);
-                for (int i = 0; i < actual_count; i++) {
-                    dprintf(client_fd, "$%lu\r\n%s\r\n", strlen(popped_elements[i]), popped_elements[i]);
-                    free(popped_elements[i]);
+        //-- Without a count: the element itself, or null --//
+        ListSink sink = { token_count == 2 ? sink_single_begin : sink_array_begin, sink_bulk, reply };
+        long long popped = pop_list_into(tokens[1], lens[1], where, (size_t)count, &sink);
+        if (popped == LIST_ERR_WRONGTYPE) {
+            reply_add_format(reply, "[MemoraDB: ERROR] WRONGTYPE Operation against a key holding the wrong kind of value\r\n");
+        } else if (token_count == 2 && popped == 0) {
+            reply_add_null(reply);
+        }
+        break;
+    }
+    case CMD_LINDEX: {
+        if (token_count != 3) {
+            reply_add_format(reply, "[MemoraDB: ERROR] wrong number of arguments for 'LINDEX'\r\n");
+            break;
+        }
+        long long index;
+        if (!parse_integer(tokens[2], lens[2], &index)) {
+            reply_add_format(reply, "[MemoraDB: ERROR] value is not an integer or out of range\r\n");
+            break;
+        }
+
+        //-- A one-element range: LRANGE's bounds handling matches LINDEX's --//
+        ListSink sink = { sink_single_begin, sink_bulk, reply };
+        long long found = read_list_range(tokens[1], lens[1], (long)index, (long)index, &sink);
+        if (found == LIST_ERR_WRONGTYPE) {
+            reply_add_format(reply, "[MemoraDB: ERROR] WRONGTYPE Operation against a key holding the wrong kind of value\r\n");
+        } else if (found == 0) {
+            reply_add_null(reply);
+        }
+        break;
+    }
+    case CMD_LSET: {
+        if (token_count != 4) {
+            reply_add_format(reply, "[MemoraDB: ERROR] wrong number of arguments for 'LSET'\r\n");
+            break;
+        }
+        long long index;
+        if (!parse_integer(tokens[2], lens[2], &index)) {
+            reply_add_format(reply, "[MemoraDB: ERROR] value is not an integer or out of range\r\n");
+            break;
+        }
+
+        switch (set_list_index(tokens[1], lens[1], (long)index, tokens[3], lens[3])) {
+        case LIST_ERR_WRONGTYPE:
+            reply_add_format(reply, "[MemoraDB: ERROR] WRONGTYPE Operation against a key holding the wrong kind of value\r\n");
+            break;
+        case LIST_ERR_NO_KEY:
+            reply_add_format(reply, "[MemoraDB: ERROR] no such key\r\n");
+            break;
+        case LIST_ERR_RANGE:
+            reply_add_format(reply, "[MemoraDB: ERROR] index out of range\r\n");
+            break;
+        case LIST_ERR_NO_MEMORY:
+            reply_add_format(reply, "[MemoraDB: ERROR] out of memory\r\n");
+            break;
+        default:
+            reply_add_simple(reply, "OK");
+            break;
+        }
+        break;
+    }
+    case CMD_LINSERT: {
+        if (token_count != 5) {
+            reply_add_format(reply, "[MemoraDB: ERROR] wrong number of arguments for 'LINSERT'\r\n");
+            break;
+        }
+        int after;
+        if (strcasecmp(tokens[2], "BEFORE") == 0) {
+            after = 0;
+        } else if (strcasecmp(tokens[2], "AFTER") == 0) {
+            after = 1;
+        } else {
+            reply_add_format(reply, "[MemoraDB: ERROR] syntax error\r\n");
+            break;
+        }
+
+        long long length = insert_list_value(tokens[1], lens[1], after, tokens[3], lens[3], tokens[4], lens[4]);
+        if (length == LIST_ERR_WRONGTYPE) {
+            reply_add_format(reply, "[MemoraDB: ERROR] WRONGTYPE Operation against a key holding the wrong kind of value\r\n");
+        } else if (length == LIST_ERR_NO_MEMORY) {
+            reply_add_format(reply, "[MemoraDB: ERROR] out of memory\r\n");
+        } else {
+            //-- A missing pivot answers -1, a missing key 0 --//
+            reply_add_integer(reply, length == LIST_ERR_NO_PIVOT ? -1 : length);
+        }
+        break;
+    }
+    case CMD_LTRIM: {
+        if (token_count != 4) {
+            reply_add_format(reply, "[MemoraDB: ERROR] wrong number of arguments for 'LTRIM'\r\n");
+            break;
+        }
+        long long start, end;
+        if (!parse_integer(tokens[2], lens[2], &start) || !parse_integer(tokens[3], lens[3], &end)) {
+            reply_add_format(reply, "[MemoraDB: ERROR] value is not an integer or out of range\r\n");
+            break;
+        }
+
+        if (trim_list(tokens[1], lens[1], (long)start, (long)end) == LIST_ERR_WRONGTYPE) {
+            reply_add_format(reply, "[MemoraDB: ERROR] WRONGTYPE Operation against a key holding the wrong kind of value\r\n");
+        } else {
+            reply_add_simple(reply, "OK");
+        }
+        break;
+    }
+    case CMD_LREM: {
+        if (token_count != 4) {
+            reply_add_format(reply, "[MemoraDB: ERROR] wrong number of arguments for 'LREM'\r\n");
+            break;
+        }
+        long long count;
+        if (!parse_integer(tokens[2], lens[2], &count)) {
+            reply_add_format(reply, "[MemoraDB: ERROR] value is not an integer or out of range\r\n");
+            break;
+        }
+
+        long long removed = remove_list_values(tokens[1], lens[1], (long)count, tokens[3], lens[3]);
+        if (removed == LIST_ERR_WRONGTYPE) {
+            reply_add_format(reply, "[MemoraDB: ERROR] WRONGTYPE Operation against a key holding the wrong kind of value\r\n");
+        } else {
+            reply_add_integer(reply, removed);
+        }
+        break;
+    }
+    case CMD_LPOS: {
+        if (token_count < 3 || token_count % 2 == 0) {
+            reply_add_format(reply, token_count < 3 ? "[MemoraDB: ERROR] wrong number of arguments for 'LPOS'\r\n"
+                                                    : "[MemoraDB: ERROR] syntax error\r\n");
+            break;
+        }
+
+        long long rank = 1, count = 0, maxlen = 0;
+        int has_count = 0;
+        const char *error = NULL;
+        for (int i = 3; i < token_count && !error; i += 2) {
+            long long amount;
+            if (!parse_integer(tokens[i + 1], lens[i + 1], &amount)) {
+                error = "value is not an integer or out of range";
+            } else if (strcasecmp(tokens[i], "RANK") == 0) {
+                if (amount == 0 || amount == LLONG_MIN) {
+                    error = "RANK can't be zero: use 1 to start from the first match, 2 from the second ... "
+                            "or use negative to start from the end of the list";
                 }
-                free(popped_elements);
+                rank = amount;
+            } else if (strcasecmp(tokens[i], "COUNT") == 0) {
+                if (amount < 0) error = "COUNT can't be negative";
+                count = amount;
+                has_count = 1;
+            } else if (strcasecmp(tokens[i], "MAXLEN") == 0) {
+                if (amount < 0) error = "MAXLEN can't be negative";
+                maxlen = amount;
+            } else {
+                error = "syntax error";
             }
+        }
+        if (error) {
+            reply_add_format(reply, "[MemoraDB: ERROR] %s\r\n", error);
+            break;
+        }
+
+        //-- Without COUNT only the first match is wanted --//
+        long found;
+        long *positions = find_list_positions(tokens[1], lens[1], tokens[2], lens[2], (long)rank, has_count ? (long)count : 1,
+                                              (long)maxlen, &found);
+        if (found == LIST_ERR_WRONGTYPE) {
+            reply_add_format(reply, "[MemoraDB: ERROR] WRONGTYPE Operation against a key holding the wrong kind of value\r\n");
+        } else if (has_count) {
+            reply_add_array_len(reply, found);
+            for (long i = 0; i < found; i++) reply_add_integer(reply, positions[i]);
+        } else if (found > 0) {
+            reply_add_integer(reply, positions[0]);
         } else {
-            dprintf(client_fd, "[MemoraDB: ERROR] wrong number of arguments for 'LPOP'\r\n");
+            reply_add_null(reply);
         }
+        free(positions);
         break;
-    case CMD_BLPOP: {
-        if (token_count != 3) {
-            dprintf(client_fd, "[MemoraDB: ERROR] wrong number of arguments for 'BLPOP'\r\n");
+    }
+    case CMD_BLPOP:
+    case CMD_BRPOP: {
+        if (token_count < 3) {
+            reply_add_format(reply, "[MemoraDB: ERROR] wrong number of arguments for '%s'\r\n",
+                             cmd == CMD_BLPOP ? "BLPOP" : "BRPOP");
             break;
         }
 
-        const char *list_name = tokens[1];
-        double timeout_sec = atof(tokens[2]);
-        long long start_time = current_millis();
-        long long timeout_ms = (long long)(timeout_sec * 1000);
+        long long deadline;
+        const char *error = parse_block_timeout(tokens[token_count - 1], lens[token_count - 1], &deadline);
+        if (error) {
+            reply_add_format(reply, "[MemoraDB: ERROR] %s\r\n", error);
+            break;
+        }
 
-        List *list = get_list_if_exists(list_name);
-        char *element = NULL;
+        //-- Blocked: the reply is written when a push or the timeout releases the client --//
+        BlockingPop op = { BLOCK_POP, cmd == CMD_BLPOP ? LIST_HEAD : LIST_TAIL, 1, NULL, 0, 0 };
+        blocking_pop(conn, &tokens[1], &lens[1], token_count - 2, &op, deadline, reply);
+        break;
+    }
+    case CMD_LMOVE:
+    case CMD_BLMOVE: {
+        int blocking = cmd == CMD_BLMOVE;
+        if (token_count != (blocking ? 6 : 5)) {
+            reply_add_format(reply, "[MemoraDB: ERROR] wrong number of arguments for '%s'\r\n",
+                             blocking ? "BLMOVE" : "LMOVE");
+            break;
+        }
 
-        while (1) {
-            element = lpop_element(list);
-            if (element != NULL) {
-                dprintf(client_fd, "*2\r\n$%lu\r\n%s\r\n$%lu\r\n%s\r\n",
-                        strlen(list_name), list_name,
-                        strlen(element), element);
-                free(element);
-                break;
-            }
+        int from, to;
+        if (!parse_list_end(tokens[3], &from) || !parse_list_end(tokens[4], &to)) {
+            reply_add_format(reply, "[MemoraDB: ERROR] syntax error\r\n");
+            break;
+        }
+        long long deadline = 0;
+        const char *error = blocking ? parse_block_timeout(tokens[5], lens[5], &deadline) : NULL;
+        if (error) {
+            reply_add_format(reply, "[MemoraDB: ERROR] %s\r\n", error);
+            break;
+        }
 
-            long long elapsed = current_millis() - start_time;
+        BlockingPop op = { BLOCK_MOVE, from, 1, tokens[2], lens[2], to };
+        blocking_pop(blocking ? conn : NULL, &tokens[1], &lens[1], 1, &op, deadline, reply);
+        break;
+    }
+    case CMD_LMPOP:
+    case CMD_BLMPOP: {
+        int blocking = cmd == CMD_BLMPOP;
+        int base = blocking ? 2 : 1;   //- Index of numkeys -//
+        if (token_count < base + 3) {
+            reply_add_format(reply, "[MemoraDB: ERROR] wrong number of arguments for '%s'\r\n",
+                             blocking ? "BLMPOP" : "LMPOP");
+            break;
+        }
 
-            if (timeout_sec == 0.0 || elapsed < timeout_ms) {
-                usleep(100 * 1000);
-                continue;
+        long long deadline = 0;
+        const char *error = blocking ? parse_block_timeout(tokens[1], lens[1], &deadline) : NULL;
+        long long numkeys, count = 1;
+        int where;
+        if (!error && (!parse_integer(tokens[base], lens[base], &numkeys) || numkeys <= 0)) {
+            error = "numkeys should be greater than 0";
+        }
+        if (!error && (numkeys > token_count - base - 2 ||
+                       !parse_list_end(tokens[base + 1 + numkeys], &where))) {
+            error = "syntax error";
+        }
+        if (!error && base + 2 + numkeys < token_count) {
+            int opt = base + 2 + (int)numkeys;
+            if (opt + 2 != token_count || strcasecmp(tokens[opt], "COUNT") != 0) {
+                error = "syntax error";
+            } else if (!parse_integer(tokens[opt + 1], lens[opt + 1], &count) || count <= 0) {
+                error = "count should be greater than 0";
             }
-
-            dprintf(client_fd, "$-1\r\n");
+        }
+        if (error) {
+            reply_add_format(reply, "[MemoraDB: ERROR] %s\r\n", error);
             break;
         }
+
+        BlockingPop op = { BLOCK_MPOP, where, count > INT_MAX ? INT_MAX : (int)count, NULL, 0, 0 };
+        blocking_pop(blocking ? conn : NULL, &tokens[base + 1], &lens[base + 1], (int)numkeys, &op, deadline, reply);
         break;
     }
     case CMD_DEL:
         if (token_count < 2) {
-            dprintf(client_fd, "[MemoraDB: ERROR] wrong number of arguments for 'DEL'\r\n");
+            reply_add_format(reply, "[MemoraDB: ERROR] wrong number of arguments for 'DEL'\r\n");
         } else {
             int deleted_count = 0;
             /* delete each key provided */
             for (int i = 1; i < token_count; i++) {
-                if (delete_key(tokens[i])) {
+                if (delete_key(tokens[i], lens[i])) {
                     deleted_count++;
                 }
             }
-            dprintf(client_fd, ":%d\r\n", deleted_count);
+            reply_add_integer(reply, deleted_count);
         }
         break;
     case CMD_TYPE:
         if (token_count<2){
-            dprintf(client_fd, "[MemoraDB: ERROR] wrong number of arguments for 'TYPE', the 'TYPE' command expects a key\r\n");
+            reply_add_format(reply, "[MemoraDB: ERROR] wrong number of arguments for 'TYPE', the 'TYPE' command expects a key\r\n");
         }else{
-            const char *type = get_type(tokens[1]); 
-            dprintf(client_fd, "+%s\r\n", type); 
+            const char *type = get_type(tokens[1], lens[1]); 
+            reply_add_simple(reply, type); 
+        }
+        break;
+    case CMD_INFO:
+        stats_info(reply);
+        break;
+    case CMD_EXPIRE:
+    case CMD_PEXPIRE:
+    case CMD_EXPIREAT:
+    case CMD_PEXPIREAT: {
+        if (token_count != 3 && token_count != 4) {
+            reply_add_format(reply, "[MemoraDB: ERROR] wrong number of arguments for '%s'\r\n", tokens[0]);
+            break;
+        }
+
+        long long amount;
+        if (!parse_integer(tokens[2], lens[2], &amount)) {
+            reply_add_format(reply, "[MemoraDB: ERROR] value is not an integer or out of range\r\n");
+            break;
+        }
+
+        int flags = 0;
+        if (token_count == 4) {
+            if (strcasecmp(tokens[3], "NX") == 0) flags = EXPIRE_NX;
+            else if (strcasecmp(tokens[3], "XX") == 0) flags = EXPIRE_XX;
+            else if (strcasecmp(tokens[3], "GT") == 0) flags = EXPIRE_GT;
+            else if (strcasecmp(tokens[3], "LT") == 0) flags = EXPIRE_LT;
+            else {
+                reply_add_format(reply, "[MemoraDB: ERROR] Unsupported option %s\r\n", tokens[3]);
+                break;
+            }
+        }
+
+        long long unit_ms = (cmd == CMD_EXPIRE || cmd == CMD_EXPIREAT) ? 1000 : 1;
+        int absolute = (cmd == CMD_EXPIREAT || cmd == CMD_PEXPIREAT);
+        long long deadline;
+        if (!deadline_from_arg(amount, unit_ms, absolute, &deadline)) {
+            reply_add_format(reply, "[MemoraDB: ERROR] invalid expire time in '%s' command\r\n", tokens[0]);
+            break;
+        }
+        reply_add_integer(reply, set_key_expiry(tokens[1], lens[1], deadline, flags));
+        break;
+    }
+    case CMD_TTL:
+    case CMD_PTTL:
+        if (token_count != 2) {
+            reply_add_format(reply, "[MemoraDB: ERROR] wrong number of arguments for '%s'\r\n", tokens[0]);
+        } else {
+            long long ttl = get_key_ttl(tokens[1], lens[1]);
+            if (ttl >= 0 && cmd == CMD_TTL) ttl = (ttl + 500) / 1000;
+            reply_add_integer(reply, ttl);
+        }
+        break;
+    case CMD_PERSIST:
+        if (token_count != 2) {
+            reply_add_format(reply, "[MemoraDB: ERROR] wrong number of arguments for 'PERSIST'\r\n");
+        } else {
+            reply_add_integer(reply, persist_key(tokens[1], lens[1]));
         }
         break;
     default:
-        dprintf(client_fd, "[MemoraDB: WARN] Unknown command '%s'\n", tokens[0]);
+        reply_add_format(reply, "[MemoraDB: WARN] Unknown command '%s'\n", tokens[0]);
         break;
     }
 }
@@ -5,8 +5,8 @@
  * 
  * File                      : src/parser/parser.h
  * Module                    : RESP Protocol Parser
- * Last Updating Author      : youssefbouraoui1
- * Last Update               : 02/08/2026
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
  * Version                   : 1.0.0
  * 
  * Description:
@@ -25,6 +25,43 @@
 #include <stdlib.h>
 #include <strings.h>
 #include <unistd.h>
+#include "../server/reply.h"
+
+/* ==================== Request Parser Limits ==================== */
+#define REQUEST_MAX_INLINE 65536              //- Longest accepted *<n> / $<n> header line -//
+#define REQUEST_MAX_BULK   (512L * 1024 * 1024)
+#define REQUEST_ARGV_PREALLOC 1024            //- Argument slots reserved up front, the rest as they arrive -//
+#define RESP_CRLF_LEN      2
+
+/**
+ * Result of feeding buffered bytes to a RequestParser
+ */
+typedef enum {
+    REQUEST_PARSE_ERROR = -1,
+    REQUEST_PARSE_INCOMPLETE = 0,
+    REQUEST_PARSE_OK = 1
+} request_parse_t;
+
+/**
+ * Resumable RESP request parser, one per connection.
+ *
+ * The parser works on a buffer that starts at the first byte of the request
+ * being parsed. When the request is not complete yet it remembers how far it
+ * got (as offsets, so the caller may grow or move the buffer) and resumes
+ * from there once more bytes have been appended.
+ */
+typedef struct {
+    int max_args;          //- Requests with more arguments are rejected -//
+    int multibulk_len;     //- Arguments announced by *<n>, 0 while the header is pending -//
+    long bulk_len;         //- Length announced by the pending $<n>, -1 while the header is pending -//
+    size_t pos;            //- Resume offset into the request -//
+    int argc;              //- Arguments fully received so far -//
+    int argv_cap;
+    size_t *argv_off;
+    size_t *argv_len;
+    char **argv;           //- Filled once the request is complete -//
+    const char *error;     //- Reason of the last REQUEST_PARSE_ERROR -//
+} RequestParser;
 
 /**
  * Command types supported by MemoraDB
@@ -34,24 +71,90 @@ enum command_t {
     CMD_ECHO,
     CMD_SET,
     CMD_GET,
+    CMD_MGET,
+    CMD_MSET,
+    CMD_MSETNX,
+    CMD_INCR,
+    CMD_DECR,
+    CMD_INCRBY,
+    CMD_DECRBY,
+    CMD_INCRBYFLOAT,
     CMD_DEL,
     CMD_RPUSH,
     CMD_LPUSH,
     CMD_LRANGE,
     CMD_LLEN,
     CMD_LPOP,
+    CMD_RPOP,
+    CMD_LINDEX,
+    CMD_LSET,
+    CMD_LINSERT,
+    CMD_LTRIM,
+    CMD_LREM,
+    CMD_LPOS,
     CMD_BLPOP,
+    CMD_BRPOP,
+    CMD_LMOVE,
+    CMD_BLMOVE,
+    CMD_LMPOP,
+    CMD_BLMPOP,
     CMD_TYPE,
+    CMD_INFO,
+    CMD_EXPIRE,
+    CMD_PEXPIRE,
+    CMD_EXPIREAT,
+    CMD_PEXPIREAT,
+    CMD_TTL,
+    CMD_PTTL,
+    CMD_PERSIST,
     CMD_UNKNOWN
 };
 
+/**
+ * Initialise a request parser.
+ * @param parser Parser to initialise
+ * @param max_args Upper bound on arguments per request
+ */
+void request_parser_init(RequestParser *parser, int max_args);
+
+/**
+ * Release the memory owned by a request parser.
+ * @param parser Parser to free
+ */
+void request_parser_free(RequestParser *parser);
+
+/**
+ * Forget the request in progress, ready for the next one.
+ * @param parser Parser to reset
+ */
+void request_parser_reset(RequestParser *parser);
+
+/**
+ * Continue parsing the request that starts at buf.
+ *
+ * On REQUEST_PARSE_OK, parser->argv[0..argc) point into buf, each argument is
+ * NUL-terminated in place (and may hold NULs of its own: parser->argv_len
+ * has the lengths), and *consumed is the size of the whole request.
+ * The caller executes it, then calls request_parser_reset() and parses again
+ * from buf + *consumed. On REQUEST_PARSE_INCOMPLETE the caller keeps the
+ * bytes and calls again with the same request start once more data arrived.
+ *
+ * @param parser Parser state
+ * @param buf First byte of the request
+ * @param len Bytes available from buf
+ * @param consumed Set to the request size on success
+ * @return REQUEST_PARSE_OK, REQUEST_PARSE_INCOMPLETE or REQUEST_PARSE_ERROR
+ */
+request_parse_t request_parser_parse(RequestParser *parser, char *buf, size_t len, size_t *consumed);
+
 /**
  * Parse RESP protocol command from input buffer
  * 
  * @param input Input buffer containing RESP formatted command
  * @param tokens Array to store parsed tokens
  * @param max_tokens Maximum number of tokens to parse
- * @return Number of tokens parsed, or -1 on error
+ * @return Number of tokens parsed, or -1 on error, incomplete input or
+ *         more than max_tokens arguments
  */
 int parse_command(char *input, char *tokens[], int max_tokens);
 
@@ -64,11 +167,49 @@ int parse_command(char *input, char *tokens[], int max_tokens);
 enum command_t identify_command(const char *cmd);
 
 /**
- * Dispatch and execute command based on tokens
- * @param client_fd Client socket file descriptor
+ * Locate the key arguments of a command, for routing it to the loop that
+ * owns them.
+ * @param tokens Array of parsed command tokens
+ * @param token_count Number of tokens in array
+ * @param first Set to the index of the first key
+ * @param last Set to the index of the last key
+ * @param step Set to the distance between keys (2 for MSET's key/value pairs)
+ * @return 1 if the command has keys, 0 otherwise
+ */
+int command_key_range(char *tokens[], int token_count, int *first, int *last, int *step);
+
+/**
+ * Dispatch and execute command based on tokens. Tokens are binary safe:
+ * lens[] gives their lengths, and each is also NUL-terminated so that
+ * option names and numbers can be read as C strings.
+ * @param reply Output buffer receiving the RESP reply
+ * @param tokens Array of parsed command tokens
+ * @param lens Length of each token
+ * @param token_count Number of tokens in array
+ */
+void dispatch_command(ReplyBuffer *reply, char *tokens[], size_t lens[], int token_count);
+
+struct Connection;
+
+/**
+ * Whether a command may block its client (BLPOP).
+ * @param tokens Array of parsed command tokens
+ * @param token_count Number of tokens in array
+ * @return 1 if it may block, 0 otherwise
+ */
+int command_may_block(char *tokens[], int token_count);
+
+/**
+ * Dispatch a command on behalf of a connection. A blocking command that
+ * cannot be served right away writes no reply and sets conn->blocked
+ * instead (see blocking.h). With conn NULL, as in dispatch_command(),
+ * blocking commands behave like their non-blocking form.
+ * @param conn Client issuing the command, or NULL
+ * @param reply Output buffer receiving the RESP reply
  * @param tokens Array of parsed command tokens
+ * @param lens Length of each token
  * @param token_count Number of tokens in array
  */
-void dispatch_command(int client_fd, char *tokens[], int token_count);
+void dispatch_client_command(struct Connection *conn, ReplyBuffer *reply, char *tokens[], size_t lens[], int token_count);
 
 #endif // PARSER_H
@@ -0,0 +1,646 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/server/blocking.c
+ * Module                    : Blocked Clients
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Registry of clients blocked on list keys (BLPOP, BRPOP, BLMOVE,
+ *  BLMPOP). Each key with waiters has a FIFO queue, and a client waiting
+ *  on several keys sits in all of their queues at once; a push hands its
+ *  elements straight to the oldest waiters, and deadlines are enforced by
+ *  the client's own event loop timer. Blocked clients cost no thread and
+ *  no polling.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include "blocking.h"
+#include "connection.h"
+#include "config.h"
+#include "router.h"
+#include "../utils/hashTable.h"
+#include "../utils/list.h"
+#include "../utils/log.h"
+#include <sched.h>
+#include <stddef.h>
+
+/*
+ * Lock order: bucket locks are taken before the keyspace shard locks (the
+ * operations under them), never the other way round, and several bucket
+ * locks only in ascending index order. Pushes release the shard lock
+ * before signalling, and a push holds one bucket lock at a time.
+ */
+
+/* ==================== Registry Structures ==================== */
+
+//-- Links of the clients waiting on one key, oldest at the head --//
+typedef struct WaitQueue {
+    char *key;
+    size_t key_len;
+    WaitLink *head;
+    WaitLink *tail;
+    struct WaitQueue *next;    //- Next key in the same bucket -//
+} WaitQueue;
+
+typedef struct {
+    pthread_mutex_t lock;
+    unsigned long waiters;     //- Links queued here; pushes read it without the lock -//
+    WaitQueue *queues;
+} WaitBucket;
+
+//-- Destinations of BLMOVEs served by one push, signalled after it --//
+typedef struct {
+    char **keys;
+    size_t *lens;
+    int count;
+    int capacity;
+} SignalList;
+
+//-- Elements popped for a blocked client, copied out of the list --//
+typedef struct {
+    char **elements;
+    size_t *lens;
+    int count;
+} ElementCollector;
+
+#define BLOCKING_STACK_KEYS 16  //- Keys whose buckets are sorted without allocating -//
+
+static WaitBucket registry[BLOCKING_BUCKETS];
+static pthread_once_t registry_once = PTHREAD_ONCE_INIT;
+static size_t blocked_clients = 0;
+
+static void registry_init(void) {
+    for (int i = 0; i < BLOCKING_BUCKETS; i++) {
+        pthread_mutex_init(&registry[i].lock, NULL);
+    }
+}
+
+static int bucket_index(const char *key, size_t key_len) {
+    pthread_once(&registry_once, registry_init);
+    return (int)(hash(key, key_len) & (BLOCKING_BUCKETS - 1));
+}
+
+static WaitBucket *bucket_for(const char *key, size_t key_len) {
+    return &registry[bucket_index(key, key_len)];
+}
+
+static WaitQueue **find_queue_ref(WaitBucket *bucket, const char *key, size_t key_len) {
+    WaitQueue **ref = &bucket->queues;
+    while (*ref && ((*ref)->key_len != key_len || memcmp((*ref)->key, key, key_len) != 0)) {
+        ref = &(*ref)->next;
+    }
+    return ref;
+}
+
+static void free_elements(char **elements, size_t *lens, int count) {
+    for (int i = 0; i < count; i++) free(elements[i]);
+    free(elements);
+    free(lens);
+}
+
+/* ==================== Wait Queues ==================== */
+
+/**
+ * Take a link out of its queue, dropping the queue once empty.
+ * The bucket lock must be held.
+ */
+static void link_remove(WaitBucket *bucket, WaitLink *link) {
+    WaitQueue *queue = link->queue;
+    if (link->prev) link->prev->next = link->next; else queue->head = link->next;
+    if (link->next) link->next->prev = link->prev; else queue->tail = link->prev;
+    link->next = NULL;
+    link->prev = NULL;
+    link->queue = NULL;
+    __atomic_sub_fetch(&bucket->waiters, 1, __ATOMIC_SEQ_CST);
+
+    if (!queue->head) {
+        WaitQueue **ref = &bucket->queues;
+        while (*ref != queue) ref = &(*ref)->next;
+        *ref = queue->next;
+        free(queue->key);
+        free(queue);
+    }
+}
+
+/**
+ * Append a link to the queue of key, creating the queue on first use.
+ * The bucket lock must be held.
+ */
+static int link_append(WaitBucket *bucket, const char *key, size_t key_len, WaitLink *link) {
+    WaitQueue **ref = find_queue_ref(bucket, key, key_len);
+    WaitQueue *queue = *ref;
+    if (!queue) {
+        queue = calloc(1, sizeof(WaitQueue));
+        if (!queue || !(queue->key = malloc(key_len + 1))) {
+            free(queue);
+            return -1;
+        }
+        memcpy(queue->key, key, key_len);
+        queue->key[key_len] = '\0';
+        queue->key_len = key_len;
+        *ref = queue;
+    }
+
+    link->prev = queue->tail;
+    link->next = NULL;
+    if (queue->tail) queue->tail->next = link; else queue->head = link;
+    queue->tail = link;
+    link->queue = queue;
+    return 0;
+}
+
+/**
+ * Sorted, distinct bucket indexes of keys: the order their locks are taken.
+ * @return Number of distinct buckets written to out
+ */
+static int sorted_buckets(char *keys[], const size_t key_lens[], int nkeys, int *out) {
+    int count = 0;
+    for (int i = 0; i < nkeys; i++) {
+        int index = bucket_index(keys[i], key_lens[i]);
+        int pos = count;
+        while (pos > 0 && out[pos - 1] > index) pos--;
+        if (pos > 0 && out[pos - 1] == index) continue;
+        memmove(&out[pos + 1], &out[pos], (size_t)(count - pos) * sizeof(int));
+        out[pos] = index;
+        count++;
+    }
+    return count;
+}
+
+/* ==================== Blocked Client Lifecycle ==================== */
+
+/**
+ * Copy len bytes and a NUL to dst.
+ * @return The byte after the NUL
+ */
+static char *copy_key(char *dst, const char *key, size_t len) {
+    memcpy(dst, key, len);
+    dst[len] = '\0';
+    return dst + len + 1;
+}
+
+/**
+ * Allocate a client waiting on keys, with its links, keys and op in one block.
+ */
+static BlockedClient *blocked_create(char *keys[], const size_t key_lens[], int nkeys, const BlockingPop *op) {
+    size_t size = sizeof(BlockedClient) + (size_t)nkeys * (sizeof(WaitLink) + sizeof(char *) + sizeof(size_t));
+    for (int i = 0; i < nkeys; i++) size += key_lens[i] + 1;
+    if (op->dst) size += op->dst_len + 1;
+
+    BlockedClient *bc = calloc(1, size);
+    if (!bc) return NULL;
+
+    bc->nkeys = nkeys;
+    bc->keys = (char **)&bc->links[nkeys];
+    bc->key_lens = (size_t *)&bc->keys[nkeys];
+    char *strings = (char *)&bc->key_lens[nkeys];
+    for (int i = 0; i < nkeys; i++) {
+        bc->links[i].client = bc;
+        bc->keys[i] = strings;
+        bc->key_lens[i] = key_lens[i];
+        strings = copy_key(strings, keys[i], key_lens[i]);
+    }
+
+    bc->op = *op;
+    if (op->dst) {
+        bc->op.dst = strings;
+        copy_key(strings, op->dst, op->dst_len);
+    }
+    return bc;
+}
+
+/**
+ * Remove the links still queued, one bucket at a time. Once a client is
+ * served or cancelled nothing links it anew, and pushes meeting a stale
+ * link only drop it, so no lock order is needed here.
+ */
+static void blocked_unlink_all(BlockedClient *bc) {
+    for (int i = 0; i < bc->nkeys; i++) {
+        WaitBucket *bucket = bucket_for(bc->keys[i], bc->key_lens[i]);
+        pthread_mutex_lock(&bucket->lock);
+        if (bc->links[i].queue) link_remove(bucket, &bc->links[i]);
+        pthread_mutex_unlock(&bucket->lock);
+    }
+}
+
+static void blocked_free(BlockedClient *bc) {
+    blocked_unlink_all(bc);
+    if (bc->count > 0) free_elements(bc->elements, bc->element_lens, bc->count);
+    free(bc);
+}
+
+/**
+ * Take a client out of the registry unless a push got to it first.
+ * A push holding the claim finishes quickly (one list operation), so the
+ * claim is waited out rather than slept on.
+ * @return 1 if it was still waiting (no delivery will come), 0 if a push
+ *         already served it and its delivery task is on the way
+ */
+static int blocking_cancel(BlockedClient *bc) {
+    for (;;) {
+        int state = __atomic_load_n(&bc->state, __ATOMIC_ACQUIRE);
+        if (state == BLOCKED_CLAIMING) {
+            sched_yield();
+            continue;
+        }
+        if (state != BLOCKED_WAITING) return 0;
+
+        if (__atomic_compare_exchange_n(&bc->state, &state, BLOCKED_CANCELLED, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            __atomic_sub_fetch(&blocked_clients, 1, __ATOMIC_RELAXED);
+            blocked_unlink_all(bc);
+            return 1;
+        }
+    }
+}
+
+/* ==================== Running Operations ==================== */
+
+static void collect_begin(void *ctx, size_t count) {
+    ElementCollector *collector = ctx;
+    if (count == 0) return;
+    collector->elements = malloc(count * sizeof(char *));
+    collector->lens = malloc(count * sizeof(size_t));
+}
+
+static void collect_element(void *ctx, const char *value, size_t len) {
+    ElementCollector *collector = ctx;
+    if (!value || !collector->elements || !collector->lens) return;
+
+    char *copy = malloc(len + 1);
+    if (!copy) return;
+    memcpy(copy, value, len);
+    copy[len] = '\0';
+    collector->elements[collector->count] = copy;
+    collector->lens[collector->count++] = len;
+}
+
+/**
+ * Run op against the list at key.
+ * @param elements Set to the resulting elements, nearest the popped end first
+ * @param lens Set to their lengths
+ * @return Number of elements, 0 if the list is empty or absent, -1 if a
+ *         key involved holds another type
+ */
+static int op_execute(const BlockingPop *op, const char *key, size_t key_len,
+                      char ***elements, size_t **lens) {
+    *elements = NULL;
+    *lens = NULL;
+    if (op->type == BLOCK_MOVE) {
+        char **slot = malloc(sizeof(char *));
+        size_t *slot_len = malloc(sizeof(size_t));
+        int moved = slot && slot_len ? move_list_value(key, key_len, op->dst, op->dst_len, op->where,
+                                                       op->dst_where, slot, slot_len) : 0;
+        if (moved <= 0) {
+            free(slot);
+            free(slot_len);
+            return moved;
+        }
+        *elements = slot;
+        *lens = slot_len;
+        return 1;
+    }
+
+    ElementCollector collector = { NULL, NULL, 0 };
+    ListSink sink = { collect_begin, collect_element, &collector };
+    long long popped = pop_list_into(key, key_len, op->where, op->type == BLOCK_MPOP ? (size_t)op->count : 1, &sink);
+    if (popped < 0 || collector.count == 0) {
+        free(collector.elements);
+        free(collector.lens);
+        return popped < 0 ? -1 : 0;
+    }
+    *elements = collector.elements;
+    *lens = collector.lens;
+    return collector.count;
+}
+
+/**
+ * Write the reply of op: its result, a null when nothing was popped, or
+ * WRONGTYPE.
+ */
+static void add_op_reply(ReplyBuffer *reply, const BlockingPop *op, const char *key, size_t key_len,
+                         char **elements, const size_t *lens, int count) {
+    if (count < 0) {
+        reply_add_format(reply, "[MemoraDB: ERROR] WRONGTYPE Operation against a key holding the wrong kind of value\r\n");
+        return;
+    }
+    if (count == 0) {
+        reply_add_null(reply);
+        return;
+    }
+    if (op->type == BLOCK_MOVE) {
+        reply_add_bulk(reply, elements[0], lens[0]);
+        return;
+    }
+
+    reply_add_array_len(reply, 2);
+    reply_add_bulk(reply, key, key_len);
+    if (op->type == BLOCK_MPOP) reply_add_array_len(reply, count);
+    for (int i = 0; i < count; i++) {
+        reply_add_bulk(reply, elements[i], lens[i]);
+    }
+}
+
+static void signal_list_add(SignalList *list, const char *key, size_t key_len) {
+    //-- Nobody waits there: no copy, no signal --//
+    if (__atomic_load_n(&bucket_for(key, key_len)->waiters, __ATOMIC_SEQ_CST) == 0) return;
+
+    if (list->count == list->capacity) {
+        int capacity = list->capacity ? list->capacity * 2 : 4;
+        char **keys = realloc(list->keys, (size_t)capacity * sizeof(char *));
+        if (!keys) return;
+        list->keys = keys;
+        size_t *lens = realloc(list->lens, (size_t)capacity * sizeof(size_t));
+        if (!lens) return;
+        list->lens = lens;
+        list->capacity = capacity;
+    }
+
+    char *copy = malloc(key_len + 1);
+    if (!copy) return;
+    copy_key(copy, key, key_len);
+    list->keys[list->count] = copy;
+    list->lens[list->count++] = key_len;
+}
+
+/* ==================== Giving Elements Back ==================== */
+
+static void give_back_run(EventLoop *loop, LoopTask *task) {
+    (void)loop;
+    BlockedClient *bc = (BlockedClient *)task;
+
+    //-- Popped nearest first: pushing them back in reverse restores the list --//
+    for (int i = 0, j = bc->count - 1; i < j; i++, j--) {
+        char *tmp = bc->elements[i];
+        bc->elements[i] = bc->elements[j];
+        bc->elements[j] = tmp;
+        size_t tmp_len = bc->element_lens[i];
+        bc->element_lens[i] = bc->element_lens[j];
+        bc->element_lens[j] = tmp_len;
+    }
+    if (push_list_values(bc->served_key, bc->served_key_len, bc->elements, bc->element_lens,
+                         bc->count, bc->op.where == LIST_HEAD) >= 0) {
+        blocking_signal_key(bc->served_key, bc->served_key_len);
+    } else {
+        log_message(LOG_WARN, "Dropped %d element(s) of '%s' popped for a closed client",
+                    bc->count, bc->served_key);
+    }
+    blocked_free(bc);
+}
+
+/**
+ * The client left after a push popped elements for it: put them back at
+ * the end of the list they came from, on the loop owning the key when
+ * commands are routed. A move already landed in its destination and stays
+ * there, as if the client had read the reply. Frees bc.
+ */
+static void blocking_give_back(BlockedClient *bc) {
+    if (bc->count <= 0 || bc->op.type == BLOCK_MOVE) {
+        blocked_free(bc);
+        return;
+    }
+
+    bc->task.run = give_back_run;
+    if (router_enabled()) {
+        int owner = router_shard_owner(keyspace_shard_of(bc->served_key, bc->served_key_len));
+        if (owner != bc->loop->id) {
+            event_loop_post(event_loop_get(owner), &bc->task);
+            return;
+        }
+    }
+    give_back_run(bc->loop, &bc->task);
+}
+
+/* ==================== Answering Blocked Clients ==================== */
+
+/**
+ * Write the reply of the blocked command: its result when served, a null
+ * on timeout. Clears conn->blocked and frees it.
+ */
+static void blocking_reply(Connection *conn) {
+    BlockedClient *bc = conn->blocked;
+    minheap_remove(&conn->loop->blocked_timeouts, &bc->timeout_node);
+    add_op_reply(&conn->reply, &bc->op, bc->served_key, bc->served_key_len, bc->elements, bc->element_lens, bc->count);
+    conn->blocked = NULL;
+    blocked_free(bc);
+}
+
+/**
+ * Runs on the connection's loop after a push served the client.
+ */
+static void blocking_deliver(EventLoop *loop, LoopTask *task) {
+    (void)loop;
+    BlockedClient *bc = (BlockedClient *)task;
+    bc->arrived = 1;
+
+    Connection *conn = bc->conn;
+    if (!conn) {
+        blocking_give_back(bc);
+        return;
+    }
+
+    //-- Forwarded batch not back yet: connection_resume() adopts and answers in order --//
+    if (conn->forward_pending) return;
+
+    blocking_reply(conn);
+    connection_resume(conn);
+}
+
+/**
+ * Serve the clients waiting on key, oldest first, until one finds the list
+ * empty. Destinations of the moves served are added to signals.
+ */
+static void serve_key(const char *key, size_t key_len, SignalList *signals) {
+    WaitBucket *bucket = bucket_for(key, key_len);
+    if (__atomic_load_n(&bucket->waiters, __ATOMIC_SEQ_CST) == 0) return;
+
+    pthread_mutex_lock(&bucket->lock);
+    for (;;) {
+        WaitQueue *queue = *find_queue_ref(bucket, key, key_len);
+        if (!queue) break;
+
+        WaitLink *link = queue->head;
+        BlockedClient *bc = link->client;
+        int state = BLOCKED_WAITING;
+        if (!__atomic_compare_exchange_n(&bc->state, &state, BLOCKED_CLAIMING, 0,
+                                         __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            //-- Served through another key, or cancelled: only the link is left --//
+            link_remove(bucket, link);
+            continue;
+        }
+
+        char **elements;
+        size_t *lens;
+        int count = op_execute(&bc->op, key, key_len, &elements, &lens);
+        if (count == 0) {
+            __atomic_store_n(&bc->state, BLOCKED_WAITING, __ATOMIC_RELEASE);
+            break;
+        }
+
+        link_remove(bucket, link);
+        bc->served_key = bc->keys[link - bc->links];
+        bc->served_key_len = bc->key_lens[link - bc->links];
+        bc->elements = elements;
+        bc->element_lens = lens;
+        bc->count = count;
+        if (count > 0 && bc->op.type == BLOCK_MOVE) signal_list_add(signals, bc->op.dst, bc->op.dst_len);
+        __atomic_sub_fetch(&blocked_clients, 1, __ATOMIC_RELAXED);
+
+        //-- Once posted, bc belongs to its loop --//
+        __atomic_store_n(&bc->state, BLOCKED_SERVED, __ATOMIC_RELEASE);
+        event_loop_post(bc->loop, &bc->task);
+    }
+    pthread_mutex_unlock(&bucket->lock);
+}
+
+/* ==================== Public API ==================== */
+
+int blocking_pop(Connection *conn, char *keys[], const size_t key_lens[], int nkeys, const BlockingPop *op,
+                 long long deadline, ReplyBuffer *reply) {
+    char **elements = NULL;
+    size_t *lens = NULL;
+    int count = 0, served = 0;
+
+    if (!conn) {
+        for (; served < nkeys && count == 0; served++) {
+            count = op_execute(op, keys[served], key_lens[served], &elements, &lens);
+        }
+        add_op_reply(reply, op, keys[served - 1], key_lens[served - 1], elements, lens, count);
+        if (count > 0) free_elements(elements, lens, count);
+        if (count > 0 && op->type == BLOCK_MOVE) blocking_signal_key(op->dst, op->dst_len);
+        return 1;
+    }
+
+    int stack_buckets[BLOCKING_STACK_KEYS];
+    int *buckets = nkeys <= BLOCKING_STACK_KEYS ? stack_buckets : malloc((size_t)nkeys * sizeof(int));
+    if (!buckets) {
+        log_message(LOG_ERROR, "Failed to block client on %d keys", nkeys);
+        reply_add_null(reply);
+        return 1;
+    }
+    int nbuckets = sorted_buckets(keys, key_lens, nkeys, buckets);
+    for (int i = 0; i < nbuckets; i++) pthread_mutex_lock(&registry[buckets[i]].lock);
+
+    //-- Counted before the last attempts: a push that reads 0 finished before them, so they see it --//
+    for (int i = 0; i < nkeys; i++) {
+        __atomic_add_fetch(&bucket_for(keys[i], key_lens[i])->waiters, 1, __ATOMIC_SEQ_CST);
+    }
+    for (; served < nkeys && count == 0; served++) {
+        count = op_execute(op, keys[served], key_lens[served], &elements, &lens);
+    }
+
+    int linked = 0;
+    BlockedClient *bc = NULL;
+    if (count == 0 && (bc = blocked_create(keys, key_lens, nkeys, op))) {
+        for (; linked < nkeys; linked++) {
+            WaitBucket *bucket = bucket_for(keys[linked], key_lens[linked]);
+            if (link_append(bucket, keys[linked], key_lens[linked], &bc->links[linked]) != 0) break;
+        }
+    }
+
+    if (bc && linked == nkeys) {
+        bc->task.run = blocking_deliver;
+        bc->conn = conn;
+        bc->loop = conn->loop;
+        bc->deadline = deadline;
+        heap_node_init(&bc->timeout_node);
+        __atomic_add_fetch(&blocked_clients, 1, __ATOMIC_RELAXED);
+        //-- Read by the connection's loop only once this command's reply is back --//
+        conn->blocked = bc;
+    } else {
+        //-- Served right away, or could not block: undo the counts of keys not linked --//
+        for (int i = 0; i < linked; i++) link_remove(bucket_for(keys[i], key_lens[i]), &bc->links[i]);
+        for (int i = linked; i < nkeys; i++) {
+            __atomic_sub_fetch(&bucket_for(keys[i], key_lens[i])->waiters, 1, __ATOMIC_SEQ_CST);
+        }
+    }
+
+    for (int i = nbuckets - 1; i >= 0; i--) pthread_mutex_unlock(&registry[buckets[i]].lock);
+    if (buckets != stack_buckets) free(buckets);
+
+    if (bc && linked == nkeys) return 0;
+    if (count == 0) {
+        free(bc);
+        log_message(LOG_ERROR, "Failed to block client on '%s'", keys[0]);
+    }
+    add_op_reply(reply, op, keys[served - 1], key_lens[served - 1], elements, lens, count);
+    if (count > 0) free_elements(elements, lens, count);
+    if (count > 0 && op->type == BLOCK_MOVE) blocking_signal_key(op->dst, op->dst_len);
+    return 1;
+}
+
+void blocking_signal_key(const char *key, size_t key_len) {
+    SignalList signals = { NULL, NULL, 0, 0 };
+    serve_key(key, key_len, &signals);
+
+    //-- Chained moves are served here rather than recursively, one bucket lock at a time --//
+    while (signals.count > 0) {
+        signals.count--;
+        char *next = signals.keys[signals.count];
+        serve_key(next, signals.lens[signals.count], &signals);
+        free(next);
+    }
+    free(signals.keys);
+    free(signals.lens);
+}
+
+int blocking_adopt(Connection *conn) {
+    BlockedClient *bc = conn->blocked;
+    if (bc->arrived) {
+        blocking_reply(conn);
+        return 0;
+    }
+
+    if (bc->deadline &&
+        minheap_schedule(&conn->loop->blocked_timeouts, &bc->timeout_node, bc->deadline) != 0) {
+        log_message(LOG_ERROR, "Failed to arm the timeout of a client blocked on '%s'", bc->keys[0]);
+    }
+    return 1;
+}
+
+void blocking_handle_timeouts(EventLoop *loop, long long now) {
+    HeapNode *node;
+    while ((node = minheap_peek(&loop->blocked_timeouts)) && node->key <= now) {
+        minheap_pop(&loop->blocked_timeouts);
+        BlockedClient *bc = (BlockedClient *)((char *)node - offsetof(BlockedClient, timeout_node));
+
+        //-- A push got there first: its delivery is already on the way --//
+        if (!blocking_cancel(bc)) continue;
+
+        Connection *conn = bc->conn;
+        blocking_reply(conn);
+        connection_resume(conn);
+    }
+}
+
+long long blocking_next_timeout(EventLoop *loop, long long now, long long max) {
+    HeapNode *first = minheap_peek(&loop->blocked_timeouts);
+    if (!first) return max;
+    long long wait = first->key - now;
+    return wait < max ? wait : max;
+}
+
+void blocking_abandon(Connection *conn) {
+    BlockedClient *bc = conn->blocked;
+    conn->blocked = NULL;
+    minheap_remove(&conn->loop->blocked_timeouts, &bc->timeout_node);
+
+    if (blocking_cancel(bc)) {
+        blocked_free(bc);
+    } else if (bc->arrived) {
+        blocking_give_back(bc);
+    } else {
+        bc->conn = NULL;   //- The delivery in flight gives the elements back -//
+    }
+}
+
+size_t blocking_client_count(void) {
+    return __atomic_load_n(&blocked_clients, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,166 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/server/blocking.h
+ * Module                    : Blocked Clients
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Registry of clients blocked on list keys (BLPOP, BRPOP, BLMOVE,
+ *  BLMPOP). Each key with waiters has a FIFO queue, and a client waiting
+ *  on several keys sits in all of their queues at once; a push hands its
+ *  elements straight to the oldest waiters, and deadlines are enforced by
+ *  the client's own event loop timer. Blocked clients cost no thread and
+ *  no polling.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#ifndef MEMORADB_BLOCKING_H
+#define MEMORADB_BLOCKING_H
+
+#include "event_loop.h"
+#include "reply.h"
+#include "../utils/minheap.h"
+
+/* ==================== Registry Sizing ==================== */
+#define BLOCKING_BUCKETS 1024   //- Independently locked key buckets, a power of two -//
+
+struct Connection;
+
+/* ==================== Blocking Operations ==================== */
+typedef enum {
+    BLOCK_POP,       //- BLPOP/BRPOP: replies [key, element] -//
+    BLOCK_MPOP,      //- LMPOP/BLMPOP: replies [key, [elements...]] -//
+    BLOCK_MOVE       //- LMOVE/BLMOVE: pushes onto dst, replies element -//
+} block_op_t;
+
+//-- What to do with the first non-empty list among the keys --//
+typedef struct {
+    block_op_t type;
+    int where;             //- End popped from, LIST_HEAD or LIST_TAIL -//
+    int count;             //- Elements per pop, BLOCK_MPOP only -//
+    const char *dst;       //- Destination list, BLOCK_MOVE only -//
+    size_t dst_len;
+    int dst_where;         //- End of dst pushed onto, BLOCK_MOVE only -//
+} BlockingPop;
+
+/* ==================== Blocked Client ==================== */
+enum {
+    BLOCKED_WAITING,       //- In the wait queues of its keys -//
+    BLOCKED_CLAIMING,      //- A push is trying to serve it -//
+    BLOCKED_SERVED,        //- A push served it; delivery is on the way -//
+    BLOCKED_CANCELLED      //- Timed out or disconnected before any push -//
+};
+
+//-- Membership of a blocked client in the wait queue of one of its keys --//
+typedef struct WaitLink {
+    struct BlockedClient *client;
+    struct WaitQueue *queue;          //- NULL once unlinked; guarded by the bucket lock -//
+    struct WaitLink *next;
+    struct WaitLink *prev;
+} WaitLink;
+
+/*
+ * Created by the loop that ran the blocking command, which may differ from
+ * the connection's loop in shard-per-core mode; owned and freed by the
+ * connection's loop afterwards. While WAITING it has one link per key. A
+ * push claims it (WAITING -> CLAIMING) under its key's bucket lock, runs
+ * the operation, stores the result and posts `task` to the connection's
+ * loop; a timeout or disconnect can only cancel it while still WAITING.
+ * Links left in the other keys' queues are skipped by pushes and removed
+ * before the client is freed.
+ */
+typedef struct BlockedClient {
+    LoopTask task;                    //- First member: delivery to the connection's loop -//
+    struct Connection *conn;          //- NULL once the connection closed -//
+    EventLoop *loop;                  //- Loop owning conn -//
+    int state;                        //- BLOCKED_*, atomic -//
+    BlockingPop op;                   //- op.dst points into this allocation -//
+    long long deadline;               //- expiry_now() deadline, 0 = wait forever -//
+    HeapNode timeout_node;            //- In loop->blocked_timeouts once adopted -//
+    int arrived;                      //- Delivery task ran; connection's loop only -//
+    const char *served_key;           //- Key the result came from -//
+    size_t served_key_len;
+    char **elements;                  //- Result handed over by a push -//
+    size_t *element_lens;
+    int count;                        //- Elements in the result, -1 for WRONGTYPE -//
+    int nkeys;
+    char **keys;                      //- Point into this allocation -//
+    size_t *key_lens;
+    WaitLink links[];                 //- links[i] waits on keys[i] -//
+} BlockedClient;
+
+/**
+ * Run op on the first non-empty list among keys, or block the connection
+ * on all of them.
+ *
+ * The attempts and the registration happen under the keys' bucket locks,
+ * so a push racing with us either is seen by an attempt or finds us
+ * queued. On block, conn->blocked is set and no reply is written; the
+ * connection's loop calls blocking_adopt() once the command has finished.
+ * Otherwise the reply (result, null, or WRONGTYPE) is written to reply.
+ *
+ * @param conn Client issuing the command, NULL if it cannot block
+ * @param keys The list keys, in priority order
+ * @param key_lens Length of each key
+ * @param nkeys Number of keys (>= 1)
+ * @param op The operation to run
+ * @param deadline expiry_now() deadline, 0 to wait forever
+ * @param reply Buffer receiving the immediate reply
+ * @return 1 if a reply was written, 0 if the client blocked
+ */
+int blocking_pop(struct Connection *conn, char *keys[], const size_t key_lens[], int nkeys, const BlockingPop *op,
+                 long long deadline, ReplyBuffer *reply);
+
+/**
+ * Serve the clients blocked on key, oldest first, while the list has
+ * elements. Called after every push, from the thread that pushed.
+ * @param key The list key that grew
+ * @param key_len Length of key
+ */
+void blocking_signal_key(const char *key, size_t key_len);
+
+/**
+ * On the connection's loop, once the command that blocked has completed
+ * (locally, or when its forwarded batch is back): arm the timeout, or
+ * answer right away if a push already served the client meanwhile.
+ * @param conn Connection with conn->blocked set
+ * @return 1 if still blocked, 0 if the reply was written and conn->blocked cleared
+ */
+int blocking_adopt(struct Connection *conn);
+
+/**
+ * Answer every client of the loop whose deadline passed with a null reply.
+ * @param loop The event loop
+ * @param now Current expiry_now() time
+ */
+void blocking_handle_timeouts(EventLoop *loop, long long now);
+
+/**
+ * Milliseconds until the loop's earliest blocked client times out.
+ * @param loop The event loop
+ * @param now Current expiry_now() time
+ * @param max Value returned when nothing times out sooner
+ * @return Time to wait in ms, at most max
+ */
+long long blocking_next_timeout(EventLoop *loop, long long now, long long max);
+
+/**
+ * Drop a closing connection's wait. Elements a push already popped for it
+ * are put back where they came from.
+ * @param conn Connection being closed, with conn->blocked set
+ */
+void blocking_abandon(struct Connection *conn);
+
+/**
+ * @return Number of clients currently waiting in the registry
+ */
+size_t blocking_client_count(void);
+
+#endif // MEMORADB_BLOCKING_H
@@ -0,0 +1,123 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/server/config.c
+ * Module                    : Server Configuration
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Runtime configuration of the MemoraDB server, loaded once at
+ *  startup from MEMORADB_* environment variables.
+ *
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include "config.h"
+#include "server.h"
+#include "../utils/list.h"
+#include "../utils/log.h"
+
+ServerConfig server_config = {
+    .port = DEFAULT_PORT,
+    .bind_address = DEFAULT_BIND_ADDRESS,
+    .tcp_backlog = CONNECTION_BACKLOG,
+    .reuseport = 0,
+    .cpu_affinity = 0,
+    .unix_socket = NULL,
+    .unix_socket_perm = DEFAULT_UNIX_SOCKET_PERM,
+    .workers = 0,
+    .thread_stack_kb = DEFAULT_THREAD_STACK_KB,
+    .maxclients = DEFAULT_MAXCLIENTS,
+    .timeout = 0,
+    .tcp_keepalive = DEFAULT_TCP_KEEPALIVE,
+    .output_limit_mb = DEFAULT_OUTPUT_LIMIT_MB,
+    .querybuf_limit_mb = DEFAULT_QUERYBUF_LIMIT_MB,
+    .shard_per_core = 0,
+    .io_threads = 0,
+    .list_node_bytes = LIST_NODE_BYTES_DEFAULT,
+    .list_compress_depth = LIST_COMPRESS_DEPTH_DEFAULT,
+};
+
+int parse_int_env(const char *name, int def, int min, int max) {
+    const char *s = getenv(name);
+    if (!s || !*s) return def;
+    char *end = NULL;
+    long v = strtol(s, &end, 10);
+    if (end == s || *end != '\0' || v < min || v > max) {
+        log_message(LOG_WARN, "Invalid %s='%s', falling back to %d", name, s, def);
+        return def;
+    }
+    return (int)v;
+}
+
+//-- File modes are written in octal, as for chmod --//
+static int parse_mode_env(const char *name, int def) {
+    const char *s = getenv(name);
+    if (!s || !*s) return def;
+    char *end = NULL;
+    long v = strtol(s, &end, 8);
+    if (end == s || *end != '\0' || v < 0 || v > 0777) {
+        log_message(LOG_WARN, "Invalid %s='%s', falling back to %o", name, s, def);
+        return def;
+    }
+    return (int)v;
+}
+
+void load_server_config(void) {
+    server_config.port = parse_int_env("MEMORADB_PORT", DEFAULT_PORT, 1, 65535);
+
+    const char *bind_ip = getenv("MEMORADB_BIND");
+    server_config.bind_address = (bind_ip && *bind_ip) ? bind_ip : DEFAULT_BIND_ADDRESS;
+
+    server_config.tcp_backlog = parse_int_env("MEMORADB_TCP_BACKLOG", CONNECTION_BACKLOG, 1, 65535);
+    server_config.reuseport = parse_int_env("MEMORADB_REUSEPORT", 0, 0, 1);
+    server_config.cpu_affinity = parse_int_env("MEMORADB_CPU_AFFINITY", 0, 0, 1);
+
+    const char *unix_socket = getenv("MEMORADB_UNIX_SOCKET");
+    server_config.unix_socket = (unix_socket && *unix_socket) ? unix_socket : NULL;
+    server_config.unix_socket_perm = parse_mode_env("MEMORADB_UNIX_SOCKET_PERM", DEFAULT_UNIX_SOCKET_PERM);
+
+    server_config.workers = parse_int_env("MEMORADB_WORKERS", 0, 0, MAX_WORKERS);
+    if (server_config.workers == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        if (cpus < 1) cpus = 1;
+        if (cpus > MAX_WORKERS) cpus = MAX_WORKERS;
+        server_config.workers = (int)cpus;
+    }
+
+    //-- Loops keep their state on the heap: a small stack is plenty and saves address space --//
+    server_config.thread_stack_kb = parse_int_env("MEMORADB_THREAD_STACK_KB", DEFAULT_THREAD_STACK_KB, 64, 65536);
+    server_config.maxclients = parse_int_env("MEMORADB_MAXCLIENTS", DEFAULT_MAXCLIENTS, 1, 10000000);
+
+    //-- Idle clients are closed by the server; dead peers behind a silent network are found by keepalive --//
+    server_config.timeout = parse_int_env("MEMORADB_TIMEOUT", 0, 0, 31536000);
+    server_config.tcp_keepalive = parse_int_env("MEMORADB_TCP_KEEPALIVE", DEFAULT_TCP_KEEPALIVE, 0, 32767);
+
+    //-- A client that sends requests but never reads their replies must not grow without bound --//
+    server_config.output_limit_mb = parse_int_env("MEMORADB_OUTPUT_LIMIT_MB", DEFAULT_OUTPUT_LIMIT_MB, 1, 1 << 20);
+    server_config.querybuf_limit_mb = parse_int_env("MEMORADB_QUERYBUF_LIMIT_MB", DEFAULT_QUERYBUF_LIMIT_MB, 1, 1 << 20);
+
+    server_config.shard_per_core = parse_int_env("MEMORADB_SHARD_PER_CORE", 0, 0, 1);
+
+    //-- Threaded I/O: the I/O loops replace the workers, one more loop executes every command --//
+    server_config.io_threads = parse_int_env("MEMORADB_IO_THREADS", 0, 0, MAX_WORKERS - 1);
+    if (server_config.io_threads > 0) {
+        if (server_config.shard_per_core) {
+            log_message(LOG_WARN, "MEMORADB_IO_THREADS set: ignoring MEMORADB_SHARD_PER_CORE");
+            server_config.shard_per_core = 0;
+        }
+        server_config.workers = server_config.io_threads;
+    }
+
+    server_config.list_node_bytes = parse_int_env("MEMORADB_LIST_NODE_SIZE", LIST_NODE_BYTES_DEFAULT,
+                                                  128, MAX_LIST_NODE_BYTES);
+    server_config.list_compress_depth = parse_int_env("MEMORADB_LIST_COMPRESS_DEPTH",
+                                                      LIST_COMPRESS_DEPTH_DEFAULT, 0, 1024);
+    list_configure((size_t)server_config.list_node_bytes, server_config.list_compress_depth);
+}
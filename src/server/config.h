@@ -0,0 +1,76 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/server/config.h
+ * Module                    : Server Configuration
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Runtime configuration of the MemoraDB server, loaded once at
+ *  startup from MEMORADB_* environment variables.
+ *
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#ifndef MEMORADB_CONFIG_H
+#define MEMORADB_CONFIG_H
+
+/* ==================== Defaults ==================== */
+#define DEFAULT_BIND_ADDRESS "0.0.0.0"
+#define DEFAULT_UNIX_SOCKET_PERM 0700
+#define DEFAULT_MAXCLIENTS 10000
+#define DEFAULT_THREAD_STACK_KB 256
+#define DEFAULT_TCP_KEEPALIVE 300
+#define DEFAULT_OUTPUT_LIMIT_MB 256
+#define DEFAULT_QUERYBUF_LIMIT_MB 1024
+#define MAX_WORKERS 64
+#define MAX_LIST_NODE_BYTES (1 << 20)
+
+/* ==================== Server Configuration ==================== */
+typedef struct {
+    int port;                   //- MEMORADB_PORT -//
+    const char *bind_address;   //- MEMORADB_BIND -//
+    int tcp_backlog;            //- MEMORADB_TCP_BACKLOG, accept queue length of each listening socket -//
+    int reuseport;              //- MEMORADB_REUSEPORT, one SO_REUSEPORT listening socket per loop -//
+    int cpu_affinity;           //- MEMORADB_CPU_AFFINITY, pin loop N to CPU N modulo the CPU count -//
+    const char *unix_socket;    //- MEMORADB_UNIX_SOCKET, path of an extra Unix domain listener (NULL = off) -//
+    int unix_socket_perm;       //- MEMORADB_UNIX_SOCKET_PERM, octal mode of the socket file -//
+    int workers;                //- MEMORADB_WORKERS, event loop threads (0 = one per CPU) -//
+    int thread_stack_kb;        //- MEMORADB_THREAD_STACK_KB, stack size of the loop threads -//
+    int maxclients;             //- MEMORADB_MAXCLIENTS, connections beyond this are refused -//
+    int timeout;                //- MEMORADB_TIMEOUT, seconds a client may stay idle (0 = forever) -//
+    int tcp_keepalive;          //- MEMORADB_TCP_KEEPALIVE, seconds of silence before probing the peer (0 = off) -//
+    int output_limit_mb;        //- MEMORADB_OUTPUT_LIMIT_MB, unsent replies a client may hold before it is closed -//
+    int querybuf_limit_mb;      //- MEMORADB_QUERYBUF_LIMIT_MB, unparsed input a client may hold before it is closed -//
+    int shard_per_core;         //- MEMORADB_SHARD_PER_CORE, loops own disjoint keyspace shards -//
+    int io_threads;             //- MEMORADB_IO_THREADS, loops doing only socket I/O and parsing (0 = off) -//
+    int list_node_bytes;        //- MEMORADB_LIST_NODE_SIZE, packed bytes per list node -//
+    int list_compress_depth;    //- MEMORADB_LIST_COMPRESS_DEPTH, raw nodes at each list end (0 = off) -//
+} ServerConfig;
+
+extern ServerConfig server_config;
+
+/**
+ * Load the server configuration from the environment.
+ * Invalid values are reported and replaced by their defaults.
+ */
+void load_server_config(void);
+
+/**
+ * Read an integer environment variable bounded to [min, max].
+ *
+ * @param name Environment variable name
+ * @param def Value used when the variable is unset or invalid
+ * @param min Smallest accepted value
+ * @param max Largest accepted value
+ * @return The parsed value or def
+ */
+int parse_int_env(const char *name, int def, int min, int max);
+
+#endif // MEMORADB_CONFIG_H
@@ -0,0 +1,503 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/server/connection.c
+ * Module                    : Client Connections
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Per-connection state owned by an event loop. Replaces the old
+ *  thread-per-client ClientContext.
+ *
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include "connection.h"
+#include "server.h"
+#include "config.h"
+#include "router.h"
+#include "blocking.h"
+#include "../parser/parser.h"
+#include "../utils/log.h"
+#include <fcntl.h>
+#include <stddef.h>
+#include <netinet/tcp.h>
+
+static uint64_t next_connection_id = 1;
+
+//-- Shared by every loop, updated atomically --//
+static size_t connected_clients = 0;
+static unsigned long long connections_received = 0;
+static unsigned long long connections_rejected = 0;
+static unsigned long long connections_timedout = 0;
+
+/**
+ * Take a client slot under maxclients. A full server answers with an
+ * error and hangs up before spending any memory on the client.
+ * @return 1 if admitted, 0 if rejected (fd is closed)
+ */
+static int connection_admit(int fd) {
+    size_t active = __atomic_add_fetch(&connected_clients, 1, __ATOMIC_RELAXED);
+    if (active <= (size_t)server_config.maxclients) {
+        __atomic_add_fetch(&connections_received, 1, __ATOMIC_RELAXED);
+        return 1;
+    }
+    __atomic_sub_fetch(&connected_clients, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&connections_rejected, 1, __ATOMIC_RELAXED);
+
+    //-- A fresh socket has an empty send buffer: the error always fits --//
+    ssize_t written = write(fd, MAXCLIENTS_ERROR, sizeof(MAXCLIENTS_ERROR) - 1);
+    (void)written;
+    close(fd);
+    return 0;
+}
+
+static void connection_release_slot(void) {
+    __atomic_sub_fetch(&connected_clients, 1, __ATOMIC_RELAXED);
+}
+
+void connection_stats(ConnectionStats *stats) {
+    stats->connected = __atomic_load_n(&connected_clients, __ATOMIC_RELAXED);
+    stats->received = __atomic_load_n(&connections_received, __ATOMIC_RELAXED);
+    stats->rejected = __atomic_load_n(&connections_rejected, __ATOMIC_RELAXED);
+    stats->timedout = __atomic_load_n(&connections_timedout, __ATOMIC_RELAXED);
+}
+
+/**
+ * Have the kernel probe a peer that stays silent for `idle` seconds, and
+ * drop it after TCP_KEEPALIVE_PROBES unanswered probes, so clients that
+ * vanished without a FIN are noticed even with no idle timeout.
+ * Fails harmlessly on Unix domain sockets.
+ */
+static void connection_set_keepalive(int fd, int idle) {
+    if (idle <= 0) return;
+    int one = 1;
+    if (setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, &one, sizeof(one)) != 0) return;
+    int interval = idle / TCP_KEEPALIVE_PROBES > 0 ? idle / TCP_KEEPALIVE_PROBES : 1;
+    int probes = TCP_KEEPALIVE_PROBES;
+    setsockopt(fd, IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof(idle));
+    setsockopt(fd, IPPROTO_TCP, TCP_KEEPINTVL, &interval, sizeof(interval));
+    setsockopt(fd, IPPROTO_TCP, TCP_KEEPCNT, &probes, sizeof(probes));
+}
+
+//-- Rounded up: a timer may fire late by up to a tick, never early --//
+static void connection_arm_idle_timer(Connection *conn, long long now_ms) {
+    long long deadline = now_ms + server_config.timeout * 1000LL;
+    timer_wheel_schedule(&conn->loop->idle_timers, &conn->idle_timer,
+                         (unsigned long long)(deadline + IDLE_TIMER_TICK_MS - 1) / IDLE_TIMER_TICK_MS);
+}
+
+Connection *connection_create(EventLoop *loop, int fd, const char *ip, int port) {
+    if (!connection_admit(fd)) return NULL;
+
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        log_message(LOG_ERROR, "Failed to make client socket non-blocking: %s", strerror(errno));
+        close(fd);
+        connection_release_slot();
+        return NULL;
+    }
+
+    //-- Replies are small and latency bound; fails harmlessly on non-TCP sockets --//
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    connection_set_keepalive(fd, server_config.tcp_keepalive);
+
+    Connection *conn = malloc(sizeof(Connection));
+    if (!conn) {
+        log_message(LOG_ERROR, "Failed to allocate client connection");
+        close(fd);
+        connection_release_slot();
+        return NULL;
+    }
+
+    conn->source = EV_SOURCE_CONNECTION;
+    conn->fd = fd;
+    conn->id = __atomic_fetch_add(&next_connection_id, 1, __ATOMIC_RELAXED);
+    strncpy(conn->ip_address, ip, sizeof(conn->ip_address) - 1);
+    conn->ip_address[sizeof(conn->ip_address) - 1] = '\0';
+    conn->port = port;
+    conn->loop = loop;
+    timer_node_init(&conn->idle_timer);
+    conn->last_active_ms = loop->now_ms;
+    conn->querybuf = NULL;
+    conn->querybuf_len = 0;
+    conn->querybuf_cap = 0;
+    request_parser_init(&conn->parser, MAX_TOKENS);
+    reply_init(&conn->reply);
+    conn->batch = NULL;
+    conn->forward_pending = 0;
+    conn->close_pending = 0;
+    conn->blocked = NULL;
+    conn->read_queued = 0;
+    conn->read_prev = NULL;
+    conn->read_next = NULL;
+    conn->write_queued = 0;
+    conn->write_prev = NULL;
+    conn->write_next = NULL;
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    //-- Edge-triggered EPOLLOUT only fires when a full socket drains, so it can stay armed --//
+    ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    ev.data.ptr = conn;
+    if (epoll_ctl(loop->epfd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+        log_message(LOG_ERROR, "Failed to register client socket: %s", strerror(errno));
+        close(fd);
+        request_parser_free(&conn->parser);
+        reply_free(&conn->reply);
+        free(conn);
+        connection_release_slot();
+        return NULL;
+    }
+
+    loop->num_connections++;
+    if (server_config.timeout > 0) connection_arm_idle_timer(conn, conn->last_active_ms);
+    return conn;
+}
+
+static void connection_queue_write(Connection *conn) {
+    if (conn->write_queued) return;
+    EventLoop *loop = conn->loop;
+    conn->write_queued = 1;
+    conn->write_prev = NULL;
+    conn->write_next = loop->pending_writes;
+    if (loop->pending_writes) loop->pending_writes->write_prev = conn;
+    loop->pending_writes = conn;
+}
+
+static void connection_unqueue_write(Connection *conn) {
+    if (!conn->write_queued) return;
+    if (conn->write_prev) {
+        conn->write_prev->write_next = conn->write_next;
+    } else {
+        conn->loop->pending_writes = conn->write_next;
+    }
+    if (conn->write_next) conn->write_next->write_prev = conn->write_prev;
+    conn->write_queued = 0;
+    conn->write_prev = NULL;
+    conn->write_next = NULL;
+}
+
+//-- Appended at the tail: a connection cut off again waits behind the others --//
+static void connection_queue_read(Connection *conn) {
+    if (conn->read_queued) return;
+    EventLoop *loop = conn->loop;
+    conn->read_queued = 1;
+    conn->read_prev = loop->pending_reads_tail;
+    conn->read_next = NULL;
+    if (loop->pending_reads_tail) {
+        loop->pending_reads_tail->read_next = conn;
+    } else {
+        loop->pending_reads = conn;
+    }
+    loop->pending_reads_tail = conn;
+    loop->num_pending_reads++;
+}
+
+static void connection_unqueue_read(Connection *conn) {
+    if (!conn->read_queued) return;
+    EventLoop *loop = conn->loop;
+    if (conn->read_prev) {
+        conn->read_prev->read_next = conn->read_next;
+    } else {
+        loop->pending_reads = conn->read_next;
+    }
+    if (conn->read_next) {
+        conn->read_next->read_prev = conn->read_prev;
+    } else {
+        loop->pending_reads_tail = conn->read_prev;
+    }
+    loop->num_pending_reads--;
+    conn->read_queued = 0;
+    conn->read_prev = NULL;
+    conn->read_next = NULL;
+}
+
+void connection_close(Connection *conn) {
+    connection_unqueue_write(conn);
+    connection_unqueue_read(conn);
+    if (conn->fd >= 0) {
+        epoll_ctl(conn->loop->epfd, EPOLL_CTL_DEL, conn->fd, NULL);
+        timer_wheel_cancel(&conn->loop->idle_timers, &conn->idle_timer);
+        close(conn->fd);
+        conn->fd = -1;
+        conn->loop->num_connections--;
+        connection_release_slot();
+        log_message(LOG_INFO, "Client %s disconnected on port %d", conn->ip_address, conn->port);
+    }
+
+    //-- The owning loop still holds a pointer to us in its reply message --//
+    if (conn->forward_pending) return;
+
+    if (conn->blocked) blocking_abandon(conn);
+
+    request_parser_free(&conn->parser);
+    reply_free(&conn->reply);
+    free(conn->querybuf);
+    free(conn);
+}
+
+/**
+ * A client that does not read its replies while it keeps sending requests
+ * is cut off once they reach server_config.output_limit_mb.
+ * @return 1 (and logged) if the connection must be closed
+ */
+static int connection_output_over_limit(Connection *conn) {
+    if (conn->reply.pending <= (size_t)server_config.output_limit_mb * 1024 * 1024) return 0;
+    log_message(LOG_WARN, "Client %s on port %d closed: %zu bytes of replies unread, over the %d MB limit",
+                conn->ip_address, conn->port, conn->reply.pending, server_config.output_limit_mb);
+    return 1;
+}
+
+/**
+ * Run one command. In shard-per-core mode and with threaded I/O, a command
+ * for keys owned by another loop starts a pipeline batch, and every later command of this
+ * read joins it so replies can be put back in order. A command that may
+ * block ends the batch: nothing behind it runs before it is answered.
+ * Returns -1 if the command could not be queued.
+ */
+static int connection_execute(Connection *conn, char *argv[], size_t lens[], int argc) {
+    if (!router_enabled()) {
+        dispatch_client_command(conn, &conn->reply, argv, lens, argc);
+        if (conn->blocked) blocking_adopt(conn);
+        return 0;
+    }
+
+    int owner = router_route(conn->loop, argv, lens, argc);
+    if (owner < 0 && !conn->batch) {
+        router_dispatch(conn->loop, conn, &conn->reply, argv, lens, argc);
+        if (conn->blocked) blocking_adopt(conn);
+        return 0;
+    }
+    if (router_batch_add(conn, owner < 0 ? conn->loop->id : owner, argv, lens, argc) != 0) return -1;
+    if (command_may_block(argv, argc)) router_batch_submit(conn);
+    return 0;
+}
+
+/**
+ * Execute every complete request in the input buffer, then move the
+ * trailing partial request (if any) to the front for the next read.
+ * Stops early while a forwarded batch is in flight or a blocking command
+ * waits, keeping the rest of the pipeline buffered so replies stay in order.
+ * Returns -1 on a protocol error: the stream cannot be resynchronised.
+ */
+static int connection_process_input(Connection *conn) {
+    size_t start = 0;
+    int result = 0;
+
+    //-- `blocked` may be set by another loop while a batch is in flight: test it after forward_pending --//
+    while (start < conn->querybuf_len && !conn->forward_pending && !conn->blocked) {
+        size_t consumed = 0;
+        request_parse_t r = request_parser_parse(&conn->parser, conn->querybuf + start,
+                                                 conn->querybuf_len - start, &consumed);
+        if (r == REQUEST_PARSE_INCOMPLETE) break;
+        if (r == REQUEST_PARSE_ERROR) {
+            reply_add_format(&conn->reply, "[MemoraDB: WARN] Invalid RESP format (%s)\r\n", conn->parser.error);
+            result = -1;
+            break;
+        }
+
+        if (conn->parser.argc > 0 &&
+            connection_execute(conn, conn->parser.argv, conn->parser.argv_len, conn->parser.argc) < 0) {
+            log_message(LOG_ERROR, "Failed to queue command from %s:%d", conn->ip_address, conn->port);
+            result = -1;
+            break;
+        }
+        request_parser_reset(&conn->parser);
+        start += consumed;
+        if (connection_output_over_limit(conn)) {
+            result = -1;
+            break;
+        }
+    }
+
+    //-- Even on error: the batch owns copies of commands that were already accepted --//
+    if (conn->batch && !conn->forward_pending) {
+        router_batch_submit(conn);
+    }
+
+    if (reply_has_pending(&conn->reply)) {
+        connection_queue_write(conn);
+    }
+    if (result < 0) return -1;
+
+    conn->querybuf_len -= start;
+    if (start > 0 && conn->querybuf_len > 0) {
+        memmove(conn->querybuf, conn->querybuf + start, conn->querybuf_len);
+    }
+    return 0;
+}
+
+/**
+ * Drain the socket: with edge-triggered notifications we must read until
+ * EAGAIN or we will not be woken up again for the remaining bytes. After
+ * READ_BUDGET_BYTES the connection is queued to continue on the next
+ * iteration instead, so a client pipelining without pause cannot keep the
+ * loop from its other clients. While a forwarded batch or a blocking
+ * command is pending, input is left in the socket for TCP flow control to
+ * push back on the client; connection_resume() queues the read again.
+ * Returns -1 once the peer is gone or misbehaved.
+ */
+static int connection_read(Connection *conn) {
+    size_t budget = READ_BUDGET_BYTES;
+    for (;;) {
+        //-- `blocked` may be set by another loop while a batch is in flight: test it after forward_pending --//
+        if (conn->forward_pending || conn->blocked) return 0;
+        if (budget == 0) {
+            connection_queue_read(conn);
+            return 0;
+        }
+
+        if (conn->querybuf_cap - conn->querybuf_len < QUERYBUF_READ_CHUNK) {
+            size_t cap = conn->querybuf_cap ? conn->querybuf_cap * 2 : QUERYBUF_READ_CHUNK;
+            while (cap - conn->querybuf_len < QUERYBUF_READ_CHUNK) cap *= 2;
+            char *buf = realloc(conn->querybuf, cap);
+            if (!buf) {
+                log_message(LOG_ERROR, "Failed to grow input buffer of %s:%d", conn->ip_address, conn->port);
+                return -1;
+            }
+            conn->querybuf = buf;
+            conn->querybuf_cap = cap;
+        }
+
+        ssize_t bytes = recv(conn->fd, conn->querybuf + conn->querybuf_len,
+                             conn->querybuf_cap - conn->querybuf_len, 0);
+        if (bytes == 0) return -1;
+        if (bytes < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                //-- Idle connections should not pin a read buffer --//
+                if (conn->querybuf_len == 0) {
+                    free(conn->querybuf);
+                    conn->querybuf = NULL;
+                    conn->querybuf_cap = 0;
+                }
+                return 0;
+            }
+            return -1;
+        }
+
+        conn->querybuf_len += (size_t)bytes;
+        budget = (size_t)bytes < budget ? budget - (size_t)bytes : 0;
+        if (connection_process_input(conn) < 0) return -1;
+
+        //-- Only a partial request is left: one this large is never going to fit --//
+        if (conn->querybuf_len > (size_t)server_config.querybuf_limit_mb * 1024 * 1024) {
+            log_message(LOG_WARN, "Client %s on port %d closed: %zu bytes of unparsed input, over the %d MB limit",
+                        conn->ip_address, conn->port, conn->querybuf_len, server_config.querybuf_limit_mb);
+            return -1;
+        }
+    }
+}
+
+void connection_handle_event(Connection *conn, uint32_t events) {
+    conn->last_active_ms = conn->loop->now_ms;
+
+    if ((events & EPOLLOUT) && reply_has_pending(&conn->reply)) {
+        if (reply_flush(&conn->reply, conn->fd) < 0) {
+            connection_close(conn);
+            return;
+        }
+    }
+
+    if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+        //-- Read first: a peer that sends a command and shuts down still gets served --//
+        //-- A paused connection does not read to EOF: the hang-up event itself ends it --//
+        int paused = conn->forward_pending || conn->blocked;
+        if (connection_read(conn) < 0 || (events & (EPOLLHUP | EPOLLERR)) ||
+            (paused && (events & EPOLLRDHUP))) {
+            if (conn->forward_pending) {
+                //-- Finish the buffered pipeline once the forwarded reply is back --//
+                conn->close_pending = 1;
+                return;
+            }
+            //-- Best effort: deliver what was produced, e.g. a protocol error --//
+            reply_flush(&conn->reply, conn->fd);
+            connection_close(conn);
+        }
+    }
+}
+
+void connection_handle_pending_reads(EventLoop *loop, size_t count) {
+    //-- Closed connections leave the list: at worst a newer one gets its turn early --//
+    while (count-- > 0 && loop->pending_reads) {
+        Connection *conn = loop->pending_reads;
+        connection_unqueue_read(conn);
+        connection_handle_event(conn, EPOLLIN);
+    }
+}
+
+void connection_resume(Connection *conn) {
+    conn->forward_pending = 0;
+    if (conn->fd < 0) {
+        connection_close(conn);
+        return;
+    }
+    conn->last_active_ms = conn->loop->now_ms;
+
+    connection_queue_write(conn);
+    //-- The batch ended with a blocking command: wait for its answer, unless the peer is gone --//
+    if (conn->blocked && !conn->close_pending && blocking_adopt(conn)) return;
+
+    if (connection_process_input(conn) < 0) {
+        conn->close_pending = 1;
+    }
+
+    if (conn->close_pending && !conn->forward_pending) {
+        reply_flush(&conn->reply, conn->fd);
+        connection_close(conn);
+        return;
+    }
+
+    //-- Input left in the socket while paused will not raise another event --//
+    if (!conn->close_pending && !conn->forward_pending && !conn->blocked) connection_queue_read(conn);
+}
+
+/**
+ * A connection's idle timer fired. It is re-armed from the last activity
+ * if there was any since it was set, which keeps activity itself down to
+ * a single store.
+ */
+static void connection_idle_timer_fired(TimerNode *node, void *arg) {
+    Connection *conn = (Connection *)((char *)node - offsetof(Connection, idle_timer));
+    long long now_ms = *(long long *)arg;
+
+    //-- Waiting is not idling: connection_resume() restarts the idle time once the wait is over --//
+    //-- `blocked` may be set by another loop while a batch is in flight: test it after forward_pending --//
+    if (conn->forward_pending || conn->blocked) {
+        connection_arm_idle_timer(conn, now_ms);
+        return;
+    }
+    if (now_ms - conn->last_active_ms < server_config.timeout * 1000LL) {
+        connection_arm_idle_timer(conn, conn->last_active_ms);
+        return;
+    }
+
+    log_message(LOG_INFO, "Client %s on port %d timed out after %d seconds idle",
+                conn->ip_address, conn->port, server_config.timeout);
+    __atomic_add_fetch(&connections_timedout, 1, __ATOMIC_RELAXED);
+    connection_close(conn);
+}
+
+void connection_expire_idle(EventLoop *loop, long long now_ms) {
+    timer_wheel_advance(&loop->idle_timers, (unsigned long long)now_ms / IDLE_TIMER_TICK_MS,
+                        connection_idle_timer_fired, &now_ms);
+}
+
+void connection_flush_pending(EventLoop *loop) {
+    while (loop->pending_writes) {
+        Connection *conn = loop->pending_writes;
+        connection_unqueue_write(conn);
+        //-- Replies merged from other loops are only measured here --//
+        if (reply_flush(&conn->reply, conn->fd) < 0 || connection_output_over_limit(conn)) {
+            connection_close(conn);
+        }
+    }
+}
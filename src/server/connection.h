@@ -0,0 +1,152 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/server/connection.h
+ * Module                    : Client Connections
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Per-connection state owned by an event loop. Replaces the old
+ *  thread-per-client ClientContext.
+ *
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#ifndef MEMORADB_CONNECTION_H
+#define MEMORADB_CONNECTION_H
+
+#include <stdint.h>
+#include "event_loop.h"
+#include "../parser/parser.h"
+#include "reply.h"
+
+/* ==================== Input Buffering ==================== */
+#define QUERYBUF_READ_CHUNK (16 * 1024)
+#define READ_BUDGET_BYTES (64 * 1024)   //- Input handled per turn before other clients get theirs -//
+
+/* ==================== Admission ==================== */
+#define MAXCLIENTS_ERROR "-ERR max number of clients reached\r\n"
+
+typedef struct {
+    size_t connected;                  //- Clients holding a slot right now -//
+    unsigned long long received;       //- Clients admitted since startup -//
+    unsigned long long rejected;       //- Clients turned away at maxclients -//
+    unsigned long long timedout;       //- Clients closed after idling past the timeout -//
+} ConnectionStats;
+
+/* ==================== Keepalive ==================== */
+#define TCP_KEEPALIVE_PROBES 3             //- Unanswered probes before the kernel drops the peer -//
+
+/* ==================== Connection ==================== */
+typedef struct Connection {
+    ev_source_t source;        //- Always EV_SOURCE_CONNECTION -//
+    int fd;
+    uint64_t id;
+    char ip_address[16];
+    int port;
+    EventLoop *loop;           //- Owning loop, the only thread touching this connection -//
+
+    //-- Idle timeout: activity only stamps the time, the timer catches up when it fires --//
+    TimerNode idle_timer;
+    long long last_active_ms;  //- loop->now_ms of the last socket event -//
+
+    //-- Unprocessed input; only a partial trailing request survives between reads --//
+    char *querybuf;
+    size_t querybuf_len;
+    size_t querybuf_cap;
+    RequestParser parser;
+
+    //-- Shard-per-core: commands executing on other loops --//
+    struct PipelineBatch *batch;   //- Commands routed during the current read -//
+    int forward_pending;           //- Batch in flight: input processing pauses until it is back -//
+    int close_pending;             //- Peer went away meanwhile: close once it is -//
+
+    //-- Waiting in a blocking command: input processing pauses until it is answered --//
+    struct BlockedClient *blocked;
+
+    //-- Input left in the socket after a full read budget, revisited next iteration --//
+    int read_queued;
+    struct Connection *read_prev;
+    struct Connection *read_next;
+
+    //-- Output waiting for the end of the loop iteration --//
+    ReplyBuffer reply;
+    int write_queued;
+    struct Connection *write_prev;
+    struct Connection *write_next;
+} Connection;
+
+/**
+ * Wrap an accepted socket in a Connection and register it with the loop.
+ * The socket is switched to non-blocking mode. With maxclients clients
+ * already connected, the socket is sent MAXCLIENTS_ERROR and closed.
+ * @param loop Owning event loop
+ * @param fd Connected socket
+ * @param ip Printable remote address
+ * @param port Remote port
+ * @return The connection, or NULL if rejected or on failure (fd is closed)
+ */
+Connection *connection_create(EventLoop *loop, int fd, const char *ip, int port);
+
+/**
+ * Read the client counters shared by every loop.
+ */
+void connection_stats(ConnectionStats *stats);
+
+/**
+ * Close the loop's connections idle for server_config.timeout seconds.
+ * Clients waiting on a forwarded or blocking command are not idle.
+ * Called from the loop's cron; each connection is looked at only when its
+ * timer fires, so the cost follows the timers due, not the client count.
+ * @param loop The event loop
+ * @param now_ms Current expiry_now() time
+ */
+void connection_expire_idle(EventLoop *loop, long long now_ms);
+
+/**
+ * Handle epoll readiness reported for the connection. May close it.
+ * @param conn The connection
+ * @param events epoll event mask
+ */
+void connection_handle_event(Connection *conn, uint32_t events);
+
+/**
+ * Give another read budget to the first `count` connections that used up
+ * theirs. Edge-triggered epoll does not report data already in a socket
+ * again, so these connections are read without waiting for an event.
+ * Connections that use up this budget too go back to the end of the list.
+ * @param loop The event loop
+ * @param count Connections to serve, those queued before this iteration
+ */
+void connection_handle_pending_reads(EventLoop *loop, size_t count);
+
+/**
+ * Write the pending replies of every connection queued on the loop during
+ * this iteration. Connections whose socket is full resume on EPOLLOUT.
+ * @param loop The event loop
+ */
+void connection_flush_pending(EventLoop *loop);
+
+/**
+ * Continue with the requests buffered behind a forwarded batch once its
+ * replies have been merged into the connection's output, or behind a
+ * blocking command once it was answered. Runs on the connection's own
+ * loop. Frees the connection if it was closed while the batch was in flight.
+ * @param conn The connection
+ */
+void connection_resume(Connection *conn);
+
+/**
+ * Unregister, close and free the connection. While a forwarded command is
+ * in flight the memory is kept until connection_resume() sees its reply.
+ * @param conn The connection
+ */
+void connection_close(Connection *conn);
+
+#endif // MEMORADB_CONNECTION_H
@@ -0,0 +1,288 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/server/event_loop.c
+ * Module                    : Event Loop
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Edge-triggered epoll reactor. A fixed set of event loop threads
+ *  multiplexes every client socket, each loop accepting from the shared
+ *  listening socket, or its own SO_REUSEPORT one, and serving the
+ *  connections it accepted.
+ *
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#define _GNU_SOURCE
+#include "event_loop.h"
+#include "connection.h"
+#include "server.h"
+#include "config.h"
+#include "../utils/log.h"
+#include "../utils/epoch.h"
+#include "../utils/hashTable.h"
+#include "stats.h"
+#include "blocking.h"
+#include "router.h"
+#include <sys/eventfd.h>
+#include <time.h>
+
+static EventLoop *event_loops[MAX_WORKERS];
+static int event_loops_created = 0;
+
+EventLoop *event_loop_create(int id) {
+    if (id < 0 || id >= MAX_WORKERS) return NULL;
+
+    EventLoop *loop = calloc(1, sizeof(EventLoop));
+    if (!loop) return NULL;
+
+    loop->id = id;
+    loop->cpu = -1;
+    for (int i = 0; i < EVENT_LOOP_MAX_LISTENERS; i++) {
+        loop->listeners[i].source = EV_SOURCE_LISTENER;
+        loop->listeners[i].fd = -1;
+    }
+    loop->inbox.source = EV_SOURCE_INBOX;
+    mpsc_init(&loop->inbox.queue);
+    minheap_init(&loop->blocked_timeouts);
+    loop->now_ms = expiry_now();
+    timer_wheel_init(&loop->idle_timers, (unsigned long long)loop->now_ms / IDLE_TIMER_TICK_MS);
+    loop->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (loop->epfd < 0) {
+        log_message(LOG_ERROR, "epoll_create1 failed: %s", strerror(errno));
+        free(loop);
+        return NULL;
+    }
+
+    loop->inbox.fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = &loop->inbox;
+    if (loop->inbox.fd < 0 || epoll_ctl(loop->epfd, EPOLL_CTL_ADD, loop->inbox.fd, &ev) != 0) {
+        log_message(LOG_ERROR, "Failed to create inbox for loop %d: %s", id, strerror(errno));
+        if (loop->inbox.fd >= 0) close(loop->inbox.fd);
+        close(loop->epfd);
+        free(loop);
+        return NULL;
+    }
+
+    event_loops[id] = loop;
+    if (id >= event_loops_created) event_loops_created = id + 1;
+    return loop;
+}
+
+EventLoop *event_loop_get(int id) {
+    return (id >= 0 && id < MAX_WORKERS) ? event_loops[id] : NULL;
+}
+
+int event_loop_count(void) {
+    return event_loops_created;
+}
+
+void event_loop_post(EventLoop *loop, LoopTask *task) {
+    //-- Only the push that finds the queue empty has to wake the loop --//
+    if (mpsc_push(&loop->inbox.queue, &task->node)) {
+        uint64_t one = 1;
+        ssize_t r = write(loop->inbox.fd, &one, sizeof(one));
+        (void)r;   //- EAGAIN means the counter is already non-zero: the loop is awake -//
+    }
+}
+
+/**
+ * Run every task posted to the loop. The eventfd is reset before the
+ * queue is detached so a post racing with us always causes a new wake-up.
+ */
+static void event_loop_drain_inbox(EventLoop *loop) {
+    uint64_t count;
+    ssize_t r = read(loop->inbox.fd, &count, sizeof(count));
+    (void)r;
+
+    MpscNode *node = mpsc_take_all(&loop->inbox.queue);
+    while (node) {
+        MpscNode *next = node->next;
+        LoopTask *task = (LoopTask *)node;
+        task->run(loop, task);
+        node = next;
+    }
+}
+
+/**
+ * Periodic housekeeping. Loop i reclaims expired keys from shards i, i + n,
+ * ..., the same split shard-per-core routing uses, so in that mode every
+ * shard is still touched by its owner only. With threaded I/O the
+ * execution loop owns every shard and the I/O loops reclaim nothing.
+ */
+static void event_loop_cron(EventLoop *loop, long long now) {
+    long long budget_us = EVENT_LOOP_CRON_MS * 10LL * ACTIVE_EXPIRE_CPU_PERCENT;
+    if (server_config.io_threads == 0) {
+        keyspace_active_expire(loop->id, event_loop_count(), budget_us);
+    } else if (loop->id == router_executor()) {
+        keyspace_active_expire(0, 1, budget_us);
+    }
+    if (server_config.timeout > 0) connection_expire_idle(loop, now);
+    if (loop->id == 0) stats_cron(now);
+}
+
+/**
+ * @return epoll_wait timeout until the next cron run or blocked client
+ *         deadline, whichever comes first, in ms
+ */
+static int event_loop_timeout(EventLoop *loop, long long now) {
+    //-- Input left unread will not be reported again: only poll for new events --//
+    if (loop->pending_reads) return 0;
+    long long wait = blocking_next_timeout(loop, now, loop->next_cron_ms - now);
+    return wait > 0 ? (int)wait : 0;
+}
+
+int event_loop_add_listener(EventLoop *loop, int listen_fd) {
+    if (loop->num_listeners == EVENT_LOOP_MAX_LISTENERS) {
+        log_message(LOG_ERROR, "Loop %d already has %d listeners", loop->id, EVENT_LOOP_MAX_LISTENERS);
+        return -1;
+    }
+    Listener *listener = &loop->listeners[loop->num_listeners];
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    //-- Level-triggered + exclusive: one loop wakes per pending connection --//
+    ev.events = EPOLLIN | EPOLLEXCLUSIVE;
+    ev.data.ptr = listener;
+    if (epoll_ctl(loop->epfd, EPOLL_CTL_ADD, listen_fd, &ev) != 0) {
+        log_message(LOG_ERROR, "Failed to register listener on loop %d: %s", loop->id, strerror(errno));
+        return -1;
+    }
+    listener->fd = listen_fd;
+    loop->num_listeners++;
+    return 0;
+}
+
+void event_loop_set_cpu(EventLoop *loop, int cpu) {
+    loop->cpu = cpu;
+}
+
+//-- Keeps the loop's connections, shards and slab cache warm in one CPU's caches --//
+static void event_loop_pin(EventLoop *loop) {
+    if (loop->cpu < 0) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(loop->cpu, &set);
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (err != 0) {
+        log_message(LOG_WARN, "Could not pin loop %d to CPU %d: %s", loop->id, loop->cpu, strerror(err));
+    }
+}
+
+/**
+ * Accept up to ACCEPT_BATCH pending connections. The batch bound keeps one
+ * loop from draining an accept storm while its existing clients wait.
+ */
+static void event_loop_accept(EventLoop *loop, Listener *listener) {
+    for (int i = 0; i < ACCEPT_BATCH; i++) {
+        struct sockaddr_storage storage;
+        socklen_t client_addr_len = sizeof(storage);
+        int client_fd = accept4(listener->fd, (struct sockaddr *)&storage, &client_addr_len,
+                                SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (client_fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                log_message(LOG_ERROR, "Accept failed: %s", strerror(errno));
+            }
+            return;
+        }
+
+        //-- Unix domain peers are unnamed: they are told apart by connection id only --//
+        char ip_address[16] = "unix";
+        int port = 0;
+        if (storage.ss_family == AF_INET) {
+            struct sockaddr_in *client_addr = (struct sockaddr_in *)&storage;
+            if (inet_ntop(AF_INET, &client_addr->sin_addr, ip_address, sizeof(ip_address)) == NULL) {
+                log_message(LOG_ERROR, "Failed to convert client IP: %s", strerror(errno));
+                strncpy(ip_address, "unknown", sizeof(ip_address));
+            }
+            port = ntohs(client_addr->sin_port);
+        }
+
+        if (connection_create(loop, client_fd, ip_address, port)) {
+            log_message(LOG_INFO, "Client %s connected on port %d", ip_address, port);
+        }
+    }
+}
+
+void *event_loop_run(void *arg) {
+    EventLoop *loop = (EventLoop *)arg;
+    event_loop_pin(loop);
+    loop->next_cron_ms = expiry_now() + EVENT_LOOP_CRON_MS;
+
+    for (;;) {
+        int timeout = event_loop_timeout(loop, expiry_now());
+        int n = epoll_wait(loop->epfd, loop->events, EVENT_LOOP_MAX_EVENTS, timeout);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            log_message(LOG_ERROR, "epoll_wait failed on loop %d: %s", loop->id, strerror(errno));
+            break;
+        }
+
+        //-- One clock read per batch: connections stamp their last activity with it --//
+        loop->now_ms = expiry_now();
+        int inbox_ready = 0;
+        size_t carried_reads = loop->num_pending_reads;
+        for (int i = 0; i < n; i++) {
+            ev_source_t *source = (ev_source_t *)loop->events[i].data.ptr;
+            switch (*source) {
+            case EV_SOURCE_LISTENER:
+                event_loop_accept(loop, (Listener *)source);
+                break;
+            case EV_SOURCE_CONNECTION:
+                connection_handle_event((Connection *)source, loop->events[i].events);
+                break;
+            case EV_SOURCE_INBOX:
+                inbox_ready = 1;
+                break;
+            }
+        }
+
+        //-- After the batch: a task may close a connection that has an event above --//
+        if (inbox_ready) event_loop_drain_inbox(loop);
+
+        //-- Clients cut off at their read budget in an earlier iteration get another turn --//
+        if (carried_reads > 0) connection_handle_pending_reads(loop, carried_reads);
+
+        long long now = expiry_now();
+        blocking_handle_timeouts(loop, now);
+
+        //-- One vectored write per connection for everything this iteration produced --//
+        connection_flush_pending(loop);
+
+        if (now >= loop->next_cron_ms) {
+            event_loop_cron(loop, now);
+            loop->next_cron_ms = now + EVENT_LOOP_CRON_MS;
+        }
+
+        //-- Free values this loop overwrote once no GET can still be reading them --//
+        epoch_collect();
+    }
+    return NULL;
+}
+
+int event_loop_start(EventLoop *loop) {
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    if (pthread_attr_setstacksize(&attr, (size_t)server_config.thread_stack_kb * 1024) != 0) {
+        log_message(LOG_WARN, "Stack size of %d KB refused, loop %d keeps the default",
+                    server_config.thread_stack_kb, loop->id);
+    }
+    int err = pthread_create(&loop->thread, &attr, event_loop_run, loop);
+    pthread_attr_destroy(&attr);
+    if (err != 0) {
+        log_message(LOG_ERROR, "Failed to start event loop %d: %s", loop->id, strerror(err));
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,151 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/server/event_loop.h
+ * Module                    : Event Loop
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Edge-triggered epoll reactor. A fixed set of event loop threads
+ *  multiplexes every client socket, each loop accepting from the shared
+ *  listening socket, or its own SO_REUSEPORT one, and serving the
+ *  connections it accepted.
+ *
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#ifndef MEMORADB_EVENT_LOOP_H
+#define MEMORADB_EVENT_LOOP_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include <sys/epoll.h>
+#include "../utils/mpsc.h"
+#include "../utils/minheap.h"
+#include "../utils/timer_wheel.h"
+
+/* ==================== Loop Constants ==================== */
+#define EVENT_LOOP_MAX_EVENTS 1024
+#define ACCEPT_BATCH 64
+#define EVENT_LOOP_MAX_LISTENERS 2      //- A TCP socket and a Unix domain socket -//
+#define EVENT_LOOP_CRON_MS 100          //- Period of each loop's housekeeping -//
+#define ACTIVE_EXPIRE_CPU_PERCENT 25    //- Share of a cron period the expire cycle may use -//
+#define IDLE_TIMER_TICK_MS 100          //- Granularity of the idle client timers -//
+
+/* ==================== Event Sources ==================== */
+//-- Every object registered in an epoll set starts with its source kind --//
+typedef enum {
+    EV_SOURCE_LISTENER,
+    EV_SOURCE_CONNECTION,
+    EV_SOURCE_INBOX
+} ev_source_t;
+
+typedef struct Listener {
+    ev_source_t source;
+    int fd;
+} Listener;
+
+struct EventLoop;
+
+/* ==================== Cross-loop Tasks ==================== */
+//-- Work handed to another loop's thread; the node must stay the first member --//
+typedef struct LoopTask {
+    MpscNode node;
+    void (*run)(struct EventLoop *loop, struct LoopTask *task);
+} LoopTask;
+
+typedef struct Inbox {
+    ev_source_t source;        //- Always EV_SOURCE_INBOX -//
+    int fd;                    //- eventfd, signalled when the queue becomes non-empty -//
+    MpscQueue queue;
+} Inbox;
+
+/* ==================== Event Loop ==================== */
+typedef struct EventLoop {
+    int id;
+    int epfd;
+    int cpu;                             //- CPU the loop's thread is pinned to, -1 if unpinned -//
+    pthread_t thread;
+    Listener listeners[EVENT_LOOP_MAX_LISTENERS];
+    int num_listeners;
+    Inbox inbox;
+    size_t num_connections;
+    long long now_ms;                    //- expiry_now() when the current batch of events arrived -//
+    long long next_cron_ms;              //- expiry_now() time of the next housekeeping run -//
+    MinHeap blocked_timeouts;            //- Blocked clients of this loop, earliest deadline first -//
+    TimerWheel idle_timers;              //- One idle timeout per connection, in IDLE_TIMER_TICK_MS ticks -//
+    struct Connection *pending_writes;   //- Connections with replies to flush this iteration -//
+    struct Connection *pending_reads;    //- Connections with input left unread, oldest first -//
+    struct Connection *pending_reads_tail;
+    size_t num_pending_reads;
+    struct epoll_event events[EVENT_LOOP_MAX_EVENTS];
+} EventLoop;
+
+/**
+ * Create an event loop with an empty epoll set.
+ * @param id Index of the loop, used in log messages
+ * @return The new loop, or NULL on failure
+ */
+EventLoop *event_loop_create(int id);
+
+/**
+ * Register a non-blocking listening socket with the loop. Several loops may
+ * share the same socket; EPOLLEXCLUSIVE wakes only one of them per connection.
+ * With SO_REUSEPORT each loop is given a socket of its own instead.
+ * A loop accepts from up to EVENT_LOOP_MAX_LISTENERS sockets, TCP or Unix.
+ * @param loop The event loop
+ * @param listen_fd Listening socket
+ * @return 0 on success, -1 on error
+ */
+int event_loop_add_listener(EventLoop *loop, int listen_fd);
+
+/**
+ * Pin the thread that will run the loop to one CPU. Takes effect when
+ * event_loop_run() starts, whether on a new thread or the calling one.
+ * @param loop The event loop
+ * @param cpu CPU index, -1 to leave the thread unpinned
+ */
+void event_loop_set_cpu(EventLoop *loop, int cpu);
+
+/**
+ * Look up a loop by id.
+ * @param id Index given to event_loop_create()
+ * @return The loop, or NULL if none was created with that id
+ */
+EventLoop *event_loop_get(int id);
+
+/**
+ * @return Number of event loops created so far
+ */
+int event_loop_count(void);
+
+/**
+ * Queue a task for execution on the loop's own thread, waking it up if
+ * needed. Safe to call from any thread, lock-free.
+ * @param loop Loop that will run the task
+ * @param task Task to run; owned by the loop until task->run is called
+ */
+void event_loop_post(EventLoop *loop, LoopTask *task);
+
+/**
+ * Start the loop on its own thread, with a stack of
+ * server_config.thread_stack_kb.
+ * @param loop The event loop
+ * @return 0 on success, -1 on error
+ */
+int event_loop_start(EventLoop *loop);
+
+/**
+ * Run the loop on the calling thread; never returns under normal operation.
+ * @param arg The EventLoop to run
+ * @return NULL
+ */
+void *event_loop_run(void *arg);
+
+#endif // MEMORADB_EVENT_LOOP_H
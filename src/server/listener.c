@@ -0,0 +1,125 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/server/listener.c
+ * Module                    : Listening Sockets
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Creation of the server's listening sockets. With SO_REUSEPORT every
+ *  event loop binds a socket of its own to the same address, and the
+ *  kernel spreads incoming connections over their accept queues instead
+ *  of funnelling them through one. A Unix domain socket can be added for
+ *  clients on the same host, shared by every loop.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include "listener.h"
+#include "server.h"
+#include "../utils/log.h"
+#include <sys/stat.h>
+#include <sys/un.h>
+
+int listener_open_tcp(const char *address, int port, int backlog, int reuseport) {
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, address, &addr.sin_addr) != 1) {
+        log_message(LOG_ERROR, "Invalid bind address '%s'", address);
+        return -1;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd == -1) {
+        log_message(LOG_ERROR, "Socket creation failed: %s", strerror(errno));
+        return -1;
+    }
+
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (reuseport && setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) != 0) {
+        log_message(LOG_ERROR, "SO_REUSEPORT failed: %s", strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        log_message(LOG_ERROR, "Bind to %s:%d failed: %s", address, port, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    if (listen(fd, backlog) != 0) {
+        log_message(LOG_ERROR, "Listen failed: %s", strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int listener_open_unix(const char *path, int perm, int backlog) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        log_message(LOG_ERROR, "Unix socket path '%s' is longer than %zu bytes", path, sizeof(addr.sun_path) - 1);
+        return -1;
+    }
+    memcpy(addr.sun_path, path, strlen(path) + 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd == -1) {
+        log_message(LOG_ERROR, "Unix socket creation failed: %s", strerror(errno));
+        return -1;
+    }
+
+    //-- A crash leaves the socket file behind; never remove anything else, nor a live socket --//
+    struct stat st;
+    if (lstat(path, &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            log_message(LOG_ERROR, "Unix socket path '%s' exists and is not a socket", path);
+            close(fd);
+            return -1;
+        }
+        int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        int live = probe >= 0 && connect(probe, (struct sockaddr *)&addr, sizeof(addr)) == 0;
+        if (probe >= 0) close(probe);
+        if (live) {
+            log_message(LOG_ERROR, "Unix socket %s is in use by another server", path);
+            close(fd);
+            return -1;
+        }
+        unlink(path);
+    }
+
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        log_message(LOG_ERROR, "Bind to %s failed: %s", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    //-- Connecting needs write permission on the file: the mode is the access control --//
+    if (chmod(path, (mode_t)perm) != 0 || listen(fd, backlog) != 0) {
+        log_message(LOG_ERROR, "Unix socket %s setup failed: %s", path, strerror(errno));
+        close(fd);
+        unlink(path);
+        return -1;
+    }
+    return fd;
+}
+
+int listener_somaxconn(void) {
+    FILE *f = fopen("/proc/sys/net/core/somaxconn", "r");
+    if (!f) return -1;
+    int value = -1;
+    if (fscanf(f, "%d", &value) != 1) value = -1;
+    fclose(f);
+    return value;
+}
@@ -0,0 +1,54 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/server/listener.h
+ * Module                    : Listening Sockets
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Creation of the server's listening sockets. With SO_REUSEPORT every
+ *  event loop binds a socket of its own to the same address, and the
+ *  kernel spreads incoming connections over their accept queues instead
+ *  of funnelling them through one. A Unix domain socket can be added for
+ *  clients on the same host, shared by every loop.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#ifndef MEMORADB_LISTENER_H
+#define MEMORADB_LISTENER_H
+
+/**
+ * Create a non-blocking TCP socket bound to address:port and listening.
+ * Errors are logged.
+ * @param address IPv4 address to bind, e.g. "0.0.0.0"
+ * @param port TCP port
+ * @param backlog Accept queue length, capped by the kernel at somaxconn
+ * @param reuseport Set SO_REUSEPORT so that other sockets can share the port
+ * @return The listening socket, -1 on error
+ */
+int listener_open_tcp(const char *address, int port, int backlog, int reuseport);
+
+/**
+ * Create a non-blocking Unix domain stream socket at path, listening. A
+ * stale socket left at path by a previous run is replaced; any other kind
+ * of file there is an error. Errors are logged.
+ * @param path Filesystem path of the socket
+ * @param perm Permission bits given to the socket file, e.g. 0700
+ * @param backlog Accept queue length
+ * @return The listening socket, -1 on error
+ */
+int listener_open_unix(const char *path, int perm, int backlog);
+
+/**
+ * @return net.core.somaxconn, the kernel's cap on listen() backlogs, or
+ *         -1 if it cannot be read
+ */
+int listener_somaxconn(void);
+
+#endif // MEMORADB_LISTENER_H
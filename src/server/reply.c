@@ -0,0 +1,255 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/server/reply.c
+ * Module                    : Reply Buffers
+ * Last Updating Author      : agent
+ * Last Update               : 10/17/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Per-connection output buffer. Command handlers append RESP into it and
+ *  the event loop writes everything pending with a single writev() per
+ *  iteration, so pipelined and multi-element replies cost one syscall.
+ *
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include "reply.h"
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#define REPLY_MAX_IOV 64
+
+void reply_init(ReplyBuffer *reply) {
+    reply->bufpos = 0;
+    reply->sentlen = 0;
+    reply->head = NULL;
+    reply->tail = NULL;
+    reply->pending = 0;
+}
+
+void reply_free(ReplyBuffer *reply) {
+    ReplyBlock *block = reply->head;
+    while (block) {
+        ReplyBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    reply_init(reply);
+}
+
+/**
+ * Copy into the overflow list, filling the tail block before allocating a
+ * new one sized for whatever is left.
+ */
+static void reply_add_to_blocks(ReplyBuffer *reply, const char *data, size_t len) {
+    ReplyBlock *tail = reply->tail;
+    if (tail && tail->used < tail->size) {
+        size_t room = tail->size - tail->used;
+        size_t n = len < room ? len : room;
+        memcpy(tail->data + tail->used, data, n);
+        tail->used += n;
+        data += n;
+        len -= n;
+    }
+    if (len == 0) return;
+
+    size_t size = len > REPLY_BLOCK_BYTES ? len : REPLY_BLOCK_BYTES;
+    ReplyBlock *block = malloc(sizeof(ReplyBlock) + size);
+    if (!block) {
+        //-- Out of memory: the reply is truncated and the client will notice --//
+        reply->pending -= len;
+        return;
+    }
+    block->next = NULL;
+    block->size = size;
+    block->used = len;
+    memcpy(block->data, data, len);
+
+    if (reply->tail) {
+        reply->tail->next = block;
+    } else {
+        reply->head = block;
+    }
+    reply->tail = block;
+}
+
+void reply_add(ReplyBuffer *reply, const char *data, size_t len) {
+    reply->pending += len;
+
+    //-- The static chunk is only usable while no block is queued behind it --//
+    if (!reply->head) {
+        size_t room = REPLY_STATIC_BYTES - reply->bufpos;
+        size_t n = len < room ? len : room;
+        memcpy(reply->buf + reply->bufpos, data, n);
+        reply->bufpos += n;
+        data += n;
+        len -= n;
+    }
+    if (len > 0) {
+        reply_add_to_blocks(reply, data, len);
+    }
+}
+
+void reply_add_format(ReplyBuffer *reply, const char *format, ...) {
+    char small[256];
+    va_list args;
+
+    va_start(args, format);
+    int len = vsnprintf(small, sizeof(small), format, args);
+    va_end(args);
+    if (len < 0) return;
+
+    if ((size_t)len < sizeof(small)) {
+        reply_add(reply, small, (size_t)len);
+        return;
+    }
+
+    char *large = malloc((size_t)len + 1);
+    if (!large) return;
+    va_start(args, format);
+    vsnprintf(large, (size_t)len + 1, format, args);
+    va_end(args);
+    reply_add(reply, large, (size_t)len);
+    free(large);
+}
+
+/**
+ * Emit "<prefix><value>\r\n" without going through printf.
+ */
+static void reply_add_prefixed_number(ReplyBuffer *reply, char prefix, long long value) {
+    char buf[32];
+    char *p = buf + sizeof(buf);
+    unsigned long long v = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+
+    *--p = '\n';
+    *--p = '\r';
+    do {
+        *--p = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+    if (value < 0) *--p = '-';
+    *--p = prefix;
+
+    reply_add(reply, p, (size_t)(buf + sizeof(buf) - p));
+}
+
+void reply_add_simple(ReplyBuffer *reply, const char *str) {
+    reply_add(reply, "+", 1);
+    reply_add(reply, str, strlen(str));
+    reply_add(reply, "\r\n", 2);
+}
+
+void reply_add_bulk(ReplyBuffer *reply, const char *data, size_t len) {
+    reply_add_prefixed_number(reply, '$', (long long)len);
+    reply_add(reply, data, len);
+    reply_add(reply, "\r\n", 2);
+}
+
+void reply_add_integer(ReplyBuffer *reply, long long value) {
+    reply_add_prefixed_number(reply, ':', value);
+}
+
+void reply_add_array_len(ReplyBuffer *reply, long long count) {
+    reply_add_prefixed_number(reply, '*', count);
+}
+
+void reply_add_null(ReplyBuffer *reply) {
+    reply_add(reply, "$-1\r\n", 5);
+}
+
+/**
+ * Account for `written` bytes leaving the buffer, releasing finished blocks.
+ */
+static void reply_consume(ReplyBuffer *reply, size_t written) {
+    reply->pending -= written;
+
+    if (reply->bufpos > 0) {
+        size_t remaining = reply->bufpos - reply->sentlen;
+        if (written < remaining) {
+            reply->sentlen += written;
+            return;
+        }
+        written -= remaining;
+        reply->bufpos = 0;
+        reply->sentlen = 0;
+    }
+
+    while (reply->head && written > 0) {
+        ReplyBlock *block = reply->head;
+        size_t remaining = block->used - reply->sentlen;
+        if (written < remaining) {
+            reply->sentlen += written;
+            return;
+        }
+        written -= remaining;
+        reply->sentlen = 0;
+        reply->head = block->next;
+        if (!reply->head) reply->tail = NULL;
+        free(block);
+    }
+}
+
+void reply_transfer(ReplyBuffer *dst, ReplyBuffer *src, size_t len) {
+    while (len > 0 && src->pending > 0) {
+        const char *data;
+        size_t avail;
+        if (src->bufpos > 0) {
+            data = src->buf + src->sentlen;
+            avail = src->bufpos - src->sentlen;
+        } else {
+            data = src->head->data + src->sentlen;
+            avail = src->head->used - src->sentlen;
+        }
+
+        size_t n = len < avail ? len : avail;
+        reply_add(dst, data, n);
+        reply_consume(src, n);
+        len -= n;
+    }
+}
+
+int reply_flush(ReplyBuffer *reply, int fd) {
+    while (reply->pending > 0) {
+        struct iovec iov[REPLY_MAX_IOV];
+        int iovcnt = 0;
+        size_t offset = reply->sentlen;
+
+        if (reply->bufpos > 0) {
+            iov[iovcnt].iov_base = reply->buf + offset;
+            iov[iovcnt].iov_len = reply->bufpos - offset;
+            iovcnt++;
+            offset = 0;
+        }
+        for (ReplyBlock *block = reply->head; block && iovcnt < REPLY_MAX_IOV; block = block->next) {
+            iov[iovcnt].iov_base = block->data + offset;
+            iov[iovcnt].iov_len = block->used - offset;
+            iovcnt++;
+            offset = 0;
+        }
+
+        //-- sendmsg() is writev() for sockets, minus SIGPIPE on a vanished peer --//
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = (size_t)iovcnt;
+        ssize_t written = sendmsg(fd, &msg, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return 1;
+            return -1;
+        }
+        reply_consume(reply, (size_t)written);
+    }
+    return 0;
+}
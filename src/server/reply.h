@@ -0,0 +1,128 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/server/reply.h
+ * Module                    : Reply Buffers
+ * Last Updating Author      : agent
+ * Last Update               : 10/17/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Per-connection output buffer. Command handlers append RESP into it and
+ *  the event loop writes everything pending with a single writev() per
+ *  iteration, so pipelined and multi-element replies cost one syscall.
+ *
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#ifndef MEMORADB_REPLY_H
+#define MEMORADB_REPLY_H
+
+#include <stddef.h>
+#include <sys/types.h>
+
+/* ==================== Buffer Sizes ==================== */
+#define REPLY_STATIC_BYTES 1024          //- Inline chunk, enough for typical replies -//
+#define REPLY_BLOCK_BYTES  (16 * 1024)   //- Minimum size of an overflow block -//
+
+/* ==================== Overflow Block ==================== */
+typedef struct ReplyBlock {
+    struct ReplyBlock *next;
+    size_t size;
+    size_t used;
+    char data[];
+} ReplyBlock;
+
+/* ==================== Reply Buffer ==================== */
+typedef struct {
+    size_t bufpos;          //- Bytes appended to the static chunk -//
+    size_t sentlen;         //- Bytes of the first pending chunk already written -//
+    ReplyBlock *head;       //- Overflow blocks, written after the static chunk -//
+    ReplyBlock *tail;
+    size_t pending;         //- Total bytes not yet written -//
+    char buf[REPLY_STATIC_BYTES];
+} ReplyBuffer;
+
+/**
+ * Initialise an empty reply buffer.
+ * @param reply Buffer to initialise
+ */
+void reply_init(ReplyBuffer *reply);
+
+/**
+ * Drop pending output and free every overflow block.
+ * @param reply Buffer to release
+ */
+void reply_free(ReplyBuffer *reply);
+
+/**
+ * Append raw bytes to the reply.
+ * @param reply Destination buffer
+ * @param data Bytes to append
+ * @param len Number of bytes
+ */
+void reply_add(ReplyBuffer *reply, const char *data, size_t len);
+
+/**
+ * Append printf-style formatted text to the reply.
+ * @param reply Destination buffer
+ * @param format printf-style format string
+ */
+void reply_add_format(ReplyBuffer *reply, const char *format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/**
+ * Append a RESP simple string: +<str>\r\n
+ */
+void reply_add_simple(ReplyBuffer *reply, const char *str);
+
+/**
+ * Append a RESP bulk string: $<len>\r\n<data>\r\n
+ */
+void reply_add_bulk(ReplyBuffer *reply, const char *data, size_t len);
+
+/**
+ * Append a RESP integer: :<value>\r\n
+ */
+void reply_add_integer(ReplyBuffer *reply, long long value);
+
+/**
+ * Append a RESP array header: *<count>\r\n
+ */
+void reply_add_array_len(ReplyBuffer *reply, long long count);
+
+/**
+ * Append a RESP null bulk string: $-1\r\n
+ */
+void reply_add_null(ReplyBuffer *reply);
+
+/**
+ * Move the first `len` pending bytes of `src` to the end of `dst`.
+ * @param dst Destination buffer
+ * @param src Buffer the bytes are taken from
+ * @param len Number of bytes to move
+ */
+void reply_transfer(ReplyBuffer *dst, ReplyBuffer *src, size_t len);
+
+/**
+ * @return Non-zero when output is waiting to be written
+ */
+static inline int reply_has_pending(const ReplyBuffer *reply) {
+    return reply->pending > 0;
+}
+
+/**
+ * Write as much pending output as the socket accepts, gathering the static
+ * chunk and every overflow block into one vectored write.
+ * @param reply Buffer to flush
+ * @param fd Destination socket (non-blocking)
+ * @return 0 when everything was written, 1 when the socket is full,
+ *         -1 on a write error
+ */
+int reply_flush(ReplyBuffer *reply, int fd);
+
+#endif // MEMORADB_REPLY_H
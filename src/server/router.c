@@ -0,0 +1,318 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/server/router.c
+ * Module                    : Shard-per-core Routing
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Shared-nothing execution mode. Each event loop owns a disjoint set of
+ *  keyspace shards and is the only thread that touches them, so the
+ *  shard locks are skipped. A command whose keys belong to another loop
+ *  is shipped to that loop's inbox, executed there, and its reply
+ *  shipped back to the connection's loop.
+ *
+ *  Threaded I/O reuses the same path: one execution loop owns every
+ *  shard, and the I/O loops forward it all commands that have keys.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include "router.h"
+#include "connection.h"
+#include "config.h"
+#include "../parser/parser.h"
+#include "../utils/hashTable.h"
+
+/*
+ * A pipeline is batched rather than forwarded command by command: once a
+ * command for another loop shows up, it and every later command of the
+ * same read are queued per owning loop, each loop receives one message,
+ * and the replies are stitched back together in request order. Commands
+ * on one key always go to the same loop, so they keep their order.
+ */
+
+/* ==================== Batch Structures ==================== */
+
+//-- Commands for one loop, and afterwards their replies --//
+typedef struct OwnerBatch {
+    LoopTask task;             //- First member: the inbox links through it -//
+    struct PipelineBatch *pipeline;
+    int owner;
+    int count;                 //- Commands queued -//
+    int cap;
+    size_t *reply_lens;        //- Reply bytes produced by each command -//
+    char *args;                //- Per command: int argc, then per argument its size_t length, bytes and a NUL -//
+    size_t args_len;
+    size_t args_cap;
+    ReplyBuffer reply;
+} OwnerBatch;
+
+typedef struct PipelineBatch {
+    Connection *conn;
+    EventLoop *origin;
+    int outstanding;           //- Owner batches not answered yet -//
+    int count;                 //- Commands in the pipeline -//
+    int cap;
+    unsigned char *owner_of;   //- Owning loop of each command, in request order -//
+    OwnerBatch *by_owner[MAX_WORKERS];
+} PipelineBatch;
+
+/* ==================== Routing ==================== */
+
+int router_enabled(void) {
+    return server_config.shard_per_core || server_config.io_threads > 0;
+}
+
+int router_executor(void) {
+    return server_config.io_threads;
+}
+
+int router_shard_owner(int shard) {
+    if (server_config.io_threads > 0) return router_executor();
+    int loops = event_loop_count();
+    return loops > 0 ? shard % loops : 0;
+}
+
+int router_route(EventLoop *loop, char *argv[], size_t lens[], int argc) {
+    int first, last, step;
+    if (!command_key_range(argv, argc, &first, &last, &step)) return ROUTE_LOCAL;
+
+    int owner = router_shard_owner(keyspace_shard_of(argv[first], lens[first]));
+    for (int i = first + step; i <= last; i += step) {
+        if (router_shard_owner(keyspace_shard_of(argv[i], lens[i])) != owner) {
+            return ROUTE_CROSSSLOT;
+        }
+    }
+    return owner == loop->id ? ROUTE_LOCAL : owner;
+}
+
+void router_dispatch(EventLoop *loop, Connection *conn, ReplyBuffer *reply, char *argv[], size_t lens[], int argc) {
+    if (router_route(loop, argv, lens, argc) == ROUTE_CROSSSLOT) {
+        reply_add_format(reply, "[MemoraDB: ERROR] CROSSSLOT keys in request don't hash to the same shard\r\n");
+        return;
+    }
+    dispatch_client_command(conn, reply, argv, lens, argc);
+}
+
+/* ==================== Batch Execution ==================== */
+
+static void owner_batch_free(OwnerBatch *batch) {
+    reply_free(&batch->reply);
+    free(batch->reply_lens);
+    free(batch->args);
+    free(batch);
+}
+
+/**
+ * Run every queued command, recording how many reply bytes each produced.
+ */
+static void owner_batch_execute(EventLoop *loop, OwnerBatch *batch) {
+    char *stack_argv[16];
+    size_t stack_lens[16];
+    char **argv = stack_argv;
+    size_t *lens = stack_lens;
+    int argv_cap = 16;
+    char *p = batch->args;
+
+    for (int i = 0; i < batch->count; i++) {
+        int argc;
+        memcpy(&argc, p, sizeof(int));
+        p += sizeof(int);
+
+        if (argc > argv_cap) {
+            char **grown = malloc(argc * sizeof(char *));
+            size_t *grown_lens = malloc(argc * sizeof(size_t));
+            if (!grown || !grown_lens) {
+                free(grown);
+                free(grown_lens);
+                //-- Answer this command alone: every slot needs a reply length for pipeline_complete --//
+                size_t before = batch->reply.pending;
+                reply_add_format(&batch->reply, "[MemoraDB: ERROR] out of memory\r\n");
+                batch->reply_lens[i] = batch->reply.pending - before;
+                for (int a = 0; a < argc; a++) {
+                    size_t len;
+                    memcpy(&len, p, sizeof(size_t));
+                    p += sizeof(size_t) + len + 1;
+                }
+                continue;
+            }
+            if (argv != stack_argv) {
+                free(argv);
+                free(lens);
+            }
+            argv = grown;
+            lens = grown_lens;
+            argv_cap = argc;
+        }
+        for (int a = 0; a < argc; a++) {
+            memcpy(&lens[a], p, sizeof(size_t));
+            argv[a] = p + sizeof(size_t);
+            p += sizeof(size_t) + lens[a] + 1;
+        }
+
+        size_t before = batch->reply.pending;
+        router_dispatch(loop, batch->pipeline->conn, &batch->reply, argv, lens, argc);
+        batch->reply_lens[i] = batch->reply.pending - before;
+    }
+
+    if (argv != stack_argv) {
+        free(argv);
+        free(lens);
+    }
+}
+
+/**
+ * Back on the connection's loop once every owner answered: interleave the
+ * replies in request order.
+ */
+static void pipeline_complete(PipelineBatch *pipe) {
+    Connection *conn = pipe->conn;
+
+    if (conn->fd >= 0) {
+        int cursor[MAX_WORKERS] = {0};
+        for (int i = 0; i < pipe->count; i++) {
+            OwnerBatch *batch = pipe->by_owner[pipe->owner_of[i]];
+            reply_transfer(&conn->reply, &batch->reply, batch->reply_lens[cursor[batch->owner]++]);
+        }
+    }
+
+    for (int i = 0; i < MAX_WORKERS; i++) {
+        if (pipe->by_owner[i]) owner_batch_free(pipe->by_owner[i]);
+    }
+    free(pipe->owner_of);
+    free(pipe);
+
+    conn->batch = NULL;
+    connection_resume(conn);
+}
+
+static void router_complete(EventLoop *loop, LoopTask *task) {
+    (void)loop;
+    OwnerBatch *batch = (OwnerBatch *)task;
+    if (--batch->pipeline->outstanding == 0) {
+        pipeline_complete(batch->pipeline);
+    }
+}
+
+/**
+ * On the owning loop: execute against shards no other thread touches and
+ * send the same message back.
+ */
+static void router_execute(EventLoop *loop, LoopTask *task) {
+    OwnerBatch *batch = (OwnerBatch *)task;
+    owner_batch_execute(loop, batch);
+    batch->task.run = router_complete;
+    event_loop_post(batch->pipeline->origin, &batch->task);
+}
+
+/* ==================== Batch Building ==================== */
+
+static OwnerBatch *owner_batch_get(PipelineBatch *pipe, int owner) {
+    OwnerBatch *batch = pipe->by_owner[owner];
+    if (batch) return batch;
+
+    batch = calloc(1, sizeof(OwnerBatch));
+    if (!batch) return NULL;
+    batch->pipeline = pipe;
+    batch->owner = owner;
+    batch->task.run = router_execute;
+    reply_init(&batch->reply);
+    pipe->by_owner[owner] = batch;
+    return batch;
+}
+
+/**
+ * Append one command to an owner batch.
+ */
+static int owner_batch_push(OwnerBatch *batch, char *argv[], size_t lens[], int argc) {
+    if (batch->count == batch->cap) {
+        int cap = batch->cap ? batch->cap * 2 : 16;
+        size_t *reply_lens = realloc(batch->reply_lens, cap * sizeof(size_t));
+        if (!reply_lens) return -1;
+        batch->reply_lens = reply_lens;
+        batch->cap = cap;
+    }
+
+    size_t need = sizeof(int);
+    for (int i = 0; i < argc; i++) {
+        need += sizeof(size_t) + lens[i] + 1;
+    }
+    if (batch->args_len + need > batch->args_cap) {
+        size_t cap = batch->args_cap ? batch->args_cap : 256;
+        while (cap < batch->args_len + need) cap *= 2;
+        char *args = realloc(batch->args, cap);
+        if (!args) return -1;
+        batch->args = args;
+        batch->args_cap = cap;
+    }
+
+    char *p = batch->args + batch->args_len;
+    memcpy(p, &argc, sizeof(int));
+    p += sizeof(int);
+    for (int i = 0; i < argc; i++) {
+        memcpy(p, &lens[i], sizeof(size_t));
+        p += sizeof(size_t);
+        memcpy(p, argv[i], lens[i]);
+        p += lens[i];
+        *p++ = '\0';
+    }
+    batch->args_len += need;
+    batch->count++;
+    return 0;
+}
+
+int router_batch_add(Connection *conn, int owner, char *argv[], size_t lens[], int argc) {
+    PipelineBatch *pipe = conn->batch;
+    if (!pipe) {
+        pipe = calloc(1, sizeof(PipelineBatch));
+        if (!pipe) return -1;
+        pipe->conn = conn;
+        pipe->origin = conn->loop;
+        conn->batch = pipe;
+    }
+
+    if (pipe->count == pipe->cap) {
+        int cap = pipe->cap ? pipe->cap * 2 : 16;
+        unsigned char *owner_of = realloc(pipe->owner_of, cap);
+        if (!owner_of) return -1;
+        pipe->owner_of = owner_of;
+        pipe->cap = cap;
+    }
+
+    OwnerBatch *batch = owner_batch_get(pipe, owner);
+    if (!batch || owner_batch_push(batch, argv, lens, argc) != 0) return -1;
+    pipe->owner_of[pipe->count++] = (unsigned char)owner;
+    return 0;
+}
+
+void router_batch_submit(Connection *conn) {
+    PipelineBatch *pipe = conn->batch;
+    EventLoop *self = conn->loop;
+    conn->forward_pending = 1;
+
+    //-- Answers come back through our own inbox, so nothing completes before we return --//
+    pipe->outstanding = 0;
+    for (int i = 0; i < MAX_WORKERS; i++) {
+        if (pipe->by_owner[i]) pipe->outstanding++;
+    }
+
+    OwnerBatch *local = pipe->by_owner[self->id];
+    for (int i = 0; i < MAX_WORKERS; i++) {
+        OwnerBatch *batch = pipe->by_owner[i];
+        if (batch && batch != local) {
+            event_loop_post(event_loop_get(i), &batch->task);
+        }
+    }
+
+    //-- Our own share runs right here, while the other loops work on theirs --//
+    if (local) {
+        owner_batch_execute(self, local);
+        router_complete(self, &local->task);
+    }
+}
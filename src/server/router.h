@@ -0,0 +1,102 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/server/router.h
+ * Module                    : Shard-per-core Routing
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Shared-nothing execution mode. Each event loop owns a disjoint set of
+ *  keyspace shards and is the only thread that touches them, so the
+ *  shard locks are skipped. A command whose keys belong to another loop
+ *  is shipped to that loop's inbox, executed there, and its reply
+ *  shipped back to the connection's loop.
+ *
+ *  Threaded I/O reuses the same path: one execution loop owns every
+ *  shard, and the I/O loops forward it all commands that have keys.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#ifndef MEMORADB_ROUTER_H
+#define MEMORADB_ROUTER_H
+
+#include "event_loop.h"
+#include "reply.h"
+
+/* ==================== Routing Results ==================== */
+#define ROUTE_LOCAL     -1   //- Run on the calling loop -//
+#define ROUTE_CROSSSLOT -2   //- Keys owned by different loops: rejected -//
+
+struct Connection;
+
+/**
+ * Whether commands run on the loop owning their keys rather than on the
+ * connection's own: in shard-per-core mode and with threaded I/O.
+ */
+int router_enabled(void);
+
+/**
+ * Id of the loop executing every command with threaded I/O: the one after
+ * the I/O loops.
+ */
+int router_executor(void);
+
+/**
+ * Loop owning a keyspace shard.
+ * @param shard Shard index from keyspace_shard_of()
+ * @return The owning loop id
+ */
+int router_shard_owner(int shard);
+
+/**
+ * Decide where a command must run.
+ * @param loop Loop that received the command
+ * @param argv Command arguments
+ * @param lens Length of each argument
+ * @param argc Number of arguments
+ * @return ROUTE_LOCAL, ROUTE_CROSSSLOT or the id of the owning loop
+ */
+int router_route(EventLoop *loop, char *argv[], size_t lens[], int argc);
+
+/**
+ * Execute a command on the calling loop, answering CROSSSLOT when its
+ * keys are owned by different loops.
+ * @param loop Loop executing the command
+ * @param conn Connection that issued it, possibly owned by another loop
+ * @param reply Output buffer receiving the RESP reply
+ * @param argv Command arguments
+ * @param lens Length of each argument
+ * @param argc Number of arguments
+ */
+void router_dispatch(EventLoop *loop, struct Connection *conn, ReplyBuffer *reply, char *argv[], size_t lens[], int argc);
+
+/**
+ * Add a command to the connection's pipeline batch, creating the batch on
+ * first use. Nothing runs yet: every command, including those for the
+ * connection's own loop, is queued per owning loop until
+ * router_batch_submit(). The arguments are copied.
+ * @param conn Connection that issued the command
+ * @param owner Loop id that must run it
+ * @param argv Command arguments
+ * @param lens Length of each argument
+ * @param argc Number of arguments
+ * @return 0 on success, -1 on allocation failure
+ */
+int router_batch_add(struct Connection *conn, int owner, char *argv[], size_t lens[], int argc);
+
+/**
+ * Ship the queued commands, one message per owning loop; the share of the
+ * connection's own loop runs inline before returning. Once every loop
+ * has answered, the replies are merged into the connection's output in
+ * request order and connection_resume() is called on its loop.
+ * @param conn Connection with a pending batch
+ */
+void router_batch_submit(struct Connection *conn);
+
+#endif // MEMORADB_ROUTER_H
@@ -5,8 +5,8 @@
  * 
  * File                      : src/server/server.c
  * Module                    : MemoraDB Server
- * Last Updating Author      : shady0503
- * Last Update               : 02/10/2026
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
  * Version                   : 1.0.0
  * 
  * Description:
@@ -17,55 +17,74 @@
  * =====================================================
  */
 
+#define _GNU_SOURCE
 #include "server.h"
+#include "config.h"
+#include "event_loop.h"
+#include "router.h"
+#include "listener.h"
 #include "../utils/log.h"
 #include "../utils/hashTable.h"
+#include "../utils/siphash.h"
 #include "../parser/parser.h"
 #include "../utils/logo.h"
+#include <sys/resource.h>
+#include <sched.h>
 
-void *handle_client(void *arg) {
-    ClientContext *client_context = (ClientContext*)arg;
-    int client_fd = client_context->client_fd;
-    char client_ip[16];
-    strncpy(client_ip, client_context->ip_address, sizeof(client_ip));
-    int client_port = client_context->port;
-    free(arg);
-
-    char buffer[BUFFER_SIZE];
-    char *tokens[MAX_TOKENS];
-    
-    while (1) {
-        ssize_t bytes = recv(client_fd, buffer, sizeof(buffer)-1, 0);
-        if (bytes <= 0) {
-            break;
-        }
-        buffer[bytes] = '\0';
-        int token_count = parse_command(buffer, tokens, MAX_TOKENS);
-        if(token_count < 1){
-            dprintf(client_fd, "[MemoraDB: WARN] Invalid RESP format\r\n");
-            continue;
-        }
-        dispatch_command(client_fd, tokens, token_count);
+#ifndef TESTING
+/**
+ * Every client now costs a file descriptor instead of a thread, so the
+ * default soft limit of 1024 becomes the first ceiling we hit. Raise it
+ * to the hard limit.
+ */
+static void raise_open_files_limit(void) {
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0) return;
+    if (limit.rlim_cur >= limit.rlim_max) return;
+
+    rlim_t previous = limit.rlim_cur;
+    limit.rlim_cur = limit.rlim_max;
+    if (setrlimit(RLIMIT_NOFILE, &limit) != 0) {
+        log_message(LOG_WARN, "Could not raise open files limit above %lu: %s",
+                    (unsigned long)previous, strerror(errno));
+        return;
     }
+    log_message(LOG_INFO, "Open files limit raised from %lu to %lu",
+                (unsigned long)previous, (unsigned long)limit.rlim_cur);
+}
 
-    close(client_fd);
-    log_message(LOG_INFO, "Client %s disconnected on port %d", client_ip, client_port);
-    return NULL;
+/**
+ * A client past the open files limit would fail in accept() and stay in
+ * the queue; lower maxclients so that it is refused with an error instead.
+ * The loops' epoll sets, eventfds and listeners and the logs keep a reserve.
+ */
+static void fit_maxclients_to_open_files(void) {
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0 || limit.rlim_cur == RLIM_INFINITY) return;
+
+    rlim_t reserved = RESERVED_FDS + 4 * (rlim_t)(server_config.workers + 1);
+    if ((rlim_t)server_config.maxclients + reserved <= limit.rlim_cur) return;
+
+    int fitted = limit.rlim_cur > reserved ? (int)(limit.rlim_cur - reserved) : 1;
+    log_message(LOG_WARN, "MEMORADB_MAXCLIENTS=%d lowered to %d to fit the open files limit of %lu",
+                server_config.maxclients, fitted, (unsigned long)limit.rlim_cur);
+    server_config.maxclients = fitted;
 }
 
-static int parse_port_env(const char *name, int def_port) {
-    const char *s = getenv(name);
-    if (!s || !*s) return def_port;
-    char *end = NULL;
-    long v = strtol(s, &end, 10);
-    if (end == s || *end != '\0' || v < 1 || v > 65535) {
-        log_message(LOG_WARN, "Invalid %s='%s', falling back to %d", name, s, def_port);
-        return def_port;
+/**
+ * CPU for loop n: the n-th CPU the process may run on, wrapping around,
+ * so that pinning respects a cpuset or taskset the server was started in.
+ */
+static int allowed_cpu(int n) {
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) != 0 || CPU_COUNT(&set) == 0) return -1;
+    n %= CPU_COUNT(&set);
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &set) && n-- == 0) return cpu;
     }
-    return (int)v;
+    return -1;
 }
 
-#ifndef TESTING
 int main() {
     setbuf(stdout, NULL);
     setbuf(stderr, NULL);
@@ -75,84 +94,111 @@ int main() {
 
     log_message(LOG_INFO, "MemoraDB Server started successfully.");
 
-    int server_fd;
-    socklen_t client_addr_len;
-    struct sockaddr_in client_addr;
+    load_server_config();
+    raise_open_files_limit();
+    fit_maxclients_to_open_files();
 
-    server_fd = socket(AF_INET, SOCK_STREAM, 0);
-    if (server_fd == -1) {
-        log_message(LOG_ERROR, "Socket creation failed: %s", strerror(errno));
-        return 1;
+    //-- Secret per-process seed: bucket placement must not be predictable --//
+    if (hash_seed_random() != 0) {
+        log_message(LOG_WARN, "No kernel randomness, hash seed derived from time and pid.");
     }
-    
-    int one = 1;
-    setsockopt(server_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
-
-
-    int port = parse_port_env("MEMORADB_PORT", 6379);
-    const char *bind_ip = getenv("MEMORADB_BIND");
-    if (!bind_ip || !*bind_ip) bind_ip = "0.0.0.0";
-
-    struct sockaddr_in serv_addr;
-    memset(&serv_addr, 0, sizeof(serv_addr));
-    serv_addr.sin_family = AF_INET;
-    serv_addr.sin_port = htons(port);
-    if (inet_pton(AF_INET, bind_ip, &serv_addr.sin_addr) != 1) {
-        log_message(LOG_ERROR, "Invalid MEMORADB_BIND='%s'", bind_ip);
-        return 1;
+
+    //-- A client vanishing mid-reply must not kill the whole process --//
+    signal(SIGPIPE, SIG_IGN);
+
+    int somaxconn = listener_somaxconn();
+    if (somaxconn > 0 && server_config.tcp_backlog > somaxconn) {
+        log_message(LOG_WARN, "MEMORADB_TCP_BACKLOG=%d is capped by net.core.somaxconn=%d",
+                    server_config.tcp_backlog, somaxconn);
     }
 
-    if (bind(server_fd, (struct sockaddr *) &serv_addr, sizeof(serv_addr)) != 0) {
-        log_message(LOG_ERROR, "Bind failed: %s", strerror(errno));
-        return 1;
+    //-- Without SO_REUSEPORT every loop accepts from one shared socket --//
+    //-- With it, a plain bind first: the port must not be silently shared with a running server --//
+    int shared_fd = listener_open_tcp(server_config.bind_address, server_config.port,
+                                      server_config.tcp_backlog, 0);
+    if (shared_fd < 0) return 1;
+    if (server_config.reuseport) {
+        close(shared_fd);
+        shared_fd = -1;
     }
 
-    int connection_backlog = 5;
-    if (listen(server_fd, connection_backlog) != 0) {
-        log_message(LOG_ERROR, "Listen failed: %s", strerror(errno));
-        return 1;
+    //-- Co-located clients skip the TCP stack; every loop accepts from the one socket --//
+    int unix_fd = -1;
+    if (server_config.unix_socket) {
+        unix_fd = listener_open_unix(server_config.unix_socket, server_config.unix_socket_perm,
+                                     server_config.tcp_backlog);
+        if (unix_fd < 0) return 1;
     }
 
-    log_message(LOG_INFO, "Awaiting connections...");
+    //-- Each shard then has exactly one thread touching it: no locks needed --//
+    if (server_config.shard_per_core || server_config.io_threads > 0) {
+        keyspace_set_lockless(1);
+    }
 
-    for(;;) {
-        client_addr_len = sizeof(client_addr);
-        int client_fd = accept(server_fd, (struct sockaddr *) &client_addr, &client_addr_len);
-        if (client_fd < 0) {
-            log_message(LOG_ERROR, "Accept failed: %s", strerror(errno));
-            continue;
+    //-- Fixed set of event loops, each with its own accept queue under SO_REUSEPORT --//
+    EventLoop *loops[MAX_WORKERS];
+    for (int i = 0; i < server_config.workers; i++) {
+        loops[i] = event_loop_create(i);
+        if (!loops[i]) return 1;
+        int listen_fd = shared_fd;
+        if (server_config.reuseport) {
+            listen_fd = listener_open_tcp(server_config.bind_address, server_config.port,
+                                          server_config.tcp_backlog, 1);
         }
-
-        ClientContext *client_context = malloc(sizeof(ClientContext));
-        if(!client_context){
-          log_message(LOG_ERROR, "Failed to allocate client context");
-          close(client_fd);
-          continue;
+        if (listen_fd < 0 || event_loop_add_listener(loops[i], listen_fd) != 0) {
+            return 1;
         }
-
-        client_context->client_fd = client_fd;
-
-        if (inet_ntop(AF_INET, &client_addr.sin_addr, client_context->ip_address, sizeof(client_context->ip_address)) == NULL) {
-          log_message(LOG_ERROR, "Failed to convert client IP: %s", strerror(errno));
-          strncpy(client_context->ip_address, "unknown", sizeof(client_context->ip_address));
+        if (unix_fd >= 0 && event_loop_add_listener(loops[i], unix_fd) != 0) {
+            return 1;
         }
+        if (server_config.cpu_affinity) event_loop_set_cpu(loops[i], allowed_cpu(i));
+    }
 
-        client_context->port = ntohs(client_addr.sin_port);
-
-        log_message(LOG_INFO, "Client %s connected on port %d", client_context->ip_address, client_context->port);
-
-        pthread_t thread;
-        if (pthread_create(&thread, NULL, handle_client, client_context) != 0) {
-            log_message(LOG_ERROR, "pthread_create failed: %s", strerror(errno));
-            close(client_fd);
-            free(client_context);
-            continue;
+    //-- Threaded I/O: one more loop, fed by the others only, executes every command --//
+    EventLoop *main_loop = loops[0];
+    int first_thread = 1;
+    if (server_config.io_threads > 0) {
+        main_loop = event_loop_create(router_executor());
+        if (!main_loop) return 1;
+        if (server_config.cpu_affinity) event_loop_set_cpu(main_loop, allowed_cpu(router_executor()));
+        first_thread = 0;
+    }
+    for (int i = first_thread; i < server_config.workers; i++) {
+        if (event_loop_start(loops[i]) != 0) {
+            return 1;
         }
-        pthread_detach(thread);
     }
 
+    if (server_config.io_threads > 0) {
+        log_message(LOG_INFO, "Awaiting connections with %d I/O thread(s) and one execution thread...",
+                    server_config.io_threads);
+    } else {
+        log_message(LOG_INFO, "Awaiting connections with %d event loop(s)%s...", server_config.workers,
+                    server_config.shard_per_core ? ", shard-per-core" : "");
+    }
+    log_message(LOG_INFO, "Accepting up to %d clients, %d KB loop thread stacks",
+                server_config.maxclients, server_config.thread_stack_kb);
+    log_message(LOG_INFO, "Listening on %s:%d, %s, backlog %d%s", server_config.bind_address, server_config.port,
+                server_config.reuseport ? "one SO_REUSEPORT socket per loop" : "one shared socket",
+                server_config.tcp_backlog, server_config.cpu_affinity ? ", loops pinned to CPUs" : "");
+    if (unix_fd >= 0) {
+        log_message(LOG_INFO, "Listening on Unix socket %s, mode %#o", server_config.unix_socket,
+                    server_config.unix_socket_perm);
+    }
+
+    //-- The main thread runs loop 0, or the execution loop with threaded I/O --//
+    event_loop_run(main_loop);
+
     log_message(LOG_INFO, "Server shutting down...");
-    close(server_fd);
+    for (int i = 0; i < server_config.workers; i++) {
+        int tcp_fd = loops[i]->listeners[0].fd;
+        if (tcp_fd != shared_fd) close(tcp_fd);
+    }
+    if (shared_fd >= 0) close(shared_fd);
+    if (unix_fd >= 0) {
+        close(unix_fd);
+        unlink(server_config.unix_socket);
+    }
     return 0;
 }
 #endif
\ No newline at end of file
@@ -5,8 +5,8 @@
  * 
  * File                      : src/server/server.h
  * Module                    : MemoraDB Server Header
- * Last Updating Author      : youssefbouraoui1
- * Last Update               : 02/02/2026
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
  * Version                   : 1.0.0
  * 
  * Description:
@@ -35,27 +35,13 @@
 
 //-- Config Constants --//
 #define BUFFER_SIZE 1024
-#define MAX_TOKENS 16
+#define MAX_TOKENS (1024 * 1024)   //- Arguments per request: room for MGET/MSET over many keys -//
 #define DEFAULT_PORT 6379
-#define CONNECTION_BACKLOG 5
+#define CONNECTION_BACKLOG 511
+#define RESERVED_FDS 32            //- Descriptors kept free of clients for the server's own use -//
 #define RESP_TERMINATOR_LEN 2
 
 extern volatile int server_running;
 extern int server_fd_global;
 
-
-// ClientContext stores per-client connection metadata (socket fd + remote address info).
-typedef struct {
-  int client_fd;
-  char ip_address[16]; 
-  int port; 
-} ClientContext;
-
-/**
- * Handle client connection in separate thread
- * @param arg: Pointer to the client's ClientContext structure
- * @return: NULL on completion
- */
-void *handle_client(void *arg);
-
 #endif
\ No newline at end of file
@@ -0,0 +1,126 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/server/stats.c
+ * Module                    : Server Statistics
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Server-wide metrics and the INFO command. Counters live with the
+ *  code they measure; this module samples them into per-second rates
+ *  from loop 0's cron and renders everything as INFO text.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include "stats.h"
+#include "config.h"
+#include "event_loop.h"
+#include "blocking.h"
+#include "connection.h"
+#include "../utils/hashTable.h"
+#include "../utils/slab.h"
+#include <stdio.h>
+
+#define STATS_INFO_MAX 4096
+
+/* ==================== Rate Sampling ==================== */
+
+static long long sample_time_ms = 0;
+static unsigned long long sample_expired = 0;
+static unsigned long long expired_per_sec = 0;   //- Written by loop 0, read by any loop -//
+
+void stats_cron(long long now_ms) {
+    if (sample_time_ms != 0 && now_ms - sample_time_ms < STATS_SAMPLE_MS) return;
+
+    ExpireStats expire;
+    keyspace_expire_stats(&expire);
+    if (sample_time_ms != 0) {
+        unsigned long long rate = (expire.expired_keys - sample_expired) * 1000 /
+                                  (unsigned long long)(now_ms - sample_time_ms);
+        __atomic_store_n(&expired_per_sec, rate, __ATOMIC_RELAXED);
+    }
+    sample_time_ms = now_ms;
+    sample_expired = expire.expired_keys;
+}
+
+unsigned long long stats_expired_per_sec(void) {
+    return __atomic_load_n(&expired_per_sec, __ATOMIC_RELAXED);
+}
+
+/* ==================== INFO ==================== */
+
+void stats_info(ReplyBuffer *reply) {
+    char info[STATS_INFO_MAX];
+    ExpireStats expire;
+    keyspace_expire_stats(&expire);
+    ConnectionStats clients;
+    connection_stats(&clients);
+
+    int len = snprintf(info, sizeof(info),
+        "# Server\r\n"
+        "event_loops:%d\r\n"
+        "shard_per_core:%d\r\n"
+        "io_threads:%d\r\n"
+        "tcp_backlog:%d\r\n"
+        "reuseport:%d\r\n"
+        "cpu_affinity:%d\r\n"
+        "unix_socket:%s\r\n"
+        "\r\n"
+        "# Clients\r\n"
+        "connected_clients:%zu\r\n"
+        "maxclients:%d\r\n"
+        "blocked_clients:%zu\r\n"
+        "total_connections_received:%llu\r\n"
+        "rejected_connections:%llu\r\n"
+        "timeout:%d\r\n"
+        "tcp_keepalive:%d\r\n"
+        "timedout_connections:%llu\r\n"
+        "\r\n"
+        "# Keyspace\r\n"
+        "keys:%zu\r\n"
+        "expires:%zu\r\n"
+        "\r\n"
+        "# Expiry\r\n"
+        "expired_keys:%llu\r\n"
+        "expired_keys_per_sec:%llu\r\n"
+        "expired_bytes:%llu\r\n"
+        "active_expire_cycles:%llu\r\n"
+        "active_expire_time_us:%llu\r\n"
+        "active_expire_timelimit_exits:%llu\r\n",
+        event_loop_count(), server_config.shard_per_core, server_config.io_threads,
+        server_config.tcp_backlog, server_config.reuseport, server_config.cpu_affinity,
+        server_config.unix_socket ? server_config.unix_socket : "",
+        clients.connected, server_config.maxclients, blocking_client_count(), clients.received, clients.rejected,
+        server_config.timeout, server_config.tcp_keepalive, clients.timedout,
+        hashtable_key_count(), hashtable_expires_count(),
+        expire.expired_keys, stats_expired_per_sec(), expire.expired_bytes,
+        expire.active_cycles, expire.active_time_us, expire.timelimit_exits);
+    if (len < 0) len = 0;
+
+    //-- Slab classes in use: pages reserved, objects allocated, bytes callers asked for --//
+    SlabStats slab;
+    slab_stats(&slab);
+    len += snprintf(info + len, len < (int)sizeof(info) ? sizeof(info) - len : 0,
+        "\r\n"
+        "# Memory\r\n"
+        "slab_reserved_bytes:%zu\r\n"
+        "slab_allocated_bytes:%zu\r\n"
+        "slab_requested_bytes:%zu\r\n"
+        "large_allocated_bytes:%zu\r\n",
+        slab.reserved, slab.allocated, slab.requested, slab.large);
+    for (int cls = 0; cls < SLAB_CLASSES; cls++) {
+        const SlabClassStats *c = &slab.classes[cls];
+        if (c->reserved == 0 || len >= (int)sizeof(info)) continue;
+        len += snprintf(info + len, sizeof(info) - len, "slab_class_%zu:reserved=%zu,allocated=%zu,requested=%zu\r\n",
+                        c->size, c->reserved, c->allocated, c->requested);
+    }
+
+    if ((size_t)len >= sizeof(info)) len = sizeof(info) - 1;
+    reply_add_bulk(reply, info, (size_t)len);
+}
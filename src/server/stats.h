@@ -0,0 +1,46 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/server/stats.h
+ * Module                    : Server Statistics
+ * Last Updating Author      : agent
+ * Last Update               : 10/17/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Server-wide metrics and the INFO command. Counters live with the
+ *  code they measure; this module samples them into per-second rates
+ *  from loop 0's cron and renders everything as INFO text.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#ifndef MEMORADB_STATS_H
+#define MEMORADB_STATS_H
+
+#include "reply.h"
+
+#define STATS_SAMPLE_MS 1000   //- Window of the instantaneous rates -//
+
+/**
+ * Sample counters for the instantaneous rates. Called from one thread
+ * only (loop 0's cron); at most once per STATS_SAMPLE_MS takes effect.
+ * @param now_ms Monotonic time in milliseconds
+ */
+void stats_cron(long long now_ms);
+
+/**
+ * @return Keys expired per second over the last sample window
+ */
+unsigned long long stats_expired_per_sec(void);
+
+/**
+ * Append the INFO reply, a bulk string of "# Section" headers and
+ * "field:value" lines.
+ */
+void stats_info(ReplyBuffer *reply);
+
+#endif // MEMORADB_STATS_H
@@ -0,0 +1,246 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/utils/epoch.c
+ * Module                    : Epoch-based Reclamation
+ * Last Updating Author      : agent
+ * Last Update               : 10/17/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Every thread that reads or retires owns an EpochRecord, published once
+ *  on a global lock-free list. A record announces the epoch its thread
+ *  entered in; the global epoch only moves from e to e+1 when every active
+ *  record is at e. An object retired during epoch e is therefore
+ *  unreachable by any reader once the global epoch reaches e+2.
+ *
+ *  Retired objects sit in a per-thread limbo list, in retire order, so
+ *  freeing is a prefix scan. When a thread exits, its leftovers move to a
+ *  shared orphan list that later collections drain.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include "epoch.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+/* ==================== Records ==================== */
+
+typedef struct {
+    void *ptr;
+    void (*free_fn)(void *);
+    uint64_t epoch;           //- Global epoch observed after the object was unlinked -//
+} Retired;
+
+typedef struct {
+    Retired *items;
+    size_t head;              //- First item not yet freed -//
+    size_t len;
+    size_t cap;
+} Limbo;
+
+typedef struct EpochRecord {
+    uint64_t state;           //- (epoch << 1) | active, read by every thread -//
+    int in_use;               //- Claimed by a live thread, accessed atomically -//
+    int depth;                //- Section nesting, owner only -//
+    unsigned int retires;     //- Retires since the last collection, owner only -//
+    Limbo limbo;
+    struct EpochRecord *next; //- Immutable once published -//
+} __attribute__((aligned(64))) EpochRecord;
+
+static uint64_t global_epoch = 1;
+static EpochRecord *records = NULL;
+
+static pthread_once_t epoch_once = PTHREAD_ONCE_INIT;
+static pthread_key_t epoch_key;
+static __thread EpochRecord *self = NULL;
+
+static pthread_mutex_t orphans_mutex = PTHREAD_MUTEX_INITIALIZER;
+static Limbo orphans;
+static int orphans_pending = 0;
+
+/* ==================== Limbo Lists ==================== */
+
+static int limbo_push(Limbo *limbo, void *ptr, void (*free_fn)(void *), uint64_t epoch) {
+    if (limbo->len == limbo->cap) {
+        //-- Compact the freed prefix before growing --//
+        if (limbo->head > 0) {
+            memmove(limbo->items, limbo->items + limbo->head,
+                    (limbo->len - limbo->head) * sizeof(Retired));
+            limbo->len -= limbo->head;
+            limbo->head = 0;
+        }
+        if (limbo->len == limbo->cap) {
+            size_t cap = limbo->cap ? limbo->cap * 2 : 256;
+            Retired *items = realloc(limbo->items, cap * sizeof(Retired));
+            if (!items) return -1;
+            limbo->items = items;
+            limbo->cap = cap;
+        }
+    }
+    limbo->items[limbo->len++] = (Retired){ ptr, free_fn, epoch };
+    return 0;
+}
+
+/**
+ * Free every object retired at least two epochs before `epoch`.
+ */
+static void limbo_free_before(Limbo *limbo, uint64_t epoch) {
+    while (limbo->head < limbo->len && limbo->items[limbo->head].epoch + 2 <= epoch) {
+        Retired *r = &limbo->items[limbo->head++];
+        r->free_fn(r->ptr);
+    }
+    if (limbo->head == limbo->len) {
+        limbo->head = 0;
+        limbo->len = 0;
+    }
+}
+
+/* ==================== Thread Registration ==================== */
+
+static void epoch_thread_exit(void *arg) {
+    EpochRecord *rec = arg;
+
+    //-- Hand leftovers to whoever collects next; the record is reused as-is --//
+    pthread_mutex_lock(&orphans_mutex);
+    for (size_t i = rec->limbo.head; i < rec->limbo.len; i++) {
+        Retired *r = &rec->limbo.items[i];
+        if (limbo_push(&orphans, r->ptr, r->free_fn, r->epoch) != 0) break;
+    }
+    __atomic_store_n(&orphans_pending, orphans.len > orphans.head, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&orphans_mutex);
+
+    rec->limbo.head = 0;
+    rec->limbo.len = 0;
+    rec->depth = 0;
+    rec->retires = 0;
+    __atomic_store_n(&rec->state, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&rec->in_use, 0, __ATOMIC_RELEASE);
+}
+
+static void epoch_init(void) {
+    pthread_key_create(&epoch_key, epoch_thread_exit);
+}
+
+/**
+ * Claim a record released by an exited thread, or publish a new one.
+ */
+static EpochRecord *epoch_register(void) {
+    pthread_once(&epoch_once, epoch_init);
+
+    EpochRecord *rec = __atomic_load_n(&records, __ATOMIC_ACQUIRE);
+    for (; rec; rec = rec->next) {
+        int expected = 0;
+        if (__atomic_load_n(&rec->in_use, __ATOMIC_RELAXED) == 0 &&
+            __atomic_compare_exchange_n(&rec->in_use, &expected, 1, 0,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+
+    if (!rec) {
+        if (posix_memalign((void **)&rec, 64, sizeof(EpochRecord)) != 0) abort();
+        memset(rec, 0, sizeof(*rec));
+        rec->in_use = 1;
+        EpochRecord *head = __atomic_load_n(&records, __ATOMIC_RELAXED);
+        do {
+            rec->next = head;
+        } while (!__atomic_compare_exchange_n(&records, &head, rec, 1,
+                                              __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    }
+
+    pthread_setspecific(epoch_key, rec);
+    self = rec;
+    return rec;
+}
+
+static inline EpochRecord *epoch_self(void) {
+    return self ? self : epoch_register();
+}
+
+/* ==================== Read-side Sections ==================== */
+
+void epoch_enter(void) {
+    EpochRecord *rec = epoch_self();
+    if (rec->depth++ > 0) return;
+
+    //-- Re-announce if the epoch moved before our announcement became visible --//
+    uint64_t epoch = __atomic_load_n(&global_epoch, __ATOMIC_RELAXED);
+    for (;;) {
+        __atomic_store_n(&rec->state, (epoch << 1) | 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        uint64_t now = __atomic_load_n(&global_epoch, __ATOMIC_RELAXED);
+        if (now == epoch) break;
+        epoch = now;
+    }
+}
+
+void epoch_exit(void) {
+    EpochRecord *rec = self;
+    if (--rec->depth > 0) return;
+    __atomic_store_n(&rec->state, 0, __ATOMIC_RELEASE);
+}
+
+/* ==================== Reclamation ==================== */
+
+/**
+ * Advance the global epoch if every active thread has caught up with it.
+ * @return The global epoch after the attempt
+ */
+static uint64_t epoch_try_advance(void) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    uint64_t epoch = __atomic_load_n(&global_epoch, __ATOMIC_RELAXED);
+
+    for (EpochRecord *rec = __atomic_load_n(&records, __ATOMIC_ACQUIRE); rec; rec = rec->next) {
+        uint64_t state = __atomic_load_n(&rec->state, __ATOMIC_ACQUIRE);
+        if ((state & 1) && (state >> 1) != epoch) return epoch;
+    }
+
+    //-- Losing the race is fine: someone else advanced it --//
+    __atomic_compare_exchange_n(&global_epoch, &epoch, epoch + 1, 0,
+                                __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+    return __atomic_load_n(&global_epoch, __ATOMIC_ACQUIRE);
+}
+
+void epoch_retire(void *ptr, void (*free_fn)(void *)) {
+    EpochRecord *rec = epoch_self();
+
+    //-- The unlink must be ordered before the epoch we stamp it with --//
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    uint64_t epoch = __atomic_load_n(&global_epoch, __ATOMIC_RELAXED);
+
+    if (limbo_push(&rec->limbo, ptr, free_fn, epoch) != 0) {
+        //-- Out of memory for bookkeeping: wait out the grace period instead --//
+        while (epoch_try_advance() < epoch + 2) {
+            if (rec->depth > 0) abort();   //- Would wait on ourselves -//
+        }
+        free_fn(ptr);
+        return;
+    }
+
+    if (++rec->retires >= EPOCH_COLLECT_INTERVAL) epoch_collect();
+}
+
+void epoch_collect(void) {
+    EpochRecord *rec = self;
+
+    if (__atomic_load_n(&orphans_pending, __ATOMIC_ACQUIRE) &&
+        pthread_mutex_trylock(&orphans_mutex) == 0) {
+        limbo_free_before(&orphans, epoch_try_advance());
+        __atomic_store_n(&orphans_pending, orphans.len > orphans.head, __ATOMIC_RELEASE);
+        pthread_mutex_unlock(&orphans_mutex);
+    }
+
+    if (!rec || rec->limbo.len == rec->limbo.head) return;
+    rec->retires = 0;
+    limbo_free_before(&rec->limbo, epoch_try_advance());
+}
+
+size_t epoch_pending(void) {
+    return self ? self->limbo.len - self->limbo.head : 0;
+}
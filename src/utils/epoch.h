@@ -0,0 +1,61 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/utils/epoch.h
+ * Module                    : Epoch-based Reclamation
+ * Last Updating Author      : agent
+ * Last Update               : 10/17/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Deferred freeing for memory that lock-free readers may still hold.
+ *  A reader brackets its accesses with epoch_enter()/epoch_exit(); a
+ *  writer unlinks an object and hands it to epoch_retire() instead of
+ *  freeing it. The object is freed once the global epoch has advanced
+ *  twice, by which point every reader that could have seen it has left.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#ifndef MEMORADB_EPOCH_H
+#define MEMORADB_EPOCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define EPOCH_COLLECT_INTERVAL 64   //- Retires between reclamation attempts -//
+
+/**
+ * Enter a read-side critical section on the calling thread. Sections
+ * nest; memory reached inside one stays valid until the outermost
+ * epoch_exit(). Sections must be short and must not block.
+ */
+void epoch_enter(void);
+
+/**
+ * Leave the innermost read-side critical section.
+ */
+void epoch_exit(void);
+
+/**
+ * Free `ptr` with `free_fn` once no reader can still hold it. The caller
+ * must already have unlinked it from every shared structure.
+ */
+void epoch_retire(void *ptr, void (*free_fn)(void *));
+
+/**
+ * Try to advance the global epoch and free the calling thread's retired
+ * objects that are past their grace period. Cheap when nothing is pending;
+ * event loops call it once per iteration.
+ */
+void epoch_collect(void);
+
+/**
+ * @return Objects retired by the calling thread and not yet freed
+ */
+size_t epoch_pending(void);
+
+#endif // MEMORADB_EPOCH_H
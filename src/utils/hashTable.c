@@ -5,8 +5,8 @@
  * 
  * File                      : src/utils/hashTable.c
  * Module                    : Hash Table
- * Last Updating Author      : youssefbouraoui1
- * Last Update               : 02/08/2026
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
  * Version                   : 1.0.0
  * 
  * Description:
@@ -18,29 +18,47 @@
 
 #include "hashTable.h"
 #include <stdio.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <pthread.h>
 #include <sys/time.h>
+#include <time.h>
+#include <limits.h>
+#include <ctype.h>
+#include <errno.h>
+#include <math.h>
+#include "siphash.h"
+#include "epoch.h"
+#include "slab.h"
 
 /*
  * Hash Table Implementation
  * 
  * This hash table uses separate chaining for collision resolution.
  * Each entry contains a key-value pair and a pointer to the next entry.
+ * The bucket array grows and shrinks with the number of keys; resizing is
+ * incremental (see HashTable in hashTable.h).
+ *
+ * Fields a lock-free GET walks (bucket slots, next links, the bucket array
+ * pointers and masks, an entry's expiry) are written with HT_STORE and read
+ * with HT_LOAD; anything unlinked goes through epoch_retire(). An entry's
+ * key, type and string value are fixed before it is linked, so a GET never
+ * sees them change.
  */
 
-unsigned int hash(const char *key) {
-    unsigned int h = 0;
-    while (*key) {
-        h = (h << 5) + *key++;
-    }
-    return h % TABLE_SIZE;
+#define HT_LOAD(field)         __atomic_load_n(&(field), __ATOMIC_ACQUIRE)
+#define HT_STORE(field, value) __atomic_store_n(&(field), (value), __ATOMIC_RELEASE)
+
+uint64_t hash(const char *key, size_t len) {
+    return hash_bytes(key, len);
 }
 
-pthread_mutex_t hashtable_mutex = PTHREAD_MUTEX_INITIALIZER;
+KeyspaceShard KEYSPACE[KEYSPACE_SHARDS];
 
-Entry *HASHTABLE[TABLE_SIZE] = {0};
+static pthread_once_t keyspace_once = PTHREAD_ONCE_INIT;
+static int keyspace_lockless = 0;
+static ExpireStats expire_stats;   //- Updated with relaxed atomics from any thread -//
 
 long long current_millis() {
     struct timeval tv;
@@ -48,210 +66,1442 @@ long long current_millis() {
     return ((long long)tv.tv_sec) * 1000 + tv.tv_usec / 1000;
 }
 
-void set_value(const char *key, const char *value, long long px) {
-    pthread_mutex_lock(&hashtable_mutex);
-    unsigned int idx = hash(key);
-    Entry *entry = HASHTABLE[idx];
-    long long expiry = (px > 0) ? current_millis() + px : 0;
+long long expiry_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    //-- +1 keeps it clear of 0, which means "no deadline" --//
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000 + 1;
+}
 
-    while (entry) {
-        if (strcmp(entry->key, key) == 0) {
-            //-- Free old value based on type --//
-            if (entry->type == VALUE_STRING) {
-                free(entry->data.string_value);
-            } else if (entry->type == VALUE_LIST) {
-                list_free(entry->data.list_value);
-            }
-            
-            entry->type = VALUE_STRING;
-            entry->data.string_value = strdup(value);
-            entry->expiry = expiry;
-            pthread_mutex_unlock(&hashtable_mutex);
-            return;
+long long expiry_from_unix_ms(long long unix_ms) {
+    long long delta, deadline;
+    if (__builtin_sub_overflow(unix_ms, current_millis(), &delta) ||
+        __builtin_add_overflow(expiry_now(), delta, &deadline)) {
+        return unix_ms > 0 ? LLONG_MAX : 1;
+    }
+    return deadline > 0 ? deadline : 1;   //- Already in the past, still a deadline -//
+}
+
+/* ==================== Entries ==================== */
+
+/**
+ * Copy a value into a buffer of its own, sized to its slab class.
+ * @return The copy, NULL if out of memory
+ */
+static StoredString *stored_string_create(const char *value, size_t len) {
+    if (len >= UINT32_MAX) return NULL;
+    size_t size = slab_good_size(sizeof(StoredString) + len + 1);
+    StoredString *string = slab_alloc(size);
+    if (!string) return NULL;
+    string->len = (uint32_t)len;
+    string->capacity = (uint32_t)(size - sizeof(StoredString));
+    memcpy(string->buf, value, len);
+    string->buf[len] = '\0';
+    return string;
+}
+
+static void stored_string_free(StoredString *string) {
+    slab_free(string, sizeof(StoredString) + string->capacity);
+}
+
+/**
+ * Offset of an embedded value: just past the key and its NUL, aligned.
+ */
+static inline size_t entry_embed_offset(size_t key_len) {
+    size_t align = _Alignof(StoredString);
+    return (offsetof(Entry, key) + key_len + 1 + align - 1) & ~(align - 1);
+}
+
+static inline int entry_embeds_value(const Entry *entry) {
+    return entry->type == VALUE_STRING && entry->encoding == STRING_RAW &&
+           (const char *)entry->data.string_value == (const char *)entry + entry_embed_offset(entry->key_len);
+}
+
+//-- A raw string too long to embed lives in a buffer of its own --//
+static inline int entry_owns_string(const Entry *entry) {
+    return entry->type == VALUE_STRING && entry->encoding == STRING_RAW && !entry_embeds_value(entry);
+}
+
+/**
+ * Bytes allocated for the entry itself, embedded value included.
+ */
+static size_t entry_size(const Entry *entry) {
+    if (entry_embeds_value(entry)) {
+        return entry_embed_offset(entry->key_len) + sizeof(StoredString) + entry->data.string_value->capacity;
+    }
+    return offsetof(Entry, key) + entry->key_len + 1;
+}
+
+/**
+ * Parse a canonical 64-bit integer: an optional '-', then digits with no
+ * leading zero. Exactly the strings integer_to_string() writes back, so
+ * storing one as a number never changes what GET returns.
+ * @return 1 with *out set, 0 otherwise
+ */
+static int string_to_integer(const char *s, size_t len, long long *out) {
+    if (len == 0 || len >= INT_TEXT_MAX) return 0;
+    size_t i = s[0] == '-';
+    if (i == len || (s[i] == '0' && len > 1)) return 0;   //- "-", "-0" and "007" stay strings -//
+
+    unsigned long long v = 0;
+    for (; i < len; i++) {
+        if (s[i] < '0' || s[i] > '9') return 0;
+        unsigned digit = (unsigned)(s[i] - '0');
+        if (v > (ULLONG_MAX - digit) / 10) return 0;
+        v = v * 10 + digit;
+    }
+    if (s[0] == '-') {
+        if (v > (unsigned long long)LLONG_MAX + 1) return 0;
+        *out = v == (unsigned long long)LLONG_MAX + 1 ? LLONG_MIN : -(long long)v;
+    } else {
+        if (v > (unsigned long long)LLONG_MAX) return 0;
+        *out = (long long)v;
+    }
+    return 1;
+}
+
+/**
+ * Write value as text followed by a NUL.
+ * @param buf At least INT_TEXT_MAX bytes
+ * @return The text length
+ */
+static size_t integer_to_string(long long value, char *buf) {
+    char tmp[INT_TEXT_MAX];
+    unsigned long long v = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    char *p = tmp + sizeof(tmp);
+    do {
+        *--p = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+    if (value < 0) *--p = '-';
+
+    size_t len = (size_t)(tmp + sizeof(tmp) - p);
+    memcpy(buf, p, len);
+    buf[len] = '\0';
+    return len;
+}
+
+//-- Text of 0..SHARED_INTEGERS-1, built once with the keyspace --//
+static char shared_integers[SHARED_INTEGERS][8];
+
+static void shared_integers_init(void) {
+    for (int i = 0; i < SHARED_INTEGERS; i++) {
+        integer_to_string(i, shared_integers[i]);
+    }
+}
+
+/**
+ * Text of an integer value: shared for small ones, rendered into buf
+ * otherwise.
+ */
+static const char *integer_text(long long value, char *buf, size_t *len) {
+    if (value >= 0 && value < SHARED_INTEGERS) {
+        *len = strlen(shared_integers[value]);
+        return shared_integers[value];
+    }
+    *len = integer_to_string(value, buf);
+    return buf;
+}
+
+/**
+ * Allocate an unlinked entry. A string that reads as an integer is kept
+ * as the number; other strings are embedded when the whole entry fits in
+ * ENTRY_EMBED_MAX bytes and copied to their own buffer otherwise. A list
+ * entry gets its list from the caller.
+ * @return The entry, NULL if out of memory
+ */
+static Entry *entry_create(const char *key, size_t key_len, value_type_t type,
+                           const char *value, size_t value_len) {
+    if (key_len >= UINT32_MAX) return NULL;
+    long long integer = 0;
+    int is_integer = type == VALUE_STRING && string_to_integer(value, value_len, &integer);
+    size_t offset = entry_embed_offset(key_len);
+    size_t size = offsetof(Entry, key) + key_len + 1;
+    int embed = type == VALUE_STRING && !is_integer &&
+                offset + sizeof(StoredString) + value_len + 1 <= ENTRY_EMBED_MAX;
+    if (embed) size = slab_good_size(offset + sizeof(StoredString) + value_len + 1);
+
+    Entry *entry = slab_alloc(size);
+    if (!entry) return NULL;
+    entry->next = NULL;
+    entry->data.list_value = NULL;
+    entry->key_len = (uint32_t)key_len;
+    entry->type = (uint8_t)type;
+    entry->encoding = is_integer ? STRING_INT : STRING_RAW;
+    entry->expiry = 0;
+    heap_node_init(&entry->expire_node);
+    memcpy(entry->key, key, key_len);
+    entry->key[key_len] = '\0';
+
+    if (type != VALUE_STRING) return entry;
+    if (is_integer) {
+        entry->data.int_value = integer;
+        return entry;
+    }
+
+    StoredString *string;
+    if (embed) {
+        string = (StoredString *)((char *)entry + offset);
+        string->len = (uint32_t)value_len;
+        string->capacity = (uint32_t)(size - offset - sizeof(StoredString));
+        memcpy(string->buf, value, value_len);
+        string->buf[value_len] = '\0';
+    } else if (!(string = stored_string_create(value, value_len))) {
+        slab_free(entry, size);
+        return NULL;
+    }
+    entry->data.string_value = string;
+    return entry;
+}
+
+static void free_entry(void *ptr) {
+    Entry *entry = ptr;
+    size_t size = entry_size(entry);
+    if (entry_owns_string(entry)) {
+        stored_string_free(entry->data.string_value);
+    } else if (entry->type == VALUE_LIST) {
+        list_free(entry->data.list_value);
+    }
+    slab_free(entry, size);
+}
+
+static inline int entry_key_is(const Entry *entry, const char *key, size_t key_len) {
+    return entry->key_len == key_len && memcmp(entry->key, key, key_len) == 0;
+}
+
+/* ==================== Table Maintenance ==================== */
+
+static int ht_is_rehashing(const HashTable *ht) {
+    return ht->rehashidx != -1;
+}
+
+/**
+ * Move up to `steps` non-empty buckets from ht[0] to ht[1]. Visiting empty
+ * buckets is bounded too, so a sparse table cannot turn one call into a
+ * long scan.
+ */
+static void ht_rehash_step(HashTable *ht, int steps) {
+    int empty_visits = steps * HT_REHASH_EMPTY_VISITS;
+    HashBuckets *from = &ht->ht[0];
+    HashBuckets *to = &ht->ht[1];
+
+    while (steps-- && from->used > 0) {
+        while (from->table[ht->rehashidx] == NULL) {
+            HT_STORE(ht->rehashidx, ht->rehashidx + 1);
+            if (--empty_visits == 0) return;
         }
-        entry = entry->next;
-    }
-
-    //-- New entry --//
-    entry = malloc(sizeof(Entry));
-    entry->key = strdup(key);
-    entry->type = VALUE_STRING;
-    entry->data.string_value = strdup(value);
-    entry->expiry = expiry;
-    entry->next = HASHTABLE[idx];
-    HASHTABLE[idx] = entry;
-    pthread_mutex_unlock(&hashtable_mutex);
-}
-
-const char *get_value(const char *key) {
-    pthread_mutex_lock(&hashtable_mutex);
-    unsigned int idx = hash(key);
-    Entry *prev = NULL;
-    Entry *entry = HASHTABLE[idx];
-    long long now = current_millis();
-
-    while (entry) {
-        if (strcmp(entry->key, key) == 0) {
-            if (entry->expiry > 0 && entry->expiry <= now) {
-                if (prev)
-                    prev->next = entry->next;
-                else
-                    HASHTABLE[idx] = entry->next;
-
-                free(entry->key);
-                if (entry->type == VALUE_STRING) {
-                    free(entry->data.string_value);
-                } else if (entry->type == VALUE_LIST) {
-                    list_free(entry->data.list_value);
-                }
-                free(entry);
-                pthread_mutex_unlock(&hashtable_mutex);
-                return NULL;
-            } else {
-                if (entry->type == VALUE_STRING) {
-                    const char *result = entry->data.string_value;
-                    pthread_mutex_unlock(&hashtable_mutex);
-                    return result;
-                }
-                pthread_mutex_unlock(&hashtable_mutex);
-                return NULL;
-            }
+
+        Entry *entry = from->table[ht->rehashidx];
+        while (entry) {
+            Entry *next = entry->next;
+            unsigned long idx = hash(entry->key, entry->key_len) & to->sizemask;
+            HT_STORE(entry->next, to->table[idx]);
+            HT_STORE(to->table[idx], entry);
+            from->used--;
+            to->used++;
+            entry = next;
         }
-        prev = entry;
-        entry = entry->next;
+        HT_STORE(from->table[ht->rehashidx], NULL);
+        HT_STORE(ht->rehashidx, ht->rehashidx + 1);
     }
 
-    pthread_mutex_unlock(&hashtable_mutex);
-    return NULL;
+    //-- Migration finished: the new array becomes the main one --//
+    if (from->used == 0) {
+        epoch_retire(from->table, free);
+        HT_STORE(from->table, to->table);
+        HT_STORE(from->sizemask, to->sizemask);
+        from->size = to->size;
+        from->used = to->used;
+        HT_STORE(to->table, NULL);
+        HT_STORE(to->sizemask, 0);
+        to->size = 0;
+        to->used = 0;
+        HT_STORE(ht->rehashidx, -1);
+    }
 }
 
-List *get_or_create_list(const char *key) {
-    pthread_mutex_lock(&hashtable_mutex);
-    unsigned int idx = hash(key);
-    Entry *entry = HASHTABLE[idx];
-    long long now = current_millis();
+/**
+ * Start migrating to a bucket array sized for `target` keys.
+ */
+static void ht_resize(HashTable *ht, unsigned long target) {
+    unsigned long size = HT_INITIAL_SIZE;
+    while (size < target) size <<= 1;
+    if (size == ht->ht[0].size) return;
 
-    while (entry) {
-        if (strcmp(entry->key, key) == 0) {
-            if (entry->expiry > 0 && entry->expiry <= now) {
-                pthread_mutex_unlock(&hashtable_mutex);
-                return NULL;
-            }
-            if (entry->type == VALUE_LIST) {
-                List *list = entry->data.list_value;
-                pthread_mutex_unlock(&hashtable_mutex);
-                return list;
-            } else {
-                pthread_mutex_unlock(&hashtable_mutex);
-                return NULL;
+    Entry **table = calloc(size, sizeof(Entry *));
+    if (!table) return;   //- Keep serving from the current table, retry on a later write -//
+
+    if (ht->ht[0].table == NULL) {
+        HT_STORE(ht->ht[0].sizemask, size - 1);
+        HT_STORE(ht->ht[0].table, table);
+        ht->ht[0].size = size;
+        ht->ht[0].used = 0;
+        return;
+    }
+
+    HT_STORE(ht->ht[1].sizemask, size - 1);
+    HT_STORE(ht->ht[1].table, table);
+    ht->ht[1].size = size;
+    ht->ht[1].used = 0;
+    HT_STORE(ht->rehashidx, 0);
+}
+
+/**
+ * Called on every write: advance a resize in progress, or start one when
+ * the load factor leaves its bounds.
+ */
+static void ht_maintain(HashTable *ht) {
+    if (ht_is_rehashing(ht)) {
+        ht_rehash_step(ht, HT_REHASH_STEP);
+        return;
+    }
+
+    HashBuckets *main = &ht->ht[0];
+    if (main->table == NULL) {
+        ht_resize(ht, HT_INITIAL_SIZE);
+    } else if (main->used >= main->size * HT_GROW_LOAD_FACTOR) {
+        ht_resize(ht, main->size * 2);
+    } else if (main->size > HT_INITIAL_SIZE &&
+               main->used * 100 < main->size * HT_SHRINK_LOAD_PERCENT) {
+        ht_resize(ht, main->used * 2);
+    }
+}
+
+/**
+ * Find the link pointing at the entry for `key` (a bucket head or the
+ * previous entry's next field), so callers can unlink it in place.
+ * @param h hash(key)
+ * @param table_out Set to the bucket array holding the entry
+ * @return The link, or NULL if the key is absent
+ */
+static Entry **ht_find_ref(HashTable *ht, const char *key, size_t key_len, uint64_t h,
+                           HashBuckets **table_out) {
+    for (int t = 0; t <= 1; t++) {
+        HashBuckets *buckets = &ht->ht[t];
+        if (buckets->table == NULL) continue;
+
+        Entry **ref = &buckets->table[h & buckets->sizemask];
+        while (*ref) {
+            if (entry_key_is(*ref, key, key_len)) {
+                if (table_out) *table_out = buckets;
+                return ref;
             }
+            ref = &(*ref)->next;
         }
-        entry = entry->next;
+        if (!ht_is_rehashing(ht)) break;
     }
+    return NULL;
+}
+
+static Entry *ht_find(HashTable *ht, const char *key, size_t key_len, uint64_t h) {
+    Entry **ref = ht_find_ref(ht, key, key_len, h, NULL);
+    return ref ? *ref : NULL;
+}
+
+/**
+ * Link a new entry; during a resize new keys always go to the new array.
+ */
+static void ht_insert(HashTable *ht, Entry *entry, uint64_t h) {
+    HashBuckets *buckets = ht_is_rehashing(ht) ? &ht->ht[1] : &ht->ht[0];
+    unsigned long idx = h & buckets->sizemask;
+    entry->next = buckets->table[idx];
+    HT_STORE(buckets->table[idx], entry);
+    buckets->used++;
+}
 
-    //-- Not found, create new list entry --//
-    Entry *new_entry = malloc(sizeof(Entry));
-    if (!new_entry) {
-        pthread_mutex_unlock(&hashtable_mutex);
+/**
+ * Unlink the entry `ref` points at and drop it from the expiry index; it
+ * is freed once no GET can reach it.
+ */
+static void ht_delete_ref(KeyspaceShard *shard, HashBuckets *buckets, Entry **ref) {
+    Entry *entry = *ref;
+    HT_STORE(*ref, entry->next);
+    buckets->used--;
+    minheap_remove(&shard->expires, &entry->expire_node);
+    epoch_retire(entry, free_entry);
+}
+
+/**
+ * Put `replacement` in the place of the entry `ref` points at, with the
+ * same deadline; a GET finds one or the other. The old entry is freed once
+ * no GET can reach it.
+ */
+static void ht_replace_ref(KeyspaceShard *shard, Entry **ref, Entry *replacement) {
+    Entry *entry = *ref;
+    replacement->next = entry->next;
+    replacement->expiry = entry->expiry;
+    minheap_replace(&shard->expires, &entry->expire_node, &replacement->expire_node);
+    HT_STORE(*ref, replacement);
+    epoch_retire(entry, free_entry);
+}
+
+static int is_expired(Entry *entry, long long now) {
+    long long expiry = HT_LOAD(entry->expiry);
+    return expiry > 0 && expiry <= now;
+}
+
+/* ==================== Expiry Index ==================== */
+
+/**
+ * Set an entry's deadline and keep the shard's expiry index in step.
+ * If the index cannot grow the key still expires, lazily on access.
+ */
+static void entry_set_expiry(KeyspaceShard *shard, Entry *entry, long long expiry) {
+    HT_STORE(entry->expiry, expiry);
+    if (expiry > 0) {
+        minheap_schedule(&shard->expires, &entry->expire_node, expiry);
+    } else {
+        minheap_remove(&shard->expires, &entry->expire_node);
+    }
+}
+
+/**
+ * Approximate heap footprint of an entry, for the reclaimed-memory metric.
+ */
+static size_t entry_memory(const Entry *entry) {
+    size_t bytes = entry_size(entry);
+    if (entry_owns_string(entry)) {
+        bytes += sizeof(StoredString) + entry->data.string_value->capacity;
+    } else if (entry->type == VALUE_LIST) {
+        bytes += list_memory(entry->data.list_value);
+    }
+    return bytes;
+}
+
+/**
+ * Delete an entry whose deadline has passed and account for it.
+ */
+static void ht_expire_ref(KeyspaceShard *shard, HashBuckets *buckets, Entry **ref) {
+    __atomic_fetch_add(&expire_stats.expired_keys, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&expire_stats.expired_bytes, entry_memory(*ref), __ATOMIC_RELAXED);
+    ht_delete_ref(shard, buckets, ref);
+}
+
+/* ==================== Shard Locking ==================== */
+
+static void keyspace_init(void) {
+    pthread_rwlockattr_t attr;
+    pthread_rwlockattr_init(&attr);
+#ifdef __GLIBC__
+    //-- glibc prefers readers by default: a GET-heavy load would starve SETs --//
+    pthread_rwlockattr_setkind_np(&attr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+#endif
+    for (int i = 0; i < KEYSPACE_SHARDS; i++) {
+        pthread_rwlock_init(&KEYSPACE[i].lock, &attr);
+        KEYSPACE[i].table.rehashidx = -1;
+        minheap_init(&KEYSPACE[i].expires);
+    }
+    pthread_rwlockattr_destroy(&attr);
+    shared_integers_init();
+}
+
+/**
+ * Shard owning a hash. The top bits are used so the choice stays
+ * independent of the low bits that pick a bucket inside the shard.
+ */
+static int shard_index(uint64_t h) {
+    return (int)(h >> (64 - __builtin_ctz(KEYSPACE_SHARDS)));
+}
+
+static KeyspaceShard *shard_for(uint64_t h) {
+    pthread_once(&keyspace_once, keyspace_init);
+    return &KEYSPACE[shard_index(h)];
+}
+
+static inline void shard_unlock(KeyspaceShard *shard) {
+    if (!keyspace_lockless) pthread_rwlock_unlock(&shard->lock);
+}
+
+/**
+ * Lock a shard for writing and advance its maintenance. The sequence
+ * counter stays odd until shard_write_unlock().
+ */
+static void shard_lock_exclusive(KeyspaceShard *shard) {
+    if (!keyspace_lockless) pthread_rwlock_wrlock(&shard->lock);
+    __atomic_store_n(&shard->seq, shard->seq + 1, __ATOMIC_RELAXED);
+    //-- Order the odd count before any store a lock-free reader could see --//
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    ht_maintain(&shard->table);
+}
+
+/**
+ * Lock the shard owning `key` for writing.
+ */
+static KeyspaceShard *shard_write_lock(const char *key, size_t key_len, uint64_t *h) {
+    *h = hash(key, key_len);
+    KeyspaceShard *shard = shard_for(*h);
+    shard_lock_exclusive(shard);
+    return shard;
+}
+
+static inline void shard_write_unlock(KeyspaceShard *shard) {
+    __atomic_store_n(&shard->seq, shard->seq + 1, __ATOMIC_RELEASE);
+    shard_unlock(shard);
+}
+
+static KeyspaceShard *shard_read_lock(const char *key, size_t key_len, uint64_t *h) {
+    *h = hash(key, key_len);
+    KeyspaceShard *shard = shard_for(*h);
+    if (!keyspace_lockless) pthread_rwlock_rdlock(&shard->lock);
+    return shard;
+}
+
+int keyspace_shard_of(const char *key, size_t key_len) {
+    return shard_index(hash(key, key_len));
+}
+
+void keyspace_set_lockless(int enabled) {
+    keyspace_lockless = enabled;
+}
+
+/**
+ * Readers may not unlink entries, so an expired key seen under the shared
+ * lock is reclaimed here, after re-checking it under the exclusive lock.
+ */
+static void reclaim_expired(const char *key, size_t key_len) {
+    uint64_t h;
+    KeyspaceShard *shard = shard_write_lock(key, key_len, &h);
+    HashBuckets *buckets = NULL;
+    Entry **ref = ht_find_ref(&shard->table, key, key_len, h, &buckets);
+    if (ref && is_expired(*ref, expiry_now())) {
+        ht_expire_ref(shard, buckets, ref);
+    }
+    shard_write_unlock(shard);
+}
+
+/**
+ * Find the live entry for key under the shard's exclusive lock, reclaiming
+ * it first if it has expired.
+ */
+static Entry **find_live_ref(KeyspaceShard *shard, const char *key, size_t key_len, uint64_t h,
+                             HashBuckets **buckets) {
+    Entry **ref = ht_find_ref(&shard->table, key, key_len, h, buckets);
+    if (ref && is_expired(*ref, expiry_now())) {
+        ht_expire_ref(shard, *buckets, ref);
         return NULL;
     }
-    new_entry->key = strdup(key);
-    new_entry->type = VALUE_LIST;
-    new_entry->data.list_value = list_create();
-    new_entry->expiry = 0;
-    new_entry->next = HASHTABLE[idx];
-    HASHTABLE[idx] = new_entry;
-
-    List *list = new_entry->data.list_value;
-    pthread_mutex_unlock(&hashtable_mutex);
-    return list;
-}
-
-List *get_list_if_exists(const char *key) {
-    pthread_mutex_lock(&hashtable_mutex);
-    unsigned int idx = hash(key);
-    Entry *entry = HASHTABLE[idx];
-    long long now = current_millis();
-
-    while (entry) {
-        if (strcmp(entry->key, key) == 0) {
-            if (entry->expiry > 0 && entry->expiry <= now) {
-                pthread_mutex_unlock(&hashtable_mutex);
-                return NULL;
+    return ref;
+}
+
+/**
+ * Find a live entry of the wanted type under the shard's shared lock.
+ * Sets *expired when the key exists but is past its expiry.
+ */
+static Entry *find_live(KeyspaceShard *shard, const char *key, size_t key_len, uint64_t h,
+                        value_type_t type, int *expired) {
+    Entry *entry = ht_find(&shard->table, key, key_len, h);
+    *expired = 0;
+    if (!entry) return NULL;
+    if (is_expired(entry, expiry_now())) {
+        *expired = 1;
+        return NULL;
+    }
+    return entry->type == type ? entry : NULL;
+}
+
+//-- A string value read out of an entry --//
+typedef struct {
+    int found;                   //- The entry holds a string -//
+    const StoredString *raw;     //- STRING_RAW, NULL for an integer -//
+    long long integer;           //- STRING_INT -//
+} StringRead;
+
+static void string_read(const Entry *entry, StringRead *out) {
+    out->found = entry->type == VALUE_STRING;
+    if (!out->found) return;
+    if (entry->encoding == STRING_INT) {
+        out->raw = NULL;
+        out->integer = HT_LOAD(entry->data.int_value);
+    } else {
+        out->raw = entry->data.string_value;
+    }
+}
+
+//-- A shard's bucket arrays as a lock-free reader loaded them --//
+typedef struct {
+    unsigned long seq;        //- Counter value the snapshot is valid for -//
+    int rehashing;
+    Entry **tables[2];
+    unsigned long masks[2];
+} ShardSnapshot;
+
+/**
+ * Load a shard's bucket arrays without its lock. They may only be
+ * dereferenced once this returns 1, which means no writer moved them
+ * while they were read.
+ * @return 1 with *snap set, 0 if a writer holds or took the shard
+ */
+static int shard_snapshot(KeyspaceShard *shard, ShardSnapshot *snap) {
+    snap->seq = __atomic_load_n(&shard->seq, __ATOMIC_ACQUIRE);
+    if (snap->seq & 1) return 0;
+
+    HashTable *ht = &shard->table;
+    snap->rehashing = HT_LOAD(ht->rehashidx) != -1;
+    for (int t = 0; t <= 1; t++) {
+        snap->tables[t] = HT_LOAD(ht->ht[t].table);
+        snap->masks[t] = HT_LOAD(ht->ht[t].sizemask);
+    }
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&shard->seq, __ATOMIC_RELAXED) == snap->seq;
+}
+
+/**
+ * Whether no writer ran since the snapshot was taken, i.e. whether what
+ * was read through it is consistent.
+ */
+static int shard_snapshot_valid(KeyspaceShard *shard, const ShardSnapshot *snap) {
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&shard->seq, __ATOMIC_RELAXED) == snap->seq;
+}
+
+/**
+ * Read the string at key through a snapshot: *value is found or not, and
+ * *expired set when the key exists but is past its deadline.
+ */
+static void snapshot_read_string(const ShardSnapshot *snap, const char *key, size_t key_len, uint64_t h,
+                                 StringRead *value, int *expired) {
+    Entry *entry = NULL;
+    for (int t = 0; t <= 1 && !entry; t++) {
+        if (snap->tables[t] == NULL) continue;
+        for (Entry *e = HT_LOAD(snap->tables[t][h & snap->masks[t]]); e; e = HT_LOAD(e->next)) {
+            if (entry_key_is(e, key, key_len)) {
+                entry = e;
+                break;
             }
-            if (entry->type == VALUE_LIST) {
-                List *list = entry->data.list_value;
-                pthread_mutex_unlock(&hashtable_mutex);
-                return list;
-            } else {
-                pthread_mutex_unlock(&hashtable_mutex);
-                return NULL;
+        }
+        if (!snap->rehashing) break;
+    }
+
+    value->found = 0;
+    *expired = 0;
+    if (entry) {
+        if (is_expired(entry, expiry_now())) {
+            *expired = 1;
+        } else {
+            string_read(entry, value);
+        }
+    }
+}
+
+/**
+ * Look up a string value without the shard lock. The result only counts
+ * if no writer ran during the whole lookup. Must run inside an epoch
+ * section.
+ * @return 1 with *value and *expired set, 0 if a writer interfered
+ */
+static int find_string_optimistic(KeyspaceShard *shard, const char *key, size_t key_len, uint64_t h,
+                                  StringRead *value, int *expired) {
+    ShardSnapshot snap;
+    if (!shard_snapshot(shard, &snap)) return 0;
+    snapshot_read_string(&snap, key, key_len, h, value, expired);
+    return shard_snapshot_valid(shard, &snap);
+}
+
+/* ==================== Public API ==================== */
+
+size_t hashtable_key_count(void) {
+    size_t count = 0;
+    pthread_once(&keyspace_once, keyspace_init);
+    for (int i = 0; i < KEYSPACE_SHARDS; i++) {
+        pthread_rwlock_rdlock(&KEYSPACE[i].lock);
+        count += KEYSPACE[i].table.ht[0].used + KEYSPACE[i].table.ht[1].used;
+        pthread_rwlock_unlock(&KEYSPACE[i].lock);
+    }
+    return count;
+}
+
+size_t hashtable_expires_count(void) {
+    size_t count = 0;
+    pthread_once(&keyspace_once, keyspace_init);
+    for (int i = 0; i < KEYSPACE_SHARDS; i++) {
+        pthread_rwlock_rdlock(&KEYSPACE[i].lock);
+        count += minheap_size(&KEYSPACE[i].expires);
+        pthread_rwlock_unlock(&KEYSPACE[i].lock);
+    }
+    return count;
+}
+
+size_t hashtable_bucket_count(void) {
+    size_t count = 0;
+    pthread_once(&keyspace_once, keyspace_init);
+    for (int i = 0; i < KEYSPACE_SHARDS; i++) {
+        pthread_rwlock_rdlock(&KEYSPACE[i].lock);
+        count += KEYSPACE[i].table.ht[0].size + KEYSPACE[i].table.ht[1].size;
+        pthread_rwlock_unlock(&KEYSPACE[i].lock);
+    }
+    return count;
+}
+
+int hashtable_is_rehashing(void) {
+    int rehashing = 0;
+    pthread_once(&keyspace_once, keyspace_init);
+    for (int i = 0; i < KEYSPACE_SHARDS && !rehashing; i++) {
+        pthread_rwlock_rdlock(&KEYSPACE[i].lock);
+        rehashing = ht_is_rehashing(&KEYSPACE[i].table);
+        pthread_rwlock_unlock(&KEYSPACE[i].lock);
+    }
+    return rehashing;
+}
+
+void set_value(const char *key, size_t key_len, const char *value, size_t value_len, long long px) {
+    set_value_ex(key, key_len, value, value_len, (px > 0) ? expiry_now() + px : 0, 0, NULL, NULL);
+}
+
+int set_value_ex(const char *key, size_t key_len, const char *value, size_t value_len,
+                 long long expiry, int flags, char **old_value, size_t *old_len) {
+    uint64_t h;
+    KeyspaceShard *shard = shard_write_lock(key, key_len, &h);
+    HashBuckets *buckets = NULL;
+    Entry **ref = find_live_ref(shard, key, key_len, h, &buckets);
+    Entry *entry = ref ? *ref : NULL;
+
+    if (old_value) {
+        *old_value = NULL;
+        if (entry && entry->type != VALUE_STRING) {
+            shard_write_unlock(shard);
+            return STRING_ERR_WRONGTYPE;
+        }
+        if (entry) {
+            char int_buf[INT_TEXT_MAX];
+            StringRead old = { 0, NULL, 0 };
+            string_read(entry, &old);
+            const char *text = old.raw ? old.raw->buf : integer_text(old.integer, int_buf, old_len);
+            if (old.raw) *old_len = old.raw->len;
+            if (!(*old_value = malloc(*old_len + 1))) {
+                shard_write_unlock(shard);
+                return STRING_ERR_NO_MEMORY;
             }
+            memcpy(*old_value, text, *old_len + 1);
         }
-        entry = entry->next;
     }
-    pthread_mutex_unlock(&hashtable_mutex);
-    return NULL;
+
+    if ((flags & SET_NX && entry) || (flags & SET_XX && !entry)) {
+        shard_write_unlock(shard);
+        return 0;
+    }
+
+    //-- Copy-on-write: a lock-free GET may still be reading the old entry --//
+    Entry *stored = entry_create(key, key_len, VALUE_STRING, value, value_len);
+    if (!stored) {
+        shard_write_unlock(shard);
+        if (old_value) {
+            free(*old_value);
+            *old_value = NULL;
+        }
+        return STRING_ERR_NO_MEMORY;
+    }
+    if (entry) {
+        ht_replace_ref(shard, ref, stored);
+    } else {
+        ht_insert(&shard->table, stored, h);
+    }
+    if (!(flags & SET_KEEPTTL)) entry_set_expiry(shard, stored, expiry);
+    shard_write_unlock(shard);
+    return 1;
+}
+
+int set_key_expiry(const char *key, size_t key_len, long long expiry, int flags) {
+    uint64_t h;
+    KeyspaceShard *shard = shard_write_lock(key, key_len, &h);
+    HashBuckets *buckets = NULL;
+    Entry **ref = find_live_ref(shard, key, key_len, h, &buckets);
+    if (!ref) {
+        shard_write_unlock(shard);
+        return 0;
+    }
+
+    //-- No deadline counts as an infinite one for GT and LT --//
+    long long current = (*ref)->expiry;
+    int allowed = !((flags & EXPIRE_NX && current != 0) ||
+                    (flags & EXPIRE_XX && current == 0) ||
+                    (flags & EXPIRE_GT && (current == 0 || expiry <= current)) ||
+                    (flags & EXPIRE_LT && current != 0 && expiry >= current));
+    if (allowed) {
+        if (expiry <= expiry_now()) {
+            ht_delete_ref(shard, buckets, ref);
+        } else {
+            entry_set_expiry(shard, *ref, expiry);
+        }
+    }
+    shard_write_unlock(shard);
+    return allowed;
+}
+
+int persist_key(const char *key, size_t key_len) {
+    uint64_t h;
+    KeyspaceShard *shard = shard_write_lock(key, key_len, &h);
+    HashBuckets *buckets = NULL;
+    Entry **ref = find_live_ref(shard, key, key_len, h, &buckets);
+    int persisted = ref && (*ref)->expiry != 0;
+    if (persisted) entry_set_expiry(shard, *ref, 0);
+    shard_write_unlock(shard);
+    return persisted;
+}
+
+long long get_key_ttl(const char *key, size_t key_len) {
+    uint64_t h;
+    KeyspaceShard *shard = shard_read_lock(key, key_len, &h);
+    Entry *entry = ht_find(&shard->table, key, key_len, h);
+    long long now = expiry_now();
+    int expired = entry && is_expired(entry, now);
+
+    long long ttl = TTL_NO_KEY;
+    if (entry && !expired) {
+        ttl = entry->expiry ? entry->expiry - now : TTL_PERSISTENT;
+    }
+    shard_unlock(shard);
+
+    if (expired) reclaim_expired(key, key_len);
+    return ttl;
+}
+
+const char *get_value(const char *key, size_t key_len, size_t *value_len, char *int_buf) {
+    uint64_t h = hash(key, key_len);
+    KeyspaceShard *shard = shard_for(h);
+    StringRead result = { 0, NULL, 0 };
+    int expired = 0;
+    int done = 0;
+
+    epoch_enter();
+    for (int attempt = 0; attempt < HT_OPTIMISTIC_RETRIES && !done; attempt++) {
+        done = find_string_optimistic(shard, key, key_len, h, &result, &expired);
+    }
+    if (!done) {
+        //-- Writers keep the shard busy: wait behind them like any reader --//
+        if (!keyspace_lockless) pthread_rwlock_rdlock(&shard->lock);
+        Entry *entry = find_live(shard, key, key_len, h, VALUE_STRING, &expired);
+        result.found = 0;
+        if (entry) string_read(entry, &result);
+        shard_unlock(shard);
+    }
+    epoch_exit();
+
+    if (expired) reclaim_expired(key, key_len);
+    if (!result.found) return NULL;
+    if (!result.raw) return integer_text(result.integer, int_buf, value_len);
+    *value_len = result.raw->len;
+    return result.raw->buf;
+}
+
+int increment_value(const char *key, size_t key_len, long long delta, long long *result) {
+    uint64_t h;
+    KeyspaceShard *shard = shard_write_lock(key, key_len, &h);
+    HashBuckets *buckets = NULL;
+    Entry **ref = find_live_ref(shard, key, key_len, h, &buckets);
+    Entry *entry = ref ? *ref : NULL;
+
+    long long current = 0;
+    int status = 1;
+    if (entry && entry->type != VALUE_STRING) {
+        status = STRING_ERR_WRONGTYPE;
+    } else if (entry && entry->encoding == STRING_INT) {
+        current = entry->data.int_value;
+    } else if (entry && !string_to_integer(entry->data.string_value->buf, entry->data.string_value->len, &current)) {
+        status = STRING_ERR_NOT_INTEGER;
+    }
+    if (status > 0 && __builtin_add_overflow(current, delta, result)) status = STRING_ERR_OVERFLOW;
+
+    if (status > 0 && entry && entry->encoding == STRING_INT) {
+        //-- In place: a concurrent GET copies the number under the shard's counter --//
+        HT_STORE(entry->data.int_value, *result);
+    } else if (status > 0) {
+        char text[INT_TEXT_MAX];
+        Entry *stored = entry_create(key, key_len, VALUE_STRING, text, integer_to_string(*result, text));
+        if (!stored) {
+            status = STRING_ERR_NO_MEMORY;
+        } else if (entry) {
+            ht_replace_ref(shard, ref, stored);
+        } else {
+            ht_insert(&shard->table, stored, h);
+        }
+    }
+    shard_write_unlock(shard);
+    return status;
 }
 
 /**
- * Delete a key from the hash table, handling both string and list types.
- * Removes the entry from the linked list and frees all associated memory.
- */
-int delete_key(const char *key) {
-    pthread_mutex_lock(&hashtable_mutex);
-    unsigned int idx = hash(key);
-    Entry *prev = NULL;
-    Entry *entry = HASHTABLE[idx];
-
-    while (entry) {
-        if (strcmp(entry->key, key) == 0) {
-            if (prev)
-                prev->next = entry->next;
-            else
-                HASHTABLE[idx] = entry->next;
-
-            free(entry->key);
-            if (entry->type == VALUE_STRING) {
-                free(entry->data.string_value);
-            } else if (entry->type == VALUE_LIST) {
-                list_free(entry->data.list_value);
+ * Parse a whole string as a finite long double, as INCRBYFLOAT reads both
+ * the stored value and its increment.
+ * @return 1 with *out set, 0 otherwise
+ */
+static int string_to_long_double(const char *s, size_t len, long double *out) {
+    if (len == 0 || len >= FLOAT_TEXT_MAX || isspace((unsigned char)s[0])) return 0;
+
+    //-- strtold() needs a terminator, and a stored value may be followed by anything --//
+    char buf[FLOAT_TEXT_MAX];
+    memcpy(buf, s, len);
+    buf[len] = '\0';
+    char *end;
+    errno = 0;
+    long double value = strtold(buf, &end);
+    if (end != buf + len || errno == ERANGE || isnan(value) || isinf(value)) return 0;
+    *out = value;
+    return 1;
+}
+
+/**
+ * Write value in fixed point, without trailing zeros, followed by a NUL.
+ * @param buf At least FLOAT_TEXT_MAX bytes
+ * @return The text length
+ */
+static size_t long_double_to_string(long double value, char *buf) {
+    int len = snprintf(buf, FLOAT_TEXT_MAX, "%.17Lf", value);
+    if (len <= 0 || len >= FLOAT_TEXT_MAX) return 0;
+    if (strchr(buf, '.')) {
+        while (buf[len - 1] == '0') len--;
+        if (buf[len - 1] == '.') len--;
+    }
+    if (len == 2 && buf[0] == '-' && buf[1] == '0') {
+        buf[0] = '0';
+        len = 1;
+    }
+    buf[len] = '\0';
+    return (size_t)len;
+}
+
+int increment_value_float(const char *key, size_t key_len, long double delta, char *result, size_t *result_len) {
+    uint64_t h;
+    KeyspaceShard *shard = shard_write_lock(key, key_len, &h);
+    HashBuckets *buckets = NULL;
+    Entry **ref = find_live_ref(shard, key, key_len, h, &buckets);
+    Entry *entry = ref ? *ref : NULL;
+
+    long double current = 0;
+    int status = 1;
+    if (entry && entry->type != VALUE_STRING) {
+        status = STRING_ERR_WRONGTYPE;
+    } else if (entry && entry->encoding == STRING_INT) {
+        current = (long double)entry->data.int_value;
+    } else if (entry && !string_to_long_double(entry->data.string_value->buf, entry->data.string_value->len, &current)) {
+        status = STRING_ERR_NOT_FLOAT;
+    }
+
+    long double sum = current + delta;
+    if (status > 0 && (isnan(sum) || isinf(sum))) status = STRING_ERR_OVERFLOW;
+    if (status > 0 && (*result_len = long_double_to_string(sum, result)) == 0) status = STRING_ERR_OVERFLOW;
+
+    if (status > 0) {
+        //-- A whole result such as "3" goes back to the integer encoding --//
+        Entry *stored = entry_create(key, key_len, VALUE_STRING, result, *result_len);
+        if (!stored) {
+            status = STRING_ERR_NO_MEMORY;
+        } else if (entry) {
+            ht_replace_ref(shard, ref, stored);
+        } else {
+            ht_insert(&shard->table, stored, h);
+        }
+    }
+    shard_write_unlock(shard);
+    return status;
+}
+
+/* ==================== Multi-key Strings ==================== */
+
+/*
+ * MGET, MSET and MSETNX sort their keys by shard first, so each shard is
+ * visited, and locked, once however many of its keys a command carries.
+ * Several shards are locked in index order, as in move_list_value().
+ */
+
+//-- Keys of one command, grouped by shard --//
+typedef struct {
+    uint64_t *hashes;                 //- hash() of each key, in request order -//
+    int *order;                       //- Key indexes by shard, request order within a shard -//
+    char *expired;                    //- Per key, set when a read found it past its deadline -//
+    int starts[KEYSPACE_SHARDS + 1];  //- Shard s holds order[starts[s]] .. order[starts[s + 1] - 1] -//
+} KeyGroups;
+
+/**
+ * Group count keys by shard. Key i is keys[i * stride], so that MSET can
+ * pass its key/value pairs as they are.
+ * @return 0 on success, -1 if out of memory
+ */
+static int key_groups_init(KeyGroups *groups, char *keys[], const size_t lens[], int count, int stride) {
+    pthread_once(&keyspace_once, keyspace_init);
+    groups->hashes = malloc((size_t)count * (sizeof(uint64_t) + sizeof(int) + sizeof(char)));
+    if (!groups->hashes) return -1;
+    groups->order = (int *)(groups->hashes + count);
+    groups->expired = (char *)(groups->order + count);
+    memset(groups->expired, 0, (size_t)count);
+
+    int counts[KEYSPACE_SHARDS] = { 0 };
+    for (int i = 0; i < count; i++) {
+        groups->hashes[i] = hash(keys[i * stride], lens[i * stride]);
+        counts[shard_index(groups->hashes[i])]++;
+    }
+
+    //-- Counting sort: stable, so a key given twice is written in request order --//
+    int next[KEYSPACE_SHARDS];
+    groups->starts[0] = 0;
+    for (int s = 0; s < KEYSPACE_SHARDS; s++) {
+        next[s] = groups->starts[s];
+        groups->starts[s + 1] = groups->starts[s] + counts[s];
+    }
+    for (int i = 0; i < count; i++) {
+        groups->order[next[shard_index(groups->hashes[i])]++] = i;
+    }
+    return 0;
+}
+
+static inline int key_groups_has(const KeyGroups *groups, int shard) {
+    return groups->starts[shard + 1] > groups->starts[shard];
+}
+
+static void key_groups_free(KeyGroups *groups) {
+    free(groups->hashes);
+}
+
+static void string_value_set(StringValue *value, const StringRead *read) {
+    if (!read->found) {
+        value->value = NULL;
+        value->len = 0;
+    } else if (!read->raw) {
+        value->value = integer_text(read->integer, value->int_buf, &value->len);
+    } else {
+        value->value = read->raw->buf;
+        value->len = read->raw->len;
+    }
+}
+
+/**
+ * Read every key without locks. The shards are validated together at the
+ * end, so there was an instant at which all the values were current.
+ * @return 1 on success, 0 if a writer interfered
+ */
+static int get_values_optimistic(KeyGroups *groups, char *keys[], const size_t lens[], StringValue values[]) {
+    ShardSnapshot snaps[KEYSPACE_SHARDS];
+    for (int s = 0; s < KEYSPACE_SHARDS; s++) {
+        if (!key_groups_has(groups, s)) continue;
+        if (!shard_snapshot(&KEYSPACE[s], &snaps[s])) return 0;
+        for (int k = groups->starts[s]; k < groups->starts[s + 1]; k++) {
+            int i = groups->order[k], expired;
+            StringRead read;
+            snapshot_read_string(&snaps[s], keys[i], lens[i], groups->hashes[i], &read, &expired);
+            groups->expired[i] = (char)expired;
+            string_value_set(&values[i], &read);
+        }
+    }
+    for (int s = 0; s < KEYSPACE_SHARDS; s++) {
+        if (key_groups_has(groups, s) && !shard_snapshot_valid(&KEYSPACE[s], &snaps[s])) return 0;
+    }
+    return 1;
+}
+
+int get_values(char *keys[], const size_t key_lens[], int count, StringValue values[]) {
+    KeyGroups groups;
+    if (key_groups_init(&groups, keys, key_lens, count, 1) != 0) return STRING_ERR_NO_MEMORY;
+
+    int done = 0;
+    epoch_enter();
+    for (int attempt = 0; attempt < HT_OPTIMISTIC_RETRIES && !done; attempt++) {
+        done = get_values_optimistic(&groups, keys, key_lens, values);
+    }
+    if (!done) {
+        //-- Every shard involved is held shared at once, for the same snapshot --//
+        for (int s = 0; s < KEYSPACE_SHARDS; s++) {
+            if (key_groups_has(&groups, s) && !keyspace_lockless) pthread_rwlock_rdlock(&KEYSPACE[s].lock);
+        }
+        for (int i = 0; i < count; i++) {
+            int expired;
+            StringRead read = { 0, NULL, 0 };
+            Entry *entry = find_live(&KEYSPACE[shard_index(groups.hashes[i])], keys[i], key_lens[i],
+                                     groups.hashes[i], VALUE_STRING, &expired);
+            if (entry) string_read(entry, &read);
+            groups.expired[i] = (char)expired;
+            string_value_set(&values[i], &read);
+        }
+        for (int s = 0; s < KEYSPACE_SHARDS; s++) {
+            if (key_groups_has(&groups, s)) shard_unlock(&KEYSPACE[s]);
+        }
+    }
+    epoch_exit();
+
+    for (int i = 0; i < count; i++) {
+        if (groups.expired[i]) reclaim_expired(keys[i], key_lens[i]);
+    }
+    key_groups_free(&groups);
+    return 0;
+}
+
+int set_values(char *pairs[], const size_t lens[], int count, int flags) {
+    KeyGroups groups;
+    Entry **stored = malloc((size_t)count * sizeof(Entry *));
+    if (!stored || key_groups_init(&groups, pairs, lens, count, 2) != 0) {
+        free(stored);
+        return STRING_ERR_NO_MEMORY;
+    }
+
+    //-- Built before any shard is locked, so running out of memory stores nothing --//
+    int created = 0;
+    while (created < count &&
+           (stored[created] = entry_create(pairs[2 * created], lens[2 * created], VALUE_STRING,
+                                           pairs[2 * created + 1], lens[2 * created + 1]))) {
+        created++;
+    }
+    int status = created == count ? 1 : STRING_ERR_NO_MEMORY;
+
+    if (status > 0) {
+        for (int s = 0; s < KEYSPACE_SHARDS; s++) {
+            if (key_groups_has(&groups, s)) shard_lock_exclusive(&KEYSPACE[s]);
+        }
+
+        HashBuckets *buckets = NULL;
+        for (int i = 0; i < count && (flags & SET_NX) && status > 0; i++) {
+            KeyspaceShard *shard = &KEYSPACE[shard_index(groups.hashes[i])];
+            if (find_live_ref(shard, pairs[2 * i], lens[2 * i], groups.hashes[i], &buckets)) status = 0;
+        }
+
+        for (int s = 0; s < KEYSPACE_SHARDS && status > 0; s++) {
+            KeyspaceShard *shard = &KEYSPACE[s];
+            for (int k = groups.starts[s]; k < groups.starts[s + 1]; k++) {
+                int i = groups.order[k];
+                //-- Each key is a write of its own to the table: keep the load factor in bounds --//
+                if (k > groups.starts[s]) ht_maintain(&shard->table);
+                Entry **ref = find_live_ref(shard, pairs[2 * i], lens[2 * i], groups.hashes[i], &buckets);
+                if (ref) {
+                    ht_replace_ref(shard, ref, stored[i]);
+                } else {
+                    ht_insert(&shard->table, stored[i], groups.hashes[i]);
+                }
+                entry_set_expiry(shard, stored[i], 0);
             }
-            free(entry);
-            
-            pthread_mutex_unlock(&hashtable_mutex);
-            return 1;
         }
-        prev = entry;
-        entry = entry->next;
+
+        for (int s = 0; s < KEYSPACE_SHARDS; s++) {
+            if (key_groups_has(&groups, s)) shard_write_unlock(&KEYSPACE[s]);
+        }
+    }
+
+    //-- Entries never linked are freed right away: no reader can have seen them --//
+    if (status <= 0) {
+        for (int i = 0; i < created; i++) free_entry(stored[i]);
+    }
+    key_groups_free(&groups);
+    free(stored);
+    return status;
+}
+
+/**
+ * Create an empty list entry for key in a shard locked for writing.
+ * @return The new entry, NULL on allocation failure
+ */
+static Entry *list_entry_create(KeyspaceShard *shard, const char *key, size_t key_len, uint64_t h) {
+    Entry *entry = entry_create(key, key_len, VALUE_LIST, NULL, 0);
+    List *list = list_create();
+    if (!entry || !list) {
+        if (entry) free_entry(entry);
+        list_free(list);
+        return NULL;
+    }
+    entry->data.list_value = list;
+    ht_insert(&shard->table, entry, h);
+    return entry;
+}
+
+long long push_list_values(const char *key, size_t key_len, char *values[], const size_t lens[],
+                           int count, int to_head) {
+    uint64_t h;
+    KeyspaceShard *shard = shard_write_lock(key, key_len, &h);
+    HashBuckets *buckets = NULL;
+    //-- An expired key of any type is replaced by a fresh list --//
+    Entry **ref = find_live_ref(shard, key, key_len, h, &buckets);
+    Entry *entry = ref ? *ref : NULL;
+    if (entry && entry->type != VALUE_LIST) {
+        shard_write_unlock(shard);
+        return LIST_ERR_WRONGTYPE;
+    }
+
+    if (!entry && !(entry = list_entry_create(shard, key, key_len, h))) {
+        shard_write_unlock(shard);
+        return LIST_ERR_NO_MEMORY;
+    }
+
+    //-- Values pushed before a failure stay, as they would after a partial write --//
+    List *list = entry->data.list_value;
+    for (int i = 0; i < count; i++) {
+        if (list_push(list, to_head ? LIST_HEAD : LIST_TAIL, values[i], lens[i]) == 0) {
+            shard_write_unlock(shard);
+            return LIST_ERR_NO_MEMORY;
+        }
+    }
+
+    long long length = (long long)list_length(list);
+    shard_write_unlock(shard);
+    return length;
+}
+
+size_t get_list_length(const char *key, size_t key_len) {
+    uint64_t h;
+    int expired;
+    KeyspaceShard *shard = shard_read_lock(key, key_len, &h);
+    Entry *entry = find_live(shard, key, key_len, h, VALUE_LIST, &expired);
+    size_t length = entry ? list_length(entry->data.list_value) : 0;
+    shard_unlock(shard);
+
+    if (expired) reclaim_expired(key, key_len);
+    return length;
+}
+
+/**
+ * Live list at key in a shard locked for reading.
+ * @param wrongtype Set to 1 if key holds another type
+ */
+static List *find_live_list(KeyspaceShard *shard, const char *key, size_t key_len, uint64_t h,
+                            int *wrongtype, int *expired) {
+    Entry *entry = find_live(shard, key, key_len, h, VALUE_LIST, expired);
+    *wrongtype = !entry && !*expired && ht_find(&shard->table, key, key_len, h) != NULL;
+    return entry ? entry->data.list_value : NULL;
+}
+
+/**
+ * Lock the shard owning key exclusively and return its live list, if any.
+ * The caller edits it and then unlocks *shard_out.
+ * @param wrongtype Set to 1 if key holds another type
+ */
+static List *lock_list_for_write(const char *key, size_t key_len, KeyspaceShard **shard_out, int *wrongtype) {
+    uint64_t h;
+    KeyspaceShard *shard = shard_write_lock(key, key_len, &h);
+    HashBuckets *buckets = NULL;
+    Entry **ref = find_live_ref(shard, key, key_len, h, &buckets);
+    *shard_out = shard;
+    *wrongtype = ref && (*ref)->type != VALUE_LIST;
+
+    if (!ref || *wrongtype) return NULL;
+    return (*ref)->data.list_value;
+}
+
+long long read_list_range(const char *key, size_t key_len, long start, long end, const ListSink *sink) {
+    uint64_t h;
+    int wrongtype, expired;
+    KeyspaceShard *shard = shard_read_lock(key, key_len, &h);
+    List *list = find_live_list(shard, key, key_len, h, &wrongtype, &expired);
+    long long sent = wrongtype ? LIST_ERR_WRONGTYPE : (long long)list_range_into(list, start, end, sink);
+    shard_unlock(shard);
+
+    if (expired) reclaim_expired(key, key_len);
+    return sent;
+}
+
+long long pop_list_into(const char *key, size_t key_len, int where, size_t count, const ListSink *sink) {
+    KeyspaceShard *shard;
+    int wrongtype;
+    List *list = lock_list_for_write(key, key_len, &shard, &wrongtype);
+    long long popped = wrongtype ? LIST_ERR_WRONGTYPE : (long long)list_pop_into(list, where, count, sink);
+    shard_write_unlock(shard);
+    return popped;
+}
+
+int set_list_index(const char *key, size_t key_len, long index, const char *value, size_t value_len) {
+    KeyspaceShard *shard;
+    int wrongtype;
+    List *list = lock_list_for_write(key, key_len, &shard, &wrongtype);
+    int result = list ? list_set(list, index, value, value_len) : 0;
+    shard_write_unlock(shard);
+
+    if (wrongtype) return LIST_ERR_WRONGTYPE;
+    if (!list) return LIST_ERR_NO_KEY;
+    if (result == 0) return LIST_ERR_RANGE;
+    return result < 0 ? LIST_ERR_NO_MEMORY : 1;
+}
+
+long long insert_list_value(const char *key, size_t key_len, int after, const char *pivot, size_t pivot_len,
+                            const char *value, size_t value_len) {
+    KeyspaceShard *shard;
+    int wrongtype;
+    List *list = lock_list_for_write(key, key_len, &shard, &wrongtype);
+    long long result = 0;
+    if (list) {
+        int inserted = list_insert(list, pivot, pivot_len, after, value, value_len);
+        if (inserted > 0) {
+            result = (long long)list_length(list);
+        } else {
+            result = inserted == 0 ? LIST_ERR_NO_PIVOT : LIST_ERR_NO_MEMORY;
+        }
+    }
+    shard_write_unlock(shard);
+    return wrongtype ? LIST_ERR_WRONGTYPE : result;
+}
+
+int trim_list(const char *key, size_t key_len, long start, long end) {
+    KeyspaceShard *shard;
+    int wrongtype;
+    List *list = lock_list_for_write(key, key_len, &shard, &wrongtype);
+    list_trim(list, start, end);
+    shard_write_unlock(shard);
+    return wrongtype ? LIST_ERR_WRONGTYPE : list != NULL;
+}
+
+long long remove_list_values(const char *key, size_t key_len, long count, const char *value, size_t value_len) {
+    KeyspaceShard *shard;
+    int wrongtype;
+    List *list = lock_list_for_write(key, key_len, &shard, &wrongtype);
+    size_t removed = list_remove(list, value, value_len, count);
+    shard_write_unlock(shard);
+    return wrongtype ? LIST_ERR_WRONGTYPE : (long long)removed;
+}
+
+long *find_list_positions(const char *key, size_t key_len, const char *value, size_t value_len,
+                          long rank, long count, long maxlen, long *found) {
+    uint64_t h;
+    int wrongtype, expired;
+    KeyspaceShard *shard = shard_read_lock(key, key_len, &h);
+    List *list = find_live_list(shard, key, key_len, h, &wrongtype, &expired);
+    long *positions = list_positions(list, value, value_len, rank, count, maxlen, found);
+    shard_unlock(shard);
+
+    if (expired) reclaim_expired(key, key_len);
+    if (wrongtype) *found = LIST_ERR_WRONGTYPE;
+    return positions;
+}
+
+int move_list_value(const char *src, size_t src_len, const char *dst, size_t dst_len,
+                    int src_where, int dst_where, char **element, size_t *element_len) {
+    uint64_t src_h = hash(src, src_len), dst_h = hash(dst, dst_len);
+    KeyspaceShard *src_shard = shard_for(src_h), *dst_shard = shard_for(dst_h);
+    *element = NULL;
+
+    //-- Two shards are locked in index order so that crossing moves cannot deadlock --//
+    KeyspaceShard *first = src_shard < dst_shard ? src_shard : dst_shard;
+    KeyspaceShard *second = src_shard < dst_shard ? dst_shard : src_shard;
+    shard_lock_exclusive(first);
+    if (second != first) shard_lock_exclusive(second);
+
+    HashBuckets *buckets = NULL;
+    Entry **dst_ref = find_live_ref(dst_shard, dst, dst_len, dst_h, &buckets);
+    Entry *dst_entry = dst_ref ? *dst_ref : NULL;
+    Entry **src_ref = find_live_ref(src_shard, src, src_len, src_h, &buckets);
+    Entry *src_entry = src_ref ? *src_ref : NULL;
+
+    int result = 0;
+    if ((src_entry && src_entry->type != VALUE_LIST) ||
+        (dst_entry && dst_entry->type != VALUE_LIST)) {
+        result = -1;
+    } else if (src_entry && list_length(src_entry->data.list_value) > 0) {
+        if (!dst_entry) dst_entry = list_entry_create(dst_shard, dst, dst_len, dst_h);
+        if (dst_entry && (*element = list_pop(src_entry->data.list_value, src_where, element_len))) {
+            list_push(dst_entry->data.list_value, dst_where, *element, *element_len);
+            result = 1;
+        }
+    }
+
+    if (second != first) shard_write_unlock(second);
+    shard_write_unlock(first);
+    return result;
+}
+
+/**
+ * Delete a key from the hash table, handling both string and list types.
+ * Removes the entry from its bucket chain and frees all associated memory.
+ */
+int delete_key(const char *key, size_t key_len) {
+    uint64_t h;
+    KeyspaceShard *shard = shard_write_lock(key, key_len, &h);
+    HashBuckets *buckets = NULL;
+    //-- An expired key is reclaimed, not counted as deleted --//
+    Entry **ref = find_live_ref(shard, key, key_len, h, &buckets);
+
+    if (ref) {
+        ht_delete_ref(shard, buckets, ref);
+        shard_write_unlock(shard);
+        return 1;
     }
     
-    pthread_mutex_unlock(&hashtable_mutex);
+    shard_write_unlock(shard);
     return 0;
 }
 
-const char *get_type(const char *key) {
-    pthread_mutex_lock(&hashtable_mutex);
-    unsigned int idx = hash(key);
-    Entry *entry = HASHTABLE[idx];
-    long long now = current_millis();
-    while (entry) {
-        if (strcmp(entry->key, key) == 0) {
-            if (entry->expiry > 0 && entry->expiry <= now) {
-                pthread_mutex_unlock(&hashtable_mutex);
-                return "none"; 
-            }
-            const char *typeStr = "none";
-            if (entry->type == VALUE_STRING) {
-                typeStr = "string";
-            } else if (entry->type == VALUE_LIST) {
-                typeStr = "list";
+const char *get_type(const char *key, size_t key_len) {
+    uint64_t h;
+    KeyspaceShard *shard = shard_read_lock(key, key_len, &h);
+    Entry *entry = ht_find(&shard->table, key, key_len, h);
+    int expired = entry && is_expired(entry, expiry_now());
+
+    const char *typeStr = "none";
+    if (entry && !expired) {
+        if (entry->type == VALUE_STRING) {
+            typeStr = "string";
+        } else if (entry->type == VALUE_LIST) {
+            typeStr = "list";
+        }
+    }
+    shard_unlock(shard);
+
+    if (expired) reclaim_expired(key, key_len);
+    return typeStr;
+}
+
+/* ==================== Active Expiry ==================== */
+
+static long long monotonic_micros(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/**
+ * Reclaim up to ACTIVE_EXPIRE_BATCH due keys from one shard.
+ * @param more Set when due keys remain after the batch
+ * @return Keys reclaimed
+ */
+static size_t shard_expire_batch(KeyspaceShard *shard, long long now, int *more) {
+    size_t reclaimed = 0;
+    shard_lock_exclusive(shard);
+
+    HeapNode *node;
+    while ((node = minheap_peek(&shard->expires)) && node->key <= now) {
+        if (reclaimed == ACTIVE_EXPIRE_BATCH) {
+            *more = 1;
+            break;
+        }
+        Entry *entry = (Entry *)((char *)node - offsetof(Entry, expire_node));
+        HashBuckets *buckets = NULL;
+        Entry **ref = ht_find_ref(&shard->table, entry->key, entry->key_len, hash(entry->key, entry->key_len), &buckets);
+        if (ref) {
+            ht_expire_ref(shard, buckets, ref);
+        } else {
+            minheap_remove(&shard->expires, node);   //- Not reachable; should not happen -//
+        }
+        reclaimed++;
+    }
+
+    shard_write_unlock(shard);
+    return reclaimed;
+}
+
+size_t keyspace_active_expire(int first, int stride, long long budget_us) {
+    pthread_once(&keyspace_once, keyspace_init);
+    if (stride < 1) stride = 1;
+
+    long long start = monotonic_micros();
+    long long now = expiry_now();
+    size_t reclaimed = 0;
+    int more = 1;
+    int out_of_time = 0;
+
+    //-- Round-robin over our shards so one backlog cannot hog the budget --//
+    while (more && !out_of_time) {
+        more = 0;
+        for (int i = first; i < KEYSPACE_SHARDS; i += stride) {
+            reclaimed += shard_expire_batch(&KEYSPACE[i], now, &more);
+            if (monotonic_micros() - start >= budget_us) {
+                out_of_time = 1;
+                break;
             }
-            pthread_mutex_unlock(&hashtable_mutex);
-            return typeStr;
         }
-        entry = entry->next;
     }
-    pthread_mutex_unlock(&hashtable_mutex);
-    return "none";
+
+    __atomic_fetch_add(&expire_stats.active_cycles, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&expire_stats.active_time_us, monotonic_micros() - start, __ATOMIC_RELAXED);
+    if (out_of_time && more) {
+        __atomic_fetch_add(&expire_stats.timelimit_exits, 1, __ATOMIC_RELAXED);
+    }
+    return reclaimed;
+}
+
+void keyspace_expire_stats(ExpireStats *out) {
+    out->expired_keys = __atomic_load_n(&expire_stats.expired_keys, __ATOMIC_RELAXED);
+    out->expired_bytes = __atomic_load_n(&expire_stats.expired_bytes, __ATOMIC_RELAXED);
+    out->active_cycles = __atomic_load_n(&expire_stats.active_cycles, __ATOMIC_RELAXED);
+    out->active_time_us = __atomic_load_n(&expire_stats.active_time_us, __ATOMIC_RELAXED);
+    out->timelimit_exits = __atomic_load_n(&expire_stats.timelimit_exits, __ATOMIC_RELAXED);
 }
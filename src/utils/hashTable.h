@@ -5,8 +5,8 @@
  * 
  * File                      : src/utils/hashTable.h
  * Module                    : Hash Table
- * Last Updating Author      : youssefbouraoui1
- * Last Update               : 02/08/2026
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
  * Version                   : 1.0.0
  * 
  * Description:
@@ -19,10 +19,50 @@
 #ifndef HASHTABLE_H
 #define HASHTABLE_H
 
+#include <stdint.h>
+#include <pthread.h>
 #include "list.h"
+#include "minheap.h"
 
-/* ==================== HASHTABLE SIZE ==================== */
-#define TABLE_SIZE 1024
+/* ==================== HASHTABLE SIZING ==================== */
+#define HT_INITIAL_SIZE        16    //- Buckets in a fresh table, always a power of two -//
+#define HT_GROW_LOAD_FACTOR    1     //- Grow once keys >= buckets -//
+#define HT_SHRINK_LOAD_PERCENT 10    //- Shrink once keys < 10% of buckets -//
+#define HT_REHASH_STEP         1     //- Buckets migrated per operation while rehashing -//
+#define HT_REHASH_EMPTY_VISITS 10    //- Empty buckets skipped per migrated bucket -//
+#define KEYSPACE_SHARDS        16    //- Independently locked tables, a power of two -//
+#define HT_OPTIMISTIC_RETRIES  4     //- Lock-free GET attempts before taking the shared lock -//
+#define ACTIVE_EXPIRE_BATCH    32    //- Expired keys reclaimed per shard lock hold -//
+
+/* ==================== Write Conditions ==================== */
+#define SET_NX          (1 << 0)   //- Only set if the key does not exist -//
+#define SET_XX          (1 << 1)   //- Only set if the key exists -//
+#define SET_KEEPTTL     (1 << 2)   //- Keep the existing deadline -//
+
+#define EXPIRE_NX       (1 << 0)   //- Only if the key has no deadline -//
+#define EXPIRE_XX       (1 << 1)   //- Only if the key has a deadline -//
+#define EXPIRE_GT       (1 << 2)   //- Only if later than the current one (none = infinite) -//
+#define EXPIRE_LT       (1 << 3)   //- Only if earlier than the current one (none = infinite) -//
+
+#define TTL_NO_KEY      -2         //- get_key_ttl(): key absent -//
+#define TTL_PERSISTENT  -1         //- get_key_ttl(): key has no deadline -//
+
+#define LIST_ERR_WRONGTYPE  -1     //- List commands: key holds another type -//
+#define LIST_ERR_NO_KEY     -2     //- List commands: key absent -//
+#define LIST_ERR_RANGE      -3     //- set_list_index(): index out of range -//
+#define LIST_ERR_NO_PIVOT   -4     //- insert_list_value(): pivot not found -//
+#define LIST_ERR_NO_MEMORY  -5     //- List commands: allocation failed -//
+
+#define STRING_ERR_WRONGTYPE    -1 //- Counter commands: key holds another type -//
+#define STRING_ERR_NOT_INTEGER  -2 //- increment_value(): value is not an integer -//
+#define STRING_ERR_NOT_FLOAT    -3 //- increment_value_float(): value is not a number -//
+#define STRING_ERR_OVERFLOW     -4 //- Result out of range, NaN or infinite -//
+#define STRING_ERR_NO_MEMORY    -5 //- Counter commands: allocation failed -//
+
+/* ==================== Value Text Sizes ==================== */
+#define INT_TEXT_MAX        21     //- A 64-bit integer in text, sign and NUL included -//
+#define FLOAT_TEXT_MAX      5120   //- A long double in fixed-point text, NUL included -//
+#define SHARED_INTEGERS     10000  //- 0..9999 are served from pre-rendered text -//
 
 /* ==================== Value Types ==================== */
 typedef enum {
@@ -30,73 +70,422 @@ typedef enum {
     VALUE_LIST
 } value_type_t;
 
+typedef enum {
+    STRING_RAW,               //- Bytes in a StoredString -//
+    STRING_INT                //- A 64-bit integer kept in the entry, rendered as text on output -//
+} string_encoding_t;
+
+/* ==================== Stored Strings ==================== */
+/*
+ * A string value, sds style: its length and the room allocated for it sit
+ * in front of the bytes, which are NUL-terminated so they can also be read
+ * as a C string. Short values are embedded in their Entry; longer ones get
+ * a buffer of their own.
+ */
+typedef struct {
+    uint32_t len;             //- Bytes in the value -//
+    uint32_t capacity;        //- Bytes allocated for buf, NUL included -//
+    char buf[];
+} StoredString;
+
 /* ==================== Key-Value Struct ==================== */
+/*
+ * One allocation holds the entry, its key and, when the whole fits in
+ * ENTRY_EMBED_MAX bytes, its string value, so a GET reads one contiguous
+ * block. A string that reads as a canonical 64-bit integer ("42", "-7",
+ * not "007" or "+1") is kept as the number itself, with no StoredString.
+ * Once linked into a table, an entry's key, type, encoding and string
+ * value never change: overwriting a string builds a new entry in its
+ * place. The one exception is an integer, which INCR updates in place;
+ * a GET copies it out under the shard's sequence counter.
+ */
+#define ENTRY_EMBED_MAX 128   //- Largest entry that embeds its string value -//
+
 typedef struct Entry {
-    char *key;
-    value_type_t type;
+    struct Entry *next;
     union {
-        char *string_value;
+        StoredString *string_value;   //- STRING_RAW: embedded after the key, or a buffer of its own -//
+        long long int_value;          //- STRING_INT -//
         List *list_value;
     } data;
-    long long expiry; //- 0 = no expiry, != 0 = expiry time in ms -//
-    struct Entry *next;
+    uint32_t key_len;
+    uint8_t type;             //- value_type_t -//
+    uint8_t encoding;         //- string_encoding_t, strings only -//
+    long long expiry; //- 0 = no expiry, != 0 = deadline on the expiry_now() clock -//
+    HeapNode expire_node; //- Position in the shard's expiry index while expiry != 0 -//
+    char key[];               //- key_len bytes and a NUL, then the embedded value if any -//
 } Entry;
 
+/* ==================== Bucket Array ==================== */
+typedef struct {
+    Entry **table;
+    unsigned long size;       //- Number of buckets, a power of two (0 = unallocated) -//
+    unsigned long sizemask;
+    unsigned long used;       //- Keys stored in this array -//
+} HashBuckets;
+
+/* ==================== Incrementally Rehashed Table ==================== */
+/*
+ * Two bucket arrays: while resizing, keys move from ht[0] to ht[1] a few
+ * buckets per operation, so a resize never stops the world. Lookups check
+ * both arrays; inserts go to ht[1]. When ht[0] is empty, ht[1] takes its place.
+ */
+typedef struct {
+    HashBuckets ht[2];
+    long rehashidx;           //- Next ht[0] bucket to migrate, -1 when not rehashing -//
+} HashTable;
+
+/* ==================== Keyspace Shard ==================== */
+/*
+ * The keyspace is split into KEYSPACE_SHARDS tables, each behind its own
+ * reader/writer lock, so clients on different event loops only contend
+ * when they touch the same shard. A key's shard comes from the high bits
+ * of its hash; the low bits pick the bucket inside the shard.
+ *
+ * Readers (TYPE, LLEN, LRANGE) take the lock shared and never modify
+ * the table, so incremental rehashing only advances on writes.
+ *
+ * GET takes no lock at all: writers bump `seq` to odd for the length of
+ * their critical section and back to even when done, and a GET retries if
+ * the counter moved under it. Entries, string values and bucket arrays a
+ * GET may be looking at are retired through epoch.h rather than freed, so
+ * a stale pointer always refers to live memory.
+ */
+typedef struct {
+    pthread_rwlock_t lock;
+    unsigned long seq;        //- Odd while a writer holds the lock, accessed atomically -//
+    HashTable table;
+    MinHeap expires;          //- Entries with a TTL, earliest deadline first -//
+} KeyspaceShard;
+
+/* ==================== Expiry Statistics ==================== */
+typedef struct {
+    unsigned long long expired_keys;      //- Keys reclaimed on access or by the active cycle -//
+    unsigned long long expired_bytes;     //- Approximate memory those keys held -//
+    unsigned long long active_cycles;     //- Active expire cycles run -//
+    unsigned long long active_time_us;    //- Time spent inside them -//
+    unsigned long long timelimit_exits;   //- Cycles stopped by their budget with work left -//
+} ExpireStats;
+
 /* ============================================================ */
-/* ==================== The Main HashTable ==================== */
+/* ==================== The Main Keyspace ==================== */
 /* ============================================================ */
 
-extern Entry *HASHTABLE[TABLE_SIZE];
+extern KeyspaceShard KEYSPACE[KEYSPACE_SHARDS];
 
 /**
- * @brief Hash function to compute the index for a given key.
+ * @brief Index of the shard owning `key`, in [0, KEYSPACE_SHARDS).
+ */
+int keyspace_shard_of(const char *key, size_t key_len);
+
+/**
+ * @brief Skip the shard locks.
+ *
+ * Only valid when every shard is accessed by a single thread, as in the
+ * shard-per-core execution mode. Must be set before any thread starts.
+ *
+ * @param enabled Non-zero to stop locking.
+ */
+void keyspace_set_lockless(int enabled);
+
+/**
+ * @brief Hash function for string keys.
  * 
- * This function uses a simple hash algorithm to convert a string key
- * into an unsigned integer index suitable for use in the hash table.
+ * SipHash-1-3 under the process-wide seed (see siphash.h), so bucket
+ * placement cannot be predicted by clients; callers mask it with the
+ * bucket count.
  * 
  * @param key The key to hash.
- * @return The computed hash index.
+ * @param len Its length in bytes.
+ * @return The computed 64-bit hash.
+ */
+uint64_t hash(const char *key, size_t len);
+
+/**
+ * @brief Number of keys stored, including expired keys not yet reclaimed.
+ */
+size_t hashtable_key_count(void);
+
+/**
+ * @brief Number of keys with a TTL, including expired keys not yet reclaimed.
+ */
+size_t hashtable_expires_count(void);
+
+/**
+ * @brief Number of buckets allocated across both bucket arrays.
+ */
+size_t hashtable_bucket_count(void);
+
+/**
+ * @brief Whether a resize is in progress.
+ * @return 1 while keys are being migrated, 0 otherwise.
+ */
+int hashtable_is_rehashing(void);
+
+/*
+ * Keys and values are binary safe: every key and value crosses this API as
+ * a pointer and a length, and may contain NUL bytes.
  */
-unsigned int hash(const char *key);
 
 /**
  * @brief Set a string value in the hash table.
  * 
  * @param key The key to set.
+ * @param key_len Its length.
  * @param value The string value to associate with the key.
+ * @param value_len Its length.
  * @param px Expiry time in milliseconds (0 for no expiry).
  */
-void set_value(const char *key, const char *value, long long px);
+void set_value(const char *key, size_t key_len, const char *value, size_t value_len, long long px);
+
+/**
+ * @brief Set a string value under SET's NX/XX/KEEPTTL/GET options.
+ *
+ * @param key The key to set.
+ * @param key_len Its length.
+ * @param value The string value to associate with the key.
+ * @param value_len Its length.
+ * @param expiry Absolute deadline from expiry_now(), 0 for none.
+ * @param flags SET_NX, SET_XX and/or SET_KEEPTTL.
+ * @param old_value If not NULL, receives a heap copy of the previous
+ *                  string value (NULL if there was none), NUL-terminated.
+ * @param old_len Set to the length of *old_value when one is returned.
+ * @return 1 if the value was stored, 0 if a condition failed,
+ *         STRING_ERR_WRONGTYPE if old_value was requested and the key holds
+ *         another type, STRING_ERR_NO_MEMORY if nothing could be stored or
+ *         the previous value could not be copied (*old_value is then NULL).
+ */
+int set_value_ex(const char *key, size_t key_len, const char *value, size_t value_len,
+                 long long expiry, int flags, char **old_value, size_t *old_len);
+
+/**
+ * @brief Change a key's deadline in place, without touching its value.
+ *
+ * A deadline that has already passed deletes the key.
+ *
+ * @param key The key to update.
+ * @param expiry Absolute deadline from expiry_now().
+ * @param flags EXPIRE_NX, EXPIRE_XX, EXPIRE_GT or EXPIRE_LT.
+ * @return 1 if the deadline was set (or the key deleted), 0 if the key is
+ *         absent or a condition failed.
+ */
+int set_key_expiry(const char *key, size_t key_len, long long expiry, int flags);
+
+/**
+ * @brief Remove a key's deadline.
+ * @return 1 if a deadline was removed, 0 if the key is absent or had none.
+ */
+int persist_key(const char *key, size_t key_len);
+
+/**
+ * @brief Remaining time to live of a key.
+ * @return Milliseconds left, TTL_PERSISTENT or TTL_NO_KEY.
+ */
+long long get_key_ttl(const char *key, size_t key_len);
 
 /**
- * @brief Get a string value from the hash table.
+ * @brief Get a string value from the hash table without locking.
+ * 
+ * A raw value is returned in place, not copied. Call it inside
+ * epoch_enter()/epoch_exit(): the value stays readable until epoch_exit()
+ * even if another thread overwrites or deletes the key meanwhile. An
+ * integer is rendered into int_buf, or taken from the shared text of
+ * 0..SHARED_INTEGERS-1.
  * 
  * @param key The key to retrieve.
- * @return The string value, or NULL if not found or expired.
+ * @param key_len Its length.
+ * @param value_len Set to the length of the value when one is returned.
+ * @param int_buf INT_TEXT_MAX bytes for an integer value's text.
+ * @return The string value (also NUL-terminated), or NULL if not found,
+ *         expired or not a string.
+ */
+const char *get_value(const char *key, size_t key_len, size_t *value_len, char *int_buf);
+
+/**
+ * @brief Add delta to the integer at key (INCR, DECR, INCRBY, DECRBY).
+ *
+ * A missing key counts as 0. The key keeps its deadline.
+ *
+ * @param result Set to the new value on success.
+ * @return 1 on success, or STRING_ERR_WRONGTYPE, STRING_ERR_NOT_INTEGER,
+ *         STRING_ERR_OVERFLOW or STRING_ERR_NO_MEMORY.
+ */
+int increment_value(const char *key, size_t key_len, long long delta, long long *result);
+
+/**
+ * @brief Add delta to the number at key (INCRBYFLOAT).
+ *
+ * A missing key counts as 0. The sum is stored as text, trailing zeros
+ * dropped, and the key keeps its deadline.
+ *
+ * @param result FLOAT_TEXT_MAX bytes, set to the new value's text on success.
+ * @param result_len Set to its length.
+ * @return 1 on success, or STRING_ERR_WRONGTYPE, STRING_ERR_NOT_FLOAT,
+ *         STRING_ERR_OVERFLOW or STRING_ERR_NO_MEMORY.
+ */
+int increment_value_float(const char *key, size_t key_len, long double delta, char *result, size_t *result_len);
+
+/**
+ * A value read by get_values().
+ */
+typedef struct {
+    const char *value;            //- NULL when the key is missing, expired or not a string -//
+    size_t len;
+    char int_buf[INT_TEXT_MAX];   //- Holds the text of an integer value -//
+} StringValue;
+
+/**
+ * @brief Get several string values at once (MGET).
+ *
+ * Keys are grouped by shard and each shard is read once: lock-free, or
+ * under its shared lock if writers keep interfering. The values form one
+ * snapshot, never half of an MSET. Like get_value(), call it inside
+ * epoch_enter()/epoch_exit(): raw values are returned in place.
+ *
+ * @param keys The keys to retrieve.
+ * @param key_lens Their lengths.
+ * @param count Number of keys, at least 1.
+ * @param values Receives the value of each key, in order.
+ * @return 0 on success, STRING_ERR_NO_MEMORY.
  */
-const char *get_value(const char *key);
+int get_values(char *keys[], const size_t key_lens[], int count, StringValue values[]);
 
 /**
- * Get an existing list or create a new one
- * @param key The key to lookup or create
- * @return Pointer to the list, NULL on error
+ * @brief Set several string values at once (MSET, MSETNX).
+ *
+ * Every shard involved is locked once, and all of them for the whole
+ * update, so readers see either none or all of the values. The keys lose
+ * their deadlines. A key given twice keeps its last value.
+ *
+ * @param pairs count keys, each followed by its value.
+ * @param lens Their lengths, in the same layout.
+ * @param count Number of key/value pairs, at least 1.
+ * @param flags 0, or SET_NX to store nothing if any of the keys exists.
+ * @return 1 if stored, 0 if SET_NX found an existing key,
+ *         STRING_ERR_NO_MEMORY (nothing stored).
  */
-List *get_or_create_list(const char *key);
+int set_values(char *pairs[], const size_t lens[], int count, int flags);
 
 /**
- * Get the list at key if it exists and is a list.
- * @param key The key to lookup
- * @return Pointer to the list, or NULL if not found or not a list
+ * Push values onto the list at key, creating the list if needed.
+ * @param key The list key
+ * @param key_len Its length
+ * @param values Values to push, in order
+ * @param lens Their lengths
+ * @param count Number of values
+ * @param to_head Non-zero for LPUSH semantics, zero for RPUSH
+ * @return The new length of the list, LIST_ERR_WRONGTYPE if key holds another
+ *         type, or LIST_ERR_NO_MEMORY if a value could not be added
  */
-List *get_list_if_exists(const char *key);
+long long push_list_values(const char *key, size_t key_len, char *values[], const size_t lens[],
+                           int count, int to_head);
+
+/**
+ * @param key The list key
+ * @param key_len Its length
+ * @return Length of the list at key, 0 if absent or not a list
+ */
+size_t get_list_length(const char *key, size_t key_len);
+
+/**
+ * Atomically pop an element from one end of src and push it onto one end
+ * of dst, creating dst if needed (LMOVE semantics; src may equal dst).
+ * @param src_where End of src popped from, LIST_HEAD or LIST_TAIL
+ * @param dst_where End of dst pushed onto
+ * @param element Set to a heap copy of the moved element on success
+ * @param element_len Set to its length
+ * @return 1 if moved, 0 if src is empty or absent, -1 if either key holds
+ *         another type
+ */
+int move_list_value(const char *src, size_t src_len, const char *dst, size_t dst_len,
+                    int src_where, int dst_where, char **element, size_t *element_len);
+
+/**
+ * Hand a range of the list at key (LRANGE semantics) to sink under the
+ * shard lock, without copying the elements. A missing key is an empty list.
+ * @return Number of elements passed to sink, or LIST_ERR_WRONGTYPE (sink
+ *         not called)
+ */
+long long read_list_range(const char *key, size_t key_len, long start, long end, const ListSink *sink);
+
+/**
+ * Pop up to count elements from one end of the list at key, handing each
+ * to sink under the shard lock. A missing key is an empty list.
+ * @param where LIST_HEAD or LIST_TAIL
+ * @return Number of elements passed to sink, or LIST_ERR_WRONGTYPE (sink
+ *         not called)
+ */
+long long pop_list_into(const char *key, size_t key_len, int where, size_t count, const ListSink *sink);
+
+/**
+ * Overwrite the element at index of the list at key (LSET semantics).
+ * @return 1 on success, or LIST_ERR_NO_KEY, LIST_ERR_RANGE,
+ *         LIST_ERR_WRONGTYPE, LIST_ERR_NO_MEMORY
+ */
+int set_list_index(const char *key, size_t key_len, long index, const char *value, size_t value_len);
+
+/**
+ * Insert value before or after the first occurrence of pivot in the list
+ * at key (LINSERT semantics).
+ * @param after Nonzero to insert after the pivot
+ * @return The new length, 0 if key is absent, or LIST_ERR_NO_PIVOT,
+ *         LIST_ERR_WRONGTYPE, LIST_ERR_NO_MEMORY
+ */
+long long insert_list_value(const char *key, size_t key_len, int after, const char *pivot, size_t pivot_len,
+                            const char *value, size_t value_len);
+
+/**
+ * Keep only the elements from start to end inclusive of the list at key
+ * (LTRIM semantics).
+ * @return 1 on success, 0 if key is absent, LIST_ERR_WRONGTYPE
+ */
+int trim_list(const char *key, size_t key_len, long start, long end);
+
+/**
+ * Remove elements equal to value from the list at key (LREM semantics).
+ * @param count From the head if positive, from the tail if negative, all if 0
+ * @return Number removed, or LIST_ERR_WRONGTYPE
+ */
+long long remove_list_values(const char *key, size_t key_len, long count, const char *value, size_t value_len);
+
+/**
+ * Indexes of the elements equal to value in the list at key (LPOS semantics).
+ * @param rank Match to start from, nonzero; negative scans from the tail
+ * @param count Matches returned at most, 0 for all
+ * @param maxlen Elements compared at most, 0 for all
+ * @param found Set to the number of indexes, or LIST_ERR_WRONGTYPE
+ * @return Array of indexes the caller frees, NULL if none
+ */
+long *find_list_positions(const char *key, size_t key_len, const char *value, size_t value_len,
+                          long rank, long count, long maxlen, long *found);
 
 /**
  * Delete a key from the hash table, removing both string and list types.
  * Properly frees memory for both string values and list structures.
  * @param key The key to delete
- * @return 1 if the key was deleted, 0 if not found
+ * @param key_len Its length
+ * @return 1 if the key was deleted, 0 if not found or already expired
+ */
+int delete_key(const char *key, size_t key_len);
+
+/**
+ * @brief Reclaim expired keys from a subset of shards, earliest deadline first.
+ *
+ * Walks shards first, first + stride, ... and deletes keys whose deadline
+ * has passed, ACTIVE_EXPIRE_BATCH at a time per shard lock hold, until none
+ * are left or `budget_us` microseconds have been spent.
+ *
+ * @param first First shard to visit.
+ * @param stride Distance between visited shards (>= 1).
+ * @param budget_us CPU time budget for this call.
+ * @return Number of keys reclaimed.
+ */
+size_t keyspace_active_expire(int first, int stride, long long budget_us);
+
+/**
+ * @brief Snapshot the process-wide expiry counters.
  */
-int delete_key(const char *key);
+void keyspace_expire_stats(ExpireStats *out);
 
 /**
  * Get current time in milliseconds since epoch
@@ -104,12 +493,30 @@ int delete_key(const char *key);
  */
 long long current_millis(void);
 
+/**
+ * @brief Clock all key deadlines are measured on.
+ *
+ * Monotonic, so setting the system clock neither expires keys early nor
+ * keeps them alive. Only differences with it are meaningful.
+ *
+ * @return Milliseconds on a monotonic clock, always > 0.
+ */
+long long expiry_now(void);
+
+/**
+ * @brief Convert a Unix time in milliseconds to an expiry_now() deadline.
+ *
+ * The wall clock is only read here, at the moment the deadline is set.
+ */
+long long expiry_from_unix_ms(long long unix_ms);
+
 /**
  * @brief Get the type of the value at key.
  * 
  * @param key The key to lookup.
+ * @param key_len Its length.
  * @return "string", "list", or "none" if not found.
  */
-const char *get_type(const char *key);
+const char *get_type(const char *key, size_t key_len);
 
 #endif // HASHTABLE_H
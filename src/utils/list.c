@@ -4,80 +4,713 @@
  * =====================================================
  * 
  * File                      : src/utils/list.c
- * Module                    : Linked List
- * Last Updating Author      : kei077
- * Last Update               : 08/06/2025
+ * Module                    : Packed List
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
  * Version                   : 1.0.0
  * 
  * Description:
- *  Implementation of linked list for MemoraDB list operations.
+ *  Implementation of the packed list (quicklist) behind MemoraDB list
+ *  operations: a doubly linked list of nodes that each pack a run of
+ *  length-prefixed elements, with optional LZF compression of the nodes
+ *  away from both ends.
  * 
  * Copyright (c) 2025 MemoraDB Project
  * =====================================================
  */
 
 #include "list.h"
+#include "lzf.h"
+#include "slab.h"
 #include <string.h>
 
+/* ==================== Encoding Settings ==================== */
+#define LIST_NODE_MIN_CAPACITY 64    //- Smallest node buffer -//
+#define LIST_VARINT_MAX        10    //- Bytes of a 64-bit length prefix -//
+#define LIST_COMPRESS_GAIN     8     //- Bytes compression must save to be kept -//
+
+static size_t list_node_bytes = LIST_NODE_BYTES_DEFAULT;
+static int list_compress_depth = LIST_COMPRESS_DEPTH_DEFAULT;
+
+void list_configure(size_t node_bytes, int compress_depth) {
+    list_node_bytes = node_bytes < LIST_NODE_MIN_CAPACITY ? LIST_NODE_MIN_CAPACITY : node_bytes;
+    list_compress_depth = compress_depth < 0 ? 0 : compress_depth;
+}
+
+/* ==================== Entry Encoding ==================== */
+
+static size_t varint_size(size_t value) {
+    size_t n = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        n++;
+    }
+    return n;
+}
+
+static size_t entry_size(size_t len) {
+    return 2 * varint_size(len) + len;
+}
+
+/**
+ * Write an entry at p: prefix, bytes, then the prefix reversed so it can
+ * be read from the end.
+ */
+static void entry_write(unsigned char *p, const char *value, size_t len) {
+    unsigned char prefix[LIST_VARINT_MAX];
+    size_t n = 0;
+    size_t rest = len;
+    do {
+        prefix[n] = rest & 0x7f;
+        rest >>= 7;
+        if (rest) prefix[n] |= 0x80;
+        n++;
+    } while (rest);
+
+    memcpy(p, prefix, n);
+    memcpy(p + n, value, len);
+    p += n + len;
+    for (size_t i = 0; i < n; i++) p[i] = prefix[n - 1 - i];
+}
+
+/**
+ * Decode the entry starting at p.
+ * @return Start of the next entry
+ */
+static const unsigned char *entry_read(const unsigned char *p, const char **value, size_t *len) {
+    size_t v = 0, n = 0;
+    int shift = 0;
+    do {
+        v |= (size_t)(p[n] & 0x7f) << shift;
+        shift += 7;
+    } while (p[n++] & 0x80);
+
+    *value = (const char *)p + n;
+    *len = v;
+    return p + 2 * n + v;
+}
+
+/**
+ * Decode the entry ending just before end.
+ * @return Start of that entry
+ */
+static const unsigned char *entry_read_back(const unsigned char *end, const char **value, size_t *len) {
+    size_t v = 0, n = 0;
+    int shift = 0;
+    do {
+        n++;
+        v |= (size_t)(end[-(ptrdiff_t)n] & 0x7f) << shift;
+        shift += 7;
+    } while (end[-(ptrdiff_t)n] & 0x80);
+
+    const unsigned char *start = end - 2 * n - v;
+    *value = (const char *)start + n;
+    *len = v;
+    return start;
+}
+
+static char *value_copy(const char *value, size_t len) {
+    char *copy = malloc(len + 1);
+    if (!copy) return NULL;
+    memcpy(copy, value, len);
+    copy[len] = '\0';
+    return copy;
+}
+
+/* ==================== Nodes ==================== */
+
+/**
+ * Allocate an empty node with room for `need` bytes, the room placed on
+ * the side pushes will come from.
+ */
+static ListNode *node_create(size_t need, int where) {
+    size_t limit = need > list_node_bytes ? need : list_node_bytes;
+    size_t capacity = LIST_NODE_MIN_CAPACITY;
+    while (capacity < need) capacity *= 2;
+    if (capacity > limit) capacity = limit;
+
+    ListNode *node = slab_alloc(sizeof(ListNode));
+    if (!node) return NULL;
+    memset(node, 0, sizeof(*node));
+    node->data = slab_alloc(capacity);
+    if (!node->data) {
+        slab_free(node, sizeof(ListNode));
+        return NULL;
+    }
+    node->capacity = (unsigned int)capacity;
+    node->start = where == LIST_HEAD ? node->capacity : 0;
+    return node;
+}
+
+static void node_free(ListNode *node) {
+    slab_free(node->data, node->capacity);
+    slab_free(node, sizeof(ListNode));
+}
+
+/**
+ * Make esize bytes of room at one end of a raw node, growing it or sliding
+ * its entries. Growth puts all the new room on the side asked for, so a
+ * node filled from one end never slides.
+ */
+static int node_make_room(ListNode *node, int where, size_t esize) {
+    size_t tail_room = node->capacity - node->start - node->bytes;
+    if ((where == LIST_HEAD ? node->start : tail_room) >= esize) return 0;
+
+    size_t capacity = node->capacity;
+    size_t need = node->bytes + esize;
+    size_t limit = need > list_node_bytes ? need : list_node_bytes;
+    while (capacity < need) capacity *= 2;
+    if (capacity > limit) capacity = limit;
+    //-- LSET/LINSERT may have grown the node past the limit: never shrink here, entries may lie beyond --//
+    if (capacity < node->capacity) capacity = node->capacity;
+
+    size_t start;
+    if (capacity != node->capacity) {
+        unsigned char *data = slab_realloc(node->data, node->capacity, capacity);
+        if (!data) return -1;
+        node->data = data;
+        start = where == LIST_HEAD ? capacity - node->bytes : 0;
+    } else {
+        //-- Both ends in use: split the slack, the side asked for getting esize more --//
+        size_t side = esize + (capacity - need) / 2;
+        start = where == LIST_HEAD ? side : capacity - node->bytes - side;
+    }
+
+    memmove(node->data + start, node->data + node->start, node->bytes);
+    node->start = (unsigned int)start;
+    node->capacity = (unsigned int)capacity;
+    return 0;
+}
+
+/**
+ * Give back memory once a node is mostly empty.
+ */
+static void node_shrink(ListNode *node) {
+    if (node->capacity <= LIST_NODE_MIN_CAPACITY || (size_t)node->bytes * 4 >= node->capacity) return;
+
+    size_t capacity = node->capacity / 2;
+    memmove(node->data, node->data + node->start, node->bytes);
+    unsigned char *data = slab_realloc(node->data, node->capacity, capacity);
+    if (data) {
+        node->data = data;
+        node->capacity = (unsigned int)capacity;
+    }
+    node->start = 0;
+}
+
+static int node_push(ListNode *node, int where, const char *value, size_t len) {
+    size_t esize = entry_size(len);
+    if (node_make_room(node, where, esize) != 0) return -1;
+
+    unsigned char *p;
+    if (where == LIST_HEAD) {
+        node->start -= (unsigned int)esize;
+        p = node->data + node->start;
+    } else {
+        p = node->data + node->start + node->bytes;
+    }
+    entry_write(p, value, len);
+    node->bytes += (unsigned int)esize;
+    node->count++;
+    return 0;
+}
+
+/**
+ * Locate the entry at one end of a raw node, leaving it in place.
+ * @return Its encoded size
+ */
+static size_t node_end_entry(const ListNode *node, int where, const char **value, size_t *len) {
+    const unsigned char *first = node->data + node->start;
+    const unsigned char *end = first + node->bytes;
+
+    if (where == LIST_HEAD) {
+        return (size_t)(entry_read(first, value, len) - first);
+    }
+    return (size_t)(end - entry_read_back(end, value, len));
+}
+
+/**
+ * Drop the entry of esize bytes at one end of a raw node.
+ */
+static void node_drop(ListNode *node, int where, size_t esize) {
+    if (where == LIST_HEAD) node->start += (unsigned int)esize;
+    node->bytes -= (unsigned int)esize;
+    node->count--;
+    node_shrink(node);
+}
+
+/**
+ * Remove the entry at one end of a raw node.
+ * @param len Set to the value's length
+ * @return A copy of its value, NULL if out of memory (nothing removed)
+ */
+static char *node_pop(ListNode *node, int where, size_t *len) {
+    const char *value;
+    size_t esize = node_end_entry(node, where, &value, len);
+
+    char *copy = value_copy(value, *len);
+    if (!copy) return NULL;
+    node_drop(node, where, esize);
+    return copy;
+}
+
+/* ==================== Editing Inside Nodes ==================== */
+
+/**
+ * Entry at position offset of a raw node (offset == count is the end),
+ * reached from the nearer side.
+ */
+static unsigned char *node_entry_at(ListNode *node, size_t offset) {
+    unsigned char *p = node->data + node->start;
+    const char *value;
+    size_t len;
+
+    if (offset <= node->count / 2) {
+        for (size_t i = 0; i < offset; i++) {
+            p = (unsigned char *)entry_read(p, &value, &len);
+        }
+    } else {
+        p += node->bytes;
+        for (size_t i = node->count; i > offset; i--) {
+            p = (unsigned char *)entry_read_back(p, &value, &len);
+        }
+    }
+    return p;
+}
+
+/**
+ * Insert an entry before position offset of a raw node.
+ */
+static int node_insert_at(ListNode *node, size_t offset, const char *value, size_t len) {
+    if (offset == 0) return node_push(node, LIST_HEAD, value, len);
+    if (offset == node->count) return node_push(node, LIST_TAIL, value, len);
+
+    size_t esize = entry_size(len);
+    size_t pos = (size_t)(node_entry_at(node, offset) - (node->data + node->start));
+    if (node_make_room(node, LIST_TAIL, esize) != 0) return -1;
+
+    unsigned char *p = node->data + node->start + pos;
+    memmove(p + esize, p, node->bytes - pos);
+    entry_write(p, value, len);
+    node->bytes += (unsigned int)esize;
+    node->count++;
+    return 0;
+}
+
+/**
+ * Overwrite the entry at position offset of a raw node.
+ */
+static int node_replace(ListNode *node, size_t offset, const char *value, size_t len) {
+    unsigned char *p = node_entry_at(node, offset);
+    const char *old;
+    size_t old_len;
+    size_t pos = (size_t)(p - (node->data + node->start));
+    size_t old_size = (size_t)(entry_read(p, &old, &old_len) - p);
+    size_t new_size = entry_size(len);
+
+    if (new_size > old_size && node_make_room(node, LIST_TAIL, new_size - old_size) != 0) return -1;
+    p = node->data + node->start + pos;
+    memmove(p + new_size, p + old_size, node->bytes - pos - old_size);
+    entry_write(p, value, len);
+    node->bytes = (unsigned int)(node->bytes - old_size + new_size);
+    if (new_size < old_size) node_shrink(node);
+    return 0;
+}
+
+/**
+ * Remove n entries starting at position offset of a raw node.
+ */
+static void node_delete(ListNode *node, size_t offset, size_t n) {
+    unsigned char *p = node_entry_at(node, offset), *q = p;
+    unsigned char *end = node->data + node->start + node->bytes;
+    const char *value;
+    size_t len;
+    for (size_t i = 0; i < n; i++) {
+        q = (unsigned char *)entry_read(q, &value, &len);
+    }
+
+    //-- A cut at the front only moves the start --//
+    if (offset == 0) {
+        node->start += (unsigned int)(q - p);
+    } else {
+        memmove(p, q, (size_t)(end - q));
+    }
+    node->bytes -= (unsigned int)(q - p);
+    node->count -= (unsigned int)n;
+    node_shrink(node);
+}
+
+/**
+ * Remove the entries of a raw node equal to value, scanning from one end.
+ * @param max Entries to remove at most, 0 for all
+ * @return Number removed
+ */
+static size_t node_remove_matches(ListNode *node, int where, const char *value, size_t len, size_t max) {
+    unsigned char *first = node->data + node->start;
+    unsigned char *end = first + node->bytes;
+    const char *entry;
+    size_t entry_len, removed = 0;
+
+    if (where == LIST_HEAD) {
+        unsigned char *p = first;
+        while (p < end && (!max || removed < max)) {
+            unsigned char *next = (unsigned char *)entry_read(p, &entry, &entry_len);
+            if (entry_len == len && memcmp(entry, value, len) == 0) {
+                memmove(p, next, (size_t)(end - next));
+                end -= next - p;
+                removed++;
+            } else {
+                p = next;
+            }
+        }
+    } else {
+        unsigned char *p = end;
+        while (p > first && (!max || removed < max)) {
+            unsigned char *prev = (unsigned char *)entry_read_back(p, &entry, &entry_len);
+            if (entry_len == len && memcmp(entry, value, len) == 0) {
+                memmove(prev, p, (size_t)(end - p));
+                end -= p - prev;
+                removed++;
+            }
+            p = prev;
+        }
+    }
+
+    node->bytes = (unsigned int)(end - first);
+    node->count -= (unsigned int)removed;
+    node_shrink(node);
+    return removed;
+}
+
+/* ==================== Compression ==================== */
+
+/**
+ * Replace a node's entries by their LZF image, unless that saves too little.
+ */
+static void node_compress(ListNode *node) {
+    if (node->compressed || node->bytes < LIST_COMPRESS_MIN_BYTES) return;
+
+    unsigned char *image = slab_alloc(node->bytes);
+    size_t size = image ? lzf_compress(node->data + node->start, node->bytes, image,
+                                       node->bytes - LIST_COMPRESS_GAIN) : 0;
+    if (size == 0) {
+        slab_free(image, node->bytes);
+        return;
+    }
+
+    unsigned char *fit = slab_realloc(image, node->bytes, size);
+    slab_free(node->data, node->capacity);
+    node->data = fit ? fit : image;
+    node->capacity = (unsigned int)(fit ? size : node->bytes);
+    node->compressed = (unsigned int)size;
+    node->start = 0;
+}
+
+static int node_decompress(ListNode *node) {
+    if (!node->compressed) return 0;
+
+    unsigned char *raw = slab_alloc(node->bytes);
+    if (!raw || lzf_decompress(node->data, node->compressed, raw, node->bytes) != node->bytes) {
+        slab_free(raw, node->bytes);
+        return -1;
+    }
+    slab_free(node->data, node->capacity);
+    node->data = raw;
+    node->capacity = node->bytes;
+    node->compressed = 0;
+    node->start = 0;
+    return 0;
+}
+
+/**
+ * Entries of a node for reading. A compressed node is left as is and
+ * expanded into *scratch, which the caller frees.
+ * @return First entry, NULL if out of memory
+ */
+static const unsigned char *node_entries(const ListNode *node, unsigned char **scratch) {
+    *scratch = NULL;
+    if (!node->compressed) return node->data + node->start;
+
+    *scratch = malloc(node->bytes);
+    if (!*scratch || lzf_decompress(node->data, node->compressed, *scratch, node->bytes) != node->bytes) {
+        free(*scratch);
+        *scratch = NULL;
+    }
+    return *scratch;
+}
+
+/**
+ * Keep the compress_depth nodes at each end raw and the next ones in
+ * compressed. Nodes only come and go at the ends, where this is called
+ * after each change, so everything further in stays compressed.
+ */
+static void list_compress_ends(List *list) {
+    if (list_compress_depth == 0 || !list->head) return;
+
+    ListNode *forward = list->head, *backward = list->tail;
+    for (int i = 0; i < list_compress_depth; i++) {
+        node_decompress(forward);
+        node_decompress(backward);
+        //-- The ends met: no node is deep enough to compress --//
+        if (forward == backward || forward->next == backward) return;
+        forward = forward->next;
+        backward = backward->prev;
+    }
+
+    node_compress(forward);
+    if (backward != forward) node_compress(backward);
+}
+
+/**
+ * Compress a node edited in place if it lies deeper than compress_depth
+ * from both ends.
+ */
+static void list_settle(List *list, ListNode *node) {
+    if (list_compress_depth == 0) return;
+
+    ListNode *forward = list->head, *backward = list->tail;
+    for (int i = 0; i < list_compress_depth && forward; i++) {
+        if (forward == node || backward == node) return;
+        forward = forward->next;
+        backward = backward->prev;
+    }
+    node_compress(node);
+}
+
+/**
+ * Whether a compressed node holds value, so that only nodes with matches
+ * are expanded for good. Assumes a match when it cannot tell.
+ */
+static int node_contains(const ListNode *node, const char *value, size_t len) {
+    unsigned char *scratch;
+    const unsigned char *p = node_entries(node, &scratch);
+    if (!p) return 1;
+
+    int found = 0;
+    const char *entry;
+    size_t entry_len;
+    for (size_t i = 0; i < node->count && !found; i++) {
+        p = entry_read(p, &entry, &entry_len);
+        found = entry_len == len && memcmp(entry, value, len) == 0;
+    }
+    free(scratch);
+    return found;
+}
+
+/* ==================== Node Links ==================== */
+
+/**
+ * Link a node next to `at` (after it when `after`), or as the only node
+ * when at is NULL.
+ */
+static void list_link_at(List *list, ListNode *node, ListNode *at, int after) {
+    if (!at) {
+        node->prev = node->next = NULL;
+        list->head = list->tail = node;
+    } else if (after) {
+        node->prev = at;
+        node->next = at->next;
+        if (at->next) at->next->prev = node; else list->tail = node;
+        at->next = node;
+    } else {
+        node->next = at;
+        node->prev = at->prev;
+        if (at->prev) at->prev->next = node; else list->head = node;
+        at->prev = node;
+    }
+    list->nodes++;
+}
+
+static void list_link(List *list, ListNode *node, int where) {
+    list_link_at(list, node, where == LIST_HEAD ? list->head : list->tail, where == LIST_TAIL);
+}
+
+static void list_unlink(List *list, ListNode *node) {
+    if (node->prev) node->prev->next = node->next; else list->head = node->next;
+    if (node->next) node->next->prev = node->prev; else list->tail = node->prev;
+    list->nodes--;
+}
+
+/**
+ * Find the node holding element `index` (0 <= index < length), walking
+ * whole nodes from the nearer end.
+ * @param offset Set to the element's position inside the node
+ */
+static ListNode *list_seek(const List *list, size_t index, size_t *offset) {
+    ListNode *node;
+    if (index < list->length / 2) {
+        for (node = list->head; index >= node->count; node = node->next) {
+            index -= node->count;
+        }
+    } else {
+        size_t from_tail = list->length - 1 - index;
+        for (node = list->tail; from_tail >= node->count; node = node->prev) {
+            from_tail -= node->count;
+        }
+        index = node->count - 1 - from_tail;
+    }
+    *offset = index;
+    return node;
+}
+
+/* ==================== Multi-Node Edits ==================== */
+
+/**
+ * Move the entries of a raw node from position offset on into a new node
+ * linked after it.
+ */
+static int node_split(List *list, ListNode *node, size_t offset) {
+    size_t pos = (size_t)(node_entry_at(node, offset) - (node->data + node->start));
+    size_t moved = node->bytes - pos;
+    ListNode *right = node_create(moved, LIST_TAIL);
+    if (!right) return -1;
+
+    memcpy(right->data, node->data + node->start + pos, moved);
+    right->bytes = (unsigned int)moved;
+    right->count = node->count - (unsigned int)offset;
+    node->bytes = (unsigned int)pos;
+    node->count = (unsigned int)offset;
+    list_link_at(list, right, node, 1);
+    node_shrink(node);
+    return 0;
+}
+
+/**
+ * Insert before position offset of node, splitting it or spilling into a
+ * neighbour or a new node when it is full.
+ */
+static int list_insert_at(List *list, ListNode *node, size_t offset, const char *value, size_t len) {
+    size_t esize = entry_size(len);
+    if (node_decompress(node) != 0) return -1;
+
+    ListNode *target = node, *split = NULL;
+    if (node->bytes + esize > list_node_bytes) {
+        if (offset > 0 && offset < node->count) {
+            if (node_split(list, node, offset) != 0) return -1;
+            split = node->next;
+        }
+        //-- The insertion point is now an edge of node: use it, the node past that edge, or a new one --//
+        if (node->bytes + esize > list_node_bytes) {
+            ListNode *neighbour = offset == 0 ? node->prev : node->next;
+            if (neighbour && neighbour->bytes + esize <= list_node_bytes && node_decompress(neighbour) == 0) {
+                target = neighbour;
+                offset = offset == 0 ? neighbour->count : 0;
+            } else {
+                if (!(target = node_create(esize, LIST_TAIL))) return -1;
+                list_link_at(list, target, node, offset != 0);
+                offset = 0;
+            }
+        }
+    }
+
+    if (node_insert_at(target, offset, value, len) != 0) {
+        if (target->count == 0) {
+            list_unlink(list, target);
+            node_free(target);
+        }
+        return -1;
+    }
+    list->length++;
+
+    list_compress_ends(list);
+    list_settle(list, node);
+    if (split) list_settle(list, split);
+    if (target != node && target != split) list_settle(list, target);
+    return 0;
+}
+
+/**
+ * Remove count elements starting at index (both within the list). Whole
+ * nodes are unlinked without being expanded.
+ */
+static void list_delete_range(List *list, size_t index, size_t count) {
+    if (count == 0) return;
+
+    size_t offset;
+    ListNode *node = list_seek(list, index, &offset);
+    ListNode *edited[2];   //- Only the first and last nodes can be cut partially -//
+    int nedited = 0;
+
+    while (count > 0 && node) {
+        ListNode *next = node->next;
+        size_t n = node->count - offset < count ? node->count - offset : count;
+        if (n == node->count) {
+            list_unlink(list, node);
+            node_free(node);
+        } else {
+            if (node_decompress(node) != 0) break;
+            node_delete(node, offset, n);
+            if (nedited < 2) edited[nedited++] = node;
+        }
+        list->length -= n;
+        count -= n;
+        offset = 0;
+        node = next;
+    }
+
+    list_compress_ends(list);
+    for (int i = 0; i < nedited; i++) list_settle(list, edited[i]);
+}
+
+/**
+ * Turn a possibly negative index into a position.
+ * @return 1 if it lies within the list
+ */
+static int list_normalize_index(const List *list, long index, size_t *position) {
+    if (index < 0) index += (long)list->length;
+    if (index < 0 || (size_t)index >= list->length) return 0;
+    *position = (size_t)index;
+    return 1;
+}
+
+/* ==================== List Operations ==================== */
+
 List *list_create(void) {
-    List *list = malloc(sizeof(List));
+    List *list = slab_alloc(sizeof(List));
     if (!list) return NULL;
     
     list->head = NULL;
     list->tail = NULL;
     list->length = 0;
+    list->nodes = 0;
     
     return list;
 }
 
-size_t list_rpush(List *list, const char *value) {
+size_t list_push(List *list, int where, const char *value, size_t len) {
     if (!list || !value) return 0;
-    
-    ListNode *node = malloc(sizeof(ListNode));
-    if (!node) return list->length;
-    
-    node->value = strdup(value);
-    if (!node->value) {
-        free(node);
-        return list->length;
+
+    size_t esize = entry_size(len);
+    ListNode *node = where == LIST_HEAD ? list->head : list->tail;
+    if (node && node->bytes + esize > list_node_bytes) node = NULL;
+    if (node && node_decompress(node) != 0) return 0;
+
+    int created = !node;
+    if (created) {
+        node = node_create(esize, where);
+        if (!node) return 0;
+        list_link(list, node, where);
     }
-    
-    node->next = NULL;
-    
-    if (list->tail) {
-        list->tail->next = node;
-        list->tail = node;
-    } else {
-        //-- Empty list --//
-        list->head = list->tail = node;
+
+    if (node_push(node, where, value, len) != 0) {
+        if (created) {
+            list_unlink(list, node);
+            node_free(node);
+        }
+        return 0;
     }
-    
-    return ++list->length;
+
+    list->length++;
+    if (created) list_compress_ends(list);
+    return list->length;
+}
+
+size_t list_rpush(List *list, const char *value) {
+    return value ? list_push(list, LIST_TAIL, value, strlen(value)) : list_length(list);
 }
 
 size_t list_lpush(List *list, const char *value) {
-    if (!list || !value) return 0;
-    
-    ListNode *node = malloc(sizeof(ListNode));
-    if (!node) return list->length;
-    
-    node->value = strdup(value);
-    if (!node->value) {
-        free(node);
-        return list->length;
-    }
-    
-    node->next = NULL;
-    
-    if (list->head) {
-        node->next = list->head;
-        list->head = node;
-    } else {
-        //-- Empty list --//
-        list->head = list->tail = node;
-    }
-    
-    return ++list->length;
+    return value ? list_push(list, LIST_HEAD, value, strlen(value)) : list_length(list);
 }
 
 size_t list_length(const List *list) {
@@ -102,85 +735,357 @@ char **list_range(List *list, int start, int end, int *length) {
         return NULL;
     }
 
-    *length = end - start + 1;
-    char **result = malloc(sizeof(char*) * (*length));
+    int wanted = end - start + 1;
+    char **result = malloc(sizeof(char*) * wanted);
     if (!result) {
-        *length = 0;
         return NULL;
     }
 
-    ListNode *current = list->head;
-    for (int i = 0; i < start; i++) {
-        current = current->next;
-    }
+    size_t offset;
+    ListNode *node = list_seek(list, (size_t)start, &offset);
+    int filled = 0, failed = 0;
+    while (filled < wanted && !failed) {
+        unsigned char *scratch;
+        const unsigned char *p = node_entries(node, &scratch);
+        if (!p) break;
 
-    for (int i = 0; i < *length; i++) {
-        result[i] = strdup(current->value);
-        if (!result[i]) {
-            for (int j = 0; j < i; j++) {
-                free(result[j]);
+        const char *value;
+        size_t value_len;
+        for (size_t i = 0; i < offset; i++) {
+            p = entry_read(p, &value, &value_len);
+        }
+        for (size_t i = offset; i < node->count && filled < wanted; i++) {
+            p = entry_read(p, &value, &value_len);
+            if (!(result[filled] = value_copy(value, value_len))) {
+                failed = 1;
+                break;
             }
-            free(result);
-            *length = 0;
-            return NULL;
+            filled++;
         }
-        current = current->next;
+        free(scratch);
+
+        offset = 0;
+        node = node->next;
     }
 
+    if (filled < wanted) {
+        for (int i = 0; i < filled; i++) {
+            free(result[i]);
+        }
+        free(result);
+        return NULL;
+    }
+
+    *length = wanted;
     return result;
 }
 
-
-char* lpop_element(List *list) {
+char *list_pop(List *list, int where, size_t *len) {
     if (!list || !list->head) {
         return NULL;
     }
 
-    ListNode *node = list->head;
-    char *value = strdup(node->value);
-    
-    list->head = node->next;
+    ListNode *node = where == LIST_HEAD ? list->head : list->tail;
+    if (node_decompress(node) != 0) return NULL;
+
+    size_t value_len;
+    char *value = node_pop(node, where, &value_len);
+    if (!value) return NULL;
+    if (len) *len = value_len;
     list->length--;
-    
-    if (list->length == 0) {
-        list->tail = NULL;
+
+    if (node->count == 0) {
+        list_unlink(list, node);
+        node_free(node);
+        list_compress_ends(list);
     }
-    
-    free(node);
     return value;
 }
 
-char **lpop_multiple(List *list, int length, int *actual_length) {
+char **list_pop_multiple(List *list, int where, int length, int *actual_length) {
     if (!list || length <= 0 || list->length == 0) {
         *actual_length = 0;
         return NULL;
     }
 
-    int num = (length > list->length) ? list->length : length;
+    int num = ((size_t)length > list->length) ? (int)list->length : length;
     char **results = malloc(sizeof(char*) * num);
     if (!results) {
         *actual_length = 0;
         return NULL;
     }
 
-    for (int i = 0; i < num; i++) {
-        results[i] = lpop_element(list);  
+    int popped = 0;
+    while (popped < num && (results[popped] = list_pop(list, where, NULL))) {
+        popped++;
     }
 
-    *actual_length = num;
+    *actual_length = popped;
     return results;
 }
 
+size_t list_range_into(const List *list, long start, long end, const ListSink *sink) {
+    long len = list ? (long)list->length : 0;
+    if (start < 0) start += len;
+    if (end < 0) end += len;
+    if (start < 0) start = 0;
+    if (end >= len) end = len - 1;
+    if (start > end || start >= len) {
+        sink->begin(sink->ctx, 0);
+        return 0;
+    }
+
+    size_t wanted = (size_t)(end - start + 1), sent = 0, offset;
+    sink->begin(sink->ctx, wanted);
+
+    ListNode *node = list_seek(list, (size_t)start, &offset);
+    for (; node && sent < wanted; node = node->next, offset = 0) {
+        unsigned char *scratch;
+        const unsigned char *p = node_entries(node, &scratch);
+        if (!p) break;
+
+        const char *value;
+        size_t value_len;
+        for (size_t i = 0; i < offset; i++) {
+            p = entry_read(p, &value, &value_len);
+        }
+        for (size_t i = offset; i < node->count && sent < wanted; i++, sent++) {
+            p = entry_read(p, &value, &value_len);
+            sink->element(sink->ctx, value, value_len);
+        }
+        free(scratch);
+    }
+
+    //-- The count is already announced: elements we could not expand go out as nulls --//
+    for (; sent < wanted; sent++) {
+        sink->element(sink->ctx, NULL, 0);
+    }
+    return wanted;
+}
+
+size_t list_pop_into(List *list, int where, size_t count, const ListSink *sink) {
+    size_t wanted = list && count < list->length ? count : (list ? list->length : 0);
+    sink->begin(sink->ctx, wanted);
+
+    size_t popped = 0;
+    for (; popped < wanted; popped++) {
+        ListNode *node = where == LIST_HEAD ? list->head : list->tail;
+        if (node_decompress(node) != 0) break;
+
+        const char *value;
+        size_t len;
+        size_t esize = node_end_entry(node, where, &value, &len);
+        sink->element(sink->ctx, value, len);
+        node_drop(node, where, esize);
+        list->length--;
+
+        if (node->count == 0) {
+            list_unlink(list, node);
+            node_free(node);
+            list_compress_ends(list);
+        }
+    }
+
+    //-- The count is already announced: elements we could not pop go out as nulls --//
+    for (; popped < wanted; popped++) {
+        sink->element(sink->ctx, NULL, 0);
+    }
+    return wanted;
+}
+
+char *list_index(const List *list, long index) {
+    size_t position, offset;
+    if (!list || !list_normalize_index(list, index, &position)) return NULL;
+
+    ListNode *node = list_seek(list, position, &offset);
+    unsigned char *scratch;
+    const unsigned char *p = node_entries(node, &scratch);
+    if (!p) return NULL;
+
+    const char *value;
+    size_t len;
+    for (size_t i = 0; i <= offset; i++) {
+        p = entry_read(p, &value, &len);
+    }
+    char *copy = value_copy(value, len);
+    free(scratch);
+    return copy;
+}
+
+int list_set(List *list, long index, const char *value, size_t len) {
+    size_t position, offset;
+    if (!list || !list_normalize_index(list, index, &position)) return 0;
+
+    ListNode *node = list_seek(list, position, &offset);
+    int was_compressed = node->compressed != 0;
+    if (node_decompress(node) != 0) return -1;
+
+    int result = node_replace(node, offset, value, len) == 0 ? 1 : -1;
+    if (was_compressed) node_compress(node);
+    return result;
+}
+
+int list_insert(List *list, const char *pivot, size_t pivot_len, int after, const char *value, size_t len) {
+    if (!list) return 0;
+
+    for (ListNode *node = list->head; node; node = node->next) {
+        unsigned char *scratch;
+        const unsigned char *p = node_entries(node, &scratch);
+        if (!p) return -1;
+
+        size_t found = node->count;
+        const char *entry;
+        size_t entry_len;
+        for (size_t i = 0; i < node->count; i++) {
+            p = entry_read(p, &entry, &entry_len);
+            if (entry_len == pivot_len && memcmp(entry, pivot, pivot_len) == 0) {
+                found = i;
+                break;
+            }
+        }
+        free(scratch);
+
+        if (found < node->count) {
+            return list_insert_at(list, node, after ? found + 1 : found, value, len) == 0 ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+void list_trim(List *list, long start, long end) {
+    if (!list) return;
+
+    long len = (long)list->length;
+    if (start < 0) start += len;
+    if (end < 0) end += len;
+    if (start < 0) start = 0;
+    if (start > end || start >= len) {
+        list_delete_range(list, 0, (size_t)len);
+        return;
+    }
+    if (end >= len) end = len - 1;
+
+    //-- Tail first, so the head cut still finds its index --//
+    list_delete_range(list, (size_t)end + 1, (size_t)(len - 1 - end));
+    list_delete_range(list, 0, (size_t)start);
+}
+
+size_t list_remove(List *list, const char *value, size_t len, long count) {
+    if (!list) return 0;
+
+    int where = count < 0 ? LIST_TAIL : LIST_HEAD;
+    size_t max = count < 0 ? (size_t)0 - (size_t)count : (size_t)count;
+    size_t removed = 0;
+
+    ListNode *node = where == LIST_HEAD ? list->head : list->tail;
+    while (node && (!max || removed < max)) {
+        ListNode *next = where == LIST_HEAD ? node->next : node->prev;
+        int was_compressed = node->compressed != 0;
+
+        if ((!was_compressed || node_contains(node, value, len)) && node_decompress(node) == 0) {
+            size_t n = node_remove_matches(node, where, value, len, max ? max - removed : 0);
+            removed += n;
+            list->length -= n;
+            if (node->count == 0) {
+                list_unlink(list, node);
+                node_free(node);
+            } else if (was_compressed) {
+                node_compress(node);
+            }
+        }
+        node = next;
+    }
+
+    if (removed) list_compress_ends(list);
+    return removed;
+}
+
+long *list_positions(const List *list, const char *value, size_t len, long rank, long count,
+                     long maxlen, long *found) {
+    *found = 0;
+    if (!list || rank == 0 || list->length == 0) return NULL;
+
+    int backward = rank < 0;
+    size_t skip = (backward ? (size_t)0 - (size_t)rank : (size_t)rank) - 1;
+    size_t capacity = count > 0 && count < 16 ? (size_t)count : 16;
+    long *positions = malloc(capacity * sizeof(long));
+    if (!positions) return NULL;
+
+    size_t scanned = 0;
+    int done = 0;
+    for (ListNode *node = backward ? list->tail : list->head; node && !done;
+         node = backward ? node->prev : node->next) {
+        unsigned char *scratch;
+        const unsigned char *p = node_entries(node, &scratch);
+        if (!p) break;
+        if (backward) p += node->bytes;
+
+        const char *entry;
+        size_t entry_len;
+        for (size_t i = 0; i < node->count; i++, scanned++) {
+            if (maxlen > 0 && scanned == (size_t)maxlen) {
+                done = 1;
+                break;
+            }
+            p = backward ? entry_read_back(p, &entry, &entry_len) : entry_read(p, &entry, &entry_len);
+            if (entry_len != len || memcmp(entry, value, len) != 0) continue;
+            if (skip > 0) {
+                skip--;
+                continue;
+            }
+
+            if ((size_t)*found == capacity) {
+                long *grown = realloc(positions, capacity * 2 * sizeof(long));
+                if (!grown) {
+                    done = 1;
+                    break;
+                }
+                positions = grown;
+                capacity *= 2;
+            }
+            positions[(*found)++] = backward ? (long)(list->length - 1 - scanned) : (long)scanned;
+            if (count > 0 && *found == count) {
+                done = 1;
+                break;
+            }
+        }
+        free(scratch);
+    }
+
+    if (*found == 0) {
+        free(positions);
+        return NULL;
+    }
+    return positions;
+}
+
+char* lpop_element(List *list) {
+    return list_pop(list, LIST_HEAD, NULL);
+}
+
+char **lpop_multiple(List *list, int length, int *actual_length) {
+    return list_pop_multiple(list, LIST_HEAD, length, actual_length);
+}
+
+size_t list_memory(const List *list) {
+    if (!list) return 0;
+
+    size_t bytes = sizeof(List);
+    for (const ListNode *node = list->head; node; node = node->next) {
+        bytes += sizeof(ListNode) + node->capacity;
+    }
+    return bytes;
+}
+
 void list_free(List *list) {
     if (!list) return;
     
     ListNode *current = list->head;
     while (current) {
         ListNode *next = current->next;
-        free(current->value);
-        free(current);
+        node_free(current);
         current = next;
     }
     
-    free(list);
+    slab_free(list, sizeof(List));
 }
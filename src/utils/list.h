@@ -4,13 +4,17 @@
  * =====================================================
  * 
  * File                      : src/utils/list.h
- * Module                    : Linked List
- * Last Updating Author      : kei077
- * Last Update               : 08/06/2025
+ * Module                    : Packed List
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
  * Version                   : 1.0.0
  * 
  * Description:
- *  Header for linked list implementation for MemoraDB list operations.
+ *  Header for the list type behind MemoraDB list operations: a doubly
+ *  linked list of packed nodes (quicklist). Each node stores a run of
+ *  elements back to back, so an element costs its bytes plus two short
+ *  length prefixes instead of a node and a string allocation. Interior
+ *  nodes can be kept LZF-compressed.
  * 
  * Copyright (c) 2025 MemoraDB Project
  * =====================================================
@@ -21,19 +25,63 @@
 
 #include <stdlib.h>
 
+/* ==================== List Ends ==================== */
+#define LIST_TAIL 0   //- Right end (RPUSH, RPOP) -//
+#define LIST_HEAD 1   //- Left end (LPUSH, LPOP) -//
+
+/* ==================== Encoding Defaults ==================== */
+#define LIST_NODE_BYTES_DEFAULT     8192   //- Packed bytes per node before another is started -//
+#define LIST_COMPRESS_DEPTH_DEFAULT 0      //- Raw nodes kept at each end; 0 never compresses -//
+#define LIST_COMPRESS_MIN_BYTES     48     //- Smaller nodes are not worth compressing -//
+
 /* ==================== List Node Structure ==================== */
+/*
+ * Entries are packed in data[start, start + bytes), each as
+ *   varint(len) | len bytes | varint(len) stored backwards
+ * so a node can be walked from either end. Free room on both sides of the
+ * entries makes pushes and pops at either end O(1) amortised. While
+ * compressed, data holds the LZF image of the entries only.
+ */
 typedef struct ListNode {
-    char *value;
+    struct ListNode *prev;
     struct ListNode *next;
+    unsigned char *data;
+    unsigned int start;       //- Offset of the first entry in data -//
+    unsigned int bytes;       //- Packed size of the entries -//
+    unsigned int capacity;    //- Allocated size of data -//
+    unsigned int count;       //- Entries in the node -//
+    unsigned int compressed;  //- Size of the LZF image in data, 0 while raw -//
 } ListNode;
 
+/* ==================== List Sink ==================== */
+/*
+ * Receives elements straight from node storage, so readers can serialise
+ * them without copying each one to the heap first. begin() is called once
+ * with the number of elements that follow.
+ */
+typedef struct {
+    void (*begin)(void *ctx, size_t count);
+    void (*element)(void *ctx, const char *value, size_t len);   //- value NULL if it could not be read -//
+    void *ctx;
+} ListSink;
+
 /* ==================== List Structure ==================== */
 typedef struct List {
     ListNode *head;
     ListNode *tail;
-    size_t length;
+    size_t length;            //- Elements -//
+    size_t nodes;
 } List;
 
+/**
+ * @brief Set the encoding of lists created from now on. Call once at
+ * startup, before any thread uses lists.
+ *
+ * @param node_bytes Packed bytes per node (LIST_NODE_BYTES_DEFAULT).
+ * @param compress_depth Nodes left uncompressed at each end, 0 to disable.
+ */
+void list_configure(size_t node_bytes, int compress_depth);
+
 /**
  * @brief Create a new empty list.
  * 
@@ -59,6 +107,17 @@ size_t list_rpush(List *list, const char *value);
  */
 size_t list_lpush(List *list, const char *value);
 
+/**
+ * @brief Push a value of known length onto one end of the list.
+ *
+ * @param list The list to push to.
+ * @param where LIST_HEAD or LIST_TAIL.
+ * @param value The bytes to push.
+ * @param len Their length.
+ * @return The new length of the list, or 0 if it could not be added.
+ */
+size_t list_push(List *list, int where, const char *value, size_t len);
+
 /**
  * @brief Get the length of the list.
  * 
@@ -67,6 +126,14 @@ size_t list_lpush(List *list, const char *value);
  */
 size_t list_length(const List *list);
 
+/**
+ * @brief Heap bytes held by the list: nodes, their buffers and the header.
+ *
+ * @param list The list to measure.
+ * @return Footprint in bytes.
+ */
+size_t list_memory(const List *list);
+
 /**
  * @brief Free all memory associated with the list.
  * 
@@ -84,6 +151,97 @@ void list_free(List *list);
  */
 char **list_range(List *list, int start, int end, int *count);
 
+/**
+ * Hand the elements from start to end (LRANGE semantics) to sink, in order.
+ * The values point into the list and are only valid during the call.
+ *
+ * @return Number of elements passed to sink.
+ */
+size_t list_range_into(const List *list, long start, long end, const ListSink *sink);
+
+/**
+ * Pop up to count elements from one end, nearest first, handing each to
+ * sink before its bytes are released.
+ *
+ * @return Number of elements passed to sink.
+ */
+size_t list_pop_into(List *list, int where, size_t count, const ListSink *sink);
+
+/**
+ * Remove and return the element at one end of the list.
+ *
+ * @param list The list to remove the element from.
+ * @param where LIST_HEAD or LIST_TAIL.
+ * @param len If not NULL, set to the element's length; the copy is also
+ *            NUL-terminated.
+ * @return The element's value, or NULL if the list is empty.
+ *         Ownership passes to the caller, who frees it.
+ */
+char *list_pop(List *list, int where, size_t *len);
+
+/**
+ * Pop up to `length` elements from one end of the list, nearest first.
+ *
+ * @param list The list to pop from.
+ * @param where LIST_HEAD or LIST_TAIL.
+ * @param length The number of elements to attempt to pop.
+ * @param actual_length Set to the number of elements popped.
+ * @return Array of popped strings, or NULL if none. Caller frees each
+ *         string and the array itself.
+ */
+char **list_pop_multiple(List *list, int where, int length, int *actual_length);
+
+/**
+ * Copy the element at index (negative indexes count from the tail).
+ * Whole nodes are skipped from the nearer end.
+ *
+ * @return A heap copy the caller frees, NULL if out of range.
+ */
+char *list_index(const List *list, long index);
+
+/**
+ * Overwrite the element at index (negative indexes count from the tail).
+ *
+ * @return 1 if set, 0 if out of range, -1 if out of memory.
+ */
+int list_set(List *list, long index, const char *value, size_t len);
+
+/**
+ * Insert value before or after the first element equal to pivot.
+ * A full node is split at the insertion point.
+ *
+ * @param after Nonzero to insert after the pivot.
+ * @return 1 if inserted, 0 if the pivot was not found, -1 if out of memory.
+ */
+int list_insert(List *list, const char *pivot, size_t pivot_len, int after, const char *value, size_t len);
+
+/**
+ * Keep only the elements from start to end inclusive (LTRIM semantics).
+ * Nodes falling entirely outside are freed without being expanded.
+ */
+void list_trim(List *list, long start, long end);
+
+/**
+ * Remove elements equal to value (LREM semantics).
+ *
+ * @param count Remove the first count matches from the head if positive,
+ *              from the tail if negative, all of them if 0.
+ * @return Number of elements removed.
+ */
+size_t list_remove(List *list, const char *value, size_t len, long count);
+
+/**
+ * Indexes of the elements equal to value (LPOS semantics).
+ *
+ * @param rank Match to start from, 1 for the first; negative scans from the tail.
+ * @param count Matches to return at most, 0 for all.
+ * @param maxlen Elements to compare at most, 0 for all.
+ * @param found Set to the number of indexes returned.
+ * @return Array of indexes the caller frees, NULL if none.
+ */
+long *list_positions(const List *list, const char *value, size_t len, long rank, long count,
+                     long maxlen, long *found);
+
 /**
  * Remove and return the first element (head) of the list.
  * 
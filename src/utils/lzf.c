@@ -0,0 +1,136 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/utils/lzf.c
+ * Module                    : LZF Compression
+ * Last Updating Author      : agent
+ * Last Update               : 10/17/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Small, fast LZ77 codec in the LZF format: literal runs of up to 32
+ *  bytes and back references of 3 to 264 bytes within an 8 KB window.
+ *  Used to shrink the interior nodes of long lists.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include "lzf.h"
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Format, one control byte per item:
+ *   000LLLLL                  L + 1 literal bytes follow
+ *   LLLOOOOO [LLLLLLLL] OOOOOOOO
+ *                             back reference of L + 2 bytes (an extra
+ *                             length byte when LLL is 7), starting
+ *                             O + 1 bytes before the output position
+ */
+
+/* ==================== Codec Limits ==================== */
+#define LZF_HASH_BITS   13
+#define LZF_MAX_LITERAL 32
+#define LZF_MAX_OFFSET  (1 << 13)
+#define LZF_MAX_MATCH   (2 + 7 + 255)
+
+//-- Last position of each 3-byte prefix; stale entries are verified, so it is never cleared --//
+static __thread uint32_t lzf_table[1 << LZF_HASH_BITS];
+
+static inline unsigned lzf_hash(const unsigned char *p) {
+    uint32_t v = (uint32_t)p[0] << 16 | (uint32_t)p[1] << 8 | p[2];
+    return (v * 2654435761u) >> (32 - LZF_HASH_BITS);
+}
+
+size_t lzf_compress(const void *in, size_t in_len, void *out, size_t out_len) {
+    const unsigned char *src = in;
+    unsigned char *dst = out;
+    size_t ip = 0, op = 0;
+    if (in_len == 0 || out_len == 0 || in_len > UINT32_MAX) return 0;
+
+    size_t ctrl = op++;   //- Control byte of the literal run being built -//
+    unsigned lit = 0;
+
+    while (ip < in_len) {
+        if (ip + 2 < in_len) {
+            unsigned h = lzf_hash(src + ip);
+            size_t ref = lzf_table[h];
+            lzf_table[h] = (uint32_t)ip;
+
+            size_t off = ip - ref - 1;
+            if (ref < ip && off < LZF_MAX_OFFSET && memcmp(src + ref, src + ip, 3) == 0) {
+                size_t max = in_len - ip < LZF_MAX_MATCH ? in_len - ip : LZF_MAX_MATCH;
+                size_t len = 3;
+                while (len < max && src[ref + len] == src[ip + len]) len++;
+
+                //-- Close the literal run, or take back its unused control byte --//
+                if (lit) dst[ctrl] = (unsigned char)(lit - 1); else op--;
+                if (op + 4 > out_len) return 0;
+
+                size_t code = len - 2;
+                if (code < 7) {
+                    dst[op++] = (unsigned char)(code << 5 | off >> 8);
+                } else {
+                    dst[op++] = (unsigned char)(7 << 5 | off >> 8);
+                    dst[op++] = (unsigned char)(code - 7);
+                }
+                dst[op++] = (unsigned char)off;
+
+                ip += len;
+                ctrl = op++;
+                lit = 0;
+                continue;
+            }
+        }
+
+        if (op >= out_len) return 0;
+        dst[op++] = src[ip++];
+        if (++lit == LZF_MAX_LITERAL) {
+            dst[ctrl] = LZF_MAX_LITERAL - 1;
+            if (op >= out_len) return 0;
+            ctrl = op++;
+            lit = 0;
+        }
+    }
+
+    if (lit) dst[ctrl] = (unsigned char)(lit - 1); else op--;
+    return op;
+}
+
+size_t lzf_decompress(const void *in, size_t in_len, void *out, size_t out_len) {
+    const unsigned char *src = in;
+    unsigned char *dst = out;
+    size_t ip = 0, op = 0;
+
+    while (ip < in_len) {
+        unsigned ctrl = src[ip++];
+
+        if (ctrl < 32) {
+            size_t len = ctrl + 1;
+            if (ip + len > in_len || op + len > out_len) return 0;
+            memcpy(dst + op, src + ip, len);
+            ip += len;
+            op += len;
+            continue;
+        }
+
+        size_t len = ctrl >> 5;
+        if (len == 7) {
+            if (ip >= in_len) return 0;
+            len += src[ip++];
+        }
+        len += 2;
+        if (ip >= in_len) return 0;
+        size_t off = ((size_t)(ctrl & 0x1f) << 8 | src[ip++]) + 1;
+        if (off > op || op + len > out_len) return 0;
+
+        //-- Byte by byte: the reference may overlap what it produces --//
+        const unsigned char *ref = dst + op - off;
+        for (size_t i = 0; i < len; i++) dst[op + i] = ref[i];
+        op += len;
+    }
+    return op;
+}
@@ -0,0 +1,41 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/utils/lzf.h
+ * Module                    : LZF Compression
+ * Last Updating Author      : agent
+ * Last Update               : 10/17/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Small, fast LZ77 codec in the LZF format: literal runs of up to 32
+ *  bytes and back references of 3 to 264 bytes within an 8 KB window.
+ *  Used to shrink the interior nodes of long lists.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#ifndef MEMORADB_LZF_H
+#define MEMORADB_LZF_H
+
+#include <stddef.h>
+
+/**
+ * Compress in_len bytes of in into out.
+ * @param out_len Room in out; compression fails rather than overflow it
+ * @return Size of the compressed image, 0 if it does not fit in out_len
+ */
+size_t lzf_compress(const void *in, size_t in_len, void *out, size_t out_len);
+
+/**
+ * Expand an image made by lzf_compress().
+ * @param out_len Room in out
+ * @return Size of the expanded data, 0 if the image is corrupt or does not
+ *         fit in out_len
+ */
+size_t lzf_decompress(const void *in, size_t in_len, void *out, size_t out_len);
+
+#endif // MEMORADB_LZF_H
@@ -0,0 +1,120 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/utils/minheap.c
+ * Module                    : Min-Heap
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Array-backed binary min-heap of HeapNode pointers. Every move writes
+ *  the node's new position back into it.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include "minheap.h"
+#include <stdlib.h>
+
+#define MINHEAP_INITIAL_CAP 64
+
+void minheap_init(MinHeap *heap) {
+    heap->nodes = NULL;
+    heap->len = 0;
+    heap->cap = 0;
+}
+
+void minheap_free(MinHeap *heap) {
+    free(heap->nodes);
+    minheap_init(heap);
+}
+
+static inline void heap_place(MinHeap *heap, size_t index, HeapNode *node) {
+    heap->nodes[index] = node;
+    node->index = index;
+}
+
+static void sift_up(MinHeap *heap, size_t index) {
+    HeapNode *node = heap->nodes[index];
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (heap->nodes[parent]->key <= node->key) break;
+        heap_place(heap, index, heap->nodes[parent]);
+        index = parent;
+    }
+    heap_place(heap, index, node);
+}
+
+static void sift_down(MinHeap *heap, size_t index) {
+    HeapNode *node = heap->nodes[index];
+    for (;;) {
+        size_t child = 2 * index + 1;
+        if (child >= heap->len) break;
+        if (child + 1 < heap->len && heap->nodes[child + 1]->key < heap->nodes[child]->key) child++;
+        if (node->key <= heap->nodes[child]->key) break;
+        heap_place(heap, index, heap->nodes[child]);
+        index = child;
+    }
+    heap_place(heap, index, node);
+}
+
+int minheap_schedule(MinHeap *heap, HeapNode *node, long long key) {
+    if (heap_node_queued(node)) {
+        long long old = node->key;
+        node->key = key;
+        if (key < old) {
+            sift_up(heap, node->index);
+        } else {
+            sift_down(heap, node->index);
+        }
+        return 0;
+    }
+
+    if (heap->len == heap->cap) {
+        size_t cap = heap->cap ? heap->cap * 2 : MINHEAP_INITIAL_CAP;
+        HeapNode **nodes = realloc(heap->nodes, cap * sizeof(HeapNode *));
+        if (!nodes) return -1;
+        heap->nodes = nodes;
+        heap->cap = cap;
+    }
+
+    node->key = key;
+    heap_place(heap, heap->len++, node);
+    sift_up(heap, node->index);
+    return 0;
+}
+
+void minheap_remove(MinHeap *heap, HeapNode *node) {
+    if (!heap_node_queued(node)) return;
+
+    size_t index = node->index;
+    HeapNode *last = heap->nodes[--heap->len];
+    node->index = HEAP_NOT_QUEUED;
+    if (last == node) return;
+
+    //-- The last node fills the hole and moves whichever way restores order --//
+    heap_place(heap, index, last);
+    if (index > 0 && heap->nodes[(index - 1) / 2]->key > last->key) {
+        sift_up(heap, index);
+    } else {
+        sift_down(heap, index);
+    }
+}
+
+void minheap_replace(MinHeap *heap, HeapNode *old, HeapNode *node) {
+    if (!heap_node_queued(old)) return;
+
+    node->key = old->key;
+    heap_place(heap, old->index, node);
+    old->index = HEAP_NOT_QUEUED;
+}
+
+HeapNode *minheap_pop(MinHeap *heap) {
+    HeapNode *top = minheap_peek(heap);
+    if (top) minheap_remove(heap, top);
+    return top;
+}
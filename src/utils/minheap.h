@@ -0,0 +1,89 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/utils/minheap.h
+ * Module                    : Min-Heap
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Intrusive binary min-heap ordered by a 64-bit deadline. Each queued
+ *  object embeds a HeapNode that remembers its position, so removing or
+ *  rescheduling an arbitrary node is O(log n) without a search.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#ifndef MEMORADB_MINHEAP_H
+#define MEMORADB_MINHEAP_H
+
+#include <stddef.h>
+
+#define HEAP_NOT_QUEUED ((size_t)-1)
+
+/* ==================== Heap Types ==================== */
+typedef struct {
+    long long key;            //- Ordering key, usually a deadline in ms -//
+    size_t index;             //- Position in the heap, HEAP_NOT_QUEUED when absent -//
+} HeapNode;
+
+typedef struct {
+    HeapNode **nodes;
+    size_t len;
+    size_t cap;
+} MinHeap;
+
+static inline void heap_node_init(HeapNode *node) {
+    node->key = 0;
+    node->index = HEAP_NOT_QUEUED;
+}
+
+static inline int heap_node_queued(const HeapNode *node) {
+    return node->index != HEAP_NOT_QUEUED;
+}
+
+void minheap_init(MinHeap *heap);
+
+/**
+ * Release the heap's array; queued nodes are left untouched.
+ */
+void minheap_free(MinHeap *heap);
+
+/**
+ * Queue `node` under `key`, or move it there if it is already queued.
+ * @return 0 on success, -1 if the heap could not grow
+ */
+int minheap_schedule(MinHeap *heap, HeapNode *node, long long key);
+
+/**
+ * Remove `node` if it is queued.
+ */
+void minheap_remove(MinHeap *heap, HeapNode *node);
+
+/**
+ * Put `node` in the place of the queued `old`, under the same key, without
+ * reordering anything. Does nothing if `old` is not queued.
+ */
+void minheap_replace(MinHeap *heap, HeapNode *old, HeapNode *node);
+
+/**
+ * @return The node with the smallest key, or NULL when empty
+ */
+static inline HeapNode *minheap_peek(const MinHeap *heap) {
+    return heap->len ? heap->nodes[0] : NULL;
+}
+
+/**
+ * Remove and return the node with the smallest key, or NULL when empty.
+ */
+HeapNode *minheap_pop(MinHeap *heap);
+
+static inline size_t minheap_size(const MinHeap *heap) {
+    return heap->len;
+}
+
+#endif // MEMORADB_MINHEAP_H
@@ -0,0 +1,69 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/utils/mpsc.h
+ * Module                    : Lock-free Queue
+ * Last Updating Author      : agent
+ * Last Update               : 10/17/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Intrusive multi-producer / single-consumer queue. Producers push with
+ *  a CAS on the head; the consumer detaches the whole batch with one
+ *  exchange and reverses it, so there is no ABA problem and no lock.
+ *  Order is FIFO per producer.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#ifndef MEMORADB_MPSC_H
+#define MEMORADB_MPSC_H
+
+#include <stddef.h>
+
+/* ==================== Queue Types ==================== */
+typedef struct MpscNode {
+    struct MpscNode *next;
+} MpscNode;
+
+typedef struct {
+    MpscNode *head;   //- Most recently pushed node, accessed atomically -//
+} MpscQueue;
+
+static inline void mpsc_init(MpscQueue *queue) {
+    __atomic_store_n(&queue->head, NULL, __ATOMIC_RELAXED);
+}
+
+/**
+ * Push a node; safe from any thread.
+ * @return 1 if the queue was empty, i.e. the consumer may need a wake-up
+ */
+static inline int mpsc_push(MpscQueue *queue, MpscNode *node) {
+    MpscNode *head = __atomic_load_n(&queue->head, __ATOMIC_RELAXED);
+    do {
+        node->next = head;
+    } while (!__atomic_compare_exchange_n(&queue->head, &head, node, 1,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    return head == NULL;
+}
+
+/**
+ * Detach every queued node; consumer thread only.
+ * @return The nodes in push order, linked through next, or NULL
+ */
+static inline MpscNode *mpsc_take_all(MpscQueue *queue) {
+    MpscNode *node = __atomic_exchange_n(&queue->head, NULL, __ATOMIC_ACQUIRE);
+    MpscNode *ordered = NULL;
+    while (node) {
+        MpscNode *next = node->next;
+        node->next = ordered;
+        ordered = node;
+        node = next;
+    }
+    return ordered;
+}
+
+#endif // MEMORADB_MPSC_H
@@ -0,0 +1,66 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/utils/siphash.h
+ * Module                    : Keyed Hashing
+ * Last Updating Author      : agent
+ * Last Update               : 10/17/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  SipHash-1-3 keyed 64-bit hash and the process-wide random seed used
+ *  to hash keys. A secret seed keeps clients from crafting keys that all
+ *  land in the same bucket.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#ifndef SIPHASH_H
+#define SIPHASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SIPHASH_KEY_BYTES 16
+
+/**
+ * @brief SipHash-1-3 of a byte string.
+ *
+ * @param data Bytes to hash.
+ * @param len Number of bytes.
+ * @param key 16-byte secret key.
+ * @return The 64-bit hash.
+ */
+uint64_t siphash(const void *data, size_t len, const uint8_t key[SIPHASH_KEY_BYTES]);
+
+/**
+ * @brief Replace the process-wide hash seed.
+ *
+ * Must happen before anything is hashed with hash_bytes(): values hashed
+ * under another seed can no longer be found.
+ *
+ * @param seed 16 bytes of seed material.
+ */
+void hash_set_seed(const uint8_t seed[SIPHASH_KEY_BYTES]);
+
+/**
+ * @brief Seed hash_bytes() from the kernel's random source.
+ *
+ * @return 0 on success, -1 if no randomness was available (the seed is
+ *         then derived from the time and pid).
+ */
+int hash_seed_random(void);
+
+/**
+ * @brief SipHash-1-3 of a byte string under the process-wide seed.
+ *
+ * @param data Bytes to hash.
+ * @param len Number of bytes.
+ * @return The 64-bit hash.
+ */
+uint64_t hash_bytes(const void *data, size_t len);
+
+#endif // SIPHASH_H
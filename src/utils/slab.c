@@ -0,0 +1,369 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/utils/slab.c
+ * Module                    : Slab Allocator
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Every thread that allocates owns a SlabCache: one free list per size
+ *  class, which it pops and pushes without any lock. An empty list is
+ *  refilled with SLAB_BATCH objects from the class's central list, and a
+ *  list grown past two batches spills one back, so memory freed by one
+ *  thread is reused by others. The central list hands out recycled
+ *  objects first and carves fresh ones from its newest page otherwise;
+ *  pages are never returned to the system.
+ *
+ *  Caches are published once on a global lock-free list, like epoch
+ *  records, and reused after their thread exits. Each keeps its own
+ *  counters, so statistics cost no shared writes; slab_stats() sums them.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include "slab.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+//-- Owner-only counters that other threads read: no atomic RMW needed --//
+#define COUNTER_ADD(field, n) \
+    __atomic_store_n(&(field), __atomic_load_n(&(field), __ATOMIC_RELAXED) + (n), __ATOMIC_RELAXED)
+
+/* ==================== Central Lists ==================== */
+
+typedef struct FreeObject {
+    struct FreeObject *next;
+} FreeObject;
+
+typedef struct {
+    pthread_mutex_t lock;
+    FreeObject *free;         //- Objects spilled by thread caches -//
+    char *bump;               //- Uncarved rest of the newest page -//
+    size_t bump_left;         //- Bytes left at bump -//
+    size_t pages;             //- Pages carved for the class, read atomically -//
+} __attribute__((aligned(64))) SlabCentral;
+
+static SlabCentral central[SLAB_CLASSES] = {
+    [0 ... SLAB_CLASSES - 1] = { .lock = PTHREAD_MUTEX_INITIALIZER }
+};
+
+static inline int size_class(size_t size) {
+    return size ? (int)((size - 1) / SLAB_CLASS_STEP) : 0;
+}
+
+static inline size_t class_size(int cls) {
+    return (size_t)(cls + 1) * SLAB_CLASS_STEP;
+}
+
+/**
+ * Move up to `want` objects of a class onto *list: recycled ones first,
+ * then fresh ones carved from the newest page.
+ * @return Number moved, 0 if out of memory
+ */
+static unsigned int central_take(int cls, FreeObject **list, unsigned int want) {
+    SlabCentral *c = &central[cls];
+    size_t size = class_size(cls);
+    unsigned int got = 0;
+
+    pthread_mutex_lock(&c->lock);
+    while (got < want && c->free) {
+        FreeObject *obj = c->free;
+        c->free = obj->next;
+        obj->next = *list;
+        *list = obj;
+        got++;
+    }
+    while (got < want) {
+        if (c->bump_left < size) {
+            //-- The tail of the previous page that no object fits in stays unused --//
+            char *page = malloc(SLAB_PAGE_BYTES);
+            if (!page) break;
+            c->bump = page;
+            c->bump_left = SLAB_PAGE_BYTES;
+            __atomic_store_n(&c->pages, c->pages + 1, __ATOMIC_RELAXED);
+        }
+        FreeObject *obj = (FreeObject *)c->bump;
+        c->bump += size;
+        c->bump_left -= size;
+        obj->next = *list;
+        *list = obj;
+        got++;
+    }
+    pthread_mutex_unlock(&c->lock);
+    return got;
+}
+
+/**
+ * Prepend the chain first..last to a class's central list.
+ */
+static void central_give(int cls, FreeObject *first, FreeObject *last) {
+    SlabCentral *c = &central[cls];
+    pthread_mutex_lock(&c->lock);
+    last->next = c->free;
+    c->free = first;
+    pthread_mutex_unlock(&c->lock);
+}
+
+/* ==================== Thread Caches ==================== */
+
+typedef struct {
+    FreeObject *free;
+    unsigned int count;
+} CacheList;
+
+typedef struct {
+    unsigned long long allocs;
+    unsigned long long frees;
+    unsigned long long requested_in;    //- Bytes asked for by allocations -//
+    unsigned long long requested_out;   //- Bytes released by frees -//
+} CacheCounters;
+
+typedef struct SlabCache {
+    int in_use;                         //- Claimed by a live thread, accessed atomically -//
+    CacheList lists[SLAB_CLASSES];
+    CacheCounters counters[SLAB_CLASSES];
+    unsigned long long large_in;        //- malloc fallback bytes, owner-written -//
+    unsigned long long large_out;
+    struct SlabCache *next;             //- Immutable once published -//
+} __attribute__((aligned(64))) SlabCache;
+
+static SlabCache *caches = NULL;
+
+static pthread_once_t slab_once = PTHREAD_ONCE_INIT;
+static pthread_key_t slab_key;
+static __thread SlabCache *self = NULL;
+static __thread int exited = 0;         //- Past the thread-exit flush: no cache any more -//
+
+//-- Counters of threads allocating after their cache was flushed; shared, atomic -//
+static CacheCounters orphan_counters[SLAB_CLASSES];
+static unsigned long long orphan_large_in, orphan_large_out;
+
+static void slab_thread_exit(void *arg) {
+    SlabCache *cache = arg;
+
+    for (int cls = 0; cls < SLAB_CLASSES; cls++) {
+        CacheList *list = &cache->lists[cls];
+        if (!list->free) continue;
+        FreeObject *last = list->free;
+        while (last->next) last = last->next;
+        central_give(cls, list->free, last);
+        list->free = NULL;
+        list->count = 0;
+    }
+
+    self = NULL;
+    exited = 1;
+    __atomic_store_n(&cache->in_use, 0, __ATOMIC_RELEASE);
+}
+
+static void slab_init(void) {
+    pthread_key_create(&slab_key, slab_thread_exit);
+}
+
+/**
+ * Claim a cache released by an exited thread, or publish a new one.
+ */
+static SlabCache *slab_register(void) {
+    pthread_once(&slab_once, slab_init);
+
+    SlabCache *cache = __atomic_load_n(&caches, __ATOMIC_ACQUIRE);
+    for (; cache; cache = cache->next) {
+        int expected = 0;
+        if (__atomic_load_n(&cache->in_use, __ATOMIC_RELAXED) == 0 &&
+            __atomic_compare_exchange_n(&cache->in_use, &expected, 1, 0,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+
+    if (!cache) {
+        if (posix_memalign((void **)&cache, 64, sizeof(SlabCache)) != 0) return NULL;
+        memset(cache, 0, sizeof(*cache));
+        cache->in_use = 1;
+        SlabCache *head = __atomic_load_n(&caches, __ATOMIC_RELAXED);
+        do {
+            cache->next = head;
+        } while (!__atomic_compare_exchange_n(&caches, &head, cache, 1,
+                                              __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    }
+
+    pthread_setspecific(slab_key, cache);
+    self = cache;
+    return cache;
+}
+
+/**
+ * @return The calling thread's cache, NULL once it has exited
+ */
+static inline SlabCache *slab_self(void) {
+    if (self) return self;
+    return exited ? NULL : slab_register();
+}
+
+/* ==================== Allocation ==================== */
+
+/**
+ * Allocate and free one object straight through the central list, for a
+ * thread without a cache.
+ */
+static void *orphan_alloc(int cls, size_t size) {
+    FreeObject *obj = NULL;
+    if (central_take(cls, &obj, 1) == 0) return NULL;
+    __atomic_fetch_add(&orphan_counters[cls].allocs, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&orphan_counters[cls].requested_in, size, __ATOMIC_RELAXED);
+    return obj;
+}
+
+static void orphan_free(int cls, void *ptr, size_t size) {
+    FreeObject *obj = ptr;
+    central_give(cls, obj, obj);
+    __atomic_fetch_add(&orphan_counters[cls].frees, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&orphan_counters[cls].requested_out, size, __ATOMIC_RELAXED);
+}
+
+static void count_large(SlabCache *cache, size_t in, size_t out) {
+    if (cache) {
+        COUNTER_ADD(cache->large_in, in);
+        COUNTER_ADD(cache->large_out, out);
+    } else {
+        __atomic_fetch_add(&orphan_large_in, in, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&orphan_large_out, out, __ATOMIC_RELAXED);
+    }
+}
+
+void *slab_alloc(size_t size) {
+    SlabCache *cache = slab_self();
+    if (size > SLAB_MAX_SIZE) {
+        void *ptr = malloc(size);
+        if (ptr) count_large(cache, size, 0);
+        return ptr;
+    }
+
+    int cls = size_class(size);
+    if (!cache) return orphan_alloc(cls, size);
+
+    CacheList *list = &cache->lists[cls];
+    if (!list->free) {
+        list->count = central_take(cls, &list->free, SLAB_BATCH);
+        if (!list->free) return NULL;
+    }
+
+    FreeObject *obj = list->free;
+    list->free = obj->next;
+    list->count--;
+    COUNTER_ADD(cache->counters[cls].allocs, 1);
+    COUNTER_ADD(cache->counters[cls].requested_in, size);
+    return obj;
+}
+
+void slab_free(void *ptr, size_t size) {
+    if (!ptr) return;
+
+    SlabCache *cache = slab_self();
+    if (size > SLAB_MAX_SIZE) {
+        free(ptr);
+        count_large(cache, 0, size);
+        return;
+    }
+
+    int cls = size_class(size);
+    if (!cache) {
+        orphan_free(cls, ptr, size);
+        return;
+    }
+
+    CacheList *list = &cache->lists[cls];
+    FreeObject *obj = ptr;
+    obj->next = list->free;
+    list->free = obj;
+    list->count++;
+    COUNTER_ADD(cache->counters[cls].frees, 1);
+    COUNTER_ADD(cache->counters[cls].requested_out, size);
+
+    if (list->count > 2 * SLAB_BATCH) {
+        //-- Keep the most recently freed (cache-warm) objects, spill the rest --//
+        FreeObject *keep_last = list->free;
+        for (unsigned int i = 1; i < list->count - SLAB_BATCH; i++) keep_last = keep_last->next;
+        FreeObject *first = keep_last->next, *last = first;
+        while (last->next) last = last->next;
+        keep_last->next = NULL;
+        list->count -= SLAB_BATCH;
+        central_give(cls, first, last);
+    }
+}
+
+void *slab_realloc(void *ptr, size_t old_size, size_t new_size) {
+    if (!ptr) return slab_alloc(new_size);
+
+    if (old_size > SLAB_MAX_SIZE && new_size > SLAB_MAX_SIZE) {
+        void *moved = realloc(ptr, new_size);
+        if (moved) count_large(slab_self(), new_size, old_size);
+        return moved;
+    }
+    if (old_size <= SLAB_MAX_SIZE && new_size <= SLAB_MAX_SIZE &&
+        size_class(old_size) == size_class(new_size)) {
+        //-- Same object, only the requested size changes --//
+        SlabCache *cache = slab_self();
+        int cls = size_class(new_size);
+        if (cache) {
+            COUNTER_ADD(cache->counters[cls].requested_in, new_size);
+            COUNTER_ADD(cache->counters[cls].requested_out, old_size);
+        } else {
+            __atomic_fetch_add(&orphan_counters[cls].requested_in, new_size, __ATOMIC_RELAXED);
+            __atomic_fetch_add(&orphan_counters[cls].requested_out, old_size, __ATOMIC_RELAXED);
+        }
+        return ptr;
+    }
+
+    void *moved = slab_alloc(new_size);
+    if (!moved) return NULL;
+    memcpy(moved, ptr, old_size < new_size ? old_size : new_size);
+    slab_free(ptr, old_size);
+    return moved;
+}
+
+/* ==================== Statistics ==================== */
+
+static void add_counters(SlabStats *stats, const CacheCounters *counters, int cls) {
+    unsigned long long allocs = __atomic_load_n(&counters->allocs, __ATOMIC_RELAXED);
+    unsigned long long frees = __atomic_load_n(&counters->frees, __ATOMIC_RELAXED);
+    unsigned long long in = __atomic_load_n(&counters->requested_in, __ATOMIC_RELAXED);
+    unsigned long long out = __atomic_load_n(&counters->requested_out, __ATOMIC_RELAXED);
+
+    //-- Objects freed by another thread than the one that allocated them make single caches go negative; the sum does not --//
+    stats->classes[cls].allocated += (size_t)(allocs - frees) * class_size(cls);
+    stats->classes[cls].requested += (size_t)(in - out);
+}
+
+void slab_stats(SlabStats *stats) {
+    memset(stats, 0, sizeof(*stats));
+
+    unsigned long long large = __atomic_load_n(&orphan_large_in, __ATOMIC_RELAXED) -
+                               __atomic_load_n(&orphan_large_out, __ATOMIC_RELAXED);
+    for (int cls = 0; cls < SLAB_CLASSES; cls++) {
+        add_counters(stats, &orphan_counters[cls], cls);
+    }
+    for (SlabCache *cache = __atomic_load_n(&caches, __ATOMIC_ACQUIRE); cache; cache = cache->next) {
+        for (int cls = 0; cls < SLAB_CLASSES; cls++) {
+            add_counters(stats, &cache->counters[cls], cls);
+        }
+        large += __atomic_load_n(&cache->large_in, __ATOMIC_RELAXED) -
+                 __atomic_load_n(&cache->large_out, __ATOMIC_RELAXED);
+    }
+
+    for (int cls = 0; cls < SLAB_CLASSES; cls++) {
+        SlabClassStats *c = &stats->classes[cls];
+        c->size = class_size(cls);
+        c->reserved = __atomic_load_n(&central[cls].pages, __ATOMIC_RELAXED) * SLAB_PAGE_BYTES;
+        stats->reserved += c->reserved;
+        stats->allocated += c->allocated;
+        stats->requested += c->requested;
+    }
+    stats->large = (size_t)large;
+}
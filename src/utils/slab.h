@@ -0,0 +1,87 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/utils/slab.h
+ * Module                    : Slab Allocator
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Size-class allocator for the small objects the keyspace is made of:
+ *  entries, keys, short values, list headers and small list nodes.
+ *  Objects of one class are carved back to back from 64 KB pages, with no
+ *  per-object header. Each thread allocates from and frees to its own
+ *  cache, which trades objects with a per-class central free list in
+ *  batches. Frees are sized: the caller passes the size it allocated.
+ *  Larger requests fall through to malloc.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#ifndef MEMORADB_SLAB_H
+#define MEMORADB_SLAB_H
+
+#include <stddef.h>
+
+/* ==================== Size Classes ==================== */
+#define SLAB_CLASS_STEP  16                                   //- Classes are 16, 32, ... bytes -//
+#define SLAB_MAX_SIZE    256                                  //- Larger requests go to malloc -//
+#define SLAB_CLASSES     (SLAB_MAX_SIZE / SLAB_CLASS_STEP)
+#define SLAB_PAGE_BYTES  (64 * 1024)                          //- Carved into objects of one class -//
+#define SLAB_BATCH       32                                   //- Objects moved per cache refill or spill -//
+
+/* ==================== Statistics ==================== */
+typedef struct {
+    size_t size;              //- Object size of the class -//
+    size_t reserved;          //- Bytes of pages carved for the class -//
+    size_t allocated;         //- Objects in use times the object size -//
+    size_t requested;         //- Bytes callers asked for, summed over objects in use -//
+} SlabClassStats;
+
+typedef struct {
+    SlabClassStats classes[SLAB_CLASSES];
+    size_t reserved;          //- Totals over the classes -//
+    size_t allocated;
+    size_t requested;
+    size_t large;             //- Bytes in use through the malloc fallback -//
+} SlabStats;
+
+/**
+ * Bytes slab_alloc(size) actually provides: the class size for small
+ * requests, size itself for larger ones. Asking for that much up front
+ * turns the rounding slack into usable room.
+ */
+static inline size_t slab_good_size(size_t size) {
+    if (size == 0 || size > SLAB_MAX_SIZE) return size;
+    return (size + SLAB_CLASS_STEP - 1) / SLAB_CLASS_STEP * SLAB_CLASS_STEP;
+}
+
+/**
+ * Allocate size bytes. Release with slab_free() and the same size.
+ * @return The memory, NULL if out of memory
+ */
+void *slab_alloc(size_t size);
+
+/**
+ * Release memory from slab_alloc(). NULL is ignored.
+ * @param size The size it was allocated (or last reallocated) with
+ */
+void slab_free(void *ptr, size_t size);
+
+/**
+ * Resize an allocation, moving it when the size class changes.
+ * @return The memory, NULL if out of memory (ptr left untouched)
+ */
+void *slab_realloc(void *ptr, size_t old_size, size_t new_size);
+
+/**
+ * Sum the counters of every thread. The figures are a snapshot taken
+ * without stopping allocators, so they can be off by in-flight operations.
+ */
+void slab_stats(SlabStats *stats);
+
+#endif // MEMORADB_SLAB_H
@@ -0,0 +1,139 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/utils/timer_wheel.c
+ * Module                    : Timer Wheel
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Hierarchical timing wheel. A timer d ticks away sits at the lowest
+ *  level whose span covers d, in the slot of its expiry tick at that
+ *  level's granularity. Each time level 0 wraps, the next slot of level 1
+ *  is emptied into level 0, and so on up the levels.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include "timer_wheel.h"
+
+#define TIMER_WHEEL_MASK (TIMER_WHEEL_SLOTS - 1)
+
+static inline unsigned int slot_index(unsigned long long tick, int level) {
+    return (unsigned int)(tick >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK;
+}
+
+void timer_wheel_init(TimerWheel *wheel, unsigned long long now) {
+    wheel->now = now;
+    wheel->count = 0;
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        for (int slot = 0; slot < TIMER_WHEEL_SLOTS; slot++) {
+            TimerNode *head = &wheel->slots[level][slot];
+            head->prev = head;
+            head->next = head;
+        }
+    }
+}
+
+static inline void list_unlink(TimerNode *node) {
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    node->prev = NULL;
+    node->next = NULL;
+}
+
+static inline void list_append(TimerNode *head, TimerNode *node) {
+    node->prev = head->prev;
+    node->next = head;
+    head->prev->next = node;
+    head->prev = node;
+}
+
+/**
+ * Link a node whose expiry is at or after wheel->now. A level-L slot is
+ * emptied when time enters it, so a timer up to SLOTS^(L+1) ticks away
+ * still has its slot ahead of it, even when it is the current one.
+ */
+static void wheel_link(TimerWheel *wheel, TimerNode *node) {
+    unsigned long long delta = node->expires - wheel->now;
+    int level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 && delta >= (1ULL << (TIMER_WHEEL_BITS * (level + 1)))) {
+        level++;
+    }
+    list_append(&wheel->slots[level][slot_index(node->expires, level)], node);
+}
+
+void timer_wheel_schedule(TimerWheel *wheel, TimerNode *node, unsigned long long expires) {
+    if (timer_node_scheduled(node)) {
+        list_unlink(node);
+    } else {
+        wheel->count++;
+    }
+    if (expires < wheel->now) expires = wheel->now;
+    if (expires - wheel->now > TIMER_WHEEL_MAX_DELAY) expires = wheel->now + TIMER_WHEEL_MAX_DELAY;
+    node->expires = expires;
+    wheel_link(wheel, node);
+}
+
+void timer_wheel_cancel(TimerWheel *wheel, TimerNode *node) {
+    if (!timer_node_scheduled(node)) return;
+    list_unlink(node);
+    wheel->count--;
+}
+
+//-- Move every timer of a higher-level slot down to the level that now covers it --//
+static void wheel_cascade(TimerWheel *wheel, int level) {
+    TimerNode *head = &wheel->slots[level][slot_index(wheel->now, level)];
+    while (head->next != head) {
+        TimerNode *node = head->next;
+        list_unlink(node);
+        wheel_link(wheel, node);
+    }
+}
+
+size_t timer_wheel_advance(TimerWheel *wheel, unsigned long long now, TimerCallback callback, void *arg) {
+    size_t fired = 0;
+    while (wheel->now <= now) {
+        //-- Nothing scheduled: no slot needs visiting on the way --//
+        if (wheel->count == 0) {
+            wheel->now = now + 1;
+            break;
+        }
+
+        //-- Level 0 wrapped: refill it from the next slot above, which may itself need refilling --//
+        if (slot_index(wheel->now, 0) == 0) {
+            for (int level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+                wheel_cascade(wheel, level);
+                if (slot_index(wheel->now, level) != 0) break;
+            }
+        }
+
+        //-- Detach the due list first: callbacks may schedule timers, even into this slot --//
+        TimerNode due;
+        TimerNode *head = &wheel->slots[0][slot_index(wheel->now, 0)];
+        if (head->next == head) {
+            wheel->now++;
+            continue;
+        }
+        due.next = head->next;
+        due.prev = head->prev;
+        due.next->prev = &due;
+        due.prev->next = &due;
+        head->next = head;
+        head->prev = head;
+        wheel->now++;
+
+        while (due.next != &due) {
+            TimerNode *node = due.next;
+            list_unlink(node);
+            wheel->count--;
+            fired++;
+            callback(node, arg);
+        }
+    }
+    return fired;
+}
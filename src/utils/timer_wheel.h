@@ -0,0 +1,92 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : src/utils/timer_wheel.h
+ * Module                    : Timer Wheel
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Hierarchical timing wheel for large numbers of coarse timers, such as
+ *  one idle timeout per client. Time is counted in ticks. Level 0 has one
+ *  slot per tick; each higher level has slots TIMER_WHEEL_SLOTS times as
+ *  wide, and a slot is redistributed to the level below when time reaches
+ *  it. Scheduling and cancelling are O(1); each timer is moved at most
+ *  once per level before it fires.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#ifndef MEMORADB_TIMER_WHEEL_H
+#define MEMORADB_TIMER_WHEEL_H
+
+#include <stddef.h>
+
+/* ==================== Wheel Geometry ==================== */
+#define TIMER_WHEEL_BITS   6                                   //- 64 slots per level -//
+#define TIMER_WHEEL_SLOTS  (1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_LEVELS 4
+#define TIMER_WHEEL_MAX_DELAY ((1ULL << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) - 1)   //- Longer delays are clamped -//
+
+/* ==================== Wheel Types ==================== */
+typedef struct TimerNode {
+    struct TimerNode *prev;
+    struct TimerNode *next;         //- NULL when not scheduled -//
+    unsigned long long expires;     //- Tick the timer fires at -//
+} TimerNode;
+
+typedef struct {
+    unsigned long long now;         //- Next tick to process; every earlier tick has fired -//
+    size_t count;                   //- Scheduled timers -//
+    TimerNode slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];   //- Heads of circular lists -//
+} TimerWheel;
+
+/**
+ * Called for each timer that fires. The node is no longer scheduled, so
+ * the callback may schedule it again or free it.
+ */
+typedef void (*TimerCallback)(TimerNode *node, void *arg);
+
+static inline void timer_node_init(TimerNode *node) {
+    node->prev = NULL;
+    node->next = NULL;
+    node->expires = 0;
+}
+
+static inline int timer_node_scheduled(const TimerNode *node) {
+    return node->next != NULL;
+}
+
+/**
+ * @param now First tick the wheel will process
+ */
+void timer_wheel_init(TimerWheel *wheel, unsigned long long now);
+
+/**
+ * Schedule `node` to fire at tick `expires`, or move it there if it is
+ * already scheduled. A tick already processed fires on the next advance;
+ * one more than TIMER_WHEEL_MAX_DELAY ticks away is brought forward to
+ * that distance.
+ */
+void timer_wheel_schedule(TimerWheel *wheel, TimerNode *node, unsigned long long expires);
+
+/**
+ * Unschedule `node` if it is scheduled.
+ */
+void timer_wheel_cancel(TimerWheel *wheel, TimerNode *node);
+
+/**
+ * Fire every timer due at or before tick `now`, in tick order.
+ * @return Number of timers fired
+ */
+size_t timer_wheel_advance(TimerWheel *wheel, unsigned long long now, TimerCallback callback, void *arg);
+
+static inline size_t timer_wheel_size(const TimerWheel *wheel) {
+    return wheel->count;
+}
+
+#endif // MEMORADB_TIMER_WHEEL_H
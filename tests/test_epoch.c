@@ -0,0 +1,139 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : tests/test_epoch.c
+ * Module                    : Epoch-based Reclamation Unit Tests
+ * Last Updating Author      : agent
+ * Last Update               : 10/17/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Unit tests for deferred freeing: retired objects must outlive every
+ *  read-side section that started before they were retired, and must be
+ *  freed once those sections end.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "../src/utils/epoch.h"
+#include "test_framework.h"
+
+static int freed_count = 0;
+
+static void count_free(void *ptr) {
+    (void)ptr;
+    freed_count++;
+}
+
+static void collect_a_few_times(void) {
+    for (int i = 0; i < 4; i++) epoch_collect();
+}
+
+void test_retire_without_readers() {
+    printf("Testing reclamation with no active readers...\n");
+
+    int object;
+    freed_count = 0;
+    epoch_retire(&object, count_free);
+    TEST_ASSERT(freed_count == 0, "Retired object should not be freed immediately");
+
+    collect_a_few_times();
+    TEST_ASSERT(freed_count == 1, "Object should be freed once the epoch advances twice");
+    TEST_ASSERT(epoch_pending() == 0, "Nothing should remain pending");
+    TEST_SUCCESS("Reclamation without readers test passed");
+}
+
+static atomic_int reader_inside;
+static atomic_int reader_release;
+
+static void *pinned_reader(void *arg) {
+    (void)arg;
+    epoch_enter();
+    atomic_store(&reader_inside, 1);
+    while (!atomic_load(&reader_release)) usleep(1000);
+    epoch_exit();
+    return NULL;
+}
+
+void test_active_reader_blocks_reclamation() {
+    printf("Testing that an active reader defers reclamation...\n");
+
+    pthread_t reader;
+    atomic_store(&reader_inside, 0);
+    atomic_store(&reader_release, 0);
+    pthread_create(&reader, NULL, pinned_reader, NULL);
+    while (!atomic_load(&reader_inside)) usleep(1000);
+
+    int object;
+    freed_count = 0;
+    epoch_retire(&object, count_free);
+    collect_a_few_times();
+    TEST_ASSERT(freed_count == 0, "Object must survive while a reader may hold it");
+
+    atomic_store(&reader_release, 1);
+    pthread_join(reader, NULL);
+    collect_a_few_times();
+    TEST_ASSERT(freed_count == 1, "Object should be freed after the reader leaves");
+    TEST_SUCCESS("Active reader test passed");
+}
+
+void test_nested_sections() {
+    printf("Testing nested read-side sections...\n");
+
+    int object;
+    freed_count = 0;
+    epoch_enter();
+    epoch_enter();
+    epoch_exit();
+
+    //-- Still inside the outer section: our own retire must wait for us --//
+    epoch_retire(&object, count_free);
+    collect_a_few_times();
+    TEST_ASSERT(freed_count == 0, "Inner exit must not end the outer section");
+
+    epoch_exit();
+    collect_a_few_times();
+    TEST_ASSERT(freed_count == 1, "Object should be freed after the outer exit");
+    TEST_SUCCESS("Nested sections test passed");
+}
+
+static void *retire_and_exit(void *arg) {
+    epoch_enter();
+    epoch_exit();
+    epoch_retire(arg, count_free);
+    return NULL;
+}
+
+void test_orphaned_retires() {
+    printf("Testing objects retired by an exited thread...\n");
+
+    int object;
+    freed_count = 0;
+    pthread_t thread;
+    pthread_create(&thread, NULL, retire_and_exit, &object);
+    pthread_join(thread, NULL);
+
+    collect_a_few_times();
+    TEST_ASSERT(freed_count == 1, "Leftovers of an exited thread should be freed by others");
+    TEST_SUCCESS("Orphaned retires test passed");
+}
+
+int main() {
+    init_test_framework();
+    printf("=== Epoch Reclamation Tests ===\n");
+
+    test_retire_without_readers();
+    test_active_reader_blocks_reclamation();
+    test_nested_sections();
+    test_orphaned_retires();
+
+    save_test_results();
+    return total_tests_failed > 0 ? 1 : 0;
+}
@@ -5,8 +5,8 @@
  * 
  * File                      : tests/test_hashtable.c
  * Module                    : Hash Table Unit Tests
- * Last Updating Author      : sch0penheimer
- * Last Update               : 2025/31/07
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
  * Version                   : 1.0.0
  * 
  * Description:
@@ -20,14 +20,28 @@
 #include <assert.h>
 #include <string.h>
 #include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include "../src/utils/hashTable.h"
+#include "../src/utils/siphash.h"
+#include "../src/utils/epoch.h"
+#include "../src/utils/slab.h"
 #include "test_framework.h"
 
+//-- Most tests store text: pass a C string with its length --//
+#define STR(s) (s), strlen(s)
+
+static const char *get_str(const char *key) {
+    static __thread char int_buf[INT_TEXT_MAX];
+    size_t len;
+    return get_value(key, strlen(key), &len, int_buf);
+}
+
 void test_basic_set_get() {
     printf("Testing basic SET/GET operations...\n");
     
-    set_value("test_key", "test_value", 0);
-    const char *result = get_value("test_key");
+    set_value(STR("test_key"), STR("test_value"), 0);
+    const char *result = get_str("test_key");
     
     TEST_ASSERT(result != NULL, "GET should return non-NULL value");
     TEST_ASSERT(strcmp(result, "test_value") == 0, "GET should return correct value");
@@ -38,10 +52,10 @@ void test_key_expiry() {
     printf("Testing key expiry with TTL...\n");
     
     //-- Set key with 100ms expiry --//
-    set_value("expiry_key", "expiry_value", 100);
+    set_value(STR("expiry_key"), STR("expiry_value"), 100);
     
     //-- Should exist immediately --//
-    const char *result = get_value("expiry_key");
+    const char *result = get_str("expiry_key");
     TEST_ASSERT(result != NULL, "Key should exist immediately after SET");
     TEST_ASSERT(strcmp(result, "expiry_value") == 0, "Key should have correct value");
     
@@ -49,42 +63,595 @@ void test_key_expiry() {
     usleep(110000);
 
     //-- Should be expired --//
-    result = get_value("expiry_key");
+    result = get_str("expiry_key");
     TEST_ASSERT(result == NULL, "Key should be expired after TTL");
+
+    //-- Not yet reclaimed, but already gone for DEL too --//
+    set_value(STR("expiry_del"), STR("gone soon"), 1);
+    usleep(3000);
+    TEST_ASSERT(delete_key(STR("expiry_del")) == 0, "DEL of an expired key should delete nothing");
     
     TEST_SUCCESS("Key expiry test passed");
 }
 
+#define EXPIRE_TEST_KEYS 1000
+
+void test_active_expire() {
+    printf("Testing active expiry of keys nobody reads...\n");
+    char key[32];
+    ExpireStats before, after;
+    keyspace_expire_stats(&before);
+    size_t keys_before = hashtable_key_count();
+
+    for (int i = 0; i < EXPIRE_TEST_KEYS; i++) {
+        snprintf(key, sizeof(key), "volatile:%d", i);
+        set_value(STR(key), STR("gone soon"), 1);
+    }
+    set_value(STR("volatile:persisted"), STR("stays"), 1);
+    set_value(STR("volatile:persisted"), STR("stays"), 0);   //- Overwrite without PX drops the TTL -//
+    set_value(STR("volatile:later"), STR("stays"), 60000);
+    TEST_ASSERT(hashtable_expires_count() == EXPIRE_TEST_KEYS + 1, "Only keys with a TTL should be indexed");
+
+    usleep(5000);
+    size_t first = keyspace_active_expire(0, 1, 0);
+    TEST_ASSERT(first > 0 && first <= ACTIVE_EXPIRE_BATCH, "A zero budget should stop after one batch");
+
+    size_t rest = keyspace_active_expire(0, 1, 1000000);
+    TEST_ASSERT(first + rest == EXPIRE_TEST_KEYS, "Every due key should be reclaimed without being read");
+    TEST_ASSERT(hashtable_key_count() == keys_before + 2, "Only the unexpired keys should remain");
+    TEST_ASSERT(hashtable_expires_count() == 1, "The key with a future deadline should stay indexed");
+
+    keyspace_expire_stats(&after);
+    TEST_ASSERT(after.expired_keys - before.expired_keys == EXPIRE_TEST_KEYS, "Expired keys should be counted");
+    TEST_ASSERT(after.expired_bytes - before.expired_bytes >= EXPIRE_TEST_KEYS * sizeof(Entry),
+                "Reclaimed memory should be accounted");
+    TEST_ASSERT(after.timelimit_exits > before.timelimit_exits, "The budget-limited cycle should be recorded");
+
+    delete_key(STR("volatile:persisted"));
+    delete_key(STR("volatile:later"));
+    TEST_ASSERT(hashtable_expires_count() == 0, "Deleting a key should drop it from the index");
+    TEST_SUCCESS("Active expiry test passed");
+}
+
 void test_key_overwrite() {
     printf("Testing key overwrite...\n");
     
-    set_value("overwrite_key", "original_value", 0);
-    set_value("overwrite_key", "new_value", 0);
+    set_value(STR("overwrite_key"), STR("original_value"), 0);
+    set_value(STR("overwrite_key"), STR("new_value"), 0);
     
-    const char *result = get_value("overwrite_key");
+    const char *result = get_str("overwrite_key");
     TEST_ASSERT(result != NULL, "Overwritten key should exist");
     TEST_ASSERT(strcmp(result, "new_value") == 0, "Key should have new value");
     
     TEST_SUCCESS("Key overwrite test passed");
 }
 
+void test_embedded_values() {
+    printf("Testing embedded and out-of-line values...\n");
+
+    //-- A short value lives in the entry: one allocation for key and value --//
+    SlabStats before, after;
+    slab_stats(&before);
+    set_value(STR("embed:short"), STR("flag"), 0);
+    slab_stats(&after);
+    TEST_ASSERT(after.allocated - before.allocated <= ENTRY_EMBED_MAX,
+                "A short key and value should take one small allocation");
+    TEST_ASSERT(strcmp(get_str("embed:short"), "flag") == 0, "Embedded value should read back");
+
+    char long_value[1000];
+    memset(long_value, 'L', sizeof(long_value) - 1);
+    long_value[sizeof(long_value) - 1] = '\0';
+    set_value(STR("embed:short"), STR(long_value), 0);
+    TEST_ASSERT(strcmp(get_str("embed:short"), long_value) == 0, "A value too long to embed should read back");
+    set_value(STR("embed:short"), STR("flag again"), 0);
+    TEST_ASSERT(strcmp(get_str("embed:short"), "flag again") == 0, "A value can be embedded again");
+
+    //-- Replacing the entry carries its deadline and its place in the expiry index --//
+    size_t expires = hashtable_expires_count();
+    set_value_ex(STR("embed:ttl"), STR("v1"), expiry_now() + 100000, 0, NULL, NULL);
+    set_value_ex(STR("embed:ttl"), STR(long_value), 0, SET_KEEPTTL, NULL, NULL);
+    TEST_ASSERT(get_key_ttl(STR("embed:ttl")) > 0, "KEEPTTL should survive the entry being replaced");
+    TEST_ASSERT(hashtable_expires_count() == expires + 1, "The replacement should take over the index slot");
+    set_value_ex(STR("embed:ttl"), STR("v3"), 0, SET_KEEPTTL, NULL, NULL);
+    TEST_ASSERT(persist_key(STR("embed:ttl")) == 1, "The deadline should still be removable");
+    TEST_ASSERT(hashtable_expires_count() == expires, "Persisting should leave the index");
+
+    //-- A list overwritten by SET becomes a string --//
+    char *values[] = { "a", "b" };
+    size_t value_lens[] = { 1, 1 };
+    push_list_values(STR("embed:list"), values, value_lens, 2, 0);
+    set_value(STR("embed:list"), STR("now a string"), 0);
+    TEST_ASSERT(strcmp(get_type(STR("embed:list")), "string") == 0, "SET should replace a list");
+    TEST_ASSERT(strcmp(get_str("embed:list"), "now a string") == 0, "The new value should read back");
+
+    delete_key(STR("embed:short"));
+    delete_key(STR("embed:ttl"));
+    delete_key(STR("embed:list"));
+    TEST_SUCCESS("Embedded value test passed");
+}
+
+void test_integer_values() {
+    printf("Testing integer-encoded values and counters...\n");
+    long long value;
+
+    //-- Canonical integers read back unchanged; anything else stays text --//
+    const char *texts[] = { "0", "42", "-7", "9223372036854775807", "-9223372036854775808",
+                            "007", "-0", "+1", "1 ", "9223372036854775808", "" };
+    int is_counter[] = { 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0 };
+    for (size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); i++) {
+        set_value(STR("int:text"), STR(texts[i]), 0);
+        const char *got = get_str("int:text");
+        TEST_ASSERT(got && strcmp(got, texts[i]) == 0, "A value should read back exactly as set");
+        int status = increment_value(STR("int:text"), 0, &value);
+        TEST_ASSERT(is_counter[i] ? status == 1 : status == STRING_ERR_NOT_INTEGER,
+                    "Only canonical integers should count as integers");
+    }
+
+    //-- Small values come from the shared text --//
+    set_value(STR("int:a"), STR("7"), 0);
+    set_value(STR("int:b"), STR("7"), 0);
+    TEST_ASSERT(get_str("int:a") == get_str("int:b"), "Small integers should share their text");
+
+    TEST_ASSERT(increment_value(STR("int:new"), 5, &value) == 1 && value == 5, "A missing key should count as 0");
+    TEST_ASSERT(increment_value(STR("int:new"), -8, &value) == 1 && value == -3, "Negative deltas should decrement");
+    TEST_ASSERT(strcmp(get_str("int:new"), "-3") == 0, "GET should render the counter");
+
+    set_value(STR("int:max"), STR("9223372036854775807"), 0);
+    TEST_ASSERT(increment_value(STR("int:max"), 1, &value) == STRING_ERR_OVERFLOW, "Overflow should be refused");
+    TEST_ASSERT(strcmp(get_str("int:max"), "9223372036854775807") == 0, "A refused increment should not store");
+
+    //-- Counters keep their deadline, updated in place or replaced --//
+    set_value(STR("int:ttl"), STR("1"), 100000);
+    increment_value(STR("int:ttl"), 1, &value);
+    TEST_ASSERT(get_key_ttl(STR("int:ttl")) > 0, "INCR should keep the deadline");
+
+    char text[FLOAT_TEXT_MAX];
+    size_t len;
+    TEST_ASSERT(increment_value_float(STR("int:ttl"), 0.5L, text, &len) == 1 && strcmp(text, "2.5") == 0,
+                "An integer should take a float increment");
+    TEST_ASSERT(get_key_ttl(STR("int:ttl")) > 0, "INCRBYFLOAT should keep the deadline");
+    TEST_ASSERT(increment_value(STR("int:ttl"), 1, &value) == STRING_ERR_NOT_INTEGER, "2.5 is not an integer");
+    TEST_ASSERT(increment_value_float(STR("int:ttl"), 0.5L, text, &len) == 1 && strcmp(text, "3") == 0 && len == 1,
+                "Trailing zeros and the point should be dropped");
+    TEST_ASSERT(increment_value(STR("int:ttl"), 1, &value) == 1 && value == 4, "A whole float result should count again");
+
+    set_value(STR("int:float"), STR("10.50"), 0);
+    TEST_ASSERT(increment_value_float(STR("int:float"), 0.1L, text, &len) == 1 && strcmp(text, "10.6") == 0,
+                "Float text should be incremented");
+    TEST_ASSERT(strcmp(get_str("int:float"), "10.6") == 0, "The float result should be stored");
+    set_value(STR("int:float"), STR("abc"), 0);
+    TEST_ASSERT(increment_value_float(STR("int:float"), 1.0L, text, &len) == STRING_ERR_NOT_FLOAT,
+                "Text should not take a float increment");
+
+    char *values[] = { "x" };
+    size_t value_lens[] = { 1 };
+    push_list_values(STR("int:list"), values, value_lens, 1, 0);
+    TEST_ASSERT(increment_value(STR("int:list"), 1, &value) == STRING_ERR_WRONGTYPE, "A list should not count");
+    TEST_ASSERT(increment_value_float(STR("int:list"), 1.0L, text, &len) == STRING_ERR_WRONGTYPE,
+                "A list should not take a float increment");
+
+    const char *keys[] = { "int:text", "int:a", "int:b", "int:new", "int:max", "int:ttl", "int:float", "int:list" };
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++) delete_key(STR(keys[i]));
+    TEST_SUCCESS("Integer value test passed");
+}
+
+void test_multi_key_values() {
+    printf("Testing MGET/MSET/MSETNX batches...\n");
+
+    //-- Enough keys to touch every shard, with an integer and a long value among them --//
+    char names[40][16], long_value[300];
+    char *pairs[80];
+    size_t lens[80];
+    memset(long_value, 'L', sizeof(long_value) - 1);
+    long_value[sizeof(long_value) - 1] = '\0';
+    for (int i = 0; i < 40; i++) {
+        snprintf(names[i], sizeof(names[i]), "multi:%d", i);
+        pairs[2 * i] = names[i];
+        lens[2 * i] = strlen(names[i]);
+        pairs[2 * i + 1] = i == 0 ? "12345" : i == 1 ? long_value : names[i];
+        lens[2 * i + 1] = strlen(pairs[2 * i + 1]);
+    }
+    set_value(STR("multi:3"), STR("old"), 100000);
+    TEST_ASSERT(set_values(pairs, lens, 40, 0) == 1, "MSET should store every pair");
+    TEST_ASSERT(get_key_ttl(STR("multi:3")) == TTL_PERSISTENT, "MSET should clear deadlines");
+
+    char *keys[43];
+    size_t key_lens[43];
+    for (int i = 0; i < 40; i++) {
+        keys[i] = names[i];
+        key_lens[i] = lens[2 * i];
+    }
+    char *list_values[] = { "x" };
+    size_t list_lens[] = { 1 };
+    push_list_values(STR("multi:list"), list_values, list_lens, 1, 0);
+    TEST_ASSERT(push_list_values(STR("multi:3"), list_values, list_lens, 1, 0) == LIST_ERR_WRONGTYPE,
+                "Pushing onto a string should report the wrong type");
+    set_value(STR("multi:expired"), STR("gone"), 1);
+    usleep(5000);
+    keys[40] = "multi:missing";
+    keys[41] = "multi:list";
+    keys[42] = "multi:expired";
+    for (int i = 40; i < 43; i++) key_lens[i] = strlen(keys[i]);
+
+    StringValue values[43];
+    epoch_enter();
+    TEST_ASSERT(get_values(keys, key_lens, 43, values) == 0, "MGET should succeed");
+    int in_order = 1;
+    for (int i = 0; i < 40; i++) {
+        if (!values[i].value || values[i].len != lens[2 * i + 1] ||
+            memcmp(values[i].value, pairs[2 * i + 1], values[i].len) != 0) in_order = 0;
+    }
+    TEST_ASSERT(in_order, "MGET should answer in request order");
+    TEST_ASSERT(!values[40].value && !values[41].value && !values[42].value,
+                "Missing, list and expired keys should read as nil");
+    epoch_exit();
+    TEST_ASSERT(strcmp(get_type(STR("multi:expired")), "none") == 0, "MGET should reclaim an expired key");
+
+    //-- MSETNX is all or nothing --//
+    char *nx_pairs[] = { "multi:nx1", "a", "multi:0", "b" };
+    size_t nx_lens[] = { 9, 1, 7, 1 };
+    TEST_ASSERT(set_values(nx_pairs, nx_lens, 2, SET_NX) == 0, "MSETNX should refuse when one key exists");
+    TEST_ASSERT(get_str("multi:nx1") == NULL && strcmp(get_str("multi:0"), "12345") == 0,
+                "A refused MSETNX should store nothing");
+    nx_pairs[2] = "multi:nx2";
+    nx_lens[2] = 9;
+    TEST_ASSERT(set_values(nx_pairs, nx_lens, 2, SET_NX) == 1, "MSETNX should store new keys");
+    TEST_ASSERT(strcmp(get_str("multi:nx2"), "b") == 0, "MSETNX should store every pair");
+
+    //-- A key given twice keeps its last value --//
+    char *dup_pairs[] = { "multi:dup", "first", "multi:dup", "second" };
+    size_t dup_lens[] = { 9, 5, 9, 6 };
+    set_values(dup_pairs, dup_lens, 2, 0);
+    TEST_ASSERT(strcmp(get_str("multi:dup"), "second") == 0, "The last value of a repeated key should win");
+
+    for (int i = 0; i < 43; i++) delete_key(keys[i], key_lens[i]);
+    delete_key(STR("multi:nx1"));
+    delete_key(STR("multi:nx2"));
+    delete_key(STR("multi:dup"));
+    TEST_SUCCESS("Multi-key test passed");
+}
+
 void test_nonexistent_key() {
     printf("Testing nonexistent key...\n");
     
-    const char *result = get_value("nonexistent_key");
+    const char *result = get_str("nonexistent_key");
     TEST_ASSERT(result == NULL, "Nonexistent key should return NULL");
     
     TEST_SUCCESS("Nonexistent key test passed");
 }
 
+void test_resize_and_rehash() {
+    printf("Testing table growth, incremental rehash and shrink...\n");
+
+    const int keys = 100000;
+    char key[32], value[32];
+    int saw_rehash = 0, lookups_ok = 1;
+
+    for (int i = 0; i < keys; i++) {
+        snprintf(key, sizeof(key), "resize:%d", i);
+        snprintf(value, sizeof(value), "v%d", i);
+        set_value(STR(key), STR(value), 0);
+
+        //-- Keys inserted before a resize must stay reachable while it runs --//
+        if (hashtable_is_rehashing()) {
+            saw_rehash = 1;
+            snprintf(key, sizeof(key), "resize:%d", i / 2);
+            snprintf(value, sizeof(value), "v%d", i / 2);
+            const char *got = get_str(key);
+            if (!got || strcmp(got, value) != 0) lookups_ok = 0;
+        }
+    }
+
+    TEST_ASSERT(saw_rehash, "Inserting many keys should trigger an incremental rehash");
+    TEST_ASSERT(lookups_ok, "Keys should stay reachable during rehash");
+    TEST_ASSERT(hashtable_key_count() >= (size_t)keys, "All keys should be stored");
+    TEST_ASSERT(hashtable_bucket_count() >= (size_t)keys / 2, "Table should grow with the key count");
+
+    int all_found = 1;
+    for (int i = 0; i < keys; i++) {
+        snprintf(key, sizeof(key), "resize:%d", i);
+        snprintf(value, sizeof(value), "v%d", i);
+        const char *got = get_str(key);
+        if (!got || strcmp(got, value) != 0) all_found = 0;
+    }
+    TEST_ASSERT(all_found, "Every key should be retrievable after growth");
+
+    size_t grown = hashtable_bucket_count();
+    for (int i = 0; i < keys; i++) {
+        snprintf(key, sizeof(key), "resize:%d", i);
+        delete_key(STR(key));
+    }
+    //-- Only writes advance a resize: delete misses spread over every shard --//
+    for (int i = 0; i < 100000 && hashtable_is_rehashing(); i++) {
+        snprintf(key, sizeof(key), "resize:none:%d", i);
+        delete_key(STR(key));
+    }
+    TEST_ASSERT(hashtable_bucket_count() < grown / 8, "Table should shrink once keys are deleted");
+
+    TEST_SUCCESS("Resize and rehash test passed");
+}
+
+#define CONCURRENT_THREADS 4
+#define CONCURRENT_OPS     2000
+
+static void *concurrent_worker(void *arg) {
+    long id = (long)arg;
+    char key[32], value[32];
+    char *push[1] = { value };
+
+    for (int i = 0; i < CONCURRENT_OPS; i++) {
+        snprintf(key, sizeof(key), "thread:%ld:%d", id, i);
+        snprintf(value, sizeof(value), "%ld-%d", id, i);
+        set_value(STR(key), STR(value), 0);
+        size_t push_len[1] = { strlen(value) };
+        push_list_values(STR("shared:list"), push, push_len, 1, i & 1);
+
+        epoch_enter();
+        const char *got = get_str(key);
+        int ok = got && strcmp(got, value) == 0;
+        epoch_exit();
+        if (!ok) return (void *)1;
+    }
+    return NULL;
+}
+
+void test_concurrent_access() {
+    printf("Testing concurrent access across shards...\n");
+
+    pthread_t threads[CONCURRENT_THREADS];
+    for (long t = 0; t < CONCURRENT_THREADS; t++) {
+        pthread_create(&threads[t], NULL, concurrent_worker, (void *)t);
+    }
+
+    int all_ok = 1;
+    for (int t = 0; t < CONCURRENT_THREADS; t++) {
+        void *result;
+        pthread_join(threads[t], &result);
+        if (result != NULL) all_ok = 0;
+    }
+
+    TEST_ASSERT(all_ok, "Every thread should read back its own writes");
+    TEST_ASSERT(get_list_length(STR("shared:list")) == CONCURRENT_THREADS * CONCURRENT_OPS,
+                "Concurrent pushes to one list should not be lost");
+    TEST_ASSERT(strcmp(get_type(STR("shared:list")), "list") == 0, "Shared key should be a list");
+    TEST_SUCCESS("Concurrent access test passed");
+}
+
+#define COUNTER_OPS 20000
+
+static void *counter_worker(void *arg) {
+    (void)arg;
+    long long value;
+    for (int i = 0; i < COUNTER_OPS; i++) increment_value(STR("shared:counter"), 1, &value);
+    return NULL;
+}
+
+//-- Lock-free GETs racing in-place increments always see a whole number --//
+static void *counter_reader(void *arg) {
+    int *torn = arg;
+    for (int i = 0; i < COUNTER_OPS; i++) {
+        epoch_enter();
+        const char *got = get_str("shared:counter");
+        if (got) {
+            char *end;
+            long long v = strtoll(got, &end, 10);
+            if (*end != '\0' || v < 0 || v > CONCURRENT_THREADS * COUNTER_OPS) *torn = 1;
+        }
+        epoch_exit();
+    }
+    return NULL;
+}
+
+void test_concurrent_counters() {
+    printf("Testing concurrent increments...\n");
+
+    pthread_t writers[CONCURRENT_THREADS], reader;
+    int torn = 0;
+    pthread_create(&reader, NULL, counter_reader, &torn);
+    for (int i = 0; i < CONCURRENT_THREADS; i++) pthread_create(&writers[i], NULL, counter_worker, NULL);
+    for (int i = 0; i < CONCURRENT_THREADS; i++) pthread_join(writers[i], NULL);
+    pthread_join(reader, NULL);
+
+    long long value;
+    increment_value(STR("shared:counter"), 0, &value);
+    TEST_ASSERT(value == CONCURRENT_THREADS * COUNTER_OPS, "No increment should be lost");
+    TEST_ASSERT(!torn, "Readers should only see whole values");
+    delete_key(STR("shared:counter"));
+    TEST_SUCCESS("Concurrent counter test passed");
+}
+
+//-- Two keys on different shards, always MSET together --//
+static char pair_keys[2][32];
+static size_t pair_lens[2];
+
+static void *pair_writer(void *arg) {
+    (void)arg;
+    char value[INT_TEXT_MAX];
+    for (int i = 0; i < COUNTER_OPS; i++) {
+        snprintf(value, sizeof(value), "%d", i);
+        char *pairs[] = { pair_keys[0], value, pair_keys[1], value };
+        size_t lens[] = { pair_lens[0], strlen(value), pair_lens[1], strlen(value) };
+        set_values(pairs, lens, 2, 0);
+    }
+    return NULL;
+}
+
+static void *pair_reader(void *arg) {
+    int *split = arg;
+    char *keys[] = { pair_keys[0], pair_keys[1] };
+    for (int i = 0; i < COUNTER_OPS; i++) {
+        StringValue values[2];
+        epoch_enter();
+        get_values(keys, pair_lens, 2, values);
+        if (values[0].len != values[1].len || memcmp(values[0].value, values[1].value, values[0].len) != 0) {
+            *split = 1;
+        }
+        epoch_exit();
+    }
+    return NULL;
+}
+
+void test_mset_atomicity() {
+    printf("Testing that MGET never sees half of an MSET...\n");
+
+    snprintf(pair_keys[0], sizeof(pair_keys[0]), "pair:a");
+    int shard = keyspace_shard_of(STR(pair_keys[0]));
+    for (int n = 0; ; n++) {
+        snprintf(pair_keys[1], sizeof(pair_keys[1]), "pair:b%d", n);
+        if (keyspace_shard_of(STR(pair_keys[1])) != shard) break;
+    }
+    pair_lens[0] = strlen(pair_keys[0]);
+    pair_lens[1] = strlen(pair_keys[1]);
+    char *pairs[] = { pair_keys[0], "start", pair_keys[1], "start" };
+    size_t lens[] = { pair_lens[0], 5, pair_lens[1], 5 };
+    set_values(pairs, lens, 2, 0);
+
+    pthread_t writer, readers[2];
+    int split = 0;
+    pthread_create(&writer, NULL, pair_writer, NULL);
+    for (int i = 0; i < 2; i++) pthread_create(&readers[i], NULL, pair_reader, &split);
+    pthread_join(writer, NULL);
+    for (int i = 0; i < 2; i++) pthread_join(readers[i], NULL);
+
+    TEST_ASSERT(!split, "Both keys should always read the same value");
+    delete_key(pair_keys[0], pair_lens[0]);
+    delete_key(pair_keys[1], pair_lens[1]);
+    TEST_SUCCESS("MSET atomicity test passed");
+}
+
+void test_siphash_vectors() {
+    printf("Testing SipHash-1-3 reference vectors...\n");
+
+    uint8_t key[SIPHASH_KEY_BYTES];
+    uint8_t msg[15];
+    for (int i = 0; i < SIPHASH_KEY_BYTES; i++) key[i] = (uint8_t)i;
+    for (int i = 0; i < 15; i++) msg[i] = (uint8_t)i;
+
+    TEST_ASSERT(siphash("", 0, key) == 0xabac0158050fc4dcULL, "Empty input should match reference");
+    TEST_ASSERT(siphash(msg, sizeof(msg), key) == 0xd320d86d2a519956ULL, "15-byte input should match reference");
+    TEST_ASSERT(siphash("user:12345", 10, key) == 0x98733499bc8d8c3eULL, "Key-shaped input should match reference");
+
+    //-- A different seed must move keys around --//
+    uint8_t other[SIPHASH_KEY_BYTES] = {0};
+    TEST_ASSERT(siphash("user:12345", 10, other) != siphash("user:12345", 10, key), "Seed should change the hash");
+    TEST_SUCCESS("SipHash vector test passed");
+}
+
+#define STRESS_KEYS    64
+#define STRESS_WRITERS 2
+#define STRESS_READERS 3
+#define STRESS_MILLIS  500
+
+static atomic_int stress_running;
+
+/**
+ * Values are "<key>=<n>" padded with the digit n % 10, so a reader can
+ * tell a torn or freed value from a stale but intact one.
+ */
+static void stress_value(char *buf, size_t size, const char *key, unsigned n) {
+    int len = snprintf(buf, size, "%s=%u:", key, n);
+    memset(buf + len, '0' + n % 10, 40);
+    buf[len + 40] = '\0';
+}
+
+static int stress_value_ok(const char *key, const char *value) {
+    size_t klen = strlen(key);
+    if (strncmp(value, key, klen) != 0 || value[klen] != '=') return 0;
+    char *colon;
+    unsigned long n = strtoul(value + klen + 1, &colon, 10);
+    if (*colon != ':' || strlen(colon + 1) != 40) return 0;
+    for (const char *p = colon + 1; *p; p++) {
+        if (*p != (char)('0' + n % 10)) return 0;
+    }
+    return 1;
+}
+
+static void *stress_writer(void *arg) {
+    unsigned seed = (unsigned)(long)arg;
+    char key[32], value[96];
+    char *push[1] = { value };
+
+    for (unsigned n = 0; atomic_load(&stress_running); n++) {
+        snprintf(key, sizeof(key), "stress:%u", rand_r(&seed) % STRESS_KEYS);
+        switch (rand_r(&seed) % 8) {
+        case 0:
+            delete_key(STR(key));
+            break;
+        case 1:
+            //-- Flip the key to a list so readers also see type changes --//
+            delete_key(STR(key));
+            stress_value(value, sizeof(value), key, n);
+            size_t push_len[1] = { strlen(value) };
+            push_list_values(STR(key), push, push_len, 1, 0);
+            break;
+        default:
+            stress_value(value, sizeof(value), key, n);
+            set_value(STR(key), STR(value), 0);
+        }
+    }
+    return NULL;
+}
+
+static void *stress_reader(void *arg) {
+    unsigned seed = (unsigned)(long)arg;
+    char key[32];
+    long bad = 0;
+
+    while (atomic_load(&stress_running)) {
+        snprintf(key, sizeof(key), "stress:%u", rand_r(&seed) % STRESS_KEYS);
+        epoch_enter();
+        const char *value = get_str(key);
+        if (value && !stress_value_ok(key, value)) bad++;
+        epoch_exit();
+    }
+    return (void *)bad;
+}
+
+void test_lockfree_get_stress() {
+    printf("Testing lock-free GET against concurrent writers...\n");
+
+    pthread_t writers[STRESS_WRITERS], readers[STRESS_READERS];
+    atomic_store(&stress_running, 1);
+    for (long t = 0; t < STRESS_WRITERS; t++) {
+        pthread_create(&writers[t], NULL, stress_writer, (void *)(t + 1));
+    }
+    for (long t = 0; t < STRESS_READERS; t++) {
+        pthread_create(&readers[t], NULL, stress_reader, (void *)(t + 100));
+    }
+
+    usleep(STRESS_MILLIS * 1000);
+    atomic_store(&stress_running, 0);
+
+    long bad = 0;
+    for (int t = 0; t < STRESS_WRITERS; t++) pthread_join(writers[t], NULL);
+    for (int t = 0; t < STRESS_READERS; t++) {
+        void *result;
+        pthread_join(readers[t], &result);
+        bad += (long)result;
+    }
+
+    TEST_ASSERT(bad == 0, "Readers should never see a torn or freed value");
+    TEST_SUCCESS("Lock-free GET stress test passed");
+}
+
 int main() {
     init_test_framework();
     printf("=== Hash Table Tests ===\n");
     
     test_basic_set_get();
     test_key_expiry();
+    test_active_expire();
     test_key_overwrite();
+    test_embedded_values();
+    test_integer_values();
+    test_multi_key_values();
     test_nonexistent_key();
+    test_resize_and_rehash();
+    test_concurrent_access();
+    test_concurrent_counters();
+    test_mset_atomicity();
+    test_lockfree_get_stress();
+    test_siphash_vectors();
     
     save_test_results();
     return total_tests_failed > 0 ? 1 : 0;
@@ -5,12 +5,14 @@
  * 
  * File                      : tests/test_list.c
  * Module                    : List Operations Unit Tests
- * Last Updating Author      : sch0penheimer
- * Last Update               : 2025/31/07
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
  * Version                   : 1.0.0
  *
  * Description:
- *  Unit tests for list operations including RPUSH, LPUSH, LRANGE, LLEN.
+ *  Unit tests for list operations including RPUSH, LPUSH, LRANGE, LLEN,
+ *  pops from both ends, index access and in-place edits (LINDEX, LSET,
+ *  LINSERT, LTRIM, LREM, LPOS), and the packed node encoding with compression.
  * 
  * Copyright (c) 2025 MemoraDB Project
  * =====================================================
@@ -93,6 +95,404 @@ void test_lrange_operations() {
     TEST_SUCCESS("LRANGE operations test passed");
 }
 
+void test_pop_both_ends() {
+    printf("Testing pops from both ends...\n");
+
+    List *list = list_create();
+    list_rpush(list, "a");
+    list_rpush(list, "b");
+    list_rpush(list, "c");
+    list_lpush(list, "z");
+
+    char *tail = list_pop(list, LIST_TAIL, NULL);
+    char *head = list_pop(list, LIST_HEAD, NULL);
+    TEST_ASSERT(strcmp(tail, "c") == 0, "Tail pop should return the last element");
+    TEST_ASSERT(strcmp(head, "z") == 0, "Head pop should return the first element");
+    TEST_ASSERT(list_length(list) == 2, "Two elements should remain");
+    free(tail);
+    free(head);
+
+    int count;
+    char **popped = list_pop_multiple(list, LIST_TAIL, 5, &count);
+    TEST_ASSERT(count == 2, "Multiple pop should stop at the list length");
+    TEST_ASSERT(strcmp(popped[0], "b") == 0 && strcmp(popped[1], "a") == 0,
+                "Tail pops should come nearest first");
+    TEST_ASSERT(list->head == NULL && list->tail == NULL, "Emptied list should have no ends");
+    TEST_ASSERT(list_pop(list, LIST_TAIL, NULL) == NULL, "Pop from an empty list should return NULL");
+    free(popped[0]);
+    free(popped[1]);
+    free(popped);
+
+    //-- Elements are binary safe: the length comes back with the copy --//
+    list_push(list, LIST_TAIL, "n\0ul", 4);
+    size_t len;
+    char *binary = list_pop(list, LIST_HEAD, &len);
+    TEST_ASSERT(binary && len == 4 && memcmp(binary, "n\0ul", 4) == 0 && binary[4] == '\0',
+                "Pop should return every byte and the length");
+    free(binary);
+
+    //-- Ends stay consistent after being emptied --//
+    list_lpush(list, "x");
+    list_rpush(list, "y");
+    char **range = list_range(list, 0, -1, &count);
+    TEST_ASSERT(count == 2 && strcmp(range[0], "x") == 0 && strcmp(range[1], "y") == 0,
+                "Pushes after emptying should link both ends");
+    free(range[0]);
+    free(range[1]);
+    free(range);
+    list_free(list);
+
+    TEST_SUCCESS("Pop both ends test passed");
+}
+
+void test_packed_nodes() {
+    printf("Testing packed nodes and compression...\n");
+    char value[32], big[1000];
+
+    //-- Small nodes and one raw node per end, so the list spans many compressed nodes --//
+    list_configure(128, 1);
+    List *list = list_create();
+    for (int i = 0; i < 2000; i++) {
+        snprintf(value, sizeof(value), "value-%04d", i);
+        list_rpush(list, value);
+    }
+    for (int i = 0; i < 100; i++) {
+        snprintf(value, sizeof(value), "head-%d", i);
+        list_lpush(list, value);
+    }
+    TEST_ASSERT(list_length(list) == 2100, "Length should count every push");
+    TEST_ASSERT(list->nodes > 100, "Elements should be spread over many nodes");
+
+    size_t compressed = 0;
+    for (ListNode *node = list->head; node; node = node->next) {
+        if (node->compressed) compressed++;
+    }
+    TEST_ASSERT(compressed > list->nodes / 2, "Interior nodes should be compressed");
+    TEST_ASSERT(!list->head->compressed && !list->tail->compressed, "End nodes should stay raw");
+
+    int count;
+    char **range = list_range(list, 1000, 1009, &count);
+    TEST_ASSERT(count == 10 && strcmp(range[0], "value-0900") == 0 && strcmp(range[9], "value-0909") == 0,
+                "LRANGE should read through compressed nodes");
+    for (int i = 0; i < count; i++) free(range[i]);
+    free(range);
+    range = list_range(list, -2, -1, &count);
+    TEST_ASSERT(count == 2 && strcmp(range[1], "value-1999") == 0, "Negative ranges should start from the tail");
+    for (int i = 0; i < count; i++) free(range[i]);
+    free(range);
+
+    //-- An element larger than a node gets one of its own --//
+    memset(big, 'b', sizeof(big) - 1);
+    big[sizeof(big) - 1] = '\0';
+    list_rpush(list, big);
+    char *popped = list_pop(list, LIST_TAIL, NULL);
+    TEST_ASSERT(popped && strcmp(popped, big) == 0, "An oversized element should come back intact");
+    free(popped);
+
+    //-- Drain from both ends through every node --//
+    int in_order = 1;
+    for (int i = 99; i >= 0; i--) {
+        popped = list_pop(list, LIST_HEAD, NULL);
+        snprintf(value, sizeof(value), "head-%d", i);
+        in_order &= popped && strcmp(popped, value) == 0;
+        free(popped);
+    }
+    for (int i = 1999; i >= 0; i--) {
+        popped = list_pop(list, LIST_TAIL, NULL);
+        snprintf(value, sizeof(value), "value-%04d", i);
+        in_order &= popped && strcmp(popped, value) == 0;
+        free(popped);
+    }
+    TEST_ASSERT(in_order, "Pops should return every element in order");
+    TEST_ASSERT(list->nodes == 0 && list_length(list) == 0, "A drained list should hold no node");
+
+    list_free(list);
+    list_configure(LIST_NODE_BYTES_DEFAULT, LIST_COMPRESS_DEPTH_DEFAULT);
+    TEST_SUCCESS("Packed nodes test passed");
+}
+
+/**
+ * Check list contents against an expected array of numbers.
+ */
+static int list_matches(List *list, const int *expected, int n) {
+    int count;
+    char value[32];
+    char **range = list_range(list, 0, -1, &count);
+    int same = count == n && list_length(list) == (size_t)n;
+    for (int i = 0; i < count; i++) {
+        snprintf(value, sizeof(value), "%d", i < n ? expected[i] : -1);
+        same &= strcmp(range[i], value) == 0;
+        free(range[i]);
+    }
+    free(range);
+    return same;
+}
+
+void test_index_and_set() {
+    printf("Testing LINDEX and LSET...\n");
+    char value[32];
+
+    list_configure(128, 1);
+    List *list = list_create();
+    for (int i = 0; i < 1000; i++) {
+        snprintf(value, sizeof(value), "%d", i);
+        list_rpush(list, value);
+    }
+
+    char *element = list_index(list, 500);
+    TEST_ASSERT(element && strcmp(element, "500") == 0, "Index should reach through compressed nodes");
+    free(element);
+    element = list_index(list, -1);
+    TEST_ASSERT(element && strcmp(element, "999") == 0, "Negative index should count from the tail");
+    free(element);
+    TEST_ASSERT(list_index(list, 1000) == NULL && list_index(list, -1001) == NULL,
+                "Out of range indexes should return NULL");
+
+    //-- Grow and shrink an element inside a compressed node --//
+    TEST_ASSERT(list_set(list, 500, "a much longer replacement value", 31) == 1, "Set should succeed");
+    TEST_ASSERT(list_set(list, 501, "x", 1) == 1, "Shorter set should succeed");
+    TEST_ASSERT(list_set(list, 1000, "x", 1) == 0, "Set out of range should fail");
+    element = list_index(list, 500);
+    TEST_ASSERT(element && strcmp(element, "a much longer replacement value") == 0, "Set value should read back");
+    free(element);
+    element = list_index(list, 502);
+    TEST_ASSERT(element && strcmp(element, "502") == 0, "Neighbours of a set should be intact");
+    free(element);
+    TEST_ASSERT(list_length(list) == 1000, "Set should not change the length");
+
+    list_free(list);
+    list_configure(LIST_NODE_BYTES_DEFAULT, LIST_COMPRESS_DEPTH_DEFAULT);
+    TEST_SUCCESS("Index and set test passed");
+}
+
+void test_set_then_push() {
+    printf("Testing pushes into a node grown by LSET...\n");
+    char values[6][1801];
+
+    //-- Default node size: five values fill one node, the longer set grows it past the limit --//
+    List *list = list_create();
+    for (int i = 0; i < 5; i++) {
+        memset(values[i], 'a' + i, 1600);
+        values[i][1600] = '\0';
+        list_push(list, LIST_TAIL, values[i], 1600);
+    }
+    memset(values[0], 'S', 1800);
+    values[0][1800] = '\0';
+    TEST_ASSERT(list_set(list, 0, values[0], 1800) == 1, "Set should succeed");
+
+    //-- Room at the head, none at the tail: the push must slide the entries, not cut them --//
+    char *popped = list_pop(list, LIST_HEAD, NULL);
+    TEST_ASSERT(popped && strcmp(popped, values[0]) == 0, "The set value should pop intact");
+    free(popped);
+    memset(values[5], 'f', 1600);
+    values[5][1600] = '\0';
+    list_push(list, LIST_TAIL, values[5], 1600);
+
+    int intact = list_length(list) == 5;
+    for (int i = 0; i < 5; i++) {
+        char *element = list_index(list, i);
+        intact &= element && strcmp(element, values[i + 1]) == 0;
+        free(element);
+    }
+    TEST_ASSERT(intact, "Every element should read back byte for byte");
+
+    list_free(list);
+    TEST_SUCCESS("Set then push test passed");
+}
+
+void test_insert_split() {
+    printf("Testing LINSERT with node splits...\n");
+    char value[32];
+    int expected[600];
+
+    list_configure(128, 1);
+    List *list = list_create();
+    for (int i = 0; i < 500; i++) {
+        snprintf(value, sizeof(value), "%d", i * 10);
+        list_rpush(list, value);
+    }
+
+    //-- Insert next to every tenth element, into full nodes all over the list --//
+    int n = 0;
+    for (int i = 0; i < 500; i++) {
+        if (i % 10 == 0) expected[n++] = i * 10 - 1;
+        expected[n++] = i * 10;
+        if (i % 10 == 5) expected[n++] = i * 10 + 1;
+    }
+    int ok = 1;
+    for (int i = 0; i < 500; i += 10) {
+        char pivot[32];
+        snprintf(pivot, sizeof(pivot), "%d", i * 10);
+        snprintf(value, sizeof(value), "%d", i * 10 - 1);
+        ok &= list_insert(list, pivot, strlen(pivot), 0, value, strlen(value)) == 1;
+        snprintf(pivot, sizeof(pivot), "%d", (i + 5) * 10);
+        snprintf(value, sizeof(value), "%d", (i + 5) * 10 + 1);
+        ok &= list_insert(list, pivot, strlen(pivot), 1, value, strlen(value)) == 1;
+    }
+    TEST_ASSERT(ok, "Every insert should find its pivot");
+    TEST_ASSERT(list_matches(list, expected, n), "Inserts should land next to their pivots");
+    TEST_ASSERT(list_insert(list, "nope", 4, 0, "x", 1) == 0, "A missing pivot should insert nothing");
+
+    size_t compressed = 0;
+    for (ListNode *node = list->head; node; node = node->next) {
+        if (node->compressed) compressed++;
+    }
+    TEST_ASSERT(compressed > 0 && !list->head->compressed && !list->tail->compressed,
+                "Interior nodes should be compressed again after edits");
+
+    list_free(list);
+    list_configure(LIST_NODE_BYTES_DEFAULT, LIST_COMPRESS_DEPTH_DEFAULT);
+    TEST_SUCCESS("Insert split test passed");
+}
+
+void test_trim_and_remove() {
+    printf("Testing LTRIM and LREM...\n");
+    char value[32];
+    int expected[1000];
+
+    list_configure(128, 1);
+    List *list = list_create();
+    for (int i = 0; i < 1000; i++) {
+        snprintf(value, sizeof(value), "%d", i % 7);
+        list_rpush(list, value);
+    }
+
+    //-- Capped log: keep the middle, dropping whole nodes on both sides --//
+    list_trim(list, 100, -101);
+    int n = 0;
+    for (int i = 100; i < 900; i++) expected[n++] = i % 7;
+    TEST_ASSERT(list_matches(list, expected, n), "Trim should keep the requested range");
+    size_t nodes = 0;
+    for (ListNode *node = list->head; node; node = node->next) nodes++;
+    TEST_ASSERT(nodes == list->nodes, "Node count should follow trims");
+
+    //-- Remove the first two 3s, the last two 5s, then every 0 --//
+    TEST_ASSERT(list_remove(list, "3", 1, 2) == 2, "Remove from the head should stop at count");
+    TEST_ASSERT(list_remove(list, "5", 1, -2) == 2, "Remove from the tail should stop at count");
+    size_t zeros = 0;
+    for (int i = 0; i < n; i++) zeros += expected[i] == 0;
+    TEST_ASSERT(list_remove(list, "0", 1, 0) == zeros, "Remove with count 0 should remove every match");
+
+    int kept = 0, threes = 0, fives = 0;
+    for (int i = 0; i < n; i++) {
+        if (expected[i] == 3 && threes++ < 2) continue;
+        if (expected[i] == 0) continue;
+        expected[kept++] = expected[i];
+    }
+    for (int i = kept - 1; i >= 0; i--) {
+        if (expected[i] == 5 && fives++ < 2) {
+            memmove(&expected[i], &expected[i + 1], (size_t)(kept - i - 1) * sizeof(int));
+            kept--;
+        }
+    }
+    TEST_ASSERT(list_matches(list, expected, kept), "Removes should keep the other elements in order");
+
+    list_trim(list, 5, 1);
+    TEST_ASSERT(list_length(list) == 0 && list->nodes == 0, "An empty trim range should empty the list");
+
+    list_free(list);
+    list_configure(LIST_NODE_BYTES_DEFAULT, LIST_COMPRESS_DEPTH_DEFAULT);
+    TEST_SUCCESS("Trim and remove test passed");
+}
+
+void test_positions() {
+    printf("Testing LPOS...\n");
+    char value[32];
+
+    list_configure(128, 1);
+    List *list = list_create();
+    for (int i = 0; i < 1000; i++) {
+        snprintf(value, sizeof(value), "%d", i % 100);
+        list_rpush(list, value);
+    }
+
+    long found;
+    long *positions = list_positions(list, "42", 2, 1, 0, 0, &found);
+    TEST_ASSERT(found == 10 && positions[0] == 42 && positions[9] == 942, "All matches should be found in order");
+    free(positions);
+    positions = list_positions(list, "42", 2, -2, 3, 0, &found);
+    TEST_ASSERT(found == 3 && positions[0] == 842 && positions[2] == 642,
+                "A negative rank should skip matches from the tail");
+    free(positions);
+    positions = list_positions(list, "42", 2, 1, 0, 100, &found);
+    TEST_ASSERT(found == 1 && positions[0] == 42, "MAXLEN should bound the scan");
+    free(positions);
+    TEST_ASSERT(list_positions(list, "none", 4, 1, 0, 0, &found) == NULL && found == 0,
+                "A missing value should find nothing");
+
+    list_free(list);
+    list_configure(LIST_NODE_BYTES_DEFAULT, LIST_COMPRESS_DEPTH_DEFAULT);
+    TEST_SUCCESS("Positions test passed");
+}
+
+//-- Sink that checks elements arrive in order, as consecutive numbers --//
+typedef struct {
+    long begun;
+    long next;
+    int in_order;
+} CountingSink;
+
+static void counting_begin(void *ctx, size_t count) {
+    ((CountingSink *)ctx)->begun = (long)count;
+}
+
+static void counting_element(void *ctx, const char *value, size_t len) {
+    CountingSink *sink = ctx;
+    char expected[32];
+    snprintf(expected, sizeof(expected), "%ld", sink->next);
+    sink->in_order &= value && len == strlen(expected) && memcmp(value, expected, len) == 0;
+    sink->next++;
+}
+
+void test_sink_reads() {
+    printf("Testing range and pop sinks...\n");
+    char value[32];
+
+    list_configure(128, 1);
+    List *list = list_create();
+    for (int i = 0; i < 1000; i++) {
+        snprintf(value, sizeof(value), "%d", i);
+        list_rpush(list, value);
+    }
+
+    CountingSink counting = { -1, 250, 1 };
+    ListSink sink = { counting_begin, counting_element, &counting };
+    TEST_ASSERT(list_range_into(list, 250, -251, &sink) == 500, "Range should visit the interval");
+    TEST_ASSERT(counting.begun == 500 && counting.next == 750 && counting.in_order,
+                "Range should announce its count and stream elements in order");
+
+    counting = (CountingSink){ -1, 0, 1 };
+    TEST_ASSERT(list_range_into(list, 2000, 3000, &sink) == 0 && counting.begun == 0,
+                "An empty range should still announce a count");
+
+    counting = (CountingSink){ -1, 0, 1 };
+    TEST_ASSERT(list_pop_into(list, LIST_HEAD, 600, &sink) == 600, "Pop should stop at the count");
+    TEST_ASSERT(counting.begun == 600 && counting.in_order && list_length(list) == 400,
+                "Popped elements should stream nearest first");
+    counting = (CountingSink){ -1, 600, 1 };
+    TEST_ASSERT(list_pop_into(list, LIST_HEAD, 1000, &sink) == 400 && counting.begun == 400 && counting.in_order,
+                "Pop should stop at the list length");
+    TEST_ASSERT(list->nodes == 0, "A drained list should hold no node");
+
+    list_free(list);
+    list_configure(LIST_NODE_BYTES_DEFAULT, LIST_COMPRESS_DEPTH_DEFAULT);
+    TEST_SUCCESS("Sink reads test passed");
+}
+
+void test_packed_memory() {
+    printf("Testing packed list footprint...\n");
+
+    List *list = list_create();
+    for (int i = 0; i < 10000; i++) {
+        list_rpush(list, "item");
+    }
+    //-- A node-per-element layout needs at least a node and a string per element --//
+    TEST_ASSERT(list_memory(list) < 10000 * 8, "Packed elements should cost a few bytes each");
+    list_free(list);
+
+    TEST_SUCCESS("Packed footprint test passed");
+}
+
 int main() {
     init_test_framework();
     printf("=== List Operations Tests ===\n");
@@ -101,6 +501,15 @@ int main() {
     test_rpush_operations();
     test_lpush_operations();
     test_lrange_operations();
+    test_pop_both_ends();
+    test_packed_nodes();
+    test_packed_memory();
+    test_index_and_set();
+    test_set_then_push();
+    test_insert_split();
+    test_trim_and_remove();
+    test_positions();
+    test_sink_reads();
     
     save_test_results();
     return total_tests_failed > 0 ? 1 : 0;
@@ -0,0 +1,95 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : tests/test_lzf.c
+ * Module                    : LZF Compression Unit Tests
+ * Last Updating Author      : agent
+ * Last Update               : 10/17/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Unit tests for the LZF codec: round trips of repetitive and random
+ *  data, output bounds and rejection of corrupt images.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "../src/utils/lzf.h"
+#include "test_framework.h"
+
+#define LZF_TEST_BYTES 20000
+
+void test_lzf_round_trip() {
+    printf("Testing LZF round trips...\n");
+    static unsigned char input[LZF_TEST_BYTES], image[LZF_TEST_BYTES], output[LZF_TEST_BYTES];
+
+    //-- Packed-list-like data: short, similar elements --//
+    size_t len = 0;
+    for (int i = 0; len + 32 < sizeof(input); i++) {
+        len += snprintf((char *)input + len, 32, "%celement:%07d%c", 12, i, 12);
+    }
+    size_t size = lzf_compress(input, len, image, len);
+    TEST_ASSERT(size > 0 && size < len / 2, "Repetitive data should compress to less than half");
+    TEST_ASSERT(lzf_decompress(image, size, output, sizeof(output)) == len, "Expansion should restore the size");
+    TEST_ASSERT(memcmp(input, output, len) == 0, "Expansion should restore the bytes");
+
+    //-- One long run: back references overlapping their own output --//
+    memset(input, 'a', 1000);
+    size = lzf_compress(input, 1000, image, sizeof(image));
+    TEST_ASSERT(size > 0 && size < 40, "A run should collapse to a few back references");
+    TEST_ASSERT(lzf_decompress(image, size, output, sizeof(output)) == 1000 &&
+                memcmp(input, output, 1000) == 0, "A run should expand back");
+
+    //-- Random bytes do not shrink: every short input still round-trips with room to spare --//
+    srand(42);
+    for (size_t n = 1; n < 300; n++) {
+        for (size_t i = 0; i < n; i++) input[i] = (unsigned char)rand();
+        size = lzf_compress(input, n, image, sizeof(image));
+        if (size == 0 || lzf_decompress(image, size, output, n) != n || memcmp(input, output, n) != 0) {
+            TEST_ASSERT(0, "Random input should round-trip");
+            break;
+        }
+    }
+    TEST_SUCCESS("LZF round trip test passed");
+}
+
+void test_lzf_bounds() {
+    printf("Testing LZF output bounds and corrupt images...\n");
+    static unsigned char input[4096], image[8192], output[4096];
+
+    srand(7);
+    for (size_t i = 0; i < sizeof(input); i++) input[i] = (unsigned char)rand();
+    TEST_ASSERT(lzf_compress(input, sizeof(input), image, sizeof(input) - 8) == 0,
+                "Incompressible data should not fit in less room than it takes");
+    TEST_ASSERT(lzf_compress(input, 0, image, sizeof(image)) == 0, "Empty input should not compress");
+
+    memset(input, 'x', sizeof(input));
+    size_t size = lzf_compress(input, sizeof(input), image, sizeof(image));
+    TEST_ASSERT(lzf_decompress(image, size, output, 100) == 0, "Expansion should not overflow its output");
+
+    //-- A back reference before the start of the output --//
+    unsigned char bad[] = { 0x20, 0x05 };
+    TEST_ASSERT(lzf_decompress(bad, sizeof(bad), output, sizeof(output)) == 0,
+                "A reference before the output should be rejected");
+    //-- A literal run longer than the image --//
+    unsigned char truncated[] = { 0x1f, 'a', 'b' };
+    TEST_ASSERT(lzf_decompress(truncated, sizeof(truncated), output, sizeof(output)) == 0,
+                "A truncated literal run should be rejected");
+    TEST_SUCCESS("LZF bounds test passed");
+}
+
+int main() {
+    init_test_framework();
+    printf("=== LZF Compression Tests ===\n");
+
+    test_lzf_round_trip();
+    test_lzf_bounds();
+
+    save_test_results();
+    return total_tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : tests/test_minheap.c
+ * Module                    : Min-Heap Unit Tests
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Unit tests for the intrusive min-heap: ordering, removal of arbitrary
+ *  nodes and rescheduling in both directions.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include <stdlib.h>
+#include <limits.h>
+#include "../src/utils/minheap.h"
+#include "test_framework.h"
+
+#define HEAP_TEST_NODES 1000
+
+static int pops_in_order(MinHeap *heap, size_t expected) {
+    long long last = LLONG_MIN;
+    size_t popped = 0;
+    HeapNode *node;
+    while ((node = minheap_pop(heap))) {
+        if (node->key < last || heap_node_queued(node)) return 0;
+        last = node->key;
+        popped++;
+    }
+    return popped == expected;
+}
+
+void test_heap_ordering() {
+    printf("Testing min-heap ordering...\n");
+
+    MinHeap heap;
+    HeapNode nodes[HEAP_TEST_NODES];
+    minheap_init(&heap);
+    srand(42);
+    int scheduled = 1;
+    for (int i = 0; i < HEAP_TEST_NODES; i++) {
+        heap_node_init(&nodes[i]);
+        if (minheap_schedule(&heap, &nodes[i], rand() % 10000) != 0) scheduled = 0;
+    }
+    TEST_ASSERT(scheduled, "Scheduling should succeed");
+    TEST_ASSERT(minheap_size(&heap) == HEAP_TEST_NODES, "Every node should be queued");
+    TEST_ASSERT(pops_in_order(&heap, HEAP_TEST_NODES), "Nodes should pop in key order");
+    TEST_ASSERT(minheap_peek(&heap) == NULL, "Heap should be empty");
+
+    minheap_free(&heap);
+    TEST_SUCCESS("Min-heap ordering test passed");
+}
+
+void test_heap_remove_and_reschedule() {
+    printf("Testing min-heap removal and rescheduling...\n");
+
+    MinHeap heap;
+    HeapNode nodes[HEAP_TEST_NODES];
+    minheap_init(&heap);
+    for (int i = 0; i < HEAP_TEST_NODES; i++) {
+        heap_node_init(&nodes[i]);
+        minheap_schedule(&heap, &nodes[i], i);
+    }
+
+    //-- Remove every third node, move every fifth one to the far end or the front --//
+    size_t expected = HEAP_TEST_NODES;
+    for (int i = 0; i < HEAP_TEST_NODES; i++) {
+        if (i % 3 == 0) {
+            minheap_remove(&heap, &nodes[i]);
+            expected--;
+        } else if (i % 5 == 0) {
+            minheap_schedule(&heap, &nodes[i], (i % 2) ? -i : 100000 + i);
+        }
+    }
+    minheap_remove(&heap, &nodes[0]);   //- Removing twice is a no-op -//
+
+    //-- A replacement takes over the node's slot and deadline --//
+    HeapNode stand_in;
+    heap_node_init(&stand_in);
+    long long key = nodes[7].key;
+    minheap_replace(&heap, &nodes[7], &stand_in);
+    TEST_ASSERT(!heap_node_queued(&nodes[7]) && heap_node_queued(&stand_in) && stand_in.key == key,
+                "A replaced node should hand its place to the new one");
+
+    TEST_ASSERT(!heap_node_queued(&nodes[3]), "Removed node should not be queued");
+    TEST_ASSERT(minheap_peek(&heap)->key < 0, "A node moved to the front should be the minimum");
+    TEST_ASSERT(minheap_size(&heap) == expected, "Size should account for removals");
+    TEST_ASSERT(pops_in_order(&heap, expected), "Order should survive removals and reschedules");
+
+    minheap_free(&heap);
+    TEST_SUCCESS("Min-heap removal and rescheduling test passed");
+}
+
+int main() {
+    init_test_framework();
+    printf("=== Min-Heap Tests ===\n");
+
+    test_heap_ordering();
+    test_heap_remove_and_reschedule();
+
+    save_test_results();
+    return total_tests_failed > 0 ? 1 : 0;
+}
@@ -5,8 +5,8 @@
  * 
  * File                      : tests/test_parser.c
  * Module                    : RESP Parser Unit Tests
- * Last Updating Author      : sch0penheimer
- * Last Update               : 2025/31/07
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
  * Version                   : 1.0.0
  *
  * Description:
@@ -16,9 +16,11 @@
  * =====================================================
  */
 
+#define _GNU_SOURCE
 #include <assert.h>
 #include <string.h>
 #include "../src/parser/parser.h"
+#include "../src/utils/hashTable.h"
 #include "test_framework.h"
 
 void test_command_parsing() {
@@ -60,6 +62,419 @@ void test_invalid_resp_format() {
     TEST_SUCCESS("Invalid RESP format test passed");
 }
 
+void test_incremental_parsing() {
+    printf("Testing request split across reads...\n");
+
+    char input[] = "*3\r\n$3\r\nSET\r\n$3\r\nkey\r\n$5\r\nvalue\r\n";
+    size_t total = strlen(input);
+    RequestParser parser;
+    request_parser_init(&parser, 16);
+
+    //-- Feed the request one byte at a time, as if every byte was its own TCP segment --//
+    size_t consumed = 0;
+    request_parse_t r = REQUEST_PARSE_INCOMPLETE;
+    size_t available;
+    for (available = 1; available <= total; available++) {
+        r = request_parser_parse(&parser, input, available, &consumed);
+        if (r != REQUEST_PARSE_INCOMPLETE) break;
+    }
+
+    TEST_ASSERT(r == REQUEST_PARSE_OK, "Split request should parse once complete");
+    TEST_ASSERT(available == total, "Request should only complete on its last byte");
+    TEST_ASSERT(consumed == total, "Whole request should be consumed");
+    TEST_ASSERT(parser.argc == 3, "Expected 3 arguments");
+    TEST_ASSERT(strcmp(parser.argv[0], "SET") == 0, "First argument should be SET");
+    TEST_ASSERT(strcmp(parser.argv[2], "value") == 0, "Third argument should be value");
+
+    request_parser_free(&parser);
+    TEST_SUCCESS("Incremental parsing test passed");
+}
+
+void test_pipelined_parsing() {
+    printf("Testing pipelined requests...\n");
+
+    char input[] = "*1\r\n$4\r\nPING\r\n*2\r\n$4\r\nECHO\r\n$2\r\nhi\r\n*2\r\n$3\r\nGET";
+    size_t len = strlen(input);
+    RequestParser parser;
+    request_parser_init(&parser, 16);
+
+    size_t start = 0, consumed = 0;
+    int executed = 0;
+    while (request_parser_parse(&parser, input + start, len - start, &consumed) == REQUEST_PARSE_OK) {
+        executed++;
+        if (executed == 2) {
+            TEST_ASSERT(strcmp(parser.argv[1], "hi") == 0, "Second request argument should be hi");
+        }
+        request_parser_reset(&parser);
+        start += consumed;
+    }
+
+    TEST_ASSERT(executed == 2, "Both complete requests should be parsed");
+    TEST_ASSERT(strncmp(input + start, "*2", 2) == 0, "Partial trailing request should be left over");
+
+    request_parser_free(&parser);
+    TEST_SUCCESS("Pipelined parsing test passed");
+}
+
+void test_request_limits() {
+    printf("Testing request argument limit...\n");
+
+    char input[] = "*3\r\n$1\r\na\r\n$1\r\nb\r\n$1\r\nc\r\n";
+    RequestParser parser;
+    request_parser_init(&parser, 2);
+
+    size_t consumed = 0;
+    TEST_ASSERT(request_parser_parse(&parser, input, strlen(input), &consumed) == REQUEST_PARSE_ERROR,
+                "Request above the argument limit should be rejected");
+
+    request_parser_free(&parser);
+    TEST_SUCCESS("Request argument limit test passed");
+}
+
+/**
+ * Run a space-separated command through dispatch_command and return the
+ * reply text, which always fits the reply's static chunk here.
+ */
+static const char *run_command(const char *line) {
+    static char out[REPLY_STATIC_BYTES + 1];
+    char copy[256];
+    char *tokens[16];
+    size_t lens[16];
+    int count = 0;
+
+    strncpy(copy, line, sizeof(copy) - 1);
+    copy[sizeof(copy) - 1] = '\0';
+    for (char *tok = strtok(copy, " "); tok && count < 16; tok = strtok(NULL, " ")) {
+        lens[count] = strlen(tok);
+        tokens[count++] = tok;
+    }
+
+    ReplyBuffer reply;
+    reply_init(&reply);
+    dispatch_command(&reply, tokens, lens, count);
+    memcpy(out, reply.buf, reply.bufpos);
+    out[reply.bufpos] = '\0';
+    reply_free(&reply);
+    return out;
+}
+
+/**
+ * Parse one RESP request and dispatch it, for arguments holding bytes
+ * that run_command() cannot express.
+ * @param reply_len Set to the reply size
+ */
+static const char *run_request(const char *request, size_t len, size_t *reply_len) {
+    static char out[REPLY_STATIC_BYTES];
+    char buf[256];
+    memcpy(buf, request, len);
+
+    RequestParser parser;
+    request_parser_init(&parser, 16);
+    size_t consumed;
+    *reply_len = 0;
+    if (request_parser_parse(&parser, buf, len, &consumed) == REQUEST_PARSE_OK) {
+        ReplyBuffer reply;
+        reply_init(&reply);
+        dispatch_command(&reply, parser.argv, parser.argv_len, parser.argc);
+        memcpy(out, reply.buf, reply.bufpos);
+        *reply_len = reply.bufpos;
+        reply_free(&reply);
+    }
+    request_parser_free(&parser);
+    return out;
+}
+
+//-- Compares a reply with a literal that may contain NULs --//
+#define REPLY_IS(reply, len, literal) ((len) == sizeof(literal) - 1 && memcmp((reply), (literal), (len)) == 0)
+
+void test_ttl_commands() {
+    printf("Testing TTL command family...\n");
+
+    TEST_ASSERT(strcmp(run_command("TTL ttl:missing"), ":-2\r\n") == 0, "TTL of a missing key should be -2");
+    run_command("SET ttl:a v");
+    TEST_ASSERT(strcmp(run_command("TTL ttl:a"), ":-1\r\n") == 0, "TTL without a deadline should be -1");
+
+    TEST_ASSERT(strcmp(run_command("EXPIRE ttl:a 100"), ":1\r\n") == 0, "EXPIRE should set a deadline");
+    TEST_ASSERT(strcmp(run_command("TTL ttl:a"), ":100\r\n") == 0, "TTL should report seconds left");
+    long long pttl = atoll(run_command("PTTL ttl:a") + 1);
+    TEST_ASSERT(pttl > 99000 && pttl <= 100000, "PTTL should report milliseconds left");
+    TEST_ASSERT(strcmp(run_command("GET ttl:a"), "$1\r\nv\r\n") == 0, "EXPIRE should not touch the value");
+
+    TEST_ASSERT(strcmp(run_command("EXPIRE ttl:a 50 GT"), ":0\r\n") == 0, "GT should refuse an earlier deadline");
+    TEST_ASSERT(strcmp(run_command("EXPIRE ttl:a 50 LT"), ":1\r\n") == 0, "LT should accept an earlier deadline");
+    TEST_ASSERT(strcmp(run_command("EXPIRE ttl:a 500 NX"), ":0\r\n") == 0, "NX should refuse a key with a deadline");
+    TEST_ASSERT(strcmp(run_command("PERSIST ttl:a"), ":1\r\n") == 0, "PERSIST should drop the deadline");
+    TEST_ASSERT(strcmp(run_command("PERSIST ttl:a"), ":0\r\n") == 0, "PERSIST twice should report nothing removed");
+    TEST_ASSERT(strcmp(run_command("EXPIRE ttl:a 500 XX"), ":0\r\n") == 0, "XX should refuse a persistent key");
+    TEST_ASSERT(strcmp(run_command("EXPIRE ttl:missing 10"), ":0\r\n") == 0, "EXPIRE on a missing key should be 0");
+
+    TEST_ASSERT(strcmp(run_command("PEXPIREAT ttl:a 1000"), ":1\r\n") == 0, "A past Unix time should be accepted");
+    TEST_ASSERT(strcmp(run_command("GET ttl:a"), "$-1\r\n") == 0, "A past Unix time should delete the key");
+    TEST_ASSERT(strstr(run_command("EXPIRE ttl:a soon"), "not an integer") != NULL, "Non-numeric time should be rejected");
+
+    TEST_SUCCESS("TTL command family test passed");
+}
+
+void test_set_options() {
+    printf("Testing SET options...\n");
+
+    TEST_ASSERT(strcmp(run_command("SET opt:a 1 XX"), "$-1\r\n") == 0, "XX should not create a key");
+    TEST_ASSERT(strcmp(run_command("SET opt:a 1 NX"), "+OK\r\n") == 0, "NX should create a missing key");
+    TEST_ASSERT(strcmp(run_command("SET opt:a 2 NX"), "$-1\r\n") == 0, "NX should not overwrite");
+    TEST_ASSERT(strcmp(run_command("SET opt:a 3 XX GET"), "$1\r\n1\r\n") == 0, "GET should return the old value");
+    TEST_ASSERT(strcmp(run_command("GET opt:a"), "$1\r\n3\r\n") == 0, "XX should overwrite an existing key");
+
+    run_command("SET opt:a 4 EX 100");
+    TEST_ASSERT(strcmp(run_command("TTL opt:a"), ":100\r\n") == 0, "EX should set seconds");
+    run_command("SET opt:a 5 KEEPTTL");
+    TEST_ASSERT(strcmp(run_command("TTL opt:a"), ":100\r\n") == 0, "KEEPTTL should keep the deadline");
+    run_command("SET opt:a 6");
+    TEST_ASSERT(strcmp(run_command("TTL opt:a"), ":-1\r\n") == 0, "A plain SET should clear the deadline");
+
+    char line[64];
+    snprintf(line, sizeof(line), "SET opt:a 7 PXAT %lld", current_millis() + 100000);
+    run_command(line);
+    TEST_ASSERT(strcmp(run_command("TTL opt:a"), ":100\r\n") == 0, "PXAT should convert a Unix time to a deadline");
+
+    TEST_ASSERT(strstr(run_command("SET opt:a 1 EX 0"), "invalid expire time") != NULL, "EX 0 should be rejected");
+    TEST_ASSERT(strstr(run_command("SET opt:a 1 NX XX"), "syntax error") != NULL, "NX with XX should be rejected");
+    TEST_ASSERT(strstr(run_command("SET opt:a 1 EX 10 PX 10"), "syntax error") != NULL, "Two expiries should be rejected");
+
+    run_command("RPUSH opt:list x");
+    TEST_ASSERT(strstr(run_command("SET opt:list v GET"), "WRONGTYPE") != NULL, "GET on a list should be WRONGTYPE");
+    TEST_ASSERT(strcmp(run_command("TYPE opt:list"), "+list\r\n") == 0, "A WRONGTYPE SET must not overwrite");
+
+    TEST_SUCCESS("SET options test passed");
+}
+
+void test_blpop_without_client() {
+    printf("Testing BLPOP outside a client connection...\n");
+
+    //-- Nobody to park: an empty list answers at once, like a timeout --//
+    TEST_ASSERT(strcmp(run_command("BLPOP bl:q 0"), "$-1\r\n") == 0, "BLPOP without a client should not block");
+    run_command("RPUSH bl:q a b");
+    TEST_ASSERT(strcmp(run_command("BLPOP bl:q 5"), "*2\r\n$4\r\nbl:q\r\n$1\r\na\r\n") == 0,
+                "BLPOP should pop the head when the list has elements");
+
+    TEST_ASSERT(strstr(run_command("BLPOP bl:q -1"), "timeout is negative") != NULL, "Negative timeout should be rejected");
+    TEST_ASSERT(strstr(run_command("BLPOP bl:q soon"), "not a float") != NULL, "Non-numeric timeout should be rejected");
+    TEST_ASSERT(strcmp(run_command("LLEN bl:q"), ":1\r\n") == 0, "Rejected BLPOPs must not pop");
+
+    TEST_SUCCESS("BLPOP without client test passed");
+}
+
+void test_list_moves() {
+    printf("Testing BRPOP, LMOVE and LMPOP...\n");
+
+    run_command("RPUSH mv:a 1 2 3");
+    TEST_ASSERT(strcmp(run_command("BRPOP mv:none mv:a 0"), "*2\r\n$4\r\nmv:a\r\n$1\r\n3\r\n") == 0,
+                "BRPOP should pop the tail of the first non-empty list");
+
+    TEST_ASSERT(strcmp(run_command("LMOVE mv:a mv:b LEFT RIGHT"), "$1\r\n1\r\n") == 0,
+                "LMOVE should reply with the moved element");
+    TEST_ASSERT(strcmp(run_command("LRANGE mv:b 0 -1"), "*1\r\n$1\r\n1\r\n") == 0,
+                "LMOVE should create the destination list");
+    TEST_ASSERT(strcmp(run_command("LMOVE mv:none mv:b LEFT RIGHT"), "$-1\r\n") == 0,
+                "LMOVE from an empty list should reply null");
+    TEST_ASSERT(strstr(run_command("LMOVE mv:a mv:b UP RIGHT"), "syntax error") != NULL,
+                "LMOVE should reject an unknown direction");
+    run_command("SET mv:str x");
+    TEST_ASSERT(strstr(run_command("LMOVE mv:a mv:str LEFT LEFT"), "WRONGTYPE") != NULL,
+                "LMOVE onto a string should fail");
+    TEST_ASSERT(strcmp(run_command("LLEN mv:a"), ":1\r\n") == 0, "A failed LMOVE must not pop");
+
+    run_command("RPUSH mv:c x y z");
+    TEST_ASSERT(strcmp(run_command("LMPOP 2 mv:none mv:c RIGHT COUNT 2"),
+                       "*2\r\n$4\r\nmv:c\r\n*2\r\n$1\r\nz\r\n$1\r\ny\r\n") == 0,
+                "LMPOP should pop COUNT elements from the first non-empty list");
+    TEST_ASSERT(strcmp(run_command("BLMPOP 0 1 mv:none LEFT"), "$-1\r\n") == 0,
+                "BLMPOP without a client should not block");
+    TEST_ASSERT(strstr(run_command("LMPOP 0 mv:c LEFT"), "numkeys") != NULL, "LMPOP should reject numkeys 0");
+    TEST_ASSERT(strstr(run_command("LMPOP 3 mv:c LEFT"), "syntax error") != NULL,
+                "LMPOP should reject numkeys beyond the arguments");
+    TEST_ASSERT(strstr(run_command("LMPOP 1 mv:c LEFT COUNT 0"), "count") != NULL, "LMPOP should reject COUNT 0");
+
+    int first, last, step;
+    char *blmpop[] = { "BLMPOP", "0", "2", "k1", "k2", "LEFT" };
+    TEST_ASSERT(command_key_range(blmpop, 6, &first, &last, &step) && first == 3 && last == 4,
+                "BLMPOP keys should follow numkeys");
+    char *brpop[] = { "BRPOP", "k1", "k2", "k3", "0" };
+    TEST_ASSERT(command_key_range(brpop, 5, &first, &last, &step) && first == 1 && last == 3,
+                "BRPOP keys should exclude the timeout");
+
+    TEST_SUCCESS("List move test passed");
+}
+
+void test_list_editing() {
+    printf("Testing RPOP, LINDEX, LSET, LINSERT, LTRIM, LREM and LPOS...\n");
+
+    run_command("RPUSH ed:a a b c a b c");
+    TEST_ASSERT(strcmp(run_command("RPOP ed:a"), "$1\r\nc\r\n") == 0, "RPOP should pop the tail");
+    TEST_ASSERT(strcmp(run_command("RPOP ed:a 2"), "*2\r\n$1\r\nb\r\n$1\r\na\r\n") == 0,
+                "RPOP with a count should pop nearest first");
+    TEST_ASSERT(strcmp(run_command("RPOP ed:none"), "$-1\r\n") == 0, "RPOP of a missing key should reply null");
+
+    TEST_ASSERT(strcmp(run_command("LINDEX ed:a -1"), "$1\r\nc\r\n") == 0, "LINDEX should count from the tail");
+    TEST_ASSERT(strcmp(run_command("LINDEX ed:a 3"), "$-1\r\n") == 0, "LINDEX out of range should reply null");
+    TEST_ASSERT(strcmp(run_command("LSET ed:a 1 B"), "+OK\r\n") == 0, "LSET should reply OK");
+    TEST_ASSERT(strstr(run_command("LSET ed:a 9 x"), "index out of range") != NULL, "LSET should check the index");
+    TEST_ASSERT(strstr(run_command("LSET ed:none 0 x"), "no such key") != NULL, "LSET should need the key");
+
+    TEST_ASSERT(strcmp(run_command("LINSERT ed:a BEFORE B x"), ":4\r\n") == 0, "LINSERT should reply the length");
+    TEST_ASSERT(strcmp(run_command("LINSERT ed:a AFTER nope y"), ":-1\r\n") == 0,
+                "LINSERT without the pivot should reply -1");
+    TEST_ASSERT(strcmp(run_command("LINSERT ed:none AFTER a y"), ":0\r\n") == 0,
+                "LINSERT on a missing key should reply 0");
+    TEST_ASSERT(strcmp(run_command("LRANGE ed:a 0 -1"), "*4\r\n$1\r\na\r\n$1\r\nx\r\n$1\r\nB\r\n$1\r\nc\r\n") == 0,
+                "LSET and LINSERT should edit in place");
+
+    run_command("RPUSH ed:a a a");
+    TEST_ASSERT(strcmp(run_command("LPOS ed:a a"), ":0\r\n") == 0, "LPOS should find the first match");
+    TEST_ASSERT(strcmp(run_command("LPOS ed:a a RANK -1 COUNT 0"), "*3\r\n:5\r\n:4\r\n:0\r\n") == 0,
+                "LPOS with a negative rank should scan from the tail");
+    TEST_ASSERT(strcmp(run_command("LPOS ed:a a COUNT 2 MAXLEN 3"), "*1\r\n:0\r\n") == 0,
+                "LPOS should stop after MAXLEN elements");
+    TEST_ASSERT(strstr(run_command("LPOS ed:a a RANK 0"), "RANK can't be zero") != NULL, "LPOS should reject rank 0");
+    TEST_ASSERT(strcmp(run_command("LREM ed:a -1 a"), ":1\r\n") == 0, "LREM should count removals");
+    TEST_ASSERT(strcmp(run_command("LREM ed:a 0 a"), ":2\r\n") == 0, "LREM 0 should remove every match");
+
+    TEST_ASSERT(strcmp(run_command("LTRIM ed:a 1 -1"), "+OK\r\n") == 0, "LTRIM should reply OK");
+    TEST_ASSERT(strcmp(run_command("LRANGE ed:a 0 -1"), "*2\r\n$1\r\nB\r\n$1\r\nc\r\n") == 0,
+                "LTRIM should keep the range");
+    run_command("SET ed:str x");
+    TEST_ASSERT(strstr(run_command("LTRIM ed:str 0 1"), "WRONGTYPE") != NULL, "LTRIM of a string should fail");
+    TEST_ASSERT(strstr(run_command("LINDEX ed:str 0"), "WRONGTYPE") != NULL, "LINDEX of a string should fail");
+    TEST_ASSERT(strstr(run_command("LRANGE ed:str 0 -1"), "WRONGTYPE") != NULL, "LRANGE of a string should fail");
+    TEST_ASSERT(strstr(run_command("LPOP ed:str"), "WRONGTYPE") != NULL, "LPOP of a string should fail");
+    TEST_ASSERT(strcmp(run_command("LPOP ed:none 3"), "*0\r\n") == 0, "LPOP with a count of a missing key should reply empty");
+    TEST_ASSERT(strcmp(run_command("LRANGE ed:none 0 -1"), "*0\r\n") == 0, "LRANGE of a missing key should reply empty");
+
+    TEST_SUCCESS("List editing test passed");
+}
+
+void test_counter_commands() {
+    printf("Testing INCR, DECR, INCRBY, DECRBY and INCRBYFLOAT...\n");
+
+    TEST_ASSERT(strcmp(run_command("INCR ctr:a"), ":1\r\n") == 0, "INCR of a missing key should reply 1");
+    TEST_ASSERT(strcmp(run_command("INCRBY ctr:a 41"), ":42\r\n") == 0, "INCRBY should add");
+    TEST_ASSERT(strcmp(run_command("DECR ctr:a"), ":41\r\n") == 0, "DECR should subtract one");
+    TEST_ASSERT(strcmp(run_command("DECRBY ctr:a 50"), ":-9\r\n") == 0, "DECRBY should go negative");
+    TEST_ASSERT(strcmp(run_command("GET ctr:a"), "$2\r\n-9\r\n") == 0, "GET should render the counter");
+    TEST_ASSERT(strstr(run_command("INCRBY ctr:a x"), "not an integer") != NULL, "INCRBY should need an integer");
+    TEST_ASSERT(strstr(run_command("DECRBY ctr:a -9223372036854775808"), "decrement would overflow") != NULL,
+                "Negating the smallest integer should be refused");
+
+    run_command("SET ctr:max 9223372036854775807");
+    TEST_ASSERT(strstr(run_command("INCR ctr:max"), "would overflow") != NULL, "INCR should refuse to overflow");
+    run_command("SET ctr:text 007");
+    TEST_ASSERT(strstr(run_command("INCR ctr:text"), "not an integer") != NULL, "INCR should refuse non-canonical text");
+    TEST_ASSERT(strcmp(run_command("GET ctr:text"), "$3\r\n007\r\n") == 0, "Non-canonical text should stay as set");
+    run_command("RPUSH ctr:list x");
+    TEST_ASSERT(strstr(run_command("INCR ctr:list"), "WRONGTYPE") != NULL, "INCR of a list should fail");
+
+    run_command("SET ctr:f 10.50");
+    TEST_ASSERT(strcmp(run_command("INCRBYFLOAT ctr:f 0.1"), "$4\r\n10.6\r\n") == 0, "INCRBYFLOAT should add");
+    TEST_ASSERT(strcmp(run_command("INCRBYFLOAT ctr:f -5.6"), "$1\r\n5\r\n") == 0, "A whole result should drop the point");
+    TEST_ASSERT(strcmp(run_command("INCR ctr:f"), ":6\r\n") == 0, "A whole float result should count again");
+    TEST_ASSERT(strstr(run_command("INCRBYFLOAT ctr:f abc"), "not a valid float") != NULL,
+                "INCRBYFLOAT should need a number");
+    TEST_ASSERT(strstr(run_command("INCRBYFLOAT ctr:f inf"), "not a valid float") != NULL,
+                "INCRBYFLOAT should refuse infinity");
+    TEST_ASSERT(strstr(run_command("INCRBYFLOAT ctr:text 1"), "$1\r\n8\r\n") != NULL, "Text numbers should take floats");
+
+    TEST_SUCCESS("Counter command test passed");
+}
+
+#define BATCH_KEYS 3000
+
+void test_batch_commands() {
+    printf("Testing MGET, MSET and MSETNX...\n");
+
+    TEST_ASSERT(strcmp(run_command("MSET b:1 one b:2 2 b:3 three"), "+OK\r\n") == 0, "MSET should reply OK");
+    TEST_ASSERT(strcmp(run_command("MGET b:1 b:missing b:2 b:3"),
+                       "*4\r\n$3\r\none\r\n$-1\r\n$1\r\n2\r\n$5\r\nthree\r\n") == 0,
+                "MGET should answer every key in order");
+    TEST_ASSERT(strstr(run_command("MSET b:1 one b:2"), "wrong number of arguments") != NULL,
+                "MSET should need pairs");
+    TEST_ASSERT(strstr(run_command("MGET"), "wrong number of arguments") != NULL, "MGET should need a key");
+    TEST_ASSERT(strcmp(run_command("MSETNX b:4 four b:1 uno"), ":0\r\n") == 0, "MSETNX should refuse an existing key");
+    TEST_ASSERT(strcmp(run_command("MGET b:4 b:1"), "*2\r\n$-1\r\n$3\r\none\r\n") == 0,
+                "A refused MSETNX should store nothing");
+    TEST_ASSERT(strcmp(run_command("MSETNX b:4 four b:5 five"), ":1\r\n") == 0, "MSETNX should store new keys");
+    run_command("RPUSH b:list x");
+    TEST_ASSERT(strcmp(run_command("MGET b:list b:5"), "*2\r\n$-1\r\n$4\r\nfive\r\n") == 0,
+                "MGET should read a list as nil");
+
+    int first, last, step;
+    char *mset[] = { "MSET", "k1", "v1", "k2", "v2" };
+    TEST_ASSERT(command_key_range(mset, 5, &first, &last, &step) && first == 1 && last == 3 && step == 2,
+                "MSET keys should skip the values");
+
+    //-- Far more arguments than the old 16-token cap, arriving in two reads --//
+    size_t cap = 24 * BATCH_KEYS + 64, len = 0;
+    char *request = malloc(cap);
+    len += snprintf(request + len, cap - len, "*%d\r\n$4\r\nMGET\r\n", BATCH_KEYS + 1);
+    for (int i = 0; i < BATCH_KEYS; i++) {
+        char key[16];
+        int key_len = snprintf(key, sizeof(key), "b:many%d", i);
+        len += snprintf(request + len, cap - len, "$%d\r\n%s\r\n", key_len, key);
+    }
+    run_command("SET b:many2999 z");
+
+    RequestParser parser;
+    request_parser_init(&parser, 1024 * 1024);
+    size_t consumed;
+    TEST_ASSERT(request_parser_parse(&parser, request, len / 2, &consumed) == REQUEST_PARSE_INCOMPLETE,
+                "Half a request should be incomplete");
+    TEST_ASSERT(request_parser_parse(&parser, request, len, &consumed) == REQUEST_PARSE_OK &&
+                parser.argc == BATCH_KEYS + 1, "Every argument should be parsed");
+
+    ReplyBuffer reply;
+    reply_init(&reply);
+    dispatch_command(&reply, parser.argv, parser.argv_len, parser.argc);
+    TEST_ASSERT(memcmp(reply.buf, "*3000\r\n$-1\r\n", 12) == 0 &&
+                reply.pending == 7 + (BATCH_KEYS - 1) * 5 + 7, "MGET should answer thousands of keys");
+    reply_free(&reply);
+
+    request_parser_reset(&parser);
+    TEST_ASSERT(parser.argv_cap == 0, "A reset should drop the arrays of a huge request");
+    char header[] = "*1000000\r\n";
+    TEST_ASSERT(request_parser_parse(&parser, header, strlen(header), &consumed) == REQUEST_PARSE_INCOMPLETE &&
+                parser.argv_cap <= REQUEST_ARGV_PREALLOC, "A large count alone should not reserve its arguments");
+    request_parser_free(&parser);
+    free(request);
+
+    TEST_SUCCESS("Batch command test passed");
+}
+
+void test_binary_safe() {
+    printf("Testing keys and values holding NUL bytes...\n");
+    size_t len;
+    const char *reply;
+
+    reply = run_request("*3\r\n$3\r\nSET\r\n$3\r\na\0b\r\n$5\r\nx\0y\0z\r\n", 33, &len);
+    TEST_ASSERT(REPLY_IS(reply, len, "+OK\r\n"), "SET should store a value with NULs");
+    reply = run_request("*2\r\n$3\r\nGET\r\n$3\r\na\0b\r\n", 22, &len);
+    TEST_ASSERT(REPLY_IS(reply, len, "$5\r\nx\0y\0z\r\n"), "GET should return every byte of the value");
+    TEST_ASSERT(strcmp(run_command("GET a"), "$-1\r\n") == 0, "A key should not end at its first NUL");
+
+    reply = run_request("*4\r\n$3\r\nSET\r\n$3\r\na\0b\r\n$1\r\nv\r\n$3\r\nGET\r\n", 38, &len);
+    TEST_ASSERT(REPLY_IS(reply, len, "$5\r\nx\0y\0z\r\n"), "SET GET should return the whole old value");
+
+    reply = run_request("*3\r\n$5\r\nRPUSH\r\n$2\r\nl\0\r\n$3\r\np\0q\r\n", 32, &len);
+    TEST_ASSERT(REPLY_IS(reply, len, ":1\r\n"), "RPUSH should accept a key and element with NULs");
+    reply = run_request("*4\r\n$6\r\nLRANGE\r\n$2\r\nl\0\r\n$1\r\n0\r\n$2\r\n-1\r\n", 39, &len);
+    TEST_ASSERT(REPLY_IS(reply, len, "*1\r\n$3\r\np\0q\r\n"), "LRANGE should return the element whole");
+
+    reply = run_request("*2\r\n$4\r\nECHO\r\n$2\r\n\0\0\r\n", 22, &len);
+    TEST_ASSERT(REPLY_IS(reply, len, "$2\r\n\0\0\r\n"), "ECHO should return every byte");
+    reply = run_request("*3\r\n$6\r\nEXPIRE\r\n$3\r\na\0b\r\n$3\r\n10\0\r\n", 34, &len);
+    TEST_ASSERT(len > 0 && memmem(reply, len, "not an integer", 14) != NULL,
+                "A number followed by a NUL should be rejected");
+
+    TEST_SUCCESS("Binary safety test passed");
+}
+
 int main() {
     init_test_framework();
     printf("=== RESP Parser Tests ===\n");
@@ -67,6 +482,17 @@ int main() {
     test_command_parsing();
     test_command_identification();
     test_invalid_resp_format();
+    test_incremental_parsing();
+    test_pipelined_parsing();
+    test_request_limits();
+    test_ttl_commands();
+    test_set_options();
+    test_blpop_without_client();
+    test_list_moves();
+    test_list_editing();
+    test_binary_safe();
+    test_counter_commands();
+    test_batch_commands();
     
     save_test_results();
     return total_tests_failed > 0 ? 1 : 0;
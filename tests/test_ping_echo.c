@@ -5,33 +5,44 @@
  * 
  * File                      : tests/test_ping_echo.c
  * Module                    : Client-Server Socket Communication Tests
- * Last Updating Author      : sch0penheimer
- * Last Update               : 2025/31/07
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
  * Version                   : 1.0.0
  * 
  * Description:
  *  Unit tests for direct client-server socket communication using socketpair.
- *  Tests PING and ECHO commands through the server's handle_client function.
+ *  Tests PING and ECHO commands through a server event loop, and TCP
+ *  clients accepted through SO_REUSEPORT and Unix domain listeners, and
+ *  admission at maxclients.
  * 
  * Copyright (c) 2025 MemoraDB Project
  * =====================================================
  */
 
+#define _GNU_SOURCE
 #include <assert.h>
+#include <errno.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
 #include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "../src/server/event_loop.h"
+#include "../src/server/connection.h"
+#include "../src/server/config.h"
+#include "../src/server/router.h"
+#include "../src/server/listener.h"
+#include "../src/utils/hashTable.h"
 #include "test_framework.h"
 
-#define BUFFER_SIZE 1024
-#define MAX_TOKENS 16
-
-extern void* handle_client(void*);
-extern int parse_command(char *input, char *tokens[], int max_tokens);
-extern void dispatch_command(int client_fd, char *tokens[], int token_count);
+#define BUFFER_SIZE 4096
 
 void test_ping_echo() {
     printf("Testing PING and ECHO commands via socketpair...\n");
@@ -40,11 +51,10 @@ void test_ping_echo() {
 
     TEST_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0, "Socketpair creation failed");
 
-    pthread_t tid;
-    int *server_fd = malloc(sizeof(int));
-    *server_fd = sv[1];
-    pthread_create(&tid, NULL, handle_client, server_fd);
-    pthread_detach(tid);
+    EventLoop *loop = event_loop_create(0);
+    TEST_ASSERT(loop != NULL, "Event loop creation failed");
+    TEST_ASSERT(connection_create(loop, sv[1], "socketpair", 0) != NULL, "Connection registration failed");
+    TEST_ASSERT(event_loop_start(loop) == 0, "Event loop thread failed to start");
 
     // --- PING test --- //
     const char *ping_cmd = "*1\r\n$4\r\nPING\r\n";
@@ -62,16 +72,745 @@ void test_ping_echo() {
     buffer[bytes] = '\0';
     TEST_ASSERT(strstr(buffer, "hello") != NULL, "ECHO command should return hello");
 
+    // --- Pipelined requests, the last one split across two writes --- //
+    const char *pipelined = "*1\r\n$4\r\nPING\r\n*2\r\n$4\r\nECHO\r\n$3\r\none\r\n*2\r\n$4\r\nECHO\r\n$3\r\ntw";
+    write(sv[0], pipelined, strlen(pipelined));
+    usleep(100000);
+    write(sv[0], "o\r\n", 3);
+    usleep(100000);
+    bytes = read(sv[0], buffer, sizeof(buffer) - 1);
+    buffer[bytes] = '\0';
+    TEST_ASSERT(strstr(buffer, "+PONG") != NULL, "Pipelined PING should be answered");
+    TEST_ASSERT(strstr(buffer, "one") != NULL, "Pipelined ECHO should be answered");
+    TEST_ASSERT(strstr(buffer, "two") != NULL, "Split ECHO should be answered once complete");
+
     close(sv[0]);
     
     TEST_SUCCESS("PING and ECHO socket communication test passed");
 }
 
+/**
+ * Read until `expected` bytes arrived or the peer stays quiet for a second.
+ */
+static int read_reply(int fd, char *buffer, size_t expected) {
+    size_t got = 0;
+    for (int waited = 0; got < expected && waited < 100; waited++) {
+        ssize_t n = recv(fd, buffer + got, BUFFER_SIZE - 1 - got, MSG_DONTWAIT);
+        if (n > 0) {
+            got += (size_t)n;
+        } else {
+            usleep(10000);
+        }
+    }
+    buffer[got] = '\0';
+    return (int)got;
+}
+
+/**
+ * Find a key starting with prefix owned by the given loop.
+ */
+static void key_owned_by(int owner, const char *prefix, char *key, size_t size) {
+    for (int i = 0; ; i++) {
+        snprintf(key, size, "%s%d", prefix, i);
+        if (router_shard_owner(keyspace_shard_of(key, strlen(key))) == owner) return;
+    }
+}
+
+void test_shard_per_core() {
+    printf("Testing shard-per-core forwarding between two loops...\n");
+    int sv[2];
+    char buffer[BUFFER_SIZE], request[BUFFER_SIZE];
+    char local_key[16], remote_key[16];
+
+    //-- Loop 0 is running from the previous test; add loop 1 and serve from it --//
+    server_config.shard_per_core = 1;
+    keyspace_set_lockless(1);
+
+    TEST_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0, "Socketpair creation failed");
+    EventLoop *loop = event_loop_create(1);
+    TEST_ASSERT(loop != NULL, "Event loop creation failed");
+    TEST_ASSERT(connection_create(loop, sv[1], "socketpair", 0) != NULL, "Connection registration failed");
+    TEST_ASSERT(event_loop_start(loop) == 0, "Event loop thread failed to start");
+
+    key_owned_by(1, "k", local_key, sizeof(local_key));
+    key_owned_by(0, "k", remote_key, sizeof(remote_key));
+
+    //-- Replies must come back in request order even when some ran on loop 0 --//
+    snprintf(request, sizeof(request),
+             "*3\r\n$3\r\nSET\r\n$%zu\r\n%s\r\n$1\r\na\r\n"
+             "*3\r\n$3\r\nSET\r\n$%zu\r\n%s\r\n$1\r\nb\r\n"
+             "*2\r\n$3\r\nGET\r\n$%zu\r\n%s\r\n"
+             "*1\r\n$4\r\nPING\r\n"
+             "*2\r\n$3\r\nGET\r\n$%zu\r\n%s\r\n",
+             strlen(local_key), local_key, strlen(remote_key), remote_key,
+             strlen(remote_key), remote_key, strlen(local_key), local_key);
+    write(sv[0], request, strlen(request));
+
+    const char *expected = "+OK\r\n+OK\r\n$1\r\nb\r\n+PONG\r\n$1\r\na\r\n";
+    read_reply(sv[0], buffer, strlen(expected));
+    TEST_ASSERT(strcmp(buffer, expected) == 0, "Forwarded and local replies should keep request order");
+
+    //-- Keys owned by different loops cannot be served by one command --//
+    snprintf(request, sizeof(request), "*3\r\n$3\r\nDEL\r\n$%zu\r\n%s\r\n$%zu\r\n%s\r\n",
+             strlen(local_key), local_key, strlen(remote_key), remote_key);
+    write(sv[0], request, strlen(request));
+    read_reply(sv[0], buffer, 20);
+    TEST_ASSERT(strstr(buffer, "CROSSSLOT") != NULL, "Multi-key command across loops should be rejected");
+
+    close(sv[0]);
+    TEST_SUCCESS("Shard-per-core forwarding test passed");
+}
+
+void test_expiry_and_info() {
+    printf("Testing active expiry and INFO through the event loops...\n");
+    int sv[2];
+    char buffer[BUFFER_SIZE], request[BUFFER_SIZE];
+
+    TEST_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0, "Socketpair creation failed");
+    TEST_ASSERT(connection_create(event_loop_get(1), sv[1], "socketpair", 0) != NULL,
+                "Connection registration failed");
+
+    //-- Keys on both loops, never read again: only the cron can reclaim them --//
+    size_t len = 0;
+    for (int i = 0; i < 20; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "ttl%d", i);
+        len += snprintf(request + len, sizeof(request) - len,
+                        "*5\r\n$3\r\nSET\r\n$%zu\r\n%s\r\n$1\r\nv\r\n$2\r\nPX\r\n$2\r\n10\r\n",
+                        strlen(key), key);
+    }
+    write(sv[0], request, len);
+    read_reply(sv[0], buffer, 20 * 5);
+    usleep(3 * EVENT_LOOP_CRON_MS * 1000);
+
+    const char *info = "*1\r\n$4\r\nINFO\r\n";
+    write(sv[0], info, strlen(info));
+    read_reply(sv[0], buffer, BUFFER_SIZE - 1);
+    TEST_ASSERT(buffer[0] == '$', "INFO should reply with a bulk string");
+    TEST_ASSERT(strstr(buffer, "\r\nexpires:0\r\n") != NULL, "Expired keys should have left the index");
+
+    char *field = strstr(buffer, "expired_keys:");
+    TEST_ASSERT(field != NULL && atoi(field + strlen("expired_keys:")) >= 20,
+                "Keys nobody read should be counted as expired");
+
+    close(sv[0]);
+    TEST_SUCCESS("Active expiry and INFO test passed");
+}
+
+/**
+ * Send a space-separated command as a RESP array.
+ */
+static void send_command(int fd, const char *line) {
+    char copy[256], request[BUFFER_SIZE];
+    char *args[16];
+    int argc = 0;
+
+    strncpy(copy, line, sizeof(copy) - 1);
+    copy[sizeof(copy) - 1] = '\0';
+    for (char *tok = strtok(copy, " "); tok && argc < 16; tok = strtok(NULL, " ")) {
+        args[argc++] = tok;
+    }
+
+    size_t len = snprintf(request, sizeof(request), "*%d\r\n", argc);
+    for (int i = 0; i < argc; i++) {
+        len += snprintf(request + len, sizeof(request) - len, "$%zu\r\n%s\r\n", strlen(args[i]), args[i]);
+    }
+    write(fd, request, len);
+}
+
+static int open_client(int loop_id) {
+    int sv[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) return -1;
+    if (!connection_create(event_loop_get(loop_id), sv[1], "socketpair", 0)) {
+        close(sv[0]);
+        return -1;
+    }
+    return sv[0];
+}
+
+void test_blocking_pop() {
+    printf("Testing BLPOP wake-ups, timeouts and disconnects...\n");
+    char buffer[BUFFER_SIZE], line[128], expected[128];
+    char keys[2][16];
+
+    //-- Clients live on loop 1: one key it owns, one whose BLPOP runs on loop 0 --//
+    key_owned_by(1, "q", keys[0], sizeof(keys[0]));
+    key_owned_by(0, "q", keys[1], sizeof(keys[1]));
+    int first = open_client(1), second = open_client(1), producer = open_client(0);
+    TEST_ASSERT(first >= 0 && second >= 0 && producer >= 0, "Client registration failed");
+
+    for (int k = 0; k < 2; k++) {
+        const char *key = keys[k];
+
+        snprintf(line, sizeof(line), "BLPOP %s 0", key);
+        send_command(first, line);
+        usleep(50000);
+        send_command(second, line);
+        usleep(50000);
+        TEST_ASSERT(recv(first, buffer, sizeof(buffer), MSG_DONTWAIT) < 0, "BLPOP on an empty list should block");
+
+        //-- Waiters are served oldest first, one element each --//
+        snprintf(line, sizeof(line), "RPUSH %s x y", key);
+        send_command(producer, line);
+        read_reply(producer, buffer, 4);
+        snprintf(expected, sizeof(expected), "*2\r\n$%zu\r\n%s\r\n$1\r\nx\r\n", strlen(key), key);
+        read_reply(first, buffer, strlen(expected));
+        TEST_ASSERT(strcmp(buffer, expected) == 0, "The oldest waiter should get the first element");
+        snprintf(expected, sizeof(expected), "*2\r\n$%zu\r\n%s\r\n$1\r\ny\r\n", strlen(key), key);
+        read_reply(second, buffer, strlen(expected));
+        TEST_ASSERT(strcmp(buffer, expected) == 0, "The next waiter should get the second element");
+
+        //-- A timed out BLPOP answers null, then the pipeline behind it runs --//
+        snprintf(line, sizeof(line), "BLPOP %s 0.05", key);
+        send_command(first, line);
+        send_command(first, "PING");
+        read_reply(first, buffer, strlen("$-1\r\n+PONG\r\n"));
+        TEST_ASSERT(strcmp(buffer, "$-1\r\n+PONG\r\n") == 0, "Timeout should answer null before later commands");
+    }
+
+    //-- A client that leaves while blocked must not swallow a later push --//
+    int leaving = open_client(1);
+    snprintf(line, sizeof(line), "BLPOP %s 0", keys[1]);
+    send_command(leaving, line);
+    usleep(50000);
+    close(leaving);
+    usleep(50000);
+    snprintf(line, sizeof(line), "RPUSH %s z", keys[1]);
+    send_command(producer, line);
+    read_reply(producer, buffer, 4);
+    snprintf(line, sizeof(line), "LPOP %s", keys[1]);
+    send_command(producer, line);
+    read_reply(producer, buffer, strlen("$1\r\nz\r\n"));
+    TEST_ASSERT(strcmp(buffer, "$1\r\nz\r\n") == 0, "Element should stay in the list after the waiter left");
+
+    send_command(producer, "INFO");
+    read_reply(producer, buffer, BUFFER_SIZE - 1);
+    TEST_ASSERT(strstr(buffer, "\r\nblocked_clients:0\r\n") != NULL, "No client should be left blocked");
+
+    close(first);
+    close(second);
+    close(producer);
+    TEST_SUCCESS("Blocking pop test passed");
+}
+
+void test_blocking_multi_key() {
+    printf("Testing multi-key BRPOP, BLMOVE and BLMPOP wake-ups...\n");
+    char buffer[BUFFER_SIZE], line[160], expected[160];
+    char a[16], b[16], c[16];
+
+    //-- All keys on loop 0 so a command may name several; the clients live on loop 1 --//
+    key_owned_by(0, "ma", a, sizeof(a));
+    key_owned_by(0, "mb", b, sizeof(b));
+    key_owned_by(0, "mc", c, sizeof(c));
+    int first = open_client(1), second = open_client(1), producer = open_client(0);
+    TEST_ASSERT(first >= 0 && second >= 0 && producer >= 0, "Client registration failed");
+
+    //-- Waiting on two lists: a push to either wakes it, once --//
+    snprintf(line, sizeof(line), "BRPOP %s %s 0", a, b);
+    send_command(first, line);
+    usleep(50000);
+    snprintf(line, sizeof(line), "RPUSH %s v", b);
+    send_command(producer, line);
+    read_reply(producer, buffer, 4);
+    snprintf(expected, sizeof(expected), "*2\r\n$%zu\r\n%s\r\n$1\r\nv\r\n", strlen(b), b);
+    read_reply(first, buffer, strlen(expected));
+    TEST_ASSERT(strcmp(buffer, expected) == 0, "A push to the second key should wake the client");
+    snprintf(line, sizeof(line), "RPUSH %s w", a);
+    send_command(producer, line);
+    read_reply(producer, buffer, 4);
+    TEST_ASSERT(strcmp(buffer, ":1\r\n") == 0, "A served client must not take from its other keys");
+    snprintf(line, sizeof(line), "LPOP %s", a);
+    send_command(producer, line);
+    read_reply(producer, buffer, strlen("$1\r\nw\r\n"));
+
+    //-- A BLMOVE served by a push feeds the client waiting on its destination --//
+    snprintf(line, sizeof(line), "BLMOVE %s %s RIGHT LEFT 0", a, c);
+    send_command(first, line);
+    usleep(50000);
+    snprintf(line, sizeof(line), "BLPOP %s 0", c);
+    send_command(second, line);
+    usleep(50000);
+    snprintf(line, sizeof(line), "RPUSH %s e", a);
+    send_command(producer, line);
+    read_reply(producer, buffer, 4);
+    read_reply(first, buffer, strlen("$1\r\ne\r\n"));
+    TEST_ASSERT(strcmp(buffer, "$1\r\ne\r\n") == 0, "BLMOVE should reply with the moved element");
+    snprintf(expected, sizeof(expected), "*2\r\n$%zu\r\n%s\r\n$1\r\ne\r\n", strlen(c), c);
+    read_reply(second, buffer, strlen(expected));
+    TEST_ASSERT(strcmp(buffer, expected) == 0, "The moved element should reach the destination's waiter");
+
+    //-- BLMPOP takes up to COUNT elements in one wake-up --//
+    snprintf(line, sizeof(line), "BLMPOP 0 2 %s %s LEFT COUNT 5", b, c);
+    send_command(first, line);
+    usleep(50000);
+    snprintf(line, sizeof(line), "RPUSH %s 1 2", c);
+    send_command(producer, line);
+    read_reply(producer, buffer, 4);
+    snprintf(expected, sizeof(expected), "*2\r\n$%zu\r\n%s\r\n*2\r\n$1\r\n1\r\n$1\r\n2\r\n", strlen(c), c);
+    read_reply(first, buffer, strlen(expected));
+    TEST_ASSERT(strcmp(buffer, expected) == 0, "BLMPOP should return the pushed elements together");
+
+    send_command(producer, "INFO");
+    read_reply(producer, buffer, BUFFER_SIZE - 1);
+    TEST_ASSERT(strstr(buffer, "\r\nblocked_clients:0\r\n") != NULL, "No client should be left blocked");
+
+    close(first);
+    close(second);
+    close(producer);
+    TEST_SUCCESS("Multi-key blocking test passed");
+}
+
+#define FLOOD_PINGS 200000
+
+static void *flood_pings(void *arg) {
+    int fd = *(int *)arg;
+    const char *ping = "*1\r\n$4\r\nPING\r\n";
+    char chunk[14 * 1000];
+    for (int i = 0; i < 1000; i++) memcpy(chunk + i * 14, ping, 14);
+    for (int sent = 0; sent < FLOOD_PINGS; sent += 1000) {
+        if (write(fd, chunk, sizeof(chunk)) != (ssize_t)sizeof(chunk)) break;
+    }
+    return NULL;
+}
+
+void test_read_budget() {
+    printf("Testing that a pipelining client shares its loop...\n");
+    char buffer[BUFFER_SIZE];
+
+    //-- Both clients on loop 0: the flood must not starve the other one --//
+    int flooder = open_client(0), other = open_client(0);
+    TEST_ASSERT(flooder >= 0 && other >= 0, "Client registration failed");
+    pthread_t thread;
+    pthread_create(&thread, NULL, flood_pings, &flooder);
+    usleep(20000);
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    send_command(other, "PING");
+    int got = read_reply(other, buffer, 7);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double waited_ms = (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6;
+    TEST_ASSERT(got == 7 && strcmp(buffer, "+PONG\r\n") == 0 && waited_ms < 1000,
+                "A client should be answered while another one floods the loop");
+
+    //-- Every flooded request is still answered once its turn comes --//
+    size_t expected = (size_t)FLOOD_PINGS * 7, received = 0;
+    for (int idle = 0; received < expected && idle < 200; ) {
+        ssize_t n = recv(flooder, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (n > 0) {
+            received += (size_t)n;
+            idle = 0;
+        } else {
+            usleep(10000);
+            idle++;
+        }
+    }
+    pthread_join(thread, NULL);
+    TEST_ASSERT(received == expected, "Input left over a read budget should be served on later turns");
+
+    close(flooder);
+    close(other);
+    TEST_SUCCESS("Read budget test passed");
+}
+
+void test_paused_input() {
+    printf("Testing input left unread behind a blocked command...\n");
+    char buffer[BUFFER_SIZE];
+
+    int sv[2];
+    TEST_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0, "Socketpair creation failed");
+    Connection *conn = connection_create(event_loop_get(0), sv[1], "socketpair", 0);
+    int producer = open_client(0);
+    TEST_ASSERT(conn != NULL && producer >= 0, "Client registration failed");
+
+    //-- Pipeline behind a BLPOP until the socket is full: nothing of it may pile up in memory --//
+    send_command(sv[0], "BLPOP paused:queue 0");
+    usleep(50000);
+    const char *ping = "*1\r\n$4\r\nPING\r\n";
+    size_t sent = 0;
+    for (int full = 0; full < 20; ) {
+        if (send(sv[0], ping, 14, MSG_DONTWAIT) == 14) {
+            sent += 14;
+        } else {
+            full++;
+            usleep(5000);
+        }
+    }
+    TEST_ASSERT(conn->querybuf_cap <= 2 * READ_BUDGET_BYTES, "A blocked client's input should stay in its socket");
+
+    //-- Once answered, everything left in the socket is served in order --//
+    send_command(producer, "RPUSH paused:queue job");
+    read_reply(producer, buffer, 4);
+    const char *expected = "*2\r\n$12\r\npaused:queue\r\n$3\r\njob\r\n";
+    int got = read_reply(sv[0], buffer, strlen(expected));
+    TEST_ASSERT(got >= (int)strlen(expected) && strncmp(buffer, expected, strlen(expected)) == 0,
+                "The blocked client should be answered first");
+    size_t pongs = got > (int)strlen(expected) ? (size_t)got - strlen(expected) : 0, target = sent / 14 * 7;
+    for (int idle = 0; pongs < target && idle < 100; ) {
+        ssize_t n = recv(sv[0], buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (n > 0) {
+            pongs += (size_t)n;
+            idle = 0;
+        } else {
+            usleep(10000);
+            idle++;
+        }
+    }
+    TEST_ASSERT(pongs == target, "Every request held back in the socket should be answered");
+
+    //-- A single request past the query buffer limit ends the connection --//
+    server_config.querybuf_limit_mb = 1;
+    int greedy = open_client(0);
+    const char *header = "*3\r\n$3\r\nSET\r\n$4\r\nhuge\r\n$4000000\r\n";
+    write(greedy, header, strlen(header));
+    char *chunk = calloc(1, 64 * 1024);
+    int closed = 0;
+    for (int i = 0; i < 40 && !closed; i++) {
+        if (send(greedy, chunk, 64 * 1024, MSG_NOSIGNAL) < 0) closed = 1;
+        usleep(5000);
+    }
+    free(chunk);
+    usleep(50000);
+    while (!closed) {
+        ssize_t n = recv(greedy, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (n == 0 || (n < 0 && errno != EAGAIN)) closed = 1;
+        else if (n < 0) break;
+    }
+    TEST_ASSERT(closed, "A client over the query buffer limit should be disconnected");
+    server_config.querybuf_limit_mb = DEFAULT_QUERYBUF_LIMIT_MB;
+
+    close(greedy);
+    close(sv[0]);
+    close(producer);
+    TEST_SUCCESS("Paused input test passed");
+}
+
+void test_output_limit() {
+    printf("Testing the output limit of a client that never reads...\n");
+    char buffer[BUFFER_SIZE];
+
+    //-- 600 KB per GET: a few unread replies are past a 1 MB limit --//
+    server_config.output_limit_mb = 1;
+    int client = open_client(0);
+    TEST_ASSERT(client >= 0, "Client registration failed");
+    size_t value_len = 600 * 1024;
+    char *request = malloc(value_len + 64);
+    int header = snprintf(request, 64, "*3\r\n$3\r\nSET\r\n$3\r\nbig\r\n$%zu\r\n", value_len);
+    memset(request + header, 'v', value_len);
+    memcpy(request + header + value_len, "\r\n", 2);
+    size_t request_len = (size_t)header + value_len + 2, sent = 0;
+    while (sent < request_len) {
+        ssize_t n = write(client, request + sent, request_len - sent);
+        if (n <= 0) break;
+        sent += (size_t)n;
+    }
+    free(request);
+    TEST_ASSERT(read_reply(client, buffer, 5) == 5 && strcmp(buffer, "+OK\r\n") == 0, "SET should succeed");
+
+    for (int i = 0; i < 20; i++) send_command(client, "GET big");
+    usleep(200000);
+
+    //-- What was written before the cut is delivered, then the connection ends --//
+    size_t received = 0;
+    int closed = 0;
+    for (int idle = 0; idle < 100 && !closed; ) {
+        ssize_t n = recv(client, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (n > 0) {
+            received += (size_t)n;
+            idle = 0;
+        } else if (n == 0) {
+            closed = 1;
+        } else {
+            usleep(10000);
+            idle++;
+        }
+    }
+    TEST_ASSERT(closed && received < 20 * value_len, "A client over the output limit should be disconnected");
+
+    close(client);
+    server_config.output_limit_mb = DEFAULT_OUTPUT_LIMIT_MB;
+    TEST_SUCCESS("Output limit test passed");
+}
+
+void test_threaded_io() {
+    printf("Testing threaded I/O with a single execution loop...\n");
+    char buffer[BUFFER_SIZE], line[256];
+
+    //-- Loops 0 and 1 become I/O loops; loop 2 executes every keyed command --//
+    server_config.shard_per_core = 0;
+    server_config.io_threads = 2;
+    EventLoop *executor = event_loop_create(router_executor());
+    TEST_ASSERT(executor != NULL && router_executor() == 2, "The execution loop should follow the I/O loops");
+    TEST_ASSERT(event_loop_start(executor) == 0, "Execution loop thread failed to start");
+    TEST_ASSERT(router_shard_owner(0) == 2 && router_shard_owner(KEYSPACE_SHARDS - 1) == 2,
+                "The execution loop should own every shard");
+
+    int first = open_client(0), second = open_client(1);
+    TEST_ASSERT(first >= 0 && second >= 0, "Client registration failed");
+
+    //-- Keys that shard-per-core would split across loops are served together --//
+    char a[16] = "io:a", b[16];
+    for (int i = 0; ; i++) {
+        snprintf(b, sizeof(b), "io:b%d", i);
+        if (keyspace_shard_of(b, strlen(b)) != keyspace_shard_of(a, strlen(a))) break;
+    }
+    snprintf(line, sizeof(line), "MSET %s 1 %s 2", a, b);
+    send_command(first, line);
+    send_command(first, "PING");
+    snprintf(line, sizeof(line), "MGET %s %s", a, b);
+    send_command(first, line);
+    const char *expected = "+OK\r\n+PONG\r\n*2\r\n$1\r\n1\r\n$1\r\n2\r\n";
+    read_reply(first, buffer, strlen(expected));
+    TEST_ASSERT(strcmp(buffer, expected) == 0, "Replies should keep request order across the execution loop");
+
+    //-- A client of one I/O loop is woken by a push from another --//
+    send_command(first, "BLPOP io:queue 0");
+    usleep(50000);
+    send_command(second, "RPUSH io:queue job");
+    read_reply(second, buffer, 4);
+    expected = "*2\r\n$8\r\nio:queue\r\n$3\r\njob\r\n";
+    read_reply(first, buffer, strlen(expected));
+    TEST_ASSERT(strcmp(buffer, expected) == 0, "BLPOP should be served across I/O loops");
+
+    send_command(second, "INFO");
+    read_reply(second, buffer, BUFFER_SIZE - 1);
+    TEST_ASSERT(strstr(buffer, "\r\nio_threads:2\r\n") != NULL, "INFO should report the I/O threads");
+
+    close(first);
+    close(second);
+    TEST_SUCCESS("Threaded I/O test passed");
+}
+
+#define STORM_CLIENTS 32
+
+void test_reuseport_listeners() {
+    printf("Testing SO_REUSEPORT listeners and CPU pinning...\n");
+    char buffer[BUFFER_SIZE];
+
+    //-- Port 0 picks a free port for the first socket; the second joins it --//
+    int first_fd = listener_open_tcp("127.0.0.1", 0, 128, 1);
+    TEST_ASSERT(first_fd >= 0, "A SO_REUSEPORT listener should open");
+    struct sockaddr_in addr;
+    socklen_t addr_len = sizeof(addr);
+    getsockname(first_fd, (struct sockaddr *)&addr, &addr_len);
+    int port = ntohs(addr.sin_port);
+    int second_fd = listener_open_tcp("127.0.0.1", port, 128, 1);
+    TEST_ASSERT(second_fd >= 0, "A second SO_REUSEPORT listener should share the port");
+    TEST_ASSERT(listener_open_tcp("127.0.0.1", port, 128, 0) < 0,
+                "A plain bind should fail while the port is taken");
+
+    //-- Each of two running loops accepts from its own socket --//
+    EventLoop *a = event_loop_get(0), *b = event_loop_get(1);
+    size_t before_a = a->num_connections, before_b = b->num_connections;
+    TEST_ASSERT(event_loop_add_listener(a, first_fd) == 0 && event_loop_add_listener(b, second_fd) == 0,
+                "Listener registration failed");
+
+    int clients[STORM_CLIENTS], answered = 0;
+    for (int i = 0; i < STORM_CLIENTS; i++) {
+        clients[i] = socket(AF_INET, SOCK_STREAM, 0);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (connect(clients[i], (struct sockaddr *)&addr, sizeof(addr)) != 0) continue;
+        send_command(clients[i], "PING");
+        if (read_reply(clients[i], buffer, 7) == 7 && strcmp(buffer, "+PONG\r\n") == 0) answered++;
+    }
+    TEST_ASSERT(answered == STORM_CLIENTS, "Every connection should be accepted and answered");
+    TEST_ASSERT(a->num_connections > before_a && b->num_connections > before_b,
+                "The kernel should spread connections over both sockets");
+    for (int i = 0; i < STORM_CLIENTS; i++) close(clients[i]);
+
+    //-- A pinned loop's thread may only run on its CPU --//
+    cpu_set_t allowed, set;
+    sched_getaffinity(0, sizeof(allowed), &allowed);
+    int cpu = 0;
+    while (!CPU_ISSET(cpu, &allowed)) cpu++;
+    EventLoop *pinned = event_loop_create(3);
+    TEST_ASSERT(pinned != NULL, "Event loop creation failed");
+    event_loop_set_cpu(pinned, cpu);
+    TEST_ASSERT(event_loop_start(pinned) == 0, "Pinned loop thread failed to start");
+    usleep(50000);
+    TEST_ASSERT(pthread_getaffinity_np(pinned->thread, sizeof(set), &set) == 0 &&
+                CPU_COUNT(&set) == 1 && CPU_ISSET(cpu, &set), "The loop thread should be pinned to its CPU");
+
+    TEST_SUCCESS("SO_REUSEPORT listener test passed");
+}
+
+void test_unix_listener() {
+    printf("Testing the Unix domain socket listener...\n");
+    char buffer[BUFFER_SIZE], path[64];
+    snprintf(path, sizeof(path), "/tmp/memoradb-test-%d.sock", (int)getpid());
+
+    //-- A regular file at the path is never replaced --//
+    FILE *f = fopen(path, "w");
+    if (f) fclose(f);
+    TEST_ASSERT(listener_open_unix(path, 0600, 16) < 0, "A regular file should not be replaced by the socket");
+    unlink(path);
+
+    //-- A socket file left by a dead server is --//
+    int stale = listener_open_unix(path, 0600, 16);
+    TEST_ASSERT(stale >= 0, "The Unix listener should open");
+    close(stale);
+    int fd = listener_open_unix(path, 0600, 16);
+    TEST_ASSERT(fd >= 0, "A stale socket file should be replaced");
+    TEST_ASSERT(listener_open_unix(path, 0600, 16) < 0, "A socket another server listens on should be kept");
+
+    struct stat st;
+    TEST_ASSERT(stat(path, &st) == 0 && S_ISSOCK(st.st_mode) && (st.st_mode & 0777) == 0600,
+                "The socket file should get the configured mode");
+
+    //-- Shared by two loops, served by the same connection handling as TCP --//
+    TEST_ASSERT(event_loop_add_listener(event_loop_get(0), fd) == 0 && event_loop_add_listener(event_loop_get(1), fd) == 0,
+                "Listener registration failed");
+    TEST_ASSERT(event_loop_add_listener(event_loop_get(0), fd) < 0, "A loop should refuse a third listener");
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, path, strlen(path) + 1);
+    int client = socket(AF_UNIX, SOCK_STREAM, 0);
+    TEST_ASSERT(connect(client, (struct sockaddr *)&addr, sizeof(addr)) == 0, "Connecting to the Unix socket failed");
+
+    send_command(client, "SET unix:key over-unix");
+    send_command(client, "GET unix:key");
+    const char *expected = "+OK\r\n$9\r\nover-unix\r\n";
+    read_reply(client, buffer, strlen(expected));
+    TEST_ASSERT(strcmp(buffer, expected) == 0, "Commands over the Unix socket should be answered");
+
+    close(client);
+    unlink(path);
+    TEST_SUCCESS("Unix domain socket listener test passed");
+}
+
+void test_maxclients() {
+    printf("Testing admission at maxclients...\n");
+    char buffer[BUFFER_SIZE], line[64];
+
+    //-- Let clients closed by earlier tests give their slots back --//
+    usleep(100000);
+    ConnectionStats before, after;
+    connection_stats(&before);
+    server_config.maxclients = (int)before.connected + 1;
+
+    int admitted = open_client(0);
+    TEST_ASSERT(admitted >= 0, "A client under maxclients should be admitted");
+
+    //-- The next one is told why and hung up on, without a Connection --//
+    int sv[2];
+    TEST_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0, "Socketpair creation failed");
+    TEST_ASSERT(connection_create(event_loop_get(0), sv[1], "socketpair", 0) == NULL,
+                "A client past maxclients should be refused");
+    int got = read_reply(sv[0], buffer, sizeof(MAXCLIENTS_ERROR) - 1);
+    TEST_ASSERT(got == (int)sizeof(MAXCLIENTS_ERROR) - 1 && strcmp(buffer, MAXCLIENTS_ERROR) == 0,
+                "The refused client should get the maxclients error");
+    TEST_ASSERT(recv(sv[0], buffer, sizeof(buffer), 0) == 0, "The refused client should be disconnected");
+    close(sv[0]);
+
+    connection_stats(&after);
+    TEST_ASSERT(after.connected == before.connected + 1, "Only the admitted client should hold a slot");
+    TEST_ASSERT(after.rejected == before.rejected + 1 && after.received == before.received + 1,
+                "Admissions and rejections should be counted");
+
+    send_command(admitted, "INFO");
+    read_reply(admitted, buffer, BUFFER_SIZE - 1);
+    snprintf(line, sizeof(line), "\r\nrejected_connections:%llu\r\n", after.rejected);
+    TEST_ASSERT(strstr(buffer, line) != NULL, "INFO should report rejected connections");
+    snprintf(line, sizeof(line), "\r\nconnected_clients:%zu\r\n", after.connected);
+    TEST_ASSERT(strstr(buffer, line) != NULL, "INFO should report connected clients");
+
+    //-- A disconnect frees its slot --//
+    close(admitted);
+    usleep(100000);
+    int again = open_client(0);
+    TEST_ASSERT(again >= 0, "A freed slot should admit a new client");
+    close(again);
+    usleep(100000);
+
+    server_config.maxclients = DEFAULT_MAXCLIENTS;
+    TEST_SUCCESS("Maxclients admission test passed");
+}
+
+static int connect_tcp_port(int port) {
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd >= 0 && connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void test_idle_timeout() {
+    printf("Testing idle client timeouts...\n");
+    char buffer[BUFFER_SIZE], line[64];
+
+    //-- Accepted by loop 3 itself, so only its thread ever touches its timer wheel --//
+    server_config.timeout = 1;
+    int listen_fd = listener_open_tcp("127.0.0.1", 0, 16, 0);
+    TEST_ASSERT(listen_fd >= 0, "A TCP listener should open");
+    struct sockaddr_in addr;
+    socklen_t addr_len = sizeof(addr);
+    getsockname(listen_fd, (struct sockaddr *)&addr, &addr_len);
+    TEST_ASSERT(event_loop_add_listener(event_loop_get(3), listen_fd) == 0, "Listener registration failed");
+
+    ConnectionStats before, after;
+    connection_stats(&before);
+    int idle = connect_tcp_port(ntohs(addr.sin_port));
+    int active = connect_tcp_port(ntohs(addr.sin_port));
+    int waiting = connect_tcp_port(ntohs(addr.sin_port));
+    TEST_ASSERT(idle >= 0 && active >= 0 && waiting >= 0, "Connecting to the listener failed");
+
+    //-- A client waiting on BLPOP is not idle, however long it waits --//
+    send_command(waiting, "BLPOP idle:queue 0");
+    int answered = 0;
+    for (int i = 0; i < 8; i++) {
+        send_command(active, "PING");
+        if (read_reply(active, buffer, 7) == 7 && strcmp(buffer, "+PONG\r\n") == 0) answered++;
+        usleep(300000);
+    }
+    TEST_ASSERT(answered == 8, "A client active within the timeout should be kept");
+    TEST_ASSERT(recv(idle, buffer, sizeof(buffer), MSG_DONTWAIT) == 0, "A client idle past the timeout should be closed");
+
+    send_command(active, "RPUSH idle:queue job");
+    read_reply(active, buffer, 4);
+    const char *expected = "*2\r\n$10\r\nidle:queue\r\n$3\r\njob\r\n";
+    read_reply(waiting, buffer, strlen(expected));
+    TEST_ASSERT(strcmp(buffer, expected) == 0, "A blocked client should outlive the timeout");
+
+    connection_stats(&after);
+    TEST_ASSERT(after.timedout == before.timedout + 1, "Only the idle client should time out");
+    send_command(active, "INFO");
+    read_reply(active, buffer, BUFFER_SIZE - 1);
+    snprintf(line, sizeof(line), "\r\ntimedout_connections:%llu\r\n", after.timedout);
+    TEST_ASSERT(strstr(buffer, "\r\ntimeout:1\r\n") != NULL && strstr(buffer, line) != NULL,
+                "INFO should report the timeout and timed out clients");
+
+    server_config.timeout = 0;
+    close(idle);
+    close(active);
+    close(waiting);
+    TEST_SUCCESS("Idle client timeout test passed");
+}
+
 int main() {
     init_test_framework();
     printf("=== Client-Server Socket Communication Tests ===\n");
     
     test_ping_echo();
+    test_shard_per_core();
+    test_expiry_and_info();
+    test_blocking_pop();
+    test_blocking_multi_key();
+    test_read_budget();
+    test_output_limit();
+    test_paused_input();
+    test_threaded_io();
+    test_reuseport_listeners();
+    test_unix_listener();
+    test_maxclients();
+    test_idle_timeout();
     
     save_test_results();
     return total_tests_failed > 0 ? 1 : 0;
@@ -0,0 +1,160 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : tests/test_reply.c
+ * Module                    : Reply Buffer Unit Tests
+ * Last Updating Author      : agent
+ * Last Update               : 10/17/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Unit tests for the per-connection reply buffer: RESP encoding,
+ *  overflow into blocks and vectored flushing over a socketpair.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include <assert.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include "../src/server/reply.h"
+#include "test_framework.h"
+
+static size_t read_all(int fd, char *buf, size_t cap) {
+    size_t total = 0;
+    while (total < cap) {
+        ssize_t n = read(fd, buf + total, cap - total);
+        if (n <= 0) break;
+        total += (size_t)n;
+    }
+    return total;
+}
+
+void test_resp_encoding() {
+    printf("Testing RESP encoding helpers...\n");
+
+    int sv[2];
+    TEST_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0, "Socketpair creation failed");
+
+    ReplyBuffer reply;
+    reply_init(&reply);
+    reply_add_simple(&reply, "OK");
+    reply_add_integer(&reply, -42);
+    reply_add_array_len(&reply, 2);
+    reply_add_bulk(&reply, "abc", 3);
+    reply_add_null(&reply);
+
+    const char *expected = "+OK\r\n:-42\r\n*2\r\n$3\r\nabc\r\n$-1\r\n";
+    TEST_ASSERT(reply_has_pending(&reply), "Reply should have pending output");
+    TEST_ASSERT(reply_flush(&reply, sv[1]) == 0, "Flush should write everything");
+    TEST_ASSERT(!reply_has_pending(&reply), "Nothing should be pending after flush");
+
+    char buf[128];
+    size_t n = read_all(sv[0], buf, strlen(expected));
+    TEST_ASSERT(n == strlen(expected) && memcmp(buf, expected, n) == 0, "Encoded reply should match RESP");
+
+    reply_free(&reply);
+    close(sv[0]);
+    close(sv[1]);
+    TEST_SUCCESS("RESP encoding test passed");
+}
+
+void test_overflow_and_partial_flush() {
+    printf("Testing overflow blocks and partial flushes...\n");
+
+    int sv[2];
+    TEST_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0, "Socketpair creation failed");
+    fcntl(sv[1], F_SETFL, fcntl(sv[1], F_GETFL) | O_NONBLOCK);
+
+    //-- Far more than the static chunk and the socket buffer can hold --//
+    ReplyBuffer reply;
+    reply_init(&reply);
+    const int elements = 50000;
+    reply_add_array_len(&reply, elements);
+    for (int i = 0; i < elements; i++) {
+        reply_add_bulk(&reply, "element-value", 13);
+    }
+    size_t total = reply.pending;
+    TEST_ASSERT(reply.head != NULL, "Large reply should spill into overflow blocks");
+
+    char *received = malloc(total);
+    size_t got = 0;
+    int rounds = 0;
+    while (reply_has_pending(&reply) && rounds++ < 10000) {
+        int r = reply_flush(&reply, sv[1]);
+        TEST_ASSERT(r >= 0, "Flush should not fail");
+        ssize_t n;
+        while ((n = recv(sv[0], received + got, total - got, MSG_DONTWAIT)) > 0) {
+            got += (size_t)n;
+        }
+    }
+    got += read_all(sv[0], received + got, total - got);
+
+    TEST_ASSERT(!reply_has_pending(&reply), "Reply should be fully flushed");
+    TEST_ASSERT(got == total, "Every byte should be delivered");
+    TEST_ASSERT(memcmp(received, "*50000\r\n$13\r\nelement-value\r\n", 28) == 0, "Reply should start with the array header");
+    TEST_ASSERT(memcmp(received + total - 20, "$13\r\nelement-value\r\n", 20) == 0, "Reply should end with the last element");
+
+    free(received);
+    reply_free(&reply);
+    close(sv[0]);
+    close(sv[1]);
+    TEST_SUCCESS("Overflow and partial flush test passed");
+}
+
+void test_transfer() {
+    printf("Testing reply transfer between buffers...\n");
+
+    //-- Source spans the static chunk and overflow blocks --//
+    ReplyBuffer src, dst;
+    reply_init(&src);
+    reply_init(&dst);
+    for (int i = 0; i < 5000; i++) {
+        reply_add_integer(&src, i);
+    }
+    size_t total = src.pending;
+
+    reply_add_simple(&dst, "first");
+    size_t first = dst.pending;
+    reply_transfer(&dst, &src, 4);          //- ":0\r\n" -//
+    reply_transfer(&dst, &src, total - 4);
+
+    TEST_ASSERT(!reply_has_pending(&src), "Source should be drained");
+    TEST_ASSERT(dst.pending == first + total, "Destination should hold every byte");
+
+    int sv[2];
+    TEST_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0, "Socketpair creation failed");
+    char *received = malloc(dst.pending);
+    size_t expected = dst.pending, got = 0;
+    while (reply_has_pending(&dst)) {
+        TEST_ASSERT(reply_flush(&dst, sv[1]) >= 0, "Flush should not fail");
+        got += read_all(sv[0], received + got, expected - got);
+    }
+    TEST_ASSERT(got == expected, "Every byte should be delivered");
+    TEST_ASSERT(memcmp(received, "+first\r\n:0\r\n:1\r\n", 16) == 0, "Transferred bytes should follow existing output");
+    TEST_ASSERT(memcmp(received + expected - 7, ":4999\r\n", 7) == 0, "Last transferred reply should come last");
+
+    free(received);
+    reply_free(&src);
+    reply_free(&dst);
+    close(sv[0]);
+    close(sv[1]);
+    TEST_SUCCESS("Reply transfer test passed");
+}
+
+int main() {
+    init_test_framework();
+    printf("=== Reply Buffer Tests ===\n");
+
+    test_resp_encoding();
+    test_overflow_and_partial_flush();
+    test_transfer();
+
+    save_test_results();
+    return total_tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,188 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : tests/test_slab.c
+ * Module                    : Slab Allocator Unit Tests
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Unit tests for the size-class allocator: object reuse within a class,
+ *  the per-class byte counters, resizing across class and malloc
+ *  boundaries, and objects freed by a thread other than (or outliving)
+ *  the one that allocated them.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include <string.h>
+#include <pthread.h>
+#include "../src/utils/slab.h"
+#include "test_framework.h"
+
+#define OBJECTS 1000
+
+void test_alloc_and_reuse() {
+    printf("Testing allocation and reuse within a class...\n");
+
+    void *a = slab_alloc(24);
+    TEST_ASSERT(a != NULL, "Allocation should succeed");
+    memset(a, 0xab, 24);
+    slab_free(a, 24);
+
+    //-- 17..32 bytes share a class, so the object just freed comes back --//
+    void *b = slab_alloc(32);
+    TEST_ASSERT(b == a, "A freed object should be handed out again by its class");
+    slab_free(b, 32);
+
+    void *small = slab_alloc(8), *other = slab_alloc(40);
+    TEST_ASSERT(small != NULL && other != NULL && small != other, "Different classes should give different objects");
+    slab_free(small, 8);
+    slab_free(other, 40);
+
+    //-- Many live objects never overlap --//
+    char *objects[OBJECTS];
+    for (int i = 0; i < OBJECTS; i++) {
+        objects[i] = slab_alloc(48);
+        TEST_ASSERT(objects[i] != NULL, "Allocation should succeed");
+        memset(objects[i], i & 0xff, 48);
+    }
+    int intact = 1;
+    for (int i = 0; i < OBJECTS; i++) {
+        for (int j = 0; j < 48; j++) {
+            if ((unsigned char)objects[i][j] != (i & 0xff)) intact = 0;
+        }
+        slab_free(objects[i], 48);
+    }
+    TEST_ASSERT(intact, "Live objects should not overlap");
+    TEST_SUCCESS("Allocation and reuse test passed");
+}
+
+void test_stats_accounting() {
+    printf("Testing per-class statistics...\n");
+
+    SlabStats before, during, after;
+    slab_stats(&before);
+
+    void *objects[10];
+    for (int i = 0; i < 10; i++) objects[i] = slab_alloc(20);
+    void *large = slab_alloc(1000);
+
+    slab_stats(&during);
+    const SlabClassStats *cls = &during.classes[1];
+    TEST_ASSERT(cls->size == 32, "The second class should hold 32-byte objects");
+    TEST_ASSERT(cls->allocated - before.classes[1].allocated == 10 * 32, "Allocated bytes should count whole objects");
+    TEST_ASSERT(cls->requested - before.classes[1].requested == 10 * 20, "Requested bytes should count what callers asked for");
+    TEST_ASSERT(cls->reserved >= SLAB_PAGE_BYTES, "The class should have carved at least one page");
+    TEST_ASSERT(during.large - before.large == 1000, "Large allocations should be counted separately");
+    TEST_ASSERT(during.reserved >= during.allocated && during.allocated >= during.requested,
+                "Reserved >= allocated >= requested");
+
+    for (int i = 0; i < 10; i++) slab_free(objects[i], 20);
+    slab_free(large, 1000);
+
+    slab_stats(&after);
+    TEST_ASSERT(after.classes[1].allocated == before.classes[1].allocated, "Frees should return the allocated bytes");
+    TEST_ASSERT(after.classes[1].requested == before.classes[1].requested, "Frees should return the requested bytes");
+    TEST_ASSERT(after.large == before.large, "Large frees should be counted");
+    TEST_SUCCESS("Statistics test passed");
+}
+
+void test_realloc_boundaries() {
+    printf("Testing resizing across classes and the malloc fallback...\n");
+
+    SlabStats before, after;
+    slab_stats(&before);
+
+    char *p = slab_alloc(10);
+    memcpy(p, "abcdefghi", 10);
+
+    char *same = slab_realloc(p, 10, 16);
+    TEST_ASSERT(same == p, "Resizing within a class should keep the object");
+
+    char *bigger = slab_realloc(same, 16, 100);
+    TEST_ASSERT(bigger != NULL && strcmp(bigger, "abcdefghi") == 0, "Growing to another class should keep the bytes");
+
+    char *large = slab_realloc(bigger, 100, 4000);
+    TEST_ASSERT(large != NULL && strcmp(large, "abcdefghi") == 0, "Growing past the slab should keep the bytes");
+    memset(large + 10, 'x', 3990);
+
+    large = slab_realloc(large, 4000, 8000);
+    TEST_ASSERT(large != NULL && large[3999] == 'x', "Resizing a large block should keep the bytes");
+
+    char *back = slab_realloc(large, 8000, 12);
+    TEST_ASSERT(back != NULL && strcmp(back, "abcdefghi") == 0 && back[10] == 'x', "Shrinking into the slab should keep the prefix");
+    slab_free(back, 12);
+
+    slab_stats(&after);
+    TEST_ASSERT(after.allocated == before.allocated && after.requested == before.requested && after.large == before.large,
+                "Every resize should move the counters with the object");
+    TEST_SUCCESS("Resize test passed");
+}
+
+static void *objects_shared[OBJECTS];
+
+static void *allocate_and_exit(void *arg) {
+    (void)arg;
+    for (int i = 0; i < OBJECTS; i++) {
+        objects_shared[i] = slab_alloc(64);
+        memset(objects_shared[i], 0x5a, 64);
+    }
+    return NULL;
+}
+
+static void *free_from_other_thread(void *arg) {
+    (void)arg;
+    for (int i = 0; i < OBJECTS; i++) slab_free(objects_shared[i], 64);
+    return NULL;
+}
+
+void test_cross_thread_free() {
+    printf("Testing frees from another thread...\n");
+
+    SlabStats before, after;
+    slab_stats(&before);
+
+    //-- The allocating thread has exited before its objects are freed --//
+    pthread_t producer, consumer;
+    pthread_create(&producer, NULL, allocate_and_exit, NULL);
+    pthread_join(producer, NULL);
+
+    int intact = 1;
+    for (int i = 0; i < OBJECTS; i++) {
+        if (((unsigned char *)objects_shared[i])[63] != 0x5a) intact = 0;
+    }
+    TEST_ASSERT(intact, "Objects should outlive the thread that allocated them");
+
+    pthread_create(&consumer, NULL, free_from_other_thread, NULL);
+    pthread_join(consumer, NULL);
+
+    slab_stats(&after);
+    TEST_ASSERT(after.classes[3].allocated == before.classes[3].allocated, "Counters should balance across threads");
+
+    //-- Objects spilled by the exited threads are handed out again here --//
+    size_t reserved = after.classes[3].reserved;
+    void *again[OBJECTS];
+    for (int i = 0; i < OBJECTS; i++) again[i] = slab_alloc(64);
+    slab_stats(&after);
+    TEST_ASSERT(after.classes[3].reserved == reserved, "Freed objects should be reused before new pages are carved");
+    for (int i = 0; i < OBJECTS; i++) slab_free(again[i], 64);
+    TEST_SUCCESS("Cross-thread free test passed");
+}
+
+int main() {
+    init_test_framework();
+    printf("=== Slab Allocator Tests ===\n");
+
+    test_alloc_and_reuse();
+    test_stats_accounting();
+    test_realloc_boundaries();
+    test_cross_thread_free();
+
+    save_test_results();
+    return total_tests_failed > 0 ? 1 : 0;
+}
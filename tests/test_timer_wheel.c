@@ -0,0 +1,209 @@
+/**
+ * =====================================================
+ * MemoraDB - In-Memory Database System
+ * =====================================================
+ *
+ * File                      : tests/test_timer_wheel.c
+ * Module                    : Timer Wheel Unit Tests
+ * Last Updating Author      : agent
+ * Last Update               : 10/18/2026
+ * Version                   : 1.0.0
+ *
+ * Description:
+ *  Unit tests for the hierarchical timer wheel: firing at the exact tick
+ *  across level boundaries, cancelling and moving timers, callbacks that
+ *  reschedule, and a randomised run checked against expected deadlines.
+ *
+ * Copyright (c) 2025 MemoraDB Project
+ * =====================================================
+ */
+
+#include <stdlib.h>
+#include "../src/utils/timer_wheel.h"
+#include "test_framework.h"
+
+#define WHEEL_TEST_TIMERS 5000
+
+typedef struct {
+    TimerNode node;               //- First member: the callback casts back -//
+    unsigned long long due;       //- Tick the test expects it to fire at -//
+    unsigned long long fired_at;  //- Tick it fired at, 0 if it has not -//
+    int fired;
+    int rearm;                    //- Ticks to schedule it again by when it fires -//
+} TestTimer;
+
+static unsigned long long current_tick;
+
+static void record_fire(TimerNode *node, void *arg) {
+    TestTimer *timer = (TestTimer *)node;
+    TimerWheel *wheel = arg;
+    timer->fired++;
+    timer->fired_at = current_tick;
+    if (timer->rearm > 0) {
+        timer->due = current_tick + (unsigned long long)timer->rearm;
+        timer->rearm = 0;
+        timer_wheel_schedule(wheel, node, timer->due);
+    }
+}
+
+//-- Advance one tick at a time, as the event loops do, recording when each timer fires --//
+static size_t run_until(TimerWheel *wheel, unsigned long long last) {
+    size_t fired = 0;
+    for (; current_tick <= last; current_tick++) {
+        fired += timer_wheel_advance(wheel, current_tick, record_fire, wheel);
+    }
+    return fired;
+}
+
+void test_exact_ticks() {
+    printf("Testing firing ticks across levels...\n");
+
+    //-- Deltas on each side of every level boundary --//
+    const unsigned long long deltas[] = { 0, 1, 63, 64, 65, 127, 128, 4095, 4096, 4097, 262143, 262144, 300000 };
+    const int n = (int)(sizeof(deltas) / sizeof(deltas[0]));
+    TestTimer timers[sizeof(deltas) / sizeof(deltas[0])];
+
+    //-- Start off a slot boundary so that cascades happen mid-way --//
+    TimerWheel wheel;
+    current_tick = 1000;
+    timer_wheel_init(&wheel, current_tick);
+    for (int i = 0; i < n; i++) {
+        timers[i] = (TestTimer){ .due = current_tick + deltas[i] };
+        timer_node_init(&timers[i].node);
+        timer_wheel_schedule(&wheel, &timers[i].node, timers[i].due);
+    }
+    TEST_ASSERT(timer_wheel_size(&wheel) == (size_t)n, "Every timer should be counted");
+
+    size_t fired = run_until(&wheel, 1000 + 300001);
+    int exact = 1;
+    for (int i = 0; i < n; i++) {
+        if (timers[i].fired != 1 || timers[i].fired_at != timers[i].due) exact = 0;
+    }
+    TEST_ASSERT(fired == (size_t)n && exact, "Each timer should fire once, at its own tick");
+    TEST_ASSERT(timer_wheel_size(&wheel) == 0, "Fired timers should leave the wheel");
+
+    //-- A deadline already passed fires on the next advance --//
+    TestTimer late = { .due = 0 };
+    timer_node_init(&late.node);
+    timer_wheel_schedule(&wheel, &late.node, 5);
+    run_until(&wheel, current_tick);
+    TEST_ASSERT(late.fired == 1, "A past deadline should fire on the next tick");
+    TEST_SUCCESS("Exact tick test passed");
+}
+
+void test_cancel_and_move() {
+    printf("Testing cancelling and moving timers...\n");
+
+    TimerWheel wheel;
+    current_tick = 0;
+    timer_wheel_init(&wheel, current_tick);
+
+    TestTimer cancelled = { .due = 10 }, moved_out = { .due = 5000 }, moved_in = { .due = 3 };
+    timer_node_init(&cancelled.node);
+    timer_node_init(&moved_out.node);
+    timer_node_init(&moved_in.node);
+    timer_wheel_schedule(&wheel, &cancelled.node, 10);
+    timer_wheel_schedule(&wheel, &moved_out.node, 20);
+    timer_wheel_schedule(&wheel, &moved_in.node, 100000);
+
+    timer_wheel_cancel(&wheel, &cancelled.node);
+    timer_wheel_cancel(&wheel, &cancelled.node);
+    TEST_ASSERT(!timer_node_scheduled(&cancelled.node), "A cancelled timer should not be scheduled");
+
+    //-- Moving a scheduled timer does not count it twice --//
+    timer_wheel_schedule(&wheel, &moved_out.node, 5000);
+    timer_wheel_schedule(&wheel, &moved_in.node, 3);
+    TEST_ASSERT(timer_wheel_size(&wheel) == 2, "Moving should not change the count");
+
+    run_until(&wheel, 6000);
+    TEST_ASSERT(cancelled.fired == 0, "A cancelled timer should not fire");
+    TEST_ASSERT(moved_in.fired == 1 && moved_in.fired_at == 3, "A timer moved earlier should fire at its new tick");
+    TEST_ASSERT(moved_out.fired == 1 && moved_out.fired_at == 5000, "A timer moved later should fire at its new tick");
+
+    //-- Too far ahead: clamped to the wheel's range, never lost --//
+    TestTimer far = { .due = 0 };
+    timer_node_init(&far.node);
+    timer_wheel_schedule(&wheel, &far.node, current_tick + TIMER_WHEEL_MAX_DELAY * 4);
+    TEST_ASSERT(far.node.expires == current_tick + TIMER_WHEEL_MAX_DELAY, "A long delay should be clamped");
+    timer_wheel_cancel(&wheel, &far.node);
+    TEST_ASSERT(timer_wheel_size(&wheel) == 0, "Cancelling should empty the wheel");
+    TEST_SUCCESS("Cancel and move test passed");
+}
+
+void test_rearm_from_callback() {
+    printf("Testing timers scheduled again by their callback...\n");
+
+    TimerWheel wheel;
+    current_tick = 63;
+    timer_wheel_init(&wheel, current_tick);
+
+    //-- Idle-timeout style: on firing, the owner finds recent activity and pushes the deadline back --//
+    TestTimer again = { .due = 64, .rearm = 100 };
+    TestTimer twin = { .due = 64 };
+    timer_node_init(&again.node);
+    timer_node_init(&twin.node);
+    timer_wheel_schedule(&wheel, &again.node, 64);
+    timer_wheel_schedule(&wheel, &twin.node, 64);
+
+    run_until(&wheel, 200);
+    TEST_ASSERT(twin.fired == 1 && twin.fired_at == 64, "A timer sharing the slot should fire once");
+    TEST_ASSERT(again.fired == 2 && again.fired_at == 164, "A re-armed timer should fire again at its new tick");
+    TEST_SUCCESS("Re-arm test passed");
+}
+
+void test_random_deadlines() {
+    printf("Testing %d random deadlines...\n", WHEEL_TEST_TIMERS);
+
+    static TestTimer timers[WHEEL_TEST_TIMERS];
+    TimerWheel wheel;
+    current_tick = 123456;
+    timer_wheel_init(&wheel, current_tick);
+    srand(7);
+
+    unsigned long long last = current_tick;
+    for (int i = 0; i < WHEEL_TEST_TIMERS; i++) {
+        timers[i] = (TestTimer){ .due = current_tick + (unsigned long long)(rand() % 200000) };
+        timer_node_init(&timers[i].node);
+        timer_wheel_schedule(&wheel, &timers[i].node, timers[i].due);
+        if (timers[i].due > last) last = timers[i].due;
+    }
+
+    //-- Cancel every third one and move every fifth one part way through --//
+    run_until(&wheel, current_tick + 1000);
+    for (int i = 0; i < WHEEL_TEST_TIMERS; i++) {
+        if (timers[i].fired) continue;
+        if (i % 3 == 0) {
+            timer_wheel_cancel(&wheel, &timers[i].node);
+            timers[i].due = 0;
+        } else if (i % 5 == 0) {
+            timers[i].due = current_tick + (unsigned long long)(rand() % 5000);
+            timer_wheel_schedule(&wheel, &timers[i].node, timers[i].due);
+        }
+    }
+
+    run_until(&wheel, last + 1);
+    int correct = 1;
+    for (int i = 0; i < WHEEL_TEST_TIMERS; i++) {
+        if (timers[i].due == 0) {
+            if (timers[i].fired) correct = 0;
+        } else if (timers[i].fired != 1 || timers[i].fired_at != timers[i].due) {
+            correct = 0;
+        }
+    }
+    TEST_ASSERT(correct, "Every live timer should fire once at its deadline, and no cancelled one");
+    TEST_ASSERT(timer_wheel_size(&wheel) == 0, "The wheel should end empty");
+    TEST_SUCCESS("Random deadline test passed");
+}
+
+int main() {
+    init_test_framework();
+    printf("=== Timer Wheel Tests ===\n");
+
+    test_exact_ticks();
+    test_cancel_and_move();
+    test_rearm_from_callback();
+    test_random_deadlines();
+
+    save_test_results();
+    return total_tests_failed > 0 ? 1 : 0;
+}